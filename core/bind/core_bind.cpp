@@ -55,6 +55,7 @@
 #include "core/string_formatter.h"
 #include "EASTL/sort.h"
 
+VARIANT_ENUM_CAST(_ResourceLoader::ThreadLoadStatus);
 VARIANT_ENUM_CAST(_ResourceSaver::SaverFlags);
 VARIANT_ENUM_CAST(_OS::VideoDriver);
 VARIANT_ENUM_CAST(_OS::Weekday);
@@ -107,6 +108,29 @@ RES _ResourceLoader::load(se_string_view p_path, se_string_view p_type_hint, boo
     return ret;
 }
 
+Error _ResourceLoader::load_threaded_request(se_string_view p_path, se_string_view p_type_hint, bool p_use_sub_threads) {
+
+    return ResourceLoader::load_threaded_request(p_path, p_type_hint, p_use_sub_threads);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(se_string_view p_path, Array p_progress) {
+
+    float progress = 0;
+    ThreadLoadStatus status = (ThreadLoadStatus)ResourceLoader::load_threaded_get_status(p_path, &progress);
+    p_progress.resize(1);
+    p_progress[0] = progress;
+    return status;
+}
+
+RES _ResourceLoader::load_threaded_get(se_string_view p_path) {
+
+    Error err = OK;
+    RES ret(ResourceLoader::load_threaded_get(p_path, &err));
+
+    ERR_FAIL_COND_V_MSG(err != OK, ret, "Error loading resource: '" + String(p_path) + "'.");
+    return ret;
+}
+
 PoolStringArray _ResourceLoader::get_recognized_extensions_for_type(se_string_view p_type) {
 
     Vector<String> exts;
@@ -137,6 +161,47 @@ bool _ResourceLoader::has_cached(se_string_view p_path) {
     return ResourceCache::has(local_path);
 }
 
+void _ResourceLoader::set_cache_memory_budget(int64_t p_bytes) {
+
+    ResourceCache::set_memory_budget(MAX(p_bytes, 0));
+}
+
+int64_t _ResourceLoader::get_cache_memory_budget() const {
+
+    return ResourceCache::get_memory_budget();
+}
+
+Array _ResourceLoader::get_cache_residency() const {
+
+    Vector<ResourceCache::Residency> residency;
+    ResourceCache::get_residency(residency);
+
+    Array ret;
+    for (const ResourceCache::Residency &r : residency) {
+        Dictionary d;
+        d["path"] = r.path;
+        d["type"] = r.type;
+        d["memory_usage"] = r.memory_usage;
+        d["last_used_msec"] = r.last_used_usec / 1000;
+        d["references"] = r.reference_count;
+        d["soft_cached"] = r.soft_cached;
+        ret.push_back(d);
+    }
+    return ret;
+}
+
+Dictionary _ResourceLoader::get_cache_memory_usage_by_type() const {
+
+    Vector<ResourceCache::Residency> residency;
+    ResourceCache::get_residency(residency);
+
+    Dictionary ret;
+    for (const ResourceCache::Residency &r : residency) {
+        ret[r.type] = uint64_t(ret.get(r.type, 0)) + r.memory_usage;
+    }
+    return ret;
+}
+
 bool _ResourceLoader::exists(se_string_view p_path, se_string_view p_type_hint) {
     return ResourceLoader::exists(p_path, p_type_hint);
 }
@@ -145,11 +210,23 @@ void _ResourceLoader::_bind_methods() {
 
     MethodBinder::bind_method(D_METHOD("load_interactive", {"path", "type_hint"}), &_ResourceLoader::load_interactive, {DEFVAL(String())});
     MethodBinder::bind_method(D_METHOD("load", {"path", "type_hint", "no_cache"}), &_ResourceLoader::load, {DEFVAL(String()), DEFVAL(false)});
+    MethodBinder::bind_method(D_METHOD("load_threaded_request", {"path", "type_hint", "use_sub_threads"}), &_ResourceLoader::load_threaded_request, {DEFVAL(String()), DEFVAL(false)});
+    MethodBinder::bind_method(D_METHOD("load_threaded_get_status", {"path", "progress"}), &_ResourceLoader::load_threaded_get_status, {DEFVAL(Array())});
+    MethodBinder::bind_method(D_METHOD("load_threaded_get", {"path"}), &_ResourceLoader::load_threaded_get);
     MethodBinder::bind_method(D_METHOD("get_recognized_extensions_for_type", {"type"}), &_ResourceLoader::get_recognized_extensions_for_type);
     MethodBinder::bind_method(D_METHOD("set_abort_on_missing_resources", {"abort"}), &_ResourceLoader::set_abort_on_missing_resources);
     MethodBinder::bind_method(D_METHOD("get_dependencies", {"path"}), &_ResourceLoader::get_dependencies);
     MethodBinder::bind_method(D_METHOD("has_cached", {"path"}), &_ResourceLoader::has_cached);
+    MethodBinder::bind_method(D_METHOD("set_cache_memory_budget", {"bytes"}), &_ResourceLoader::set_cache_memory_budget);
+    MethodBinder::bind_method(D_METHOD("get_cache_memory_budget"), &_ResourceLoader::get_cache_memory_budget);
+    MethodBinder::bind_method(D_METHOD("get_cache_residency"), &_ResourceLoader::get_cache_residency);
+    MethodBinder::bind_method(D_METHOD("get_cache_memory_usage_by_type"), &_ResourceLoader::get_cache_memory_usage_by_type);
     MethodBinder::bind_method(D_METHOD("exists", {"path", "type_hint"}), &_ResourceLoader::exists, {DEFVAL(String())});
+
+    BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE)
+    BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS)
+    BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED)
+    BIND_ENUM_CONSTANT(THREAD_LOAD_LOADED)
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -191,6 +268,7 @@ void _ResourceSaver::_bind_methods() {
     BIND_ENUM_CONSTANT(FLAG_SAVE_BIG_ENDIAN)
     BIND_ENUM_CONSTANT(FLAG_COMPRESS)
     BIND_ENUM_CONSTANT(FLAG_REPLACE_SUBRESOURCE_PATHS)
+    BIND_ENUM_CONSTANT(FLAG_COMPRESS_BULK_ARRAYS)
 }
 
 _ResourceSaver::_ResourceSaver() {
@@ -59,13 +59,27 @@ protected:
     static _ResourceLoader *singleton;
 
 public:
+    enum ThreadLoadStatus {
+        THREAD_LOAD_INVALID_RESOURCE,
+        THREAD_LOAD_IN_PROGRESS,
+        THREAD_LOAD_FAILED,
+        THREAD_LOAD_LOADED,
+    };
+
     static _ResourceLoader *get_singleton() { return singleton; }
     INVOCABLE Ref<ResourceInteractiveLoader> load_interactive(se_string_view p_path, se_string_view p_type_hint = se_string_view());
     INVOCABLE RES load(se_string_view p_path, se_string_view p_type_hint = se_string_view(), bool p_no_cache = false);
+    INVOCABLE Error load_threaded_request(se_string_view p_path, se_string_view p_type_hint = se_string_view(), bool p_use_sub_threads = false);
+    INVOCABLE ThreadLoadStatus load_threaded_get_status(se_string_view p_path, Array p_progress = Array());
+    INVOCABLE RES load_threaded_get(se_string_view p_path);
     INVOCABLE PoolStringArray get_recognized_extensions_for_type(se_string_view p_type);
     INVOCABLE void set_abort_on_missing_resources(bool p_abort);
     INVOCABLE Vector<String> get_dependencies(se_string_view p_path);
     INVOCABLE bool has_cached(se_string_view p_path);
+    INVOCABLE void set_cache_memory_budget(int64_t p_bytes);
+    INVOCABLE int64_t get_cache_memory_budget() const;
+    INVOCABLE Array get_cache_residency() const;
+    INVOCABLE Dictionary get_cache_memory_usage_by_type() const;
     INVOCABLE bool exists(se_string_view p_path, se_string_view p_type_hint = se_string_view());
 
     _ResourceLoader();
@@ -87,6 +101,7 @@ public:
         FLAG_SAVE_BIG_ENDIAN = 16,
         FLAG_COMPRESS = 32,
         FLAG_REPLACE_SUBRESOURCE_PATHS = 64,
+        FLAG_COMPRESS_BULK_ARRAYS = 128,
     };
 
     static _ResourceSaver *get_singleton() { return singleton; }
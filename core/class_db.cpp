@@ -84,14 +84,32 @@ ClassDB::APIType ClassDB::get_current_api() {
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
+Vector<ClassDB::ClassInfo *> ClassDB::flattened_classes;
+std::mutex ClassDB::flatten_mutex;
 
 ClassDB::ClassInfo::ClassInfo() = default;
 
+// Resolves a method by walking the inheritance chain directly; used while
+// registering so that every bind does not force a rebuild of the flat tables.
+static MethodBind *_find_method_in_chain(const ClassDB::ClassInfo *p_type, const StringName &p_name) {
+    for (const ClassDB::ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+        MethodBind *method = check->method_map.at(p_name, nullptr);
+        if (method)
+            return method;
+    }
+    return nullptr;
+}
+
 ClassDB::ClassInfo::~ClassInfo() {
     for(auto & entry : method_map) {
         memdelete(entry.second);
     }
     method_map.clear();
+    for (const FlatTables *tables : retired_flat) {
+        memdelete(tables);
+    }
+    if (flat.load(std::memory_order_relaxed))
+        memdelete(flat.load(std::memory_order_relaxed));
 }
 
 bool ClassDB::is_parent_class(const StringName &p_class, const StringName &p_inherits) {
@@ -370,6 +388,19 @@ Object *ClassDB::instance(const StringName &p_class) {
     return ti->creation_func();
 }
 
+Object *(*ClassDB::get_creation_func(const StringName &p_class))() {
+
+    RWLockRead _rw_lockr_(lock);
+    auto iter = classes.find(p_class);
+    if (iter == classes.end() || iter->second.disabled)
+        return nullptr;
+#ifdef TOOLS_ENABLED
+    if (iter->second.api == API_EDITOR && !Engine::get_singleton()->is_editor_hint())
+        return nullptr;
+#endif
+    return iter->second.creation_func;
+}
+
 bool ClassDB::can_instance(const StringName &p_class) {
 
     RWLockRead _rw_lockr_(lock);
@@ -393,7 +424,6 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 
     ERR_FAIL_COND_MSG(classes.contains(name), "Class '" + String(p_class) + "' already exists.");
 
-    classes[name] = ClassInfo();
     ClassInfo &ti = classes[name];
     ti.name = name;
     ti.inherits = p_inherits;
@@ -482,20 +512,92 @@ void ClassDB::get_method_list(
     }
 }
 
+ClassDB::FlatTables *ClassDB::_flatten_class(const ClassInfo *p_class) {
+
+    FlatTables *tables = memnew(FlatTables);
+
+    // Walk from the class itself up to the root; the first entry found for a
+    // name wins, exactly as the per-level lookups used to resolve it.
+    for (const ClassInfo *check = p_class; check; check = check->inherits_ptr) {
+
+        for (const auto &E : check->method_map) {
+            tables->methods.insert(E);
+        }
+        for (const auto &E : check->property_setget) {
+            FlatProperty &fp = tables->properties[E.first];
+            if (!fp.setget)
+                fp.setget = &E.second;
+        }
+        for (const auto &E : check->constant_map) {
+            FlatProperty &fp = tables->properties[E.first];
+            if (fp.has_constant)
+                continue;
+            fp.has_constant = true;
+            fp.constant = E.second;
+            // A setget at the same or a more derived level is checked first.
+            fp.constant_first = fp.setget == nullptr;
+        }
+    }
+    return tables;
+}
+
+const ClassDB::FlatTables *ClassDB::_get_flattened(const StringName &p_class) {
+
+    auto iter = classes.find(p_class);
+    if (iter == classes.end())
+        return nullptr;
+
+    ClassInfo *type = &iter->second;
+    const FlatTables *tables = type->flat.load(std::memory_order_acquire);
+    if (tables)
+        return tables;
+
+    // Classes keep registering lazily on first instantiation, so the tables
+    // are built on demand.
+    std::lock_guard<std::mutex> guard(flatten_mutex);
+    tables = type->flat.load(std::memory_order_relaxed);
+    if (tables)
+        return tables;
+
+    FlatTables *fresh = _flatten_class(type);
+    flattened_classes.push_back(type);
+    type->flat.store(fresh, std::memory_order_release);
+    return fresh;
+}
+
+void ClassDB::_invalidate_flattened(const ClassInfo *p_class) {
+
+    // Only p_class and the classes inheriting from it can see the new entry.
+    // Other threads may be probing their tables, so those are retired
+    // instead of freed. A build racing the registration is published before
+    // this runs and gets retired here too.
+    std::lock_guard<std::mutex> guard(flatten_mutex);
+    for (size_t i = 0; i < flattened_classes.size();) {
+
+        ClassInfo *type = flattened_classes[i];
+        const ClassInfo *check = type;
+        while (check && check != p_class)
+            check = check->inherits_ptr;
+        if (!check) {
+            ++i;
+            continue;
+        }
+        type->retired_flat.push_back(type->flat.load(std::memory_order_relaxed));
+        type->flat.store(nullptr, std::memory_order_release);
+        flattened_classes[i] = flattened_classes.back();
+        flattened_classes.pop_back();
+    }
+}
+
 MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 
     RWLockRead _rw_lockr_(lock);
 
-    auto iter=classes.find(p_class);
+    const FlatTables *tables = _get_flattened(p_class);
+    if (!tables)
+        return nullptr;
 
-    ClassInfo *type = iter!=classes.end() ? &iter->second : nullptr;
-    while (type) {
-        MethodBind *method = type->method_map.at(p_name,nullptr);
-        if (method)
-            return method;
-        type = type->inherits_ptr;
-    }
-    return nullptr;
+    return tables->methods.at(p_name, nullptr);
 }
 
 void ClassDB::bind_integer_constant(
@@ -516,6 +618,7 @@ void ClassDB::bind_integer_constant(
     }
 
     type->constant_map[p_name] = p_constant;
+    _invalidate_flattened(type);
 
     se_string_view enum_name(p_enum);
     if (!p_enum.empty()) {
@@ -752,7 +855,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 
     MethodBind *mb_set = nullptr;
     if (p_setter) {
-        mb_set = get_method(p_class, p_setter);
+        mb_set = _find_method_in_chain(type, p_setter);
 #ifdef DEBUG_METHODS_ENABLED
 
         ERR_FAIL_COND_MSG(!mb_set, String("Invalid setter '") + p_class + "::" + p_setter + "' for property '" + p_pinfo.name + "'.");
@@ -765,7 +868,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
     MethodBind *mb_get = nullptr;
     if (p_getter) {
 
-        mb_get = get_method(p_class, p_getter);
+        mb_get = _find_method_in_chain(type, p_getter);
 #ifdef DEBUG_METHODS_ENABLED
 
         ERR_FAIL_COND_MSG(!mb_get, String("Invalid getter '") + p_class + "::" + p_getter + "' for property '" + p_pinfo.name + "'.");
@@ -799,6 +902,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
     psg.type = p_pinfo.type;
 
     type->property_setget[p_pinfo.name] = psg;
+    _invalidate_flattened(type);
 }
 
 void ClassDB::set_property_default_value(StringName p_class, const StringName &p_name, const Variant &p_default) {
@@ -832,91 +936,84 @@ void ClassDB::get_property_list(
     }
 }
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
-    auto iter=classes.find(p_object->get_class_name());
-    ClassInfo *type = iter!=classes.end() ? &iter->second : nullptr;
-    ClassInfo *check = type;
-    while (check) {
-        auto iter = check->property_setget.find(p_property);
-        if (iter!=check->property_setget.end()) {
-            const PropertySetGet &psg(iter->second);
-            if (!psg.setter) {
-                if (r_valid)
-                    *r_valid = false;
-                return true; // return true but do nothing
-            }
-
-            Variant::CallError ce;
+    const FlatTables *tables = _get_flattened(p_object->get_class_name());
+    if (!tables)
+        return false;
 
-            if (psg.index >= 0) {
-                Variant index = psg.index;
-                const Variant *arg[2] = { &index, &p_value };
-                // p_object->call(psg.setter,arg,2,ce);
-                if (psg._setptr) {
-                    psg._setptr->call(p_object, arg, 2, ce);
-                } else {
-                    p_object->call(psg.setter, arg, 2, ce);
-                }
+    auto iter = tables->properties.find(p_property);
+    if (iter == tables->properties.end() || !iter->second.setget)
+        return false;
 
-            } else {
-                const Variant *arg[1] = { &p_value };
-                if (psg._setptr) {
-                    psg._setptr->call(p_object, arg, 1, ce);
-                } else {
-                    p_object->call(psg.setter, arg, 1, ce);
-                }
-            }
+    const PropertySetGet &psg(*iter->second.setget);
+    if (!psg.setter) {
+        if (r_valid)
+            *r_valid = false;
+        return true; // return true but do nothing
+    }
 
-            if (r_valid)
-                *r_valid = ce.error == Variant::CallError::CALL_OK;
+    Variant::CallError ce;
 
-            return true;
+    if (psg.index >= 0) {
+        Variant index = psg.index;
+        const Variant *arg[2] = { &index, &p_value };
+        // p_object->call(psg.setter,arg,2,ce);
+        if (psg._setptr) {
+            psg._setptr->call(p_object, arg, 2, ce);
+        } else {
+            p_object->call(psg.setter, arg, 2, ce);
         }
 
-        check = check->inherits_ptr;
+    } else {
+        const Variant *arg[1] = { &p_value };
+        if (psg._setptr) {
+            psg._setptr->call(p_object, arg, 1, ce);
+        } else {
+            p_object->call(psg.setter, arg, 1, ce);
+        }
     }
 
-    return false;
+    if (r_valid)
+        *r_valid = ce.error == Variant::CallError::CALL_OK;
+
+    return true;
 }
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 
-    auto iter=classes.find(p_object->get_class_name());
-    ClassInfo *type = iter!=classes.end() ? &iter->second : nullptr;
-    ClassInfo *check = type;
-    while (check) {
-        auto iter2 = check->property_setget.find(p_property);
-        if (iter2!=check->property_setget.end()) {
-            const PropertySetGet &psg(iter2->second);
-            if (!psg.getter) return true; // return true but do nothing
+    const FlatTables *tables = _get_flattened(p_object->get_class_name());
+    if (!tables)
+        return false;
 
-            if (psg.index >= 0) {
-                Variant index = psg.index;
-                const Variant *arg[1] = { &index };
-                Variant::CallError ce;
-                r_value = p_object->call(psg.getter, arg, 1, ce);
+    auto iter = tables->properties.find(p_property);
+    if (iter == tables->properties.end())
+        return false;
 
-            } else {
+    const FlatProperty &fp(iter->second);
+    if (fp.has_constant && fp.constant_first) {
 
-                Variant::CallError ce;
-                if (psg._getptr) {
+        r_value = fp.constant;
+        return true;
+    }
 
-                    r_value = psg._getptr->call(p_object, nullptr, 0, ce);
-                } else {
-                    r_value = p_object->call(psg.getter, nullptr, 0, ce);
-                }
-            }
-            return true;
-        }
-        auto iter = check->constant_map.find(p_property);
-        if (iter!= check->constant_map.end()) {
+    const PropertySetGet &psg(*fp.setget);
+    if (!psg.getter) return true; // return true but do nothing
 
-            r_value = iter->second;
-            return true;
-        }
+    if (psg.index >= 0) {
+        Variant index = psg.index;
+        const Variant *arg[1] = { &index };
+        Variant::CallError ce;
+        r_value = p_object->call(psg.getter, arg, 1, ce);
 
-        check = check->inherits_ptr;
-    }
+    } else {
 
-    return false;
+        Variant::CallError ce;
+        if (psg._getptr) {
+
+            r_value = psg._getptr->call(p_object, nullptr, 0, ce);
+        } else {
+            r_value = p_object->call(psg.getter, nullptr, 0, ce);
+        }
+    }
+    return true;
 }
 
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
@@ -1085,6 +1182,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 #endif
 
     type->method_map[mdname] = p_bind;
+    _invalidate_flattened(type);
 
     Vector<Variant> defvals;
 
@@ -1278,6 +1376,7 @@ void ClassDB::cleanup_defaults() {
 void ClassDB::cleanup() {
 
     // OBJTYPE_LOCK; hah not here
+    flattened_classes.clear();
     classes.clear();
     resource_base_extensions.clear();
     compat_classes.clear();
@@ -1300,6 +1399,7 @@ bool ClassDB::bind_helper(MethodBind *bind, const char *instance_type, const Str
         ERR_FAIL_V_MSG(false, String("Method already bound: ") + instance_type + "::" + p_name + ".");
     }
     type->method_map[p_name] = bind;
+    _invalidate_flattened(type);
 #ifdef DEBUG_METHODS_ENABLED
     // FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
     // bind->set_return_type("Variant");
@@ -40,7 +40,9 @@
 
 #include "EASTL/vector.h"
 
+#include <atomic>
 #include <initializer_list>
+#include <mutex>
 
 class MethodBind;
 class RWLock;
@@ -118,6 +120,24 @@ public:
         VariantType type;
     };
 
+    // Result of resolving a property name against a class and all of its
+    // ancestors: the nearest setter/getter pair, and the nearest integer
+    // constant when it shadows that pair for reads.
+    struct FlatProperty {
+        const PropertySetGet *setget = nullptr;
+        int constant = 0;
+        bool has_constant = false;
+        bool constant_first = false;
+    };
+
+    // Dispatch tables covering inherited entries. A published table is never
+    // modified: registering into the class or one of its ancestors retires it
+    // and the next lookup builds a new one, see _get_flattened().
+    struct FlatTables {
+        HashMap<StringName, MethodBind *> methods;
+        HashMap<StringName, FlatProperty> properties;
+    };
+
     struct ClassInfo {
         APIType api = API_NONE;
         ClassInfo *inherits_ptr=nullptr;
@@ -136,6 +156,10 @@ public:
         String usage_header;
 #endif
         HashMap<StringName, PropertySetGet> property_setget;
+        std::atomic<const FlatTables *> flat {nullptr};
+        // Replaced tables, kept until the class goes away since lookups
+        // don't lock and may still be probing them.
+        Vector<const FlatTables *> retired_flat;
 
         StringName inherits;
         StringName name;
@@ -157,6 +181,13 @@ public:
     static HashMap<StringName, ClassInfo> classes;
     static HashMap<StringName, StringName> resource_base_extensions;
     static HashMap<StringName, StringName> compat_classes;
+    // Classes that currently have published flat tables, guarded by flatten_mutex.
+    static Vector<ClassInfo *> flattened_classes;
+    static std::mutex flatten_mutex;
+
+    static FlatTables *_flatten_class(const ClassInfo *p_class);
+    static const FlatTables *_get_flattened(const StringName &p_class);
+    static void _invalidate_flattened(const ClassInfo *p_class);
 
 #ifdef DEBUG_METHODS_ENABLED
     static MethodBind *bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const MethodDefinition &method_name, std::initializer_list<Variant> def_vals);
@@ -243,6 +274,9 @@ public:
     static bool is_parent_class(const StringName &p_class, const StringName &p_inherits);
     static bool can_instance(const StringName &p_class);
     static Object *instance(const StringName &p_class);
+    // Creation function instance() would use for p_class, or nullptr when it could not instance it
+    // directly (unknown, disabled or editor-only class). Compatibility remaps are not followed.
+    static Object *(*get_creation_func(const StringName &p_class))();
     static APIType get_api_type(const StringName &p_class);
 
     static uint64_t get_api_hash(APIType p_api);
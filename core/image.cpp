@@ -550,6 +550,11 @@ int Image::get_width() const {
     return width;
 }
 
+uint64_t Image::get_memory_usage() const {
+
+    return sizeof(Image) + data.size();
+}
+
 int Image::get_height() const {
 
     return height;
@@ -2673,21 +2678,24 @@ Vector<uint8_t> Image::lossy_packer(const Ref<Image> &p_image, float qualt)
         return {};
     return tmp;
 }
-Ref<Image> Image::lossy_unpacker(const Vector<uint8_t> &p_buffer)
+Ref<Image> Image::lossy_unpacker(const uint8_t *p_data, int p_len)
 {
-    int size = p_buffer.size() - 4;
-    ERR_FAIL_COND_V(size <= 0, Ref<Image>());
-    const uint8_t *r = p_buffer.data();
+    ERR_FAIL_COND_V(p_len <= 4, Ref<Image>());
+    const uint8_t *r = p_data;
 
     ERR_FAIL_COND_V(r[0] != 'W' || r[1] != 'E' || r[2] != 'B' || r[3] != 'P', Ref<Image>());
 
     Ref<Image> res(make_ref_counted<Image>());
 
-    if(OK!=res->_load_from_buffer(&r[4], size - 4,"webp"))
+    if(OK!=res->_load_from_buffer(&r[4], p_len - 4,"webp"))
         return {};
     return res;
 
 }
+Ref<Image> Image::lossy_unpacker(const Vector<uint8_t> &p_buffer)
+{
+    return lossy_unpacker(p_buffer.data(), p_buffer.size());
+}
 Vector<uint8_t> Image::lossless_packer(const Ref<Image> &p_image)
 {
     Ref<Image> img = prepareForPngStorage(p_image);
@@ -2697,18 +2705,21 @@ Vector<uint8_t> Image::lossless_packer(const Ref<Image> &p_image)
         return {};
     return tmp;
 }
-Ref<Image> Image::lossless_unpacker(const Vector<uint8_t> &p_data)
+Ref<Image> Image::lossless_unpacker(const uint8_t *p_data, int p_len)
 {
-    const int len = p_data.size();
-    ERR_FAIL_COND_V(len < 4, {});
-    const uint8_t *r = p_data.data();
+    ERR_FAIL_COND_V(p_len < 4, {});
+    const uint8_t *r = p_data;
     ERR_FAIL_COND_V(r[0] != 'P' || r[1] != 'N' || r[2] != 'G' || r[3] != ' ', {});
     Ref<Image> res(make_ref_counted<Image>());
 
-    if(OK!=res->_load_from_buffer(&r[4], len - 4,"png"))
+    if(OK!=res->_load_from_buffer(&r[4], p_len - 4,"png"))
         return {};
     return res;
 }
+Ref<Image> Image::lossless_unpacker(const Vector<uint8_t> &p_data)
+{
+    return lossless_unpacker(p_data.data(), p_data.size());
+}
 
 void Image::_set_data(const Dictionary &p_data) {
 
@@ -93,8 +93,10 @@ public:
 
     static Vector<uint8_t> lossy_packer(const Ref<Image> &p_image, float p_quality);
     static Ref<Image> lossy_unpacker(const Vector<uint8_t> &p_buffer);
+    static Ref<Image> lossy_unpacker(const uint8_t *p_data, int p_len);
     static Vector<uint8_t> lossless_packer(const Ref<Image> &p_image);
     static Ref<Image> lossless_unpacker(const Vector<uint8_t> &p_buffer);
+    static Ref<Image> lossless_unpacker(const uint8_t *p_data, int p_len);
     static Vector<uint8_t> basis_universal_packer(const Ref<Image> &p_image, ImageUsedChannels p_channels);
     static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer);
 
@@ -143,6 +145,7 @@ public:
     Vector2 get_size() const;
     bool has_mipmaps() const { return mipmaps; }
     int get_mipmap_count() const;
+    uint64_t get_memory_usage() const override;
 
     /**
      * Convert the image to another format, conversion only to raw byte format
@@ -152,7 +152,8 @@ int FileAccessMemory::get_buffer(uint8_t *p_dst, int p_length) const {
 
     ERR_FAIL_COND_V(!data, -1);
 
-    int left = length - pos;
+    // pos can be past the end after get_8() or a short read
+    int left = MAX(length - pos, 0);
     int read = MIN(p_length, left);
 
     if (read < p_length) {
@@ -165,6 +166,16 @@ int FileAccessMemory::get_buffer(uint8_t *p_dst, int p_length) const {
     return read;
 }
 
+const uint8_t *FileAccessMemory::borrow_buffer(uint64_t p_length) const {
+
+    if (!data || pos < 0 || pos > length || p_length > uint64_t(length - pos))
+        return nullptr;
+
+    const uint8_t *ret = &data[pos];
+    pos += p_length;
+    return ret;
+}
+
 Error FileAccessMemory::get_error() const {
 
     return pos >= length ? ERR_FILE_EOF : OK;
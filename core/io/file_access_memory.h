@@ -59,6 +59,7 @@ public:
     uint8_t get_8() const override; ///< get a byte
 
     int get_buffer(uint8_t *p_dst, int p_length) const override; ///< get an array of bytes
+    const uint8_t *borrow_buffer(uint64_t p_length) const override;
 
     Error get_error() const override; ///< get last error
 
@@ -830,8 +830,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
         case VariantType::OBJECT: {
 #ifdef DEBUG_ENABLED
             // Test for potential wrong values sent by the debugger when it breaks.
-            Object *obj = p_variant;
-            if (!obj || !ObjectDB::instance_validate(obj)) {
+            if (!p_variant.is_valid_object()) {
                 // Object is invalid, send a NULL instead.
                 if (buf) {
                     encode_uint32((uint32_t)VariantType::NIL, buf);
@@ -1151,10 +1150,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
             } else {
                 if (buf) {
 
-                    Object *obj = p_variant;
                     ObjectID id = 0;
-                    if (obj && ObjectDB::instance_validate(obj)) {
-                        id = obj->get_instance_id();
+                    if (p_variant.is_valid_object()) {
+                        id = p_variant.as<Object *>()->get_instance_id();
                     }
 
                     encode_uint64(id, buf);
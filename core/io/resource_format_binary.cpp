@@ -32,6 +32,7 @@
 
 #include "core/class_db.h"
 #include "core/image.h"
+#include "core/io/compression.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
@@ -46,6 +47,7 @@
 #include "core/object_tooling.h"
 
 #include "EASTL/sort.h"
+#include <cstring>
 //#define print_bl(m_what) print_line(m_what)
 #define print_bl(m_what) (void)(m_what)
 
@@ -93,6 +95,7 @@ enum {
     VARIANT_VECTOR2_ARRAY = 37,
     VARIANT_INT64 = 40,
     VARIANT_DOUBLE = 41,
+    VARIANT_BULK_ARRAY = 42,
 //#ifndef DISABLE_DEPRECATED
 //    VARIANT_IMAGE = 21, // - no longer variant type
 //    IMAGE_ENCODING_EMPTY = 0,
@@ -106,10 +109,21 @@ enum {
     OBJECT_EXTERNAL_RESOURCE_INDEX = 3,
     //version 2: added 64 bits support for float and int
     //version 3: changed nodepath encoding
-    FORMAT_VERSION = 3,
+    //version 4: large packed arrays stored in bulk sections
+    FORMAT_VERSION = 4,
     FORMAT_VERSION_CAN_RENAME_DEPS = 1,
     FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
-
+    FORMAT_VERSION_BULK_SECTIONS = 4,
+
+    // Packed arrays of at least this many bytes are written as a VARIANT_BULK_ARRAY reference (array type, length,
+    // section index) and their data goes to a section after the resources, so it loads with a single read.
+    // Sections are little endian, start BULK_SECTION_ALIGNMENT aligned and are listed in a table whose offset is kept
+    // in the first reserved header field. Section offsets are relative to the table, so only that field needs to
+    // change when the file is rewritten.
+    BULK_ARRAY_MIN_SIZE = 4096,
+    BULK_SECTION_ALIGNMENT = 16,
+    BULK_SECTION_RAW = 0,
+    BULK_SECTION_ZSTD = 1,
 };
 
 void ResourceInteractiveLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -121,6 +135,69 @@ void ResourceInteractiveLoaderBinary::_advance_padding(uint32_t p_len) {
     }
 }
 
+Error ResourceInteractiveLoaderBinary::_read_bulk_section(uint32_t p_section, uint8_t *p_dst, uint64_t p_size) {
+
+    // the section has been checked against p_size by _parse_bulk_array
+    const BulkSection &bs = bulk_sections[p_section];
+
+    uint64_t prev_pos = f->get_position();
+    f->seek(bs.offset);
+
+    Error err = OK;
+    if (bs.compression == BULK_SECTION_RAW) {
+        if (uint64_t(f->get_buffer(p_dst, p_size)) != p_size)
+            err = ERR_FILE_CORRUPT;
+    } else if (bs.compression == BULK_SECTION_ZSTD) {
+        Vector<uint8_t> buf;
+        const uint8_t *src = f->borrow_buffer(bs.size);
+        if (!src) {
+            buf.resize(bs.size);
+            if (uint64_t(f->get_buffer(buf.data(), bs.size)) != bs.size)
+                err = ERR_FILE_CORRUPT;
+            src = buf.data();
+        }
+        if (err == OK && uint64_t(Compression::decompress(p_dst, p_size, src, bs.size, Compression::MODE_ZSTD)) != p_size)
+            err = ERR_FILE_CORRUPT;
+    } else {
+        err = ERR_FILE_CORRUPT;
+    }
+
+    f->seek(prev_pos);
+    ERR_FAIL_COND_V_MSG(err != OK, err, "Corrupt bulk array section in: " + local_path + ".");
+    return OK;
+}
+
+template <class T>
+Error ResourceInteractiveLoaderBinary::_parse_bulk_array(uint32_t p_section, uint32_t p_len, Variant &r_v) {
+
+    // p_len comes from the file, so validate it against the section before allocating for it
+    ERR_FAIL_UNSIGNED_INDEX_V(p_section, bulk_sections.size(), ERR_FILE_CORRUPT);
+    const BulkSection &bs = bulk_sections[p_section];
+    ERR_FAIL_COND_V_MSG(bs.raw_size != uint64_t(p_len) * sizeof(T), ERR_FILE_CORRUPT, "Bulk array size mismatch in: " + local_path + ".");
+    ERR_FAIL_COND_V_MSG(bs.offset > f->get_len() || bs.size > f->get_len() - bs.offset || (bs.compression == BULK_SECTION_RAW && bs.size != bs.raw_size),
+            ERR_FILE_CORRUPT, "Bulk array section out of bounds in: " + local_path + ".");
+
+    PoolVector<T> array;
+    array.resize(p_len);
+    {
+        typename PoolVector<T>::Write w = array.write();
+        Error err = _read_bulk_section(p_section, (uint8_t *)w.ptr(), uint64_t(p_len) * sizeof(T));
+        if (err != OK)
+            return err;
+#ifdef BIG_ENDIAN_ENABLED
+        if (sizeof(T) > 1) {
+            uint32_t *ptr = (uint32_t *)w.ptr();
+            for (uint64_t i = 0; i < uint64_t(p_len) * sizeof(T) / 4; i++) {
+
+                ptr[i] = BSWAP32(ptr[i]);
+            }
+        }
+#endif
+    }
+    r_v = Variant(array);
+    return OK;
+}
+
 StringName ResourceInteractiveLoaderBinary::_get_string() {
 
     uint32_t id = f->get_32();
@@ -131,6 +208,8 @@ StringName ResourceInteractiveLoaderBinary::_get_string() {
         }
         if (len == 0)
             return StringName();
+        if (const char *mapped = (const char *)f->borrow_buffer(len))
+            return StringName(se_string_view(mapped, strnlen(mapped, len)));
         f->get_buffer((uint8_t *)&str_buf[0], len);
         return StringName(&str_buf[0]);
     }
@@ -567,6 +646,30 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
             w.release();
             r_v = array;
         } break;
+        case VARIANT_BULK_ARRAY: {
+
+            uint32_t array_type = f->get_32();
+            uint32_t len = f->get_32();
+            uint32_t section = f->get_32();
+
+            switch (array_type) {
+                case VARIANT_RAW_ARRAY:
+                    return _parse_bulk_array<uint8_t>(section, len, r_v);
+                case VARIANT_INT_ARRAY:
+                    return _parse_bulk_array<int>(section, len, r_v);
+                case VARIANT_REAL_ARRAY:
+                    return _parse_bulk_array<real_t>(section, len, r_v);
+                case VARIANT_VECTOR2_ARRAY:
+                    return _parse_bulk_array<Vector2>(section, len, r_v);
+                case VARIANT_VECTOR3_ARRAY:
+                    return _parse_bulk_array<Vector3>(section, len, r_v);
+                case VARIANT_COLOR_ARRAY:
+                    return _parse_bulk_array<Color>(section, len, r_v);
+                default: {
+                    ERR_FAIL_V(ERR_FILE_CORRUPT);
+                }
+            }
+        } break;
         default: {
             ERR_FAIL_V(ERR_FILE_CORRUPT);
         }
@@ -756,6 +859,8 @@ String ResourceInteractiveLoaderBinary::get_unicode_string() {
     }
     if (len == 0)
         return String();
+    if (const char *mapped = (const char *)f->borrow_buffer(len))
+        return String(mapped, strnlen(mapped, len));
     f->get_buffer((uint8_t *)&str_buf[0], len);
     return (&str_buf[0]);
 }
@@ -837,9 +942,38 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
     print_bl("type: " + type);
 
     importmd_ofs = f->get_64();
-    for (int i = 0; i < 14; i++)
+    uint64_t bulk_table_ofs = f->get_64();
+    for (int i = 0; i < 12; i++)
         f->get_32(); //skip a few reserved fields
 
+    if (ver_format >= FORMAT_VERSION_BULK_SECTIONS && bulk_table_ofs) {
+
+        // both come from the file, so check the table fits in it before allocating for it
+        const uint64_t file_len = f->get_len();
+        const uint64_t section_entry_size = 3 * 8 + 4;
+        if (bulk_table_ofs > file_len || file_len - bulk_table_ofs < 4) {
+            error = ERR_FILE_CORRUPT;
+            f->close();
+            ERR_FAIL_MSG("Bulk section table out of bounds in: " + local_path + ".");
+        }
+        uint64_t header_end = f->get_position();
+        f->seek(bulk_table_ofs);
+        uint32_t section_count = f->get_32();
+        if (uint64_t(section_count) * section_entry_size > file_len - bulk_table_ofs - 4) {
+            error = ERR_FILE_CORRUPT;
+            f->close();
+            ERR_FAIL_MSG("Bulk section table out of bounds in: " + local_path + ".");
+        }
+        bulk_sections.resize(section_count);
+        for (BulkSection &bs : bulk_sections) {
+            bs.offset = bulk_table_ofs - f->get_64(); // stored relative, sections precede the table
+            bs.size = f->get_64();
+            bs.raw_size = f->get_64();
+            bs.compression = f->get_32();
+        }
+        f->seek(header_end);
+    }
+
     uint32_t string_table_size = f->get_32();
     string_map.reserve(string_table_size);
     for (uint32_t i = 0; i < string_table_size; i++) {
@@ -1121,8 +1255,10 @@ Error ResourceFormatLoaderBinary::rename_dependencies(se_string_view _path, cons
     size_t md_ofs = f->get_position();
     size_t importmd_ofs = f->get_64();
     fw->store_64(0); //metadata offset
+    uint64_t bulk_table_ofs = f->get_64();
+    fw->store_64(0); //bulk section table offset
 
-    for (int i = 0; i < 14; i++) {
+    for (int i = 0; i < 12; i++) {
         fw->store_32(0);
         f->get_32();
     }
@@ -1168,6 +1304,13 @@ Error ResourceFormatLoaderBinary::rename_dependencies(se_string_view _path, cons
 
     int64_t size_diff = (int64_t)fw->get_position() - (int64_t)f->get_position();
 
+    // the internal resource table keeps its size, pad after it so bulk sections move by a multiple of their alignment
+    int64_t align_pad = 0;
+    if (bulk_table_ofs) {
+        align_pad = (BULK_SECTION_ALIGNMENT - (size_diff % BULK_SECTION_ALIGNMENT + BULK_SECTION_ALIGNMENT) % BULK_SECTION_ALIGNMENT) % BULK_SECTION_ALIGNMENT;
+        size_diff += align_pad;
+    }
+
     //internal resources
     uint32_t int_resources_size = f->get_32();
     fw->store_32(int_resources_size);
@@ -1179,6 +1322,9 @@ Error ResourceFormatLoaderBinary::rename_dependencies(se_string_view _path, cons
         save_ustring(fw, path);
         fw->store_64(offset + size_diff);
     }
+    for (int64_t i = 0; i < align_pad; i++) {
+        fw->store_8(0);
+    }
 
     //rest of file
     uint8_t b = f->get_8();
@@ -1191,6 +1337,7 @@ Error ResourceFormatLoaderBinary::rename_dependencies(se_string_view _path, cons
 
     fw->seek(md_ofs);
     fw->store_64(importmd_ofs + size_diff);
+    fw->store_64(bulk_table_ofs ? bulk_table_ofs + size_diff : 0);
 
     memdelete(f);
     memdelete(fw);
@@ -1236,10 +1383,116 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(FileAccess *f, int p_bytes)
 
 void ResourceFormatSaverBinaryInstance::_write_variant(const Variant &p_property) {
 
-    write_variant(f, p_property, resource_set, external_resources, string_map);
+    write_variant(f, p_property, resource_set, external_resources, string_map, &bulk_arrays);
+}
+
+static bool _store_bulk_array(FileAccess *f, const Variant &p_array, uint32_t p_type, int p_len, size_t p_elem_size, Vector<Variant> *r_bulk_arrays) {
+
+    if (!r_bulk_arrays || p_len * p_elem_size < BULK_ARRAY_MIN_SIZE)
+        return false;
+
+    f->store_32(VARIANT_BULK_ARRAY);
+    f->store_32(p_type);
+    f->store_32(p_len);
+    f->store_32(r_bulk_arrays->size());
+    r_bulk_arrays->push_back(p_array);
+    return true;
+}
+
+template <class T>
+static void _store_bulk_section(FileAccess *f, const Variant &p_array, bool p_compress, uint64_t &r_size, uint64_t &r_raw_size, uint32_t &r_compression) {
+
+    PoolVector<T> arr = p_array;
+    typename PoolVector<T>::Read r = arr.read();
+    const uint8_t *src = (const uint8_t *)r.ptr();
+    r_raw_size = uint64_t(arr.size()) * sizeof(T);
+    r_size = r_raw_size;
+    r_compression = BULK_SECTION_RAW;
+
+#ifdef BIG_ENDIAN_ENABLED
+    Vector<uint8_t> swapped;
+    if (sizeof(T) > 1) {
+        swapped.resize(r_raw_size);
+        const uint32_t *from = (const uint32_t *)src;
+        uint32_t *to = (uint32_t *)swapped.data();
+        for (uint64_t i = 0; i < r_raw_size / 4; i++) {
+            to[i] = BSWAP32(from[i]);
+        }
+        src = swapped.data();
+    }
+#endif
+
+    if (p_compress) {
+        Vector<uint8_t> compressed;
+        compressed.resize(Compression::get_max_compressed_buffer_size(r_raw_size, Compression::MODE_ZSTD));
+        int len = Compression::compress(compressed.data(), src, r_raw_size, Compression::MODE_ZSTD);
+        // keep incompressible data raw, it can then be read without the decompression step
+        if (len > 0 && uint64_t(len) < r_raw_size - r_raw_size / 8) {
+            f->store_buffer(compressed.data(), len);
+            r_size = len;
+            r_compression = BULK_SECTION_ZSTD;
+            return;
+        }
+    }
+
+    f->store_buffer(src, r_raw_size);
+}
+
+uint64_t ResourceFormatSaverBinaryInstance::_save_bulk_sections() {
+
+    struct Section {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t raw_size;
+        uint32_t compression;
+    };
+    Vector<Section> sections;
+    sections.reserve(bulk_arrays.size());
+
+    for (const Variant &v : bulk_arrays) {
+
+        while (f->get_position() % BULK_SECTION_ALIGNMENT)
+            f->store_8(0);
+
+        Section &s = sections.emplace_back();
+        s.offset = f->get_position();
+        switch (v.get_type()) {
+            case VariantType::POOL_BYTE_ARRAY:
+                _store_bulk_section<uint8_t>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            case VariantType::POOL_INT_ARRAY:
+                _store_bulk_section<int>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            case VariantType::POOL_REAL_ARRAY:
+                _store_bulk_section<real_t>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            case VariantType::POOL_VECTOR2_ARRAY:
+                _store_bulk_section<Vector2>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            case VariantType::POOL_VECTOR3_ARRAY:
+                _store_bulk_section<Vector3>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            case VariantType::POOL_COLOR_ARRAY:
+                _store_bulk_section<Color>(f, v, compress_bulk, s.size, s.raw_size, s.compression);
+                break;
+            default: {
+                ERR_FAIL_V(0);
+            }
+        }
+    }
+
+    uint64_t table_ofs = f->get_position();
+    f->store_32(sections.size());
+    for (const Section &s : sections) {
+        f->store_64(table_ofs - s.offset);
+        f->store_64(s.size);
+        f->store_64(s.raw_size);
+        f->store_32(s.compression);
+    }
+    return table_ofs;
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Variant &p_property, Set<RES> &resource_set, HashMap<RES, int> &external_resources, HashMap<StringName, int> &string_map) {
+void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Variant &p_property, Set<RES> &resource_set, HashMap<RES, int> &external_resources, HashMap<StringName, int> &string_map, Vector<Variant> *r_bulk_arrays) {
 
     switch (p_property.get_type()) {
 
@@ -1474,8 +1727,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
                     continue;
                 */
 
-                write_variant(f, E, resource_set, external_resources, string_map);
-                write_variant(f, d[E], resource_set, external_resources, string_map);
+                write_variant(f, E, resource_set, external_resources, string_map, r_bulk_arrays);
+                write_variant(f, d[E], resource_set, external_resources, string_map, r_bulk_arrays);
             }
 
         } break;
@@ -1486,15 +1739,17 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
             f->store_32(uint32_t(a.size()));
             for (int i = 0; i < a.size(); i++) {
 
-                write_variant(f, a[i], resource_set, external_resources, string_map);
+                write_variant(f, a[i], resource_set, external_resources, string_map, r_bulk_arrays);
             }
 
         } break;
         case VariantType::POOL_BYTE_ARRAY: {
 
-            f->store_32(VARIANT_RAW_ARRAY);
             PoolVector<uint8_t> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_RAW_ARRAY, len, sizeof(uint8_t), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_RAW_ARRAY);
             f->store_32(len);
             PoolVector<uint8_t>::Read r = arr.read();
             f->store_buffer(r.ptr(), len);
@@ -1503,9 +1758,11 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
         } break;
         case VariantType::POOL_INT_ARRAY: {
 
-            f->store_32(VARIANT_INT_ARRAY);
             PoolVector<int> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_INT_ARRAY, len, sizeof(int), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_INT_ARRAY);
             f->store_32(len);
             PoolVector<int>::Read r = arr.read();
             for (int i = 0; i < len; i++)
@@ -1514,9 +1771,11 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
         } break;
         case VariantType::POOL_REAL_ARRAY: {
 
-            f->store_32(VARIANT_REAL_ARRAY);
             PoolVector<real_t> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_REAL_ARRAY, len, sizeof(real_t), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_REAL_ARRAY);
             f->store_32(len);
             PoolVector<real_t>::Read r = arr.read();
             for (int i = 0; i < len; i++) {
@@ -1538,9 +1797,11 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
         } break;
         case VariantType::POOL_VECTOR3_ARRAY: {
 
-            f->store_32(VARIANT_VECTOR3_ARRAY);
             PoolVector<Vector3> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_VECTOR3_ARRAY, len, sizeof(Vector3), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_VECTOR3_ARRAY);
             f->store_32(len);
             PoolVector<Vector3>::Read r = arr.read();
             for (int i = 0; i < len; i++) {
@@ -1552,9 +1813,11 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
         } break;
         case VariantType::POOL_VECTOR2_ARRAY: {
 
-            f->store_32(VARIANT_VECTOR2_ARRAY);
             PoolVector<Vector2> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_VECTOR2_ARRAY, len, sizeof(Vector2), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_VECTOR2_ARRAY);
             f->store_32(len);
             PoolVector<Vector2>::Read r = arr.read();
             for (int i = 0; i < len; i++) {
@@ -1565,9 +1828,11 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
         } break;
         case VariantType::POOL_COLOR_ARRAY: {
 
-            f->store_32(VARIANT_COLOR_ARRAY);
             PoolVector<Color> arr = p_property;
             int len = arr.size();
+            if (_store_bulk_array(f, p_property, VARIANT_COLOR_ARRAY, len, sizeof(Color), r_bulk_arrays))
+                break;
+            f->store_32(VARIANT_COLOR_ARRAY);
             f->store_32(len);
             PoolVector<Color>::Read r = arr.read();
             for (int i = 0; i < len; i++) {
@@ -1721,6 +1986,8 @@ Error ResourceFormatSaverBinaryInstance::save(se_string_view p_path, const RES &
     bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
     big_endian = p_flags & ResourceSaver::FLAG_SAVE_BIG_ENDIAN;
     takeover_paths = p_flags & ResourceSaver::FLAG_REPLACE_SUBRESOURCE_PATHS;
+    // the whole file is compressed already, sections would only compress twice
+    compress_bulk = (p_flags & ResourceSaver::FLAG_COMPRESS_BULK_ARRAYS) && !(p_flags & ResourceSaver::FLAG_COMPRESS);
 
     if (!StringUtils::begins_with(p_path,"res://"))
         takeover_paths = false;
@@ -1755,7 +2022,9 @@ Error ResourceFormatSaverBinaryInstance::save(se_string_view p_path, const RES &
 
     save_unicode_string(f, p_resource->get_class());
     f->store_64(0); //offset to import metadata
-    for (int i = 0; i < 14; i++)
+    uint64_t bulk_table_pos = f->get_position();
+    f->store_64(0); //offset to bulk section table
+    for (int i = 0; i < 12; i++)
         f->store_32(0); // reserved
 
     Vector<ResourceData> resources;
@@ -1887,10 +2156,14 @@ Error ResourceFormatSaverBinaryInstance::save(se_string_view p_path, const RES &
         }
     }
 
+    uint64_t bulk_table_ofs = bulk_arrays.empty() ? 0 : _save_bulk_sections();
+
     for (int i = 0; i < ofs_table.size(); i++) {
         f->seek(ofs_pos[i]);
         f->store_64(ofs_table[i]);
     }
+    f->seek(bulk_table_pos);
+    f->store_64(bulk_table_ofs);
 
     f->seek_end();
 
@@ -48,12 +48,20 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
         String path;
         uint64_t offset;
     };
+    // Packed array data stored out of line, after the resources.
+    struct BulkSection {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t raw_size;
+        uint32_t compression;
+    };
 
     HashMap<String, String> remaps;
     Vector<char> str_buf;
     Vector<StringName> string_map;
     Vector<IntResource> internal_resources;
     Vector<ExtResource> external_resources;
+    Vector<BulkSection> bulk_sections;
     List<RES> resource_cache;
     String local_path;
     String res_path;
@@ -69,6 +77,9 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
     StringName _get_string();
     String get_unicode_string();
     void _advance_padding(uint32_t p_len);
+    Error _read_bulk_section(uint32_t p_section, uint8_t *p_dst, uint64_t p_size);
+    template <class T>
+    Error _parse_bulk_array(uint32_t p_section, uint32_t p_len, Variant &r_v);
 
     Error parse_variant(Variant &r_v);
 
@@ -110,6 +121,7 @@ class ResourceFormatSaverBinaryInstance {
     bool skip_editor;
     bool big_endian;
     bool takeover_paths;
+    bool compress_bulk;
     FileAccess *f;
     String magic;
     Set<RES> resource_set;
@@ -131,16 +143,19 @@ class ResourceFormatSaverBinaryInstance {
 
     HashMap<RES, int> external_resources;
     List<RES> saved_resources;
+    Vector<Variant> bulk_arrays;
 
     static void _pad_buffer(FileAccess *f, int p_bytes);
     void _write_variant(const Variant &p_property);
+    uint64_t _save_bulk_sections();
     void _find_resources(const Variant &p_variant, bool p_main = false);
     static void save_unicode_string(FileAccess *f, se_string_view p_string, bool p_bit_on_len = false);
     int get_string_index(const StringName &p_string);
 
 public:
     Error save(se_string_view p_path, const RES &p_resource, uint32_t p_flags = 0);
-    static void write_variant(FileAccess *f, const Variant &p_property, Set<RES> &resource_set, HashMap<RES, int> &external_resources, HashMap<StringName, int> &string_map);
+    // Large packed arrays are only moved to bulk sections when r_bulk_arrays is given, the caller then has to save them.
+    static void write_variant(FileAccess *f, const Variant &p_property, Set<RES> &resource_set, HashMap<RES, int> &external_resources, HashMap<StringName, int> &string_map, Vector<Variant> *r_bulk_arrays = nullptr);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
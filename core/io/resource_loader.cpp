@@ -32,9 +32,11 @@
 
 #include "core/pool_vector.h"
 #include "core/hash_map.h"
+#include "core/hash_set.h"
 #include "core/os/mutex.h"
 #include "core/io/resource_importer.h"
 #include "core/os/file_access.h"
+#include "core/os/job_system.h"
 #include "core/os/os.h"
 #include "core/os/rw_lock.h"
 #include "core/object_tooling.h"
@@ -318,60 +320,56 @@ RES ResourceLoader::_load(se_string_view p_path, se_string_view p_original_path,
     ERR_FAIL_V_MSG(RES(), "No loader found for resource: " + String(p_path) + ".");
 }
 
+ResourceLoader::LoadingMapShard &ResourceLoader::_loading_map_shard(se_string_view p_path) {
+
+    return loading_map_shards[StringUtils::hash(p_path) & (LOADING_MAP_SHARD_COUNT - 1)];
+}
+
 bool ResourceLoader::_add_to_loading_map(se_string_view p_path) {
 
     bool success;
-    if (loading_map_mutex) {
-        loading_map_mutex->lock();
+    LoadingMapShard &shard = _loading_map_shard(p_path);
+    if (shard.mutex) {
+        shard.mutex->lock();
     }
 
     LoadingMapKey key;
     key.path = p_path;
     key.thread = Thread::get_caller_id();
 
-    if (loading_map.contains(key)) {
+    if (shard.map.contains(key)) {
         success = false;
     } else {
-        loading_map[key] = true;
+        shard.map[key] = true;
         success = true;
     }
 
-    if (loading_map_mutex) {
-        loading_map_mutex->unlock();
+    if (shard.mutex) {
+        shard.mutex->unlock();
     }
 
     return success;
 }
 
 void ResourceLoader::_remove_from_loading_map(se_string_view p_path) {
-    if (loading_map_mutex) {
-        loading_map_mutex->lock();
-    }
-
-    LoadingMapKey key;
-    key.path = p_path;
-    key.thread = Thread::get_caller_id();
-
-    loading_map.erase(key);
 
-    if (loading_map_mutex) {
-        loading_map_mutex->unlock();
-    }
+    _remove_from_loading_map_and_thread(p_path, Thread::get_caller_id());
 }
 
 void ResourceLoader::_remove_from_loading_map_and_thread(se_string_view p_path, Thread::ID p_thread) {
-    if (loading_map_mutex) {
-        loading_map_mutex->lock();
+    LoadingMapShard &shard = _loading_map_shard(p_path);
+    if (shard.mutex) {
+        shard.mutex->lock();
     }
 
     LoadingMapKey key;
     key.path = p_path;
     key.thread = p_thread;
 
-    loading_map.erase(key);
+    shard.map.erase(key);
 
-    if (loading_map_mutex) {
-        loading_map_mutex->unlock();
+    if (shard.mutex) {
+        shard.mutex->unlock();
     }
 }
 
@@ -388,36 +386,17 @@ RES ResourceLoader::load(se_string_view p_path, se_string_view p_type_hint, bool
 
     if (!p_no_cache) {
 
-        {
-            bool success = _add_to_loading_map(local_path);
-            ERR_FAIL_COND_V_MSG(!success, RES(), "Resource: '" + local_path + "' is already being loaded. Cyclic reference?");
-        }
-
-        //lock first if possible
-        if (ResourceCache::lock) {
-            ResourceCache::lock->read_lock();
+        // cache hits only lock the shard of the path, and don't touch the loading map
+        RES res = ResourceCache::get_ref(local_path);
+        if (res) {
+            if (r_error)
+                *r_error = OK;
+            ResourceCache::mark_used(res.get());
+            return res;
         }
 
-        //get ptr
-        Resource *rptr = ResourceCache::get_unguarded(local_path);
-
-        if (rptr) {
-            RES res(rptr);
-            //it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
-            if (res) {
-                //referencing is fine
-                if (r_error)
-                    *r_error = OK;
-                if (ResourceCache::lock) {
-                    ResourceCache::lock->read_unlock();
-                }
-                _remove_from_loading_map(local_path);
-                return res;
-            }
-        }
-        if (ResourceCache::lock) {
-            ResourceCache::lock->read_unlock();
-        }
+        bool success = _add_to_loading_map(local_path);
+        ERR_FAIL_COND_V_MSG(!success, RES(), "Resource: '" + local_path + "' is already being loaded. Cyclic reference?");
     }
 
     bool xl_remapped = false;
@@ -458,6 +437,7 @@ RES ResourceLoader::load(se_string_view p_path, se_string_view p_type_hint, bool
 
     if (!p_no_cache) {
         _remove_from_loading_map(local_path);
+        ResourceCache::mark_used(res.get());
     }
 
     if (_loaded_callback) {
@@ -497,6 +477,289 @@ bool ResourceLoader::exists(se_string_view p_path, se_string_view p_type_hint) {
     return false;
 }
 
+struct ResourceLoader::ThreadLoadTask {
+    String local_path;
+    String type_hint;
+    bool use_sub_threads = false;
+    // Kept at one until the task finished, so callers can JobSystem::wait_background() on it.
+    JobSystem::Counter counter;
+    ThreadLoadStatus status = THREAD_LOAD_IN_PROGRESS;
+    RES resource;
+    Error error = OK;
+    // Tasks for the external dependencies, each holding a dependents reference on it.
+    Vector<ThreadLoadTask *> dependencies;
+    // Tasks to resume when this one finishes, and how many dependencies this one still waits for.
+    Vector<ThreadLoadTask *> waiters;
+    int awaiting = 0;
+    // The task is freed once it finished and nothing references it anymore.
+    int user_requests = 0;
+    int dependents = 0;
+};
+
+static String _thread_load_local_path(se_string_view p_path) {
+
+    if (PathUtils::is_rel_path(p_path))
+        return String("res://") + p_path;
+    return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_thread_load_acquire(const String &p_local_path, se_string_view p_type_hint, bool p_use_sub_threads, bool p_dependent, bool &r_start) {
+
+    // thread_load_mutex is held by the caller. The reference is taken here, before the load can
+    // finish and free the task; r_start tells the caller to _thread_load_start() it once unlocked.
+
+    r_start = false;
+
+    ThreadLoadTask *task;
+    auto E = thread_load_tasks.find(p_local_path);
+    if (E != thread_load_tasks.end()) {
+        task = E->second;
+        if (p_dependent)
+            task->dependents++;
+        else
+            task->user_requests++;
+        return task;
+    }
+
+    task = memnew(ThreadLoadTask);
+    task->local_path = p_local_path;
+    task->type_hint = p_type_hint;
+    task->use_sub_threads = p_use_sub_threads;
+    task->counter.pending.store(1, std::memory_order_relaxed);
+    if (p_dependent)
+        task->dependents++;
+    else
+        task->user_requests++;
+    thread_load_tasks[p_local_path] = task;
+
+    // null if it has just been freed in a thread, then it does not count as cached
+    task->resource = ResourceCache::get_ref(p_local_path);
+
+    if (task->resource) {
+        task->status = THREAD_LOAD_LOADED;
+        task->counter.pending.store(0, std::memory_order_release);
+        return task;
+    }
+
+    r_start = true;
+    return task;
+}
+
+void ResourceLoader::_thread_load_start(ThreadLoadTask *p_task) {
+
+    // thread_load_mutex must not be held, the load may run right here
+    JobSystem *js = JobSystem::get_singleton();
+    if (js) {
+        js->submit_background([p_task]() { _thread_load_scan(p_task); });
+    } else {
+        // no workers, load right away on the requesting thread
+        _thread_load_load(p_task);
+    }
+}
+
+void ResourceLoader::_thread_load_release(ThreadLoadTask *p_task) {
+
+    if (p_task->status == THREAD_LOAD_IN_PROGRESS || p_task->user_requests > 0 || p_task->dependents > 0)
+        return;
+
+    thread_load_tasks.erase(p_task->local_path);
+    memdelete(p_task);
+}
+
+bool ResourceLoader::_thread_load_reaches(const ThreadLoadTask *p_from, const ThreadLoadTask *p_to) {
+
+    // dependency graphs share a lot of nodes, so visit each task once
+    HashSet<const ThreadLoadTask *> visited;
+    Vector<const ThreadLoadTask *> stack;
+    stack.push_back(p_from);
+
+    while (!stack.empty()) {
+        const ThreadLoadTask *task = stack.back();
+        stack.pop_back();
+        if (task == p_to)
+            return true;
+        if (!visited.insert(task).second)
+            continue;
+        for (const ThreadLoadTask *dep : task->dependencies) {
+            stack.push_back(dep);
+        }
+    }
+    return false;
+}
+
+void ResourceLoader::_thread_load_scan(ThreadLoadTask *p_task) {
+
+    Vector<String> deps;
+    if (p_task->use_sub_threads) {
+        get_dependencies(p_task->local_path, deps, true);
+    }
+
+    bool ready;
+    Vector<ThreadLoadTask *> started;
+    {
+        MutexLock guard(*thread_load_mutex);
+
+        for (const String &dep : deps) {
+
+            se_string_view dep_path = dep;
+            se_string_view dep_type;
+            if (StringUtils::contains(dep, "::")) {
+                dep_path = StringUtils::get_slice(dep, "::", 0);
+                dep_type = StringUtils::get_slice(dep, "::", 1);
+            }
+
+            bool start;
+            ThreadLoadTask *sub = _thread_load_acquire(_thread_load_local_path(dep_path), dep_type, true, true, start);
+            if (start)
+                started.push_back(sub);
+            if (_thread_load_reaches(sub, p_task)) {
+                // circular dependency, waiting would never end; the regular loader reports it
+                sub->dependents--;
+                _thread_load_release(sub);
+                continue;
+            }
+
+            p_task->dependencies.push_back(sub);
+            if (sub->status == THREAD_LOAD_IN_PROGRESS) {
+                sub->waiters.push_back(p_task);
+                p_task->awaiting++;
+            }
+        }
+        ready = p_task->awaiting == 0;
+    }
+
+    // otherwise the last dependency to finish schedules the load, which may be one started here
+    for (ThreadLoadTask *sub : started) {
+        _thread_load_start(sub);
+    }
+    if (ready) {
+        _thread_load_load(p_task);
+    }
+}
+
+void ResourceLoader::_thread_load_load(ThreadLoadTask *p_task) {
+
+    // dependencies, if any, are all in ResourceCache by now and get picked up from there
+    Error err = OK;
+    RES res(load(p_task->local_path, p_task->type_hint, false, &err));
+
+    Vector<ThreadLoadTask *> resumed;
+    {
+        MutexLock guard(*thread_load_mutex);
+
+        p_task->resource = res;
+        p_task->error = res ? OK : (err != OK ? err : ERR_CANT_OPEN);
+        p_task->status = res ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+
+        for (ThreadLoadTask *waiter : p_task->waiters) {
+            if (--waiter->awaiting == 0)
+                resumed.push_back(waiter);
+        }
+        p_task->waiters.clear();
+
+        // the resource references what it needs now
+        Vector<ThreadLoadTask *> deps(eastl::move(p_task->dependencies));
+        p_task->dependencies.clear();
+        for (ThreadLoadTask *dep : deps) {
+            dep->dependents--;
+            _thread_load_release(dep);
+        }
+
+        p_task->counter.pending.store(0, std::memory_order_release);
+        _thread_load_release(p_task);
+    }
+
+    JobSystem *js = JobSystem::get_singleton();
+    for (ThreadLoadTask *waiter : resumed) {
+        if (js)
+            js->submit_background([waiter]() { _thread_load_load(waiter); });
+        else
+            _thread_load_load(waiter);
+    }
+}
+
+Error ResourceLoader::load_threaded_request(se_string_view p_path, se_string_view p_type_hint, bool p_use_sub_threads) {
+
+    ERR_FAIL_COND_V(p_path.empty(), ERR_INVALID_PARAMETER);
+
+    String local_path = _thread_load_local_path(p_path);
+
+    ThreadLoadTask *task;
+    bool start;
+    {
+        MutexLock guard(*thread_load_mutex);
+        task = _thread_load_acquire(local_path, p_type_hint, p_use_sub_threads, false, start);
+    }
+    // our request keeps the task alive, even when it is loaded right here
+    if (start)
+        _thread_load_start(task);
+    return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(se_string_view p_path, float *r_progress) {
+
+    String local_path = _thread_load_local_path(p_path);
+
+    MutexLock guard(*thread_load_mutex);
+
+    auto E = thread_load_tasks.find(local_path);
+    if (E == thread_load_tasks.end() || E->second->user_requests == 0) {
+        if (r_progress)
+            *r_progress = 0;
+        return THREAD_LOAD_INVALID_RESOURCE;
+    }
+
+    const ThreadLoadTask *task = E->second;
+    if (r_progress) {
+        if (task->status != THREAD_LOAD_IN_PROGRESS) {
+            *r_progress = 1;
+        } else {
+            int finished = 0;
+            for (const ThreadLoadTask *dep : task->dependencies) {
+                if (dep->status != THREAD_LOAD_IN_PROGRESS)
+                    finished++;
+            }
+            *r_progress = float(finished) / float(task->dependencies.size() + 1);
+        }
+    }
+    return task->status;
+}
+
+RES ResourceLoader::load_threaded_get(se_string_view p_path, Error *r_error) {
+
+    if (r_error)
+        *r_error = ERR_INVALID_PARAMETER;
+
+    String local_path = _thread_load_local_path(p_path);
+
+    ThreadLoadTask *task;
+    {
+        MutexLock guard(*thread_load_mutex);
+        auto E = thread_load_tasks.find(local_path);
+        ERR_FAIL_COND_V_MSG(E == thread_load_tasks.end() || E->second->user_requests == 0, RES(), "Resource '" + local_path + "' was not requested with load_threaded_request.");
+        task = E->second;
+    }
+
+    // our request keeps the task alive meanwhile
+    JobSystem *js = JobSystem::get_singleton();
+    if (js)
+        js->wait_background(&task->counter);
+    ERR_FAIL_COND_V(!task->counter.is_done(), RES());
+
+    RES res;
+    {
+        MutexLock guard(*thread_load_mutex);
+        res = task->resource;
+        if (r_error)
+            *r_error = task->error;
+        task->user_requests--;
+        _thread_load_release(task);
+    }
+    if (res)
+        ResourceCache::mark_used(res.get());
+    return res;
+}
+
 Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(se_string_view p_path, se_string_view p_type_hint, bool p_no_cache, Error *r_error) {
 
     if (r_error)
@@ -513,10 +776,10 @@ Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(se_string_view p
         bool success = _add_to_loading_map(local_path);
         ERR_FAIL_COND_V_MSG(!success, Ref<ResourceInteractiveLoader>(), "Resource: '" + local_path + "' is already being loaded. Cyclic reference?");
 
-        if (ResourceCache::has(local_path)) {
+        Ref<Resource> res_cached = ResourceCache::get_ref(local_path);
+        if (res_cached) {
 
             print_verbose("Loading resource: " + local_path + " (cached)");
-            Ref<Resource> res_cached(ResourceCache::get(local_path));
             Ref<ResourceInteractiveLoaderDefault> ril(make_ref_counted<ResourceInteractiveLoaderDefault>());
 
             ril->resource = res_cached;
@@ -1071,24 +1334,66 @@ void ResourceLoader::remove_custom_loaders() {
     }
 }
 
-Mutex *ResourceLoader::loading_map_mutex = nullptr;
-HashMap<LoadingMapKey, int,Hasher<LoadingMapKey> > ResourceLoader::loading_map;
+ResourceLoader::LoadingMapShard ResourceLoader::loading_map_shards[ResourceLoader::LOADING_MAP_SHARD_COUNT];
+Mutex *ResourceLoader::thread_load_mutex = nullptr;
+HashMap<String, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tasks;
 
 void ResourceLoader::initialize() {
 
+    thread_load_mutex = memnew(Mutex);
 #ifndef NO_THREADS
-    loading_map_mutex = memnew(Mutex);
+    for (LoadingMapShard &shard : loading_map_shards) {
+        shard.mutex = memnew(Mutex);
+    }
 #endif
 }
 
 void ResourceLoader::finalize() {
+
+    // Background loads still running touch their task and thread_load_mutex, so they are waited for before
+    // freeing anything. Without a JobSystem nothing can run them anymore, it drops its queued jobs and joins
+    // its workers when it goes away.
+    JobSystem *js = JobSystem::get_singleton();
+    if (js) {
+        Vector<ThreadLoadTask *> running;
+        {
+            MutexLock guard(*thread_load_mutex);
+            for (const eastl::pair<const String, ThreadLoadTask *> &E : thread_load_tasks) {
+                if (E.second->status != THREAD_LOAD_IN_PROGRESS)
+                    continue;
+                ERR_PRINT("Exited while resource is being loaded in the background: " + E.first);
+                // keeps dependencies alive when their dependent finishes first
+                E.second->dependents++;
+                running.push_back(E.second);
+            }
+        }
+        for (ThreadLoadTask *task : running) {
+            js->wait_background(&task->counter);
+        }
+        MutexLock guard(*thread_load_mutex);
+        for (ThreadLoadTask *task : running) {
+            task->dependents--;
+            _thread_load_release(task);
+        }
+    }
+
+    for (const eastl::pair<const String, ThreadLoadTask *> &E : thread_load_tasks) {
+        if (E.second->status == THREAD_LOAD_IN_PROGRESS)
+            ERR_PRINT("Exited while resource is being loaded in the background: " + E.first);
+        memdelete(E.second);
+    }
+    thread_load_tasks.clear();
+    memdelete(thread_load_mutex);
+    thread_load_mutex = nullptr;
 #ifndef NO_THREADS
-    for(const auto &e : loading_map) {
-        ERR_PRINT("Exited while resource is being loaded: " + e.first.path);
+    for (LoadingMapShard &shard : loading_map_shards) {
+        for (const auto &e : shard.map) {
+            ERR_PRINT("Exited while resource is being loaded: " + e.first.path);
+        }
+        shard.map.clear();
+        memdelete(shard.mutex);
+        shard.mutex = nullptr;
     }
-    loading_map.clear();
-    memdelete(loading_map_mutex);
-    loading_map_mutex = nullptr;
     for(auto &ldr : loader)
         ldr.reset();
 #endif
@@ -67,7 +67,15 @@ using ResourceLoaderImport = Error (*)(se_string_view);
 using ResourceLoadedCallback = void (*)(RES, se_string_view );
 
 class GODOT_EXPORT ResourceLoader {
+public:
+    enum ThreadLoadStatus {
+        THREAD_LOAD_INVALID_RESOURCE,
+        THREAD_LOAD_IN_PROGRESS,
+        THREAD_LOAD_FAILED,
+        THREAD_LOAD_LOADED,
+    };
 
+private:
     enum {
         MAX_LOADERS = 64
     };
@@ -97,19 +105,48 @@ class GODOT_EXPORT ResourceLoader {
     static ResourceLoadedCallback _loaded_callback;
 
     static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(se_string_view path);
-    static Mutex *loading_map_mutex;
-
-    static HashMap<LoadingMapKey, int, Hasher<LoadingMapKey>> loading_map;
+    // Split by path so concurrent loads of different resources don't serialize on one mutex.
+    static constexpr uint32_t LOADING_MAP_SHARD_COUNT = 32; // power of 2
+    struct alignas(64) LoadingMapShard {
+        Mutex *mutex = nullptr;
+        HashMap<LoadingMapKey, int, Hasher<LoadingMapKey>> map;
+    };
+    static LoadingMapShard loading_map_shards[LOADING_MAP_SHARD_COUNT];
 
+    static LoadingMapShard &_loading_map_shard(se_string_view p_path);
     static bool _add_to_loading_map(se_string_view p_path);
     static void _remove_from_loading_map(se_string_view p_path);
     static void _remove_from_loading_map_and_thread(se_string_view p_path, Thread::ID p_thread);
 
+    // background loads started by load_threaded_request, one per local path
+    struct ThreadLoadTask;
+    static Mutex *thread_load_mutex;
+    static HashMap<String, ThreadLoadTask *> thread_load_tasks;
+
+    static ThreadLoadTask *_thread_load_acquire(const String &p_local_path, se_string_view p_type_hint, bool p_use_sub_threads, bool p_dependent, bool &r_start);
+    static void _thread_load_start(ThreadLoadTask *p_task);
+    static void _thread_load_release(ThreadLoadTask *p_task);
+    static bool _thread_load_reaches(const ThreadLoadTask *p_from, const ThreadLoadTask *p_to);
+    static void _thread_load_scan(ThreadLoadTask *p_task);
+    static void _thread_load_load(ThreadLoadTask *p_task);
+
 public:
     static Ref<ResourceInteractiveLoader> load_interactive(se_string_view p_path, se_string_view p_type_hint = se_string_view(), bool p_no_cache = false, Error *r_error = nullptr);
     static RES load(se_string_view p_path, se_string_view p_type_hint = se_string_view(), bool p_no_cache = false, Error *r_error = nullptr);
     static bool exists(se_string_view p_path, se_string_view p_type_hint = se_string_view());
 
+    /**
+     * Starts loading p_path as a JobSystem background job and returns immediately; concurrent requests for the same
+     * path share one load. With p_use_sub_threads the external dependencies of the resource are requested as separate
+     * loads first, so they load in parallel, and the resource itself loads once they are all in ResourceCache.
+     * Every request must be matched by a load_threaded_get call, which hands out the result.
+     */
+    static Error load_threaded_request(se_string_view p_path, se_string_view p_type_hint = se_string_view(), bool p_use_sub_threads = false);
+    //! r_progress receives a [0, 1] estimate based on how many dependencies finished loading.
+    static ThreadLoadStatus load_threaded_get_status(se_string_view p_path, float *r_progress = nullptr);
+    //! Blocks (helping with queued jobs) until the requested load finished.
+    static RES load_threaded_get(se_string_view p_path, Error *r_error = nullptr);
+
     static void get_recognized_extensions_for_type(se_string_view p_type, Vector<String> &p_extensions);
     static void add_resource_format_loader(const Ref<ResourceFormatLoader>& p_format_loader, bool p_at_front = false);
     static void add_resource_format_loader(ResourceLoaderInterface *, bool p_at_front = false);
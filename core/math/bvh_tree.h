@@ -0,0 +1,691 @@
+/*************************************************************************/
+/*  bvh_tree.h                                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/error_macros.h"
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/vector.h"
+
+/**
+ * Dynamic AABB tree with the same interface as Octree<T, use_pairs>, meant for scenes where many elements move every
+ * frame.
+ *
+ * Nodes live in a flat array and are linked by index. Leaves store a fattened AABB, so an element that moves within
+ * its margin does not touch the tree at all, and one that leaves it is removed and reinserted using the surface area
+ * heuristic, with AVL-style rotations keeping the tree balanced.
+ *
+ * With use_pairs, pairable and non-pairable elements are kept in two separate trees: non-pairable elements (which only
+ * pair with pairable ones) never have to walk the tree that holds the other non-pairable elements. Pairs are stored in
+ * per-element arrays that reference each other by slot, so adding and removing a pair is O(1).
+ *
+ * Culling does not modify the tree, so concurrent cull_* calls are safe as long as nothing is being inserted or moved.
+ */
+template <class T, bool use_pairs = false>
+class BVHTree {
+public:
+    using ElementID = uint32_t; // 0 is never returned, same convention as OctreeElementID
+    using PairCallback = void *(*)(void *, ElementID, T *, int, ElementID, T *, int);
+    using UnpairCallback = void (*)(void *, ElementID, T *, int, ElementID, T *, int, void *);
+    static constexpr bool CONCURRENT_CULL = true;
+
+private:
+    enum : int32_t {
+        NULL_NODE = -1
+    };
+
+    struct Node {
+
+        AABB aabb;
+        int32_t parent; // next free node while unused
+        int32_t children[2];
+        int32_t height; // 0 for leaves
+        uint32_t element; // leaves only
+
+        _FORCE_INLINE_ bool is_leaf() const { return children[0] == NULL_NODE; }
+    };
+
+    struct Tree {
+
+        Vector<Node> nodes;
+        int32_t root = NULL_NODE;
+        int32_t free_list = NULL_NODE;
+        int node_count = 0;
+    };
+
+    struct Pair {
+
+        ElementID other;
+        uint32_t other_slot; // index of the mirrored entry in the other element's pair array
+        void *ud;
+    };
+
+    struct Element {
+
+        T *userdata = nullptr;
+        AABB aabb;
+        int subindex = 0;
+        bool pairable = false;
+        bool active = false;
+        uint32_t pairable_type = 0;
+        uint32_t pairable_mask = 0;
+        int32_t leaf = NULL_NODE; // NULL_NODE while the AABB has no surface
+        uint32_t next_free = 0;
+        uint64_t last_pass = 0;
+        Vector<Pair> pairs;
+    };
+
+    Tree trees[2]; // [1] holds pairable elements when use_pairs is set
+    Vector<Element> elements;
+    uint32_t free_element = 0; // 1-based, 0 when empty
+    int element_count = 0;
+    int pair_count = 0;
+    uint64_t pass = 1;
+    real_t margin;
+
+    PairCallback pair_callback = nullptr;
+    UnpairCallback unpair_callback = nullptr;
+    void *pair_callback_userdata = nullptr;
+    void *unpair_callback_userdata = nullptr;
+
+    _FORCE_INLINE_ static real_t _cost(const AABB &p_aabb) {
+        // half the surface area, all SAH comparisons are relative
+        const Vector3 &s = p_aabb.size;
+        return s.x * s.y + s.y * s.z + s.z * s.x;
+    }
+
+    _FORCE_INLINE_ Tree &_tree_of(const Element &p_element) {
+        return trees[use_pairs && p_element.pairable ? 1 : 0];
+    }
+
+    int32_t _alloc_node(Tree &p_tree) {
+
+        int32_t index;
+        if (p_tree.free_list != NULL_NODE) {
+            index = p_tree.free_list;
+            p_tree.free_list = p_tree.nodes[index].parent;
+        } else {
+            index = p_tree.nodes.size();
+            p_tree.nodes.push_back(Node());
+        }
+        Node &node = p_tree.nodes[index];
+        node.parent = NULL_NODE;
+        node.children[0] = NULL_NODE;
+        node.children[1] = NULL_NODE;
+        node.height = 0;
+        node.element = 0;
+        p_tree.node_count++;
+        return index;
+    }
+
+    void _free_node(Tree &p_tree, int32_t p_index) {
+
+        p_tree.nodes[p_index].parent = p_tree.free_list;
+        p_tree.nodes[p_index].height = -1;
+        p_tree.free_list = p_index;
+        p_tree.node_count--;
+    }
+
+    int32_t _balance(Tree &p_tree, int32_t p_index);
+    void _refit_upwards(Tree &p_tree, int32_t p_index);
+    void _insert_leaf(Tree &p_tree, int32_t p_leaf);
+    void _remove_leaf(Tree &p_tree, int32_t p_leaf);
+
+    void _add_to_tree(uint32_t p_element);
+    void _remove_from_tree(uint32_t p_element);
+
+    void _remove_pair_entry(uint32_t p_element, uint32_t p_slot);
+    void _unpair(uint32_t p_element, uint32_t p_slot);
+    void _unpair_all(uint32_t p_element);
+    void _update_pairs(uint32_t p_element);
+
+    _FORCE_INLINE_ static bool _can_pair(const Element &p_A, const Element &p_B) {
+
+        if (p_A.userdata == p_B.userdata && p_A.userdata)
+            return false;
+        if (!p_A.pairable && !p_B.pairable)
+            return false;
+        return (p_A.pairable_type & p_B.pairable_mask) || (p_B.pairable_type & p_A.pairable_mask);
+    }
+
+    //! Walks p_tree, descending into nodes accepted by p_node_test and calling p_visit with the element index of every
+    //! accepted leaf. p_visit returns false to stop the query.
+    template <class NodeTest, class Visit>
+    void _query(const Tree &p_tree, NodeTest p_node_test, Visit p_visit) const {
+
+        if (p_tree.root == NULL_NODE)
+            return;
+
+        FixedVector<int32_t, 64, true> stack;
+        stack.push_back(p_tree.root);
+        while (!stack.empty()) {
+
+            const Node &node = p_tree.nodes[stack.back()];
+            stack.pop_back();
+            if (!p_node_test(node.aabb))
+                continue;
+            if (node.is_leaf()) {
+                if (!p_visit(node.element))
+                    return;
+            } else {
+                stack.push_back(node.children[0]);
+                stack.push_back(node.children[1]);
+            }
+        }
+    }
+
+    template <class Test>
+    int _cull(Test p_test, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const {
+
+        int result_count = 0;
+        for (const Tree &tree : trees) {
+
+            if (result_count == p_result_max)
+                break;
+            _query(tree, p_test, [&](uint32_t p_index) -> bool {
+                const Element &e = elements[p_index];
+                if (use_pairs && !(e.pairable_type & p_mask))
+                    return true;
+                if (!p_test(e.aabb))
+                    return true;
+                if (result_count == p_result_max)
+                    return false;
+                p_result_array[result_count] = e.userdata;
+                if (p_subindex_array)
+                    p_subindex_array[result_count] = e.subindex;
+                result_count++;
+                return true;
+            });
+        }
+        return result_count;
+    }
+
+public:
+    ElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+    void move(ElementID p_id, const AABB &p_aabb);
+    void set_pairable(ElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+    void erase(ElementID p_id);
+
+    int cull_convex(Span<const Plane> p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const {
+        const Plane *planes = p_convex.data();
+        int plane_count = p_convex.size();
+        return _cull([planes, plane_count](const AABB &p_aabb) { return p_aabb.intersects_convex_shape(planes, plane_count); },
+                p_result_array, p_result_max, nullptr, p_mask);
+    }
+    int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) const {
+        return _cull([&p_aabb](const AABB &p_node) { return p_aabb.intersects_inclusive(p_node); },
+                p_result_array, p_result_max, p_subindex_array, p_mask);
+    }
+    int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) const {
+        return _cull([&p_from, &p_to](const AABB &p_node) { return p_node.intersects_segment(p_from, p_to); },
+                p_result_array, p_result_max, p_subindex_array, p_mask);
+    }
+
+    void set_pair_callback(PairCallback p_callback, void *p_userdata) {
+        pair_callback = p_callback;
+        pair_callback_userdata = p_userdata;
+    }
+    void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+        unpair_callback = p_callback;
+        unpair_callback_userdata = p_userdata;
+    }
+
+    int get_element_count() const { return element_count; }
+    int get_node_count() const { return trees[0].node_count + trees[1].node_count; }
+    int get_pair_count() const { return pair_count; }
+    int get_height() const {
+        int h = 0;
+        for (const Tree &tree : trees) {
+            if (tree.root != NULL_NODE)
+                h = MAX(h, tree.nodes[tree.root].height);
+        }
+        return h;
+    }
+
+    //! p_margin is how far an element can move away from where it was inserted before the tree has to be updated.
+    explicit BVHTree(real_t p_margin = 0.25) : margin(p_margin) {}
+};
+
+/* TREE MAINTENANCE */
+
+template <class T, bool use_pairs>
+int32_t BVHTree<T, use_pairs>::_balance(Tree &p_tree, int32_t p_index) {
+
+    Vector<Node> &nodes = p_tree.nodes;
+    Node &a = nodes[p_index];
+    if (a.is_leaf() || a.height < 2)
+        return p_index;
+
+    int32_t ib = a.children[0];
+    int32_t ic = a.children[1];
+    Node &b = nodes[ib];
+    Node &c = nodes[ic];
+    int32_t balance = c.height - b.height;
+
+    if (balance > 1) {
+        // rotate c up
+        int32_t iF = c.children[0];
+        int32_t iG = c.children[1];
+        Node &f = nodes[iF];
+        Node &g = nodes[iG];
+
+        c.children[0] = p_index;
+        c.parent = a.parent;
+        a.parent = ic;
+        if (c.parent != NULL_NODE) {
+            Node &p = nodes[c.parent];
+            p.children[p.children[0] == p_index ? 0 : 1] = ic;
+        } else {
+            p_tree.root = ic;
+        }
+
+        if (f.height > g.height) {
+            c.children[1] = iF;
+            a.children[1] = iG;
+            g.parent = p_index;
+            a.aabb = b.aabb.merge(g.aabb);
+            c.aabb = a.aabb.merge(f.aabb);
+            a.height = 1 + MAX(b.height, g.height);
+            c.height = 1 + MAX(a.height, f.height);
+        } else {
+            c.children[1] = iG;
+            a.children[1] = iF;
+            f.parent = p_index;
+            a.aabb = b.aabb.merge(f.aabb);
+            c.aabb = a.aabb.merge(g.aabb);
+            a.height = 1 + MAX(b.height, f.height);
+            c.height = 1 + MAX(a.height, g.height);
+        }
+        return ic;
+    }
+
+    if (balance < -1) {
+        // rotate b up
+        int32_t iD = b.children[0];
+        int32_t iE = b.children[1];
+        Node &d = nodes[iD];
+        Node &e = nodes[iE];
+
+        b.children[0] = p_index;
+        b.parent = a.parent;
+        a.parent = ib;
+        if (b.parent != NULL_NODE) {
+            Node &p = nodes[b.parent];
+            p.children[p.children[0] == p_index ? 0 : 1] = ib;
+        } else {
+            p_tree.root = ib;
+        }
+
+        if (d.height > e.height) {
+            b.children[1] = iD;
+            a.children[0] = iE;
+            e.parent = p_index;
+            a.aabb = c.aabb.merge(e.aabb);
+            b.aabb = a.aabb.merge(d.aabb);
+            a.height = 1 + MAX(c.height, e.height);
+            b.height = 1 + MAX(a.height, d.height);
+        } else {
+            b.children[1] = iE;
+            a.children[0] = iD;
+            d.parent = p_index;
+            a.aabb = c.aabb.merge(d.aabb);
+            b.aabb = a.aabb.merge(e.aabb);
+            a.height = 1 + MAX(c.height, d.height);
+            b.height = 1 + MAX(a.height, e.height);
+        }
+        return ib;
+    }
+
+    return p_index;
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_refit_upwards(Tree &p_tree, int32_t p_index) {
+
+    while (p_index != NULL_NODE) {
+
+        p_index = _balance(p_tree, p_index);
+        Node &node = p_tree.nodes[p_index];
+        const Node &c0 = p_tree.nodes[node.children[0]];
+        const Node &c1 = p_tree.nodes[node.children[1]];
+        node.height = 1 + MAX(c0.height, c1.height);
+        node.aabb = c0.aabb.merge(c1.aabb);
+        p_index = node.parent;
+    }
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_insert_leaf(Tree &p_tree, int32_t p_leaf) {
+
+    if (p_tree.root == NULL_NODE) {
+        p_tree.root = p_leaf;
+        p_tree.nodes[p_leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // find the cheapest sibling, descending while pushing the leaf further down is cheaper than pairing it here.
+    const AABB leaf_aabb = p_tree.nodes[p_leaf].aabb;
+    int32_t index = p_tree.root;
+    while (!p_tree.nodes[index].is_leaf()) {
+
+        const Node &node = p_tree.nodes[index];
+        real_t area = _cost(node.aabb);
+        real_t combined_area = _cost(node.aabb.merge(leaf_aabb));
+        real_t cost = 2 * combined_area;
+        real_t inheritance_cost = 2 * (combined_area - area);
+
+        real_t child_cost[2];
+        for (int i = 0; i < 2; i++) {
+            const Node &child = p_tree.nodes[node.children[i]];
+            real_t merged = _cost(child.aabb.merge(leaf_aabb));
+            child_cost[i] = (child.is_leaf() ? merged : merged - _cost(child.aabb)) + inheritance_cost;
+        }
+
+        if (cost < child_cost[0] && cost < child_cost[1])
+            break;
+        index = child_cost[0] < child_cost[1] ? node.children[0] : node.children[1];
+    }
+
+    int32_t sibling = index;
+    int32_t new_parent = _alloc_node(p_tree); // may reallocate nodes, only indices are held across this
+    Node &parent = p_tree.nodes[new_parent];
+    Node &sibling_node = p_tree.nodes[sibling];
+    int32_t old_parent = sibling_node.parent;
+
+    parent.parent = old_parent;
+    parent.aabb = leaf_aabb.merge(sibling_node.aabb);
+    parent.height = sibling_node.height + 1;
+    parent.children[0] = sibling;
+    parent.children[1] = p_leaf;
+    sibling_node.parent = new_parent;
+    p_tree.nodes[p_leaf].parent = new_parent;
+
+    if (old_parent != NULL_NODE) {
+        Node &op = p_tree.nodes[old_parent];
+        op.children[op.children[0] == sibling ? 0 : 1] = new_parent;
+    } else {
+        p_tree.root = new_parent;
+    }
+
+    _refit_upwards(p_tree, old_parent);
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_remove_leaf(Tree &p_tree, int32_t p_leaf) {
+
+    if (p_leaf == p_tree.root) {
+        p_tree.root = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = p_tree.nodes[p_leaf].parent;
+    const Node &parent_node = p_tree.nodes[parent];
+    int32_t grand_parent = parent_node.parent;
+    int32_t sibling = parent_node.children[0] == p_leaf ? parent_node.children[1] : parent_node.children[0];
+
+    p_tree.nodes[sibling].parent = grand_parent;
+    if (grand_parent != NULL_NODE) {
+        Node &gp = p_tree.nodes[grand_parent];
+        gp.children[gp.children[0] == parent ? 0 : 1] = sibling;
+    } else {
+        p_tree.root = sibling;
+    }
+    _free_node(p_tree, parent);
+    _refit_upwards(p_tree, grand_parent);
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_add_to_tree(uint32_t p_element) {
+
+    Element &e = elements[p_element];
+    Tree &tree = _tree_of(e);
+    int32_t leaf = _alloc_node(tree);
+    Node &node = tree.nodes[leaf];
+    node.aabb = e.aabb.grow(margin);
+    node.element = p_element;
+    e.leaf = leaf;
+    _insert_leaf(tree, leaf);
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_remove_from_tree(uint32_t p_element) {
+
+    Element &e = elements[p_element];
+    Tree &tree = _tree_of(e);
+    _remove_leaf(tree, e.leaf);
+    _free_node(tree, e.leaf);
+    e.leaf = NULL_NODE;
+}
+
+/* PAIRING */
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_remove_pair_entry(uint32_t p_element, uint32_t p_slot) {
+
+    Vector<Pair> &pairs = elements[p_element].pairs;
+    uint32_t last = pairs.size() - 1;
+    if (p_slot != last) {
+        pairs[p_slot] = pairs[last];
+        const Pair &moved = pairs[p_slot];
+        elements[moved.other - 1].pairs[moved.other_slot].other_slot = p_slot;
+    }
+    pairs.pop_back();
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_unpair(uint32_t p_element, uint32_t p_slot) {
+
+    const Pair pair = elements[p_element].pairs[p_slot];
+    Element &a = elements[p_element];
+    Element &b = elements[pair.other - 1];
+
+    if (unpair_callback) {
+        unpair_callback(unpair_callback_userdata, p_element + 1, a.userdata, a.subindex, pair.other, b.userdata, b.subindex, pair.ud);
+    }
+    pair_count--;
+
+    _remove_pair_entry(pair.other - 1, pair.other_slot);
+    _remove_pair_entry(p_element, p_slot);
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_unpair_all(uint32_t p_element) {
+
+    while (!elements[p_element].pairs.empty()) {
+        _unpair(p_element, elements[p_element].pairs.size() - 1);
+    }
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::_update_pairs(uint32_t p_element) {
+
+    Element &e = elements[p_element];
+    if (e.leaf == NULL_NODE) {
+        _unpair_all(p_element);
+        return;
+    }
+    if (e.pairs.empty() && !e.pairable && trees[1].root == NULL_NODE)
+        return; // nothing this element could pair with
+
+    // drop pairs that stopped overlapping, tag the rest so the query below skips them.
+    pass++;
+    for (int i = int(e.pairs.size()) - 1; i >= 0; --i) {
+        Element &other = elements[e.pairs[i].other - 1];
+        if (other.leaf != NULL_NODE && e.aabb.intersects_inclusive(other.aabb)) {
+            other.last_pass = pass;
+        } else {
+            _unpair(p_element, i);
+        }
+    }
+
+    const AABB aabb = e.aabb;
+    auto visit = [this, p_element, &e](uint32_t p_index) -> bool {
+        Element &other = elements[p_index];
+        if (p_index == p_element || other.last_pass == pass || !_can_pair(e, other) || !e.aabb.intersects_inclusive(other.aabb))
+            return true;
+
+        void *ud = nullptr;
+        if (pair_callback) {
+            ud = pair_callback(pair_callback_userdata, p_element + 1, e.userdata, e.subindex, p_index + 1, other.userdata, other.subindex);
+        }
+        uint32_t slot = e.pairs.size();
+        uint32_t other_slot = other.pairs.size();
+        e.pairs.push_back({ p_index + 1, other_slot, ud });
+        other.pairs.push_back({ p_element + 1, slot, ud });
+        pair_count++;
+        return true;
+    };
+    auto test = [&aabb](const AABB &p_node) { return aabb.intersects_inclusive(p_node); };
+
+    // non-pairable elements only ever pair with pairable ones.
+    _query(trees[1], test, visit);
+    if (e.pairable)
+        _query(trees[0], test, visit);
+}
+
+/* PUBLIC API */
+
+template <class T, bool use_pairs>
+typename BVHTree<T, use_pairs>::ElementID BVHTree<T, use_pairs>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+    uint32_t index;
+    if (free_element) {
+        index = free_element - 1;
+        free_element = elements[index].next_free;
+    } else {
+        index = elements.size();
+        elements.push_back(Element());
+    }
+
+    Element &e = elements[index];
+    e.userdata = p_userdata;
+    e.aabb = p_aabb;
+    e.subindex = p_subindex;
+    e.pairable = p_pairable;
+    e.pairable_type = p_pairable_type;
+    e.pairable_mask = p_pairable_mask;
+    e.active = true;
+    e.leaf = NULL_NODE;
+    e.last_pass = 0;
+    element_count++;
+
+    if (!p_aabb.has_no_surface()) {
+        _add_to_tree(index);
+        if (use_pairs)
+            _update_pairs(index);
+    }
+
+    return index + 1;
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::move(ElementID p_id, const AABB &p_aabb) {
+
+    ERR_FAIL_COND(p_id == 0 || p_id > elements.size() || !elements[p_id - 1].active);
+    uint32_t index = p_id - 1;
+    Element &e = elements[index];
+    const Vector3 old_position = e.aabb.position;
+    e.aabb = p_aabb;
+
+    if (p_aabb.has_no_surface()) {
+        if (e.leaf == NULL_NODE)
+            return;
+        _remove_from_tree(index);
+    } else if (e.leaf == NULL_NODE) {
+        _add_to_tree(index);
+    } else {
+        Tree &tree = _tree_of(e);
+        Node &leaf = tree.nodes[e.leaf];
+        if (!leaf.aabb.encloses(p_aabb)) {
+            // left its margin, reinsert with a new fat AABB stretched towards where it is heading.
+            AABB fat = p_aabb.grow(margin);
+            Vector3 displacement = (p_aabb.position - old_position) * 2;
+            for (int i = 0; i < 3; i++) {
+                if (displacement[i] < 0)
+                    fat.position[i] += displacement[i];
+                fat.size[i] += ABS(displacement[i]);
+            }
+            _remove_leaf(tree, e.leaf);
+            tree.nodes[e.leaf].aabb = fat;
+            _insert_leaf(tree, e.leaf);
+        }
+    }
+
+    if (use_pairs)
+        _update_pairs(index);
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::set_pairable(ElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+    ERR_FAIL_COND(p_id == 0 || p_id > elements.size() || !elements[p_id - 1].active);
+    uint32_t index = p_id - 1;
+    Element &e = elements[index];
+
+    if (p_pairable == e.pairable && e.pairable_type == p_pairable_type && e.pairable_mask == p_pairable_mask)
+        return; // no changes, return
+
+    bool in_tree = e.leaf != NULL_NODE;
+    if (in_tree)
+        _remove_from_tree(index);
+    if (use_pairs)
+        _unpair_all(index);
+
+    e.pairable = p_pairable;
+    e.pairable_type = p_pairable_type;
+    e.pairable_mask = p_pairable_mask;
+
+    if (in_tree) {
+        _add_to_tree(index);
+        if (use_pairs)
+            _update_pairs(index);
+    }
+}
+
+template <class T, bool use_pairs>
+void BVHTree<T, use_pairs>::erase(ElementID p_id) {
+
+    ERR_FAIL_COND(p_id == 0 || p_id > elements.size() || !elements[p_id - 1].active);
+    uint32_t index = p_id - 1;
+
+    if (use_pairs)
+        _unpair_all(index);
+    if (elements[index].leaf != NULL_NODE)
+        _remove_from_tree(index);
+
+    Element &e = elements[index];
+    e.active = false;
+    e.userdata = nullptr;
+    e.pairs.clear();
+    e.next_free = free_element;
+    free_element = p_id;
+    element_count--;
+}
@@ -47,6 +47,7 @@ class Octree {
 public:
     using PairCallback = void *(*)(void *, OctreeElementID, T *, int, OctreeElementID, T *, int);
     using UnpairCallback = void (*)(void *, OctreeElementID, T *, int, OctreeElementID, T *, int, void *);
+    static constexpr bool CONCURRENT_CULL = false; // culling stamps elements with the current pass
 
 private:
     enum {
@@ -33,10 +33,27 @@
 #include "core/project_settings.h"
 #include "core/print_string.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/object_db.h"
 #include "core/string_utils.h"
 #include "core/script_language.h"
 
+#include "concurrentqueue/concurrentqueue.h"
+
+struct MessageQueue::StagedMessage {
+
+    ObjectID instance_id;
+    StringName target;
+    int16_t type;
+    int16_t notification;
+    FixedVector<Variant, VARIANT_ARG_MAX, true> args;
+};
+
+struct MessageQueue::StagingQueue {
+    // implicit producers give every pushing thread its own FIFO sub-queue, no locks are shared between threads.
+    moodycamel::ConcurrentQueue<StagedMessage> queue;
+};
+
 MessageQueue *MessageQueue::singleton = nullptr;
 
 MessageQueue *MessageQueue::get_singleton() {
@@ -44,35 +61,129 @@ MessageQueue *MessageQueue::get_singleton() {
     return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+uint8_t *MessageQueue::_alloc(uint32_t p_size) {
+
+    if (buffer_limit && buffer_end + p_size > buffer_limit)
+        return nullptr;
+
+    if (pages[write_page].end + p_size > pages[write_page].size) {
+        // pages past write_page are always empty, so they can be reused or resized freely.
+        ++write_page;
+        if (write_page == pages.size()) {
+            Page page;
+            page.size = MAX(uint32_t(PAGE_SIZE), p_size);
+            page.data = memnew_arr(uint8_t, page.size);
+            page.end = 0;
+            pages.push_back(page);
+        } else if (pages[write_page].size < p_size) {
+            memdelete_arr(pages[write_page].data);
+            pages[write_page].size = p_size;
+            pages[write_page].data = memnew_arr(uint8_t, p_size);
+        }
+    }
 
-    _THREAD_SAFE_METHOD_
+    Page &page = pages[write_page];
+    uint8_t *ptr = page.data + page.end;
+    page.end += p_size;
+    buffer_end += p_size;
+    if (buffer_end > buffer_max_used) {
+        buffer_max_used = buffer_end;
+    }
+    if (buffer_end > frame_max_used) {
+        frame_max_used = buffer_end;
+    }
+    return ptr;
+}
+
+Error MessageQueue::_fail_out_of_memory(ObjectID p_id, se_string_view p_kind, se_string_view p_what) {
+
+    String type;
+    if (ObjectDB::get_instance(p_id))
+        type = ObjectDB::get_instance(p_id)->get_class();
+    print_line(String("Failed ") + p_kind + ": " + type + ":" + p_what + " target ID: " + ::to_string(p_id));
+    statistics();
+    ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
+}
+
+Error MessageQueue::_push_staged(ObjectID p_id, const StringName &p_target, int16_t p_type, int16_t p_notification, const Variant **p_args, int p_argcount) {
+
+    StagedMessage msg;
+    msg.instance_id = p_id;
+    msg.target = p_target;
+    msg.type = p_type;
+    msg.notification = p_notification;
+    msg.args.reserve(p_argcount);
+    for (int i = 0; i < p_argcount; i++) {
+        msg.args.push_back(*p_args[i]);
+    }
+
+    if (!staging->queue.enqueue(eastl::move(msg))) {
+        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue could not allocate a staging block.");
+    }
+    staged_count.fetch_add(1, std::memory_order_relaxed);
+    return OK;
+}
+
+bool MessageQueue::_drain_staging() {
+
+    bool drained = false;
+    StagedMessage staged;
 
-    int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+    while (staging->queue.try_dequeue(staged)) {
 
-    if ((buffer_end + room_needed) >= buffer_size) {
-        String type;
-        if (ObjectDB::get_instance(p_id))
-            type = ObjectDB::get_instance(p_id)->get_class();
-        print_line(String("Failed method: ") + type + ":" + p_method + " target ID: " + ::to_string(p_id));
-        statistics();
-        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
+        drained = true;
+        bool is_notification = (staged.type & FLAG_MASK) == TYPE_NOTIFICATION;
+        uint32_t room_needed = sizeof(Message) + (is_notification ? 0 : sizeof(Variant) * staged.args.size());
+        uint8_t *mem = _alloc(room_needed);
+        if (!mem) {
+            _fail_out_of_memory(staged.instance_id, "staged message", staged.target);
+            continue;
+        }
+
+        Message *msg = memnew_placement(mem, Message);
+        msg->instance_id = staged.instance_id;
+        msg->target = staged.target;
+        msg->type = staged.type;
+        if (is_notification) {
+            msg->notification = staged.notification;
+        } else {
+            msg->args = staged.args.size();
+            Variant *args = (Variant *)(msg + 1);
+            for (size_t i = 0; i < staged.args.size(); i++) {
+                Variant *v = memnew_placement(&args[i], Variant);
+                *v = eastl::move(staged.args[i]);
+            }
+        }
+        staged.args.clear();
     }
+    return drained;
+}
 
-    Message *msg = memnew_placement(&buffer[buffer_end], Message);
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+
+    int16_t type = TYPE_CALL;
+    if (p_show_error)
+        type |= FLAG_SHOW_ERROR;
+
+    if (Thread::get_caller_id() != Thread::get_main_id())
+        return _push_staged(p_id, p_method, type, 0, p_args, p_argcount);
+
+    _THREAD_SAFE_METHOD_
+
+    uint8_t *mem = _alloc(sizeof(Message) + sizeof(Variant) * p_argcount);
+    if (!mem)
+        return _fail_out_of_memory(p_id, "method", p_method);
+
+    Message *msg = memnew_placement(mem, Message);
     msg->args = p_argcount;
     msg->instance_id = p_id;
     msg->target = p_method;
-    msg->type = TYPE_CALL;
-    if (p_show_error)
-        msg->type |= FLAG_SHOW_ERROR;
-
-    buffer_end += sizeof(Message);
+    msg->type = type;
 
+    Variant *args = (Variant *)(msg + 1);
     for (int i = 0; i < p_argcount; i++) {
 
-        Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-        buffer_end += sizeof(Variant);
+        Variant *v = memnew_placement(&args[i], Variant);
         *v = *p_args[i];
     }
 
@@ -96,29 +207,24 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-    _THREAD_SAFE_METHOD_
+    if (Thread::get_caller_id() != Thread::get_main_id()) {
+        const Variant *value = &p_value;
+        return _push_staged(p_id, p_prop, TYPE_SET, 0, &value, 1);
+    }
 
-    uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+    _THREAD_SAFE_METHOD_
 
-    if ((buffer_end + room_needed) >= buffer_size) {
-        String type;
-        if (ObjectDB::get_instance(p_id))
-            type = ObjectDB::get_instance(p_id)->get_class();
-        print_line("Failed set: " + type + ":" + p_prop + " target ID: " + ::to_string(p_id));
-        statistics();
-        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-    }
+    uint8_t *mem = _alloc(sizeof(Message) + sizeof(Variant));
+    if (!mem)
+        return _fail_out_of_memory(p_id, "set", p_prop);
 
-    Message *msg = memnew_placement(&buffer[buffer_end], Message);
+    Message *msg = memnew_placement(mem, Message);
     msg->args = 1;
     msg->instance_id = p_id;
     msg->target = p_prop;
     msg->type = TYPE_SET;
 
-    buffer_end += sizeof(Message);
-
-    Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-    buffer_end += sizeof(Variant);
+    Variant *v = memnew_placement(msg + 1, Variant);
     *v = p_value;
 
     return OK;
@@ -126,27 +232,24 @@ Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Vari
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-    _THREAD_SAFE_METHOD_
-
     ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-    uint8_t room_needed = sizeof(Message);
+    if (Thread::get_caller_id() != Thread::get_main_id())
+        return _push_staged(p_id, StringName(), TYPE_NOTIFICATION, p_notification, nullptr, 0);
 
-    if ((buffer_end + room_needed) >= buffer_size) {
-        print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-        statistics();
-        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-    }
+    _THREAD_SAFE_METHOD_
+
+    uint8_t *mem = _alloc(sizeof(Message));
+    if (!mem)
+        return _fail_out_of_memory(p_id, "notification", itos(p_notification));
 
-    Message *msg = memnew_placement(&buffer[buffer_end], Message);
+    Message *msg = memnew_placement(mem, Message);
 
     msg->type = TYPE_NOTIFICATION;
     msg->instance_id = p_id;
     //msg->target;
     msg->notification = p_notification;
 
-    buffer_end += sizeof(Message);
-
     return OK;
 }
 
@@ -171,55 +274,59 @@ void MessageQueue::statistics() {
     HashMap<StringName, int> call_count;
     int null_count = 0;
 
-    uint32_t read_pos = 0;
-    while (read_pos < buffer_end) {
-        Message *message = (Message *)&buffer[read_pos];
+    for (uint32_t page = 0; page <= write_page; page++) {
+        uint32_t read_pos = 0;
+        while (read_pos < pages[page].end) {
+            Message *message = (Message *)&pages[page].data[read_pos];
 
-        Object *target = ObjectDB::get_instance(message->instance_id);
+            Object *target = ObjectDB::get_instance(message->instance_id);
 
-        if (target != nullptr) {
+            if (target != nullptr) {
 
-            switch (message->type & FLAG_MASK) {
+                switch (message->type & FLAG_MASK) {
 
-                case TYPE_CALL: {
+                    case TYPE_CALL: {
 
-                    if (!call_count.contains(message->target))
-                        call_count[message->target] = 0;
+                        if (!call_count.contains(message->target))
+                            call_count[message->target] = 0;
 
-                    call_count[message->target]++;
+                        call_count[message->target]++;
 
-                } break;
-                case TYPE_NOTIFICATION: {
+                    } break;
+                    case TYPE_NOTIFICATION: {
 
-                    if (!notify_count.contains(message->notification))
-                        notify_count[message->notification] = 0;
+                        if (!notify_count.contains(message->notification))
+                            notify_count[message->notification] = 0;
 
-                    notify_count[message->notification]++;
+                        notify_count[message->notification]++;
 
-                } break;
-                case TYPE_SET: {
+                    } break;
+                    case TYPE_SET: {
 
-                    if (!set_count.contains(message->target))
-                        set_count[message->target] = 0;
+                        if (!set_count.contains(message->target))
+                            set_count[message->target] = 0;
 
-                    set_count[message->target]++;
+                        set_count[message->target]++;
 
-                } break;
-            }
+                    } break;
+                }
 
-        } else {
-            //object was deleted
-            print_line("Object was deleted while awaiting a callback");
+            } else {
+                //object was deleted
+                print_line("Object was deleted while awaiting a callback");
 
-            null_count++;
-        }
+                null_count++;
+            }
 
-        read_pos += sizeof(Message);
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-            read_pos += sizeof(Variant) * message->args;
+            read_pos += sizeof(Message);
+            if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+                read_pos += sizeof(Variant) * message->args;
+        }
     }
 
     print_line("TOTAL BYTES: " + itos(buffer_end));
+    print_line("PAGES: " + itos(pages.size()));
+    print_line("STAGED (not yet merged): " + itos(staging->queue.size_approx()));
     print_line("NULL count: " + itos(null_count));
 
     for (const eastl::pair<const StringName,int> &E : set_count) {
@@ -260,23 +367,38 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 
 void MessageQueue::flush() {
 
-    if (buffer_end > buffer_max_used) {
-        buffer_max_used = buffer_end;
-    }
-
+    uint32_t read_page = 0;
     uint32_t read_pos = 0;
 
     //using reverse locking strategy
     _THREAD_SAFE_LOCK_
 
-    ERR_FAIL_COND(flushing ); //already flushing, you did something odd
+    if (flushing) {
+        _THREAD_SAFE_UNLOCK_
+        ERR_FAIL_MSG("Message queue is already flushing, you did something odd.");
+    }
     flushing = true;
 
-    while (read_pos < buffer_end) {
+    // messages from other threads go after everything the main thread queued before this flush.
+    _drain_staging();
+
+    while (true) {
+
+        if (read_pos >= pages[read_page].end) {
+            if (read_page < write_page) {
+                read_page++;
+                read_pos = 0;
+                continue;
+            }
+            // caught up with the writer, pick up whatever other threads pushed in the meantime.
+            if (_drain_staging())
+                continue;
+            break;
+        }
 
         //lock on each iteration, so a call can re-add itself to the message queue
 
-        Message *message = (Message *)&buffer[read_pos];
+        Message *message = (Message *)&pages[read_page].data[read_pos];
 
         uint32_t advance = sizeof(Message);
         if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
@@ -329,7 +451,15 @@ void MessageQueue::flush() {
         _THREAD_SAFE_LOCK_
     }
 
-    buffer_end = 0; // reset buffer
+    // reset buffer, pages stay allocated for the next frame.
+    for (uint32_t i = 0; i <= write_page; i++) {
+        pages[i].end = 0;
+    }
+    write_page = 0;
+    buffer_end = 0;
+    last_staged_count = staged_count.exchange(0, std::memory_order_relaxed);
+    last_frame_max_used = frame_max_used;
+    frame_max_used = 0;
     flushing = false;
     _THREAD_SAFE_UNLOCK_
 }
@@ -345,36 +475,55 @@ MessageQueue::MessageQueue() {
     singleton = this;
     flushing = false;
     StringName prop_name("memory/limits/message_queue/max_size_kb");
+    write_page = 0;
     buffer_end = 0;
     buffer_max_used = 0;
-    buffer_size = GLOBAL_DEF_RST(prop_name, DEFAULT_QUEUE_SIZE_KB);
+    frame_max_used = 0;
+    // the queue grows in pages on demand, the setting only caps it; 0 lets it grow without limit.
+    buffer_limit = GLOBAL_DEF_RST(prop_name, 0);
     ProjectSettings::get_singleton()->set_custom_property_info(
             prop_name, PropertyInfo(VariantType::INT, "memory/limits/message_queue/max_size_kb", PropertyHint::Range,
                                "0,2048,1,or_greater"));
-    buffer_size *= 1024;
-    buffer = memnew_arr(uint8_t, buffer_size);
+    buffer_limit *= 1024;
+
+    Page page;
+    page.size = PAGE_SIZE;
+    page.data = memnew_arr(uint8_t, page.size);
+    page.end = 0;
+    pages.push_back(page);
+
+    staging = memnew(StagingQueue);
+    staged_count = 0;
+    last_staged_count = 0;
+    last_frame_max_used = 0;
 }
 
 MessageQueue::~MessageQueue() {
 
-    uint32_t read_pos = 0;
+    for (uint32_t page = 0; page <= write_page; page++) {
+        uint32_t read_pos = 0;
 
-    while (read_pos < buffer_end) {
+        while (read_pos < pages[page].end) {
 
-        Message *message = (Message *)&buffer[read_pos];
-        Variant *args = (Variant *)(message + 1);
-        int argc = message->args;
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-            for (int i = 0; i < argc; i++)
-                args[i].~Variant();
-        }
-        message->~Message();
+            Message *message = (Message *)&pages[page].data[read_pos];
+            Variant *args = (Variant *)(message + 1);
+            int argc = message->args;
+            if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+                for (int i = 0; i < argc; i++)
+                    args[i].~Variant();
+            }
+            message->~Message();
 
-        read_pos += sizeof(Message);
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-            read_pos += sizeof(Variant) * message->args;
+            read_pos += sizeof(Message);
+            if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+                read_pos += sizeof(Variant) * message->args;
+        }
     }
 
     singleton = nullptr;
-    memdelete_arr(buffer);
+    // unmerged staged messages are destroyed with the queue.
+    memdelete(staging);
+    for (Page &page : pages) {
+        memdelete_arr(page.data);
+    }
 }
@@ -32,6 +32,9 @@
 
 #include "core/object.h"
 #include "core/os/thread_safe.h"
+#include "core/vector.h"
+
+#include <atomic>
 
 class GODOT_EXPORT MessageQueue {
 
@@ -39,7 +42,8 @@ class GODOT_EXPORT MessageQueue {
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		PAGE_SIZE_KB = 64,
+		PAGE_SIZE = PAGE_SIZE_KB * 1024
 	};
 
 	enum {
@@ -62,12 +66,33 @@ class GODOT_EXPORT MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	// Messages are written into a chain of pages, a message and its arguments never straddle two pages.
+	struct Page {
+		uint8_t *data;
+		uint32_t size;
+		uint32_t end;
+	};
+	// Per-thread lock-free staging for messages pushed outside of the main thread, drained into the pages on flush.
+	struct StagedMessage;
+	struct StagingQueue;
+
+	Vector<Page> pages;
+	uint32_t write_page;
+	uint32_t buffer_end; // bytes used in all pages
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+	uint32_t frame_max_used; // peak of buffer_end since the last flush finished
+	uint32_t buffer_limit; // 0 means the queue can grow without limit
+
+	StagingQueue *staging;
+	std::atomic<uint32_t> staged_count;
+	uint32_t last_staged_count;
+	uint32_t last_frame_max_used;
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
+	uint8_t *_alloc(uint32_t p_size);
+	bool _drain_staging();
+	Error _push_staged(ObjectID p_id, const StringName &p_target, int16_t p_type, int16_t p_notification, const Variant **p_args, int p_argcount);
+	Error _fail_out_of_memory(ObjectID p_id, se_string_view p_kind, se_string_view p_what);
 
 	static MessageQueue *singleton;
 
@@ -86,11 +111,17 @@ public:
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
 	void statistics();
+	// Runs the queued messages. Messages pushed from other threads are appended behind everything the main thread
+	// queued so far, so they run after those rather than interleaved in push order; each thread keeps its own order.
 	void flush();
 
 	bool is_flushing() const;
 
 	int get_max_buffer_usage() const;
+	//! Messages pushed from threads other than the main thread during the last flushed frame.
+	int get_staged_message_count() const { return last_staged_count; }
+	//! Largest amount of bytes queued at once during the last flushed frame, including merged staged messages.
+	int get_frame_peak_buffer_usage() const { return last_frame_max_used; }
 
 	MessageQueue();
 	~MessageQueue();
@@ -66,6 +66,8 @@ struct Object::Signal  {
     struct Slot {
         Connection conn;
         List<Connection>::iterator cE=nullptr;
+        // Resolved when connecting, lets emission skip the by-name lookup when the target has no script instance.
+        MethodBind *method_bind=nullptr;
         int reference_count=0;
     };
 
@@ -120,18 +122,13 @@ struct Object::ObjectPrivate {
 };
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-
-    Object *obj;
-
-    explicit _ObjectDebugLock(Object *p_obj) {
-        obj = p_obj;
-        obj->private_data->_lock_index.ref();
-    }
-    ~_ObjectDebugLock() {
-        obj->private_data->_lock_index.unref();
-    }
-};
+_ObjectDebugLock::_ObjectDebugLock(Object *p_obj) {
+    obj = p_obj;
+    obj->private_data->_lock_index.ref();
+}
+_ObjectDebugLock::~_ObjectDebugLock() {
+    obj->private_data->_lock_index.unref();
+}
 
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
@@ -1054,12 +1051,13 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
         return ERR_UNAVAILABLE;
     }
 
-    ListOld<_ObjectSignalDisconnectData> disconnect_data;
+    // one-shot connections are rare, this will not allocate unless more than a few of them fire at once.
+    FixedVector<_ObjectSignalDisconnectData, 4, true> disconnect_data;
 
     //copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
-    //this happens automatically and will not change the performance of calling.
-    //awesome, isn't it?
-    VMap<Signal::Target, Signal::Slot> slot_map = s->second.slot_map;
+    //taking the snapshot only bumps a reference count, the slots are copied only if a connection is modified while
+    //emitting. The snapshot must stay const, any non-const access would force that copy on every emission.
+    const VMap<Signal::Target, Signal::Slot> slot_map = s->second.slot_map;
 
     int ssize = slot_map.size();
 
@@ -1071,7 +1069,8 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
     for (int i = 0; i < ssize; i++) {
 
-        const Connection &c = slot_map.getv(i).conn;
+        const Signal::Slot &slot = slot_map.getv(i);
+        const Connection &c = slot.conn;
 
         Object *target = ObjectDB::get_instance(slot_map.getk(i)._id);
         if (!target) {
@@ -1102,7 +1101,14 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
         } else {
             Variant::CallError ce;
             _emitting = true;
-            target->call(c.method, args, argc, ce);
+            if (slot.method_bind && !target->get_script_instance()) {
+#ifdef DEBUG_ENABLED
+                _ObjectDebugLock target_lock(target);
+#endif
+                slot.method_bind->call(target, args, argc, ce);
+            } else {
+                target->call(c.method, args, argc, ce);
+            }
             _emitting = false;
 
             if (ce.error != Variant::CallError::CALL_OK) {
@@ -1132,11 +1138,8 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
         }
     }
 
-    while (!disconnect_data.empty()) {
-
-        const _ObjectSignalDisconnectData &dd = disconnect_data.front()->deref();
+    for (const _ObjectSignalDisconnectData &dd : disconnect_data) {
         disconnect(dd.signal, dd.target, dd.method);
-        disconnect_data.pop_front();
     }
 
     return err;
@@ -1358,6 +1361,10 @@ Error Object::connect(const StringName &p_signal, Object *p_to_object, const Str
     slot.conn = conn;
     auto &conns(p_to_object->private_data->connections);
     slot.cE = conns.emplace(conns.end(),conn);
+    // 'free' is handled by Object::call itself and never has a MethodBind.
+    if (p_to_method != CoreStringNames::get_singleton()->_free) {
+        slot.method_bind = ClassDB::get_method(p_to_object->get_class_name(), p_to_method);
+    }
     if (p_flags & ObjectNS::CONNECT_REFERENCE_COUNTED) {
         slot.reference_count = 1;
     }
@@ -1810,18 +1817,47 @@ void postinitialize_handler(Object *p_object) {
     p_object->_postinitialize();
 }
 
-HashMap<ObjectID, Object *> ObjectDB::instances;
-ObjectID ObjectDB::instance_counter = 1;
+std::atomic<ObjectDB::Slot *> ObjectDB::slot_blocks[ObjectDB::MAX_SLOT_BLOCKS] = {};
+uint32_t ObjectDB::slot_count = 0;
+uint32_t ObjectDB::free_slot_head = ObjectDB::INVALID_SLOT;
+std::atomic<int> ObjectDB::object_count { 0 };
+std::mutex ObjectDB::slot_mutex;
 HashMap<Object *, ObjectID, Hasher<Object *>> ObjectDB::instance_checks;
 ObjectID ObjectDB::add_instance(Object *p_object) {
 
     ERR_FAIL_COND_V(p_object->get_instance_id() != 0, 0);
 
+    uint32_t index;
+    Slot *slot;
+    {
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        if (free_slot_head != INVALID_SLOT) {
+            index = free_slot_head;
+            slot = &slot_blocks[index >> SLOT_BLOCK_SHIFT].load(std::memory_order_relaxed)[index & SLOT_BLOCK_MASK];
+            free_slot_head = slot->next_free;
+        } else {
+            ERR_FAIL_COND_V_MSG(slot_count == MAX_SLOT_BLOCKS * SLOT_BLOCK_SIZE, 0, "ObjectDB is full.");
+            index = slot_count++;
+            Slot *block = slot_blocks[index >> SLOT_BLOCK_SHIFT].load(std::memory_order_relaxed);
+            if (!block) {
+                block = memnew_arr(Slot, SLOT_BLOCK_SIZE);
+                for (uint32_t i = 0; i < SLOT_BLOCK_SIZE; ++i) {
+                    block[i].object.store(nullptr, std::memory_order_relaxed);
+                    block[i].generation.store(1, std::memory_order_relaxed);
+                    block[i].next_free = INVALID_SLOT;
+                }
+                slot_blocks[index >> SLOT_BLOCK_SHIFT].store(block, std::memory_order_release);
+            }
+            slot = &block[index & SLOT_BLOCK_MASK];
+        }
+        slot->object.store(p_object, std::memory_order_release);
+    }
+    object_count.fetch_add(1, std::memory_order_relaxed);
+
+    ObjectID instance_id = (ObjectID(slot->generation.load(std::memory_order_relaxed)) << 32) | index;
+
     rw_lock->write_lock();
-    ObjectID instance_id = ++instance_counter;
-    instances[instance_id] = p_object;
     instance_checks[p_object] = instance_id;
-
     rw_lock->write_unlock();
 
     return instance_id;
@@ -1830,32 +1866,62 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 void ObjectDB::remove_instance(Object *p_object) {
 
     rw_lock->write_lock();
-
-    instances.erase(p_object->get_instance_id());
     instance_checks.erase(p_object);
-
     rw_lock->write_unlock();
+
+    ObjectID id = p_object->get_instance_id();
+    uint32_t index = uint32_t(id);
+
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    ERR_FAIL_COND(id == 0 || index >= slot_count);
+    Slot &slot = slot_blocks[index >> SLOT_BLOCK_SHIFT].load(std::memory_order_relaxed)[index & SLOT_BLOCK_MASK];
+    ERR_FAIL_COND(slot.object.load(std::memory_order_relaxed) != p_object);
+
+    slot.object.store(nullptr, std::memory_order_release);
+    uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+    slot.generation.store(generation > MAX_GENERATION ? 1 : generation, std::memory_order_release);
+    slot.next_free = free_slot_head;
+    free_slot_head = index;
+    object_count.fetch_sub(1, std::memory_order_relaxed);
 }
-Object *ObjectDB::get_instance(ObjectID p_instance_id) {
 
-    rw_lock->read_lock();
-    auto iter= instances.find(p_instance_id);
-    Object *obj = iter!=instances.end() ? iter->second : nullptr;
-    rw_lock->read_unlock();
+Object *ObjectDB::get_instance(ObjectID p_instance_id) {
 
+    uint32_t index = uint32_t(p_instance_id);
+    uint32_t generation = uint32_t(p_instance_id >> 32);
+    if (unlikely(index >= MAX_SLOT_BLOCKS * SLOT_BLOCK_SIZE))
+        return nullptr;
+
+    Slot *block = slot_blocks[index >> SLOT_BLOCK_SHIFT].load(std::memory_order_acquire);
+    if (unlikely(!block))
+        return nullptr;
+
+    Slot &slot = block[index & SLOT_BLOCK_MASK];
+    if (slot.generation.load(std::memory_order_acquire) != generation)
+        return nullptr;
+    Object *obj = slot.object.load(std::memory_order_acquire);
+    // the slot could have been released and handed to another object while reading it.
+    if (slot.generation.load(std::memory_order_acquire) != generation)
+        return nullptr;
     return obj;
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
 
-    rw_lock->read_lock();
-
-    for(const auto &e : instances) {
+    // collect first, the callback is free to create or free objects.
+    Vector<Object *> objects;
+    {
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        objects.reserve(object_count.load(std::memory_order_relaxed));
+        for (uint32_t i = 0; i < slot_count; ++i) {
 
-        p_func(e.second);
+            Object *obj = slot_blocks[i >> SLOT_BLOCK_SHIFT].load(std::memory_order_relaxed)[i & SLOT_BLOCK_MASK].object.load(std::memory_order_relaxed);
+            if (obj)
+                objects.push_back(obj);
+        }
     }
-
-    rw_lock->read_unlock();
+    for (Object *obj : objects)
+        p_func(obj);
 }
 
 void Object::get_argument_options(const StringName & /*p_function*/, int /*p_idx*/, List<String> * /*r_options*/) const {
@@ -1863,11 +1929,7 @@ void Object::get_argument_options(const StringName & /*p_function*/, int /*p_idx
 
 int ObjectDB::get_object_count() {
 
-    rw_lock->read_lock();
-    int count = instances.size();
-    rw_lock->read_unlock();
-
-    return count;
+    return object_count.load(std::memory_order_relaxed);
 }
 
 RWLock *ObjectDB::rw_lock = nullptr;
@@ -1879,24 +1941,36 @@ void ObjectDB::setup() {
 
 void ObjectDB::cleanup() {
 
-    rw_lock->write_lock();
-    if (!instances.empty()) {
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    if (object_count.load() != 0) {
 
         WARN_PRINT("ObjectDB Instances still exist!");
         if (OS::get_singleton()->is_stdout_verbose()) {
-            for (const auto &e : instances) {
+            for (uint32_t i = 0; i < slot_count; ++i) {
+                Object *obj = slot_blocks[i >> SLOT_BLOCK_SHIFT].load()[i & SLOT_BLOCK_MASK].object.load();
+                if (!obj)
+                    continue;
                 //TODO: SEGS: use object_cast and direct calls here??
                 String node_name;
-                if (e.second->is_class("Node"))
-                    node_name = " - Node name: " + e.second->call_va("get_name").as<String>();
-                if (e.second->is_class("Resource"))
-                    node_name = " - Resource name: " + e.second->call_va("get_name").as<String>() +
-                                " Path: " + e.second->call_va("get_path").as<String>();
-                print_line(FormatVE("Leaked instance: %s:%zu%s", e.second->get_class(), e.second,node_name.c_str()));
+                if (obj->is_class("Node"))
+                    node_name = " - Node name: " + obj->call_va("get_name").as<String>();
+                if (obj->is_class("Resource"))
+                    node_name = " - Resource name: " + obj->call_va("get_name").as<String>() +
+                                " Path: " + obj->call_va("get_path").as<String>();
+                print_line(FormatVE("Leaked instance: %s:%zu%s", obj->get_class(), obj,node_name.c_str()));
             }
         }
     }
-    instances.clear();
+    for (std::atomic<Slot *> &block : slot_blocks) {
+        Slot *b = block.exchange(nullptr);
+        if (b)
+            memdelete_arr(b);
+    }
+    slot_count = 0;
+    free_slot_head = INVALID_SLOT;
+    object_count = 0;
+
+    rw_lock->write_lock();
     instance_checks.clear();
     rw_lock->write_unlock();
     memdelete(rw_lock);
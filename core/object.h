@@ -489,6 +489,7 @@ public:
 
     bool is_queued_for_deletion() const;
     void deleteLater() { _is_queued_for_deletion = true; }
+    void cancelDeleteLater() { _is_queued_for_deletion = false; } // used when a queued node is recycled instead
 
     void set_message_translation(bool p_enable) { _can_translate = p_enable; }
     bool can_translate_messages() const { return _can_translate; }
@@ -507,6 +508,17 @@ public:
     Object(Object &&) noexcept = default;
 };
 
+#ifdef DEBUG_ENABLED
+// Held for the duration of a method call, so the object refuses to be freed from inside it.
+struct GODOT_EXPORT _ObjectDebugLock {
+
+    Object *obj;
+
+    explicit _ObjectDebugLock(Object *p_obj);
+    ~_ObjectDebugLock();
+};
+#endif
+
 template <class T>
 T *object_cast(Object *p_object) {
 #ifdef RTTI_ENABLED
@@ -4,6 +4,9 @@
 #include "core/hashfuncs.h"
 #include "core/os/rw_lock.h"
 
+#include <atomic>
+#include <mutex>
+
 class Object;
 using ObjectID = uint64_t;
 
@@ -22,10 +25,33 @@ struct Hasher<Object *> {
 
 class ObjectDB {
 
-    static HashMap<ObjectID, Object *> instances;
-    static HashMap<Object *, ObjectID, Hasher<Object *>> instance_checks;
+    // Objects are registered in slots stored in lazily allocated, never moved blocks, so an ObjectID can be resolved
+    // with plain atomic loads. An ObjectID is (generation << 32) | slot index, the slot generation is bumped every time
+    // the slot is released, which invalidates all IDs handed out for the previous occupant.
+    struct Slot {
+        std::atomic<Object *> object;
+        std::atomic<uint32_t> generation;
+        uint32_t next_free;
+    };
+    enum : uint32_t {
+        SLOT_BLOCK_SHIFT = 12,
+        SLOT_BLOCK_SIZE = 1 << SLOT_BLOCK_SHIFT,
+        SLOT_BLOCK_MASK = SLOT_BLOCK_SIZE - 1,
+        MAX_SLOT_BLOCKS = 4096, // 16M live objects
+        INVALID_SLOT = 0xFFFFFFFF,
+        // generations stay below 2^31 so IDs fit in a positive int64 Variant.
+        MAX_GENERATION = 0x7FFFFFFF
+    };
+
+    static std::atomic<Slot *> slot_blocks[MAX_SLOT_BLOCKS];
+    static uint32_t slot_count;
+    static uint32_t free_slot_head;
+    static std::atomic<int> object_count;
+    static std::mutex slot_mutex;
 
-    static ObjectID instance_counter;
+    // A raw pointer may be dangling, so validating one cannot go through its ID; these are only used by
+    // instance_validate(Object *).
+    static HashMap<Object *, ObjectID, Hasher<Object *>> instance_checks;
     friend class Object;
     friend void unregister_core_types();
 
@@ -39,10 +65,15 @@ class ObjectDB {
 public:
     using DebugFunc = void (*)(Object *);
 
+    //! Wait-free, returns nullptr for IDs of objects that were freed.
     GODOT_EXPORT static Object *get_instance(ObjectID p_instance_id);
     GODOT_EXPORT static void debug_objects(DebugFunc p_func);
     GODOT_EXPORT static int get_object_count();
 
+    _FORCE_INLINE_ static bool instance_validate(ObjectID p_instance_id) {
+        return get_instance(p_instance_id) != nullptr;
+    }
+    //! Prefer the ObjectID overload (or Variant::is_valid_object), this one has to consult a locked pointer set.
     _FORCE_INLINE_ static bool instance_validate(Object *p_ptr) {
         rw_lock->read_lock();
 
@@ -113,6 +113,12 @@ public:
     virtual real_t get_real() const;
 
     virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+    /**
+     * Zero-copy alternative to get_buffer for memory backed files: returns the next p_length bytes in place and
+     * advances past them. The pointer stays valid until the file is closed. Returns nullptr, without moving,
+     * when the file is not memory backed or has fewer bytes left; callers then fall back to get_buffer.
+     */
+    virtual const uint8_t *borrow_buffer(uint64_t p_length) const { return nullptr; }
     virtual String get_line() const;
     virtual String get_token() const;
     virtual Vector<String> get_csv_line(char p_delim = ',') const;
@@ -0,0 +1,358 @@
+/*************************************************************************/
+/*  job_system.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "job_system.h"
+
+#include "core/error_macros.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include <thread>
+
+JobSystem *JobSystem::singleton = nullptr;
+
+namespace {
+thread_local int tls_worker_index = -1;
+std::atomic<uint32_t> s_next_worker_index { 0 };
+} // namespace
+
+void JobSystem::_worker_thread(void *p_userdata) {
+
+    JobSystem *js = static_cast<JobSystem *>(p_userdata);
+    tls_worker_index = s_next_worker_index.fetch_add(1);
+    Thread::set_name("JobSystem worker");
+
+    while (!js->exit_requested.load(std::memory_order_acquire)) {
+        if (js->help_one())
+            continue;
+        Job job;
+        if (js->_pop_background(job)) {
+            js->_execute(job);
+            continue;
+        }
+        js->wakeup.wait();
+    }
+    tls_worker_index = -1;
+}
+
+int JobSystem::get_current_worker_index() {
+
+    return tls_worker_index;
+}
+
+uint32_t JobSystem::_current_queue() const {
+
+    if (tls_worker_index >= 0 && uint32_t(tls_worker_index) < queue_count - 1)
+        return tls_worker_index;
+    return queue_count - 1;
+}
+
+bool JobSystem::_pop_job(uint32_t p_queue, Job &r_job) {
+
+    WorkQueue &q = queues[p_queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.jobs.empty())
+        return false;
+    // workers take their most recent job (still hot in cache), the shared queue is served in submission order.
+    if (p_queue != queue_count - 1) {
+        r_job = eastl::move(q.jobs.back());
+        q.jobs.pop_back();
+    } else {
+        r_job = eastl::move(q.jobs.front());
+        q.jobs.pop_front();
+    }
+    return true;
+}
+
+bool JobSystem::_steal_job(uint32_t p_thief, Job &r_job) {
+
+    for (uint32_t i = 1; i < queue_count; ++i) {
+        WorkQueue &q = queues[(p_thief + i) % queue_count];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.jobs.empty())
+            continue;
+        r_job = eastl::move(q.jobs.front());
+        q.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::_pop_background(Job &r_job) {
+
+    std::lock_guard<std::mutex> lock(background.mutex);
+    if (background.jobs.empty())
+        return false;
+    r_job = eastl::move(background.jobs.front());
+    background.jobs.pop_front();
+    return true;
+}
+
+void JobSystem::_execute(Job &p_job) {
+
+    p_job.func();
+    if (p_job.counter)
+        p_job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::submit(eastl::function<void()> p_func, Counter *p_counter) {
+
+    if (p_counter)
+        p_counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job job;
+    job.func = eastl::move(p_func);
+    job.counter = p_counter;
+
+    if (threads.empty()) {
+        _execute(job);
+        return;
+    }
+
+    WorkQueue &q = queues[_current_queue()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.emplace_back(eastl::move(job));
+    }
+    wakeup.post();
+}
+
+bool JobSystem::help_one() {
+
+    Job job;
+    uint32_t queue = _current_queue();
+    if (!_pop_job(queue, job) && !_steal_job(queue, job))
+        return false;
+    _execute(job);
+    return true;
+}
+
+void JobSystem::wait(Counter *p_counter) {
+
+    ERR_FAIL_COND(!p_counter);
+    while (!p_counter->is_done()) {
+        if (!help_one())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::submit_background(eastl::function<void()> p_func, Counter *p_counter) {
+
+    if (p_counter)
+        p_counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Job job;
+    job.func = eastl::move(p_func);
+    job.counter = p_counter;
+
+    if (threads.empty()) {
+        _execute(job);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(background.mutex);
+        background.jobs.emplace_back(eastl::move(job));
+    }
+    wakeup.post();
+}
+
+void JobSystem::wait_background(Counter *p_counter) {
+
+    ERR_FAIL_COND(!p_counter);
+    while (!p_counter->is_done()) {
+        if (help_one())
+            continue;
+        Job job;
+        if (_pop_background(job))
+            _execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::_parallel_for(uint32_t p_count, uint32_t p_batch, const eastl::function<void(uint32_t, uint32_t)> &p_range_func) {
+
+    if (p_count == 0)
+        return;
+
+    if (p_batch == 0) {
+        // a few batches per thread, so stealing can even out uneven per-element costs.
+        uint32_t splits = (threads.size() + 1) * 4;
+        p_batch = MAX(1, (p_count + splits - 1) / splits);
+    }
+
+    if (threads.empty() || p_count <= p_batch) {
+        p_range_func(0, p_count);
+        return;
+    }
+
+    Counter counter;
+    // the calling thread handles the first batch itself.
+    for (uint32_t begin = p_batch; begin < p_count; begin += p_batch) {
+        uint32_t end = MIN(begin + p_batch, p_count);
+        submit([&p_range_func, begin, end]() { p_range_func(begin, end); }, &counter);
+    }
+    p_range_func(0, p_batch);
+    wait(&counter);
+}
+
+JobSystem *JobSystem::replace_singleton(JobSystem *p_system) {
+
+    JobSystem *previous = singleton;
+    singleton = p_system;
+    return previous;
+}
+
+JobSystem::JobSystem(int p_worker_count) {
+
+    if (p_worker_count < 0)
+        p_worker_count = MAX(0, OS::get_singleton()->get_processor_count() - 1);
+
+    queue_count = p_worker_count + 1;
+    queues = memnew_arr(WorkQueue, queue_count);
+    s_next_worker_index = 0;
+
+    threads.reserve(p_worker_count);
+    for (int i = 0; i < p_worker_count; ++i) {
+        Thread *t = Thread::create(_worker_thread, this);
+        if (!t)
+            break; // no threading support on this platform, jobs will run on the submitting thread.
+        threads.emplace_back(t);
+    }
+
+    if (!singleton)
+        singleton = this;
+}
+
+JobSystem::~JobSystem() {
+
+    exit_requested.store(true, std::memory_order_release);
+    for (size_t i = 0; i < threads.size(); ++i)
+        wakeup.post();
+
+    for (Thread *t : threads) {
+        Thread::wait_to_finish(t);
+        memdelete(t);
+    }
+    threads.clear();
+    memdelete_arr(queues);
+
+    if (singleton == this)
+        singleton = nullptr;
+}
+
+uint32_t JobGraph::add_task(eastl::function<void()> p_func) {
+
+    Task t;
+    t.func = eastl::move(p_func);
+    tasks.emplace_back(eastl::move(t));
+    return tasks.size() - 1;
+}
+
+void JobGraph::add_dependency(uint32_t p_task, uint32_t p_depends_on) {
+
+    ERR_FAIL_INDEX(p_task, tasks.size());
+    ERR_FAIL_INDEX(p_depends_on, tasks.size());
+    ERR_FAIL_COND_MSG(p_task == p_depends_on, "A task cannot depend on itself.");
+
+    tasks[p_depends_on].dependents.push_back(p_task);
+    tasks[p_task].dependency_count++;
+}
+
+void JobGraph::_run_task(JobSystem *p_system, JobSystem::Counter *p_counter, std::atomic<uint32_t> *p_remaining, std::atomic<uint32_t> *p_executed, uint32_t p_task) {
+
+    Task &task = tasks[p_task];
+    task.func();
+    p_executed->fetch_add(1, std::memory_order_relaxed);
+
+    // dependents are submitted before this job retires, so the graph counter cannot reach zero early.
+    for (uint32_t dependent : task.dependents) {
+        if (p_remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            p_system->submit([this, p_system, p_counter, p_remaining, p_executed, dependent]() {
+                _run_task(p_system, p_counter, p_remaining, p_executed, dependent);
+            },
+                    p_counter);
+        }
+    }
+}
+
+Error JobGraph::execute(JobSystem *p_system) {
+
+    if (tasks.empty())
+        return OK;
+
+    if (!p_system) {
+        // serial fallback: Kahn's topological order.
+        Vector<uint32_t> remaining;
+        Vector<uint32_t> ready;
+        remaining.resize(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            remaining[i] = tasks[i].dependency_count;
+            if (remaining[i] == 0)
+                ready.push_back(i);
+        }
+        size_t executed = 0;
+        while (!ready.empty()) {
+            uint32_t idx = ready.back();
+            ready.pop_back();
+            tasks[idx].func();
+            ++executed;
+            for (uint32_t dependent : tasks[idx].dependents) {
+                if (--remaining[dependent] == 0)
+                    ready.push_back(dependent);
+            }
+        }
+        ERR_FAIL_COND_V_MSG(executed != tasks.size(), ERR_CYCLIC_LINK, "JobGraph contains circular dependencies.");
+        return OK;
+    }
+
+    std::atomic<uint32_t> *remaining = memnew_arr(std::atomic<uint32_t>, tasks.size());
+    std::atomic<uint32_t> executed { 0 };
+    JobSystem::Counter counter;
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+        remaining[i].store(tasks[i].dependency_count, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].dependency_count != 0)
+            continue;
+        uint32_t idx = i;
+        p_system->submit([this, p_system, &counter, remaining, &executed, idx]() {
+            _run_task(p_system, &counter, remaining, &executed, idx);
+        },
+                &counter);
+    }
+    p_system->wait(&counter);
+    memdelete_arr(remaining);
+
+    ERR_FAIL_COND_V_MSG(executed.load() != tasks.size(), ERR_CYCLIC_LINK, "JobGraph contains circular dependencies.");
+    return OK;
+}
@@ -0,0 +1,160 @@
+/*************************************************************************/
+/*  job_system.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+#include "core/vector.h"
+#include "core/os/semaphore.h"
+
+#include "EASTL/deque.h"
+#include "EASTL/functional.h"
+
+#include <atomic>
+#include <mutex>
+
+class Thread;
+
+/**
+ * Persistent pool of worker threads with per-worker work-stealing queues.
+ *
+ * Every worker owns a queue it pushes to and pops from (LIFO); idle workers steal from the front of other queues.
+ * Threads that are not workers (main thread, server threads) submit into a shared external queue.
+ * Waiting on a Counter never blocks a worker idly: the waiting thread keeps executing queued jobs until the counter
+ * reaches zero ("wait-and-help"), so jobs may freely spawn and wait on sub-jobs.
+ * Long-running background work (resource loads) goes to a separate low-priority queue instead. Only otherwise idle
+ * workers and wait_background() run those jobs, so a wait() inside a frame never picks up a whole load.
+ */
+class GODOT_EXPORT JobSystem {
+public:
+    //! Number of outstanding jobs submitted against it; a group of jobs is done once this reaches zero.
+    struct Counter {
+        std::atomic<uint32_t> pending { 0 };
+        bool is_done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+private:
+    struct Job {
+        eastl::function<void()> func;
+        Counter *counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        eastl::deque<Job> jobs;
+    };
+
+    static JobSystem *singleton;
+
+    Vector<Thread *> threads;
+    // one queue per worker, the last one is shared by all external threads.
+    WorkQueue *queues = nullptr;
+    uint32_t queue_count = 0;
+    WorkQueue background;
+    Semaphore wakeup;
+    std::atomic<bool> exit_requested { false };
+
+    static void _worker_thread(void *p_userdata);
+
+    uint32_t _current_queue() const;
+    bool _pop_job(uint32_t p_queue, Job &r_job);
+    bool _steal_job(uint32_t p_thief, Job &r_job);
+    bool _pop_background(Job &r_job);
+    void _execute(Job &p_job);
+    void _parallel_for(uint32_t p_count, uint32_t p_batch, const eastl::function<void(uint32_t, uint32_t)> &p_range_func);
+
+public:
+    static JobSystem *get_singleton() { return singleton; }
+    //! Makes p_system (may be null) the singleton and returns the previous one, so tests can run code without workers.
+    static JobSystem *replace_singleton(JobSystem *p_system);
+
+    //! Index of the calling worker thread in [0, get_worker_count()), or -1 for non-worker threads.
+    static int get_current_worker_index();
+    int get_worker_count() const { return threads.size(); }
+
+    void submit(eastl::function<void()> p_func, Counter *p_counter = nullptr);
+    //! Executes pending jobs on the calling thread until p_counter is done.
+    void wait(Counter *p_counter);
+    //! Runs a single queued job if one is available, returns false when all queues were empty.
+    bool help_one();
+
+    //! Queues a low-priority job, which wait() and help_one() never run.
+    void submit_background(eastl::function<void()> p_func, Counter *p_counter = nullptr);
+    //! Like wait(), but also executes background jobs until p_counter is done.
+    void wait_background(Counter *p_counter);
+
+    /**
+     * Calls p_func(index) for every index in [0, p_count), returns once all calls finished.
+     * p_batch is the number of consecutive indices handled by one job, 0 picks a batch size based on worker count.
+     */
+    template <class F>
+    void parallel_for(uint32_t p_count, F &&p_func, uint32_t p_batch = 0) {
+        _parallel_for(p_count, p_batch, [&p_func](uint32_t p_begin, uint32_t p_end) {
+            for (uint32_t i = p_begin; i < p_end; ++i)
+                p_func(i);
+        });
+    }
+    //! Like parallel_for, but the callable receives whole [begin, end) ranges.
+    void parallel_for_range(uint32_t p_count, const eastl::function<void(uint32_t, uint32_t)> &p_range_func, uint32_t p_batch = 0) {
+        _parallel_for(p_count, p_batch, p_range_func);
+    }
+
+    //! p_worker_count < 0 uses one worker per processor, minus the main thread.
+    explicit JobSystem(int p_worker_count = -1);
+    ~JobSystem();
+};
+
+/**
+ * Set of jobs with ordering constraints between them.
+ *
+ * Tasks are added with add_task, and add_dependency(a,b) makes task a wait for task b to finish.
+ * execute() schedules all tasks without pending dependencies, releasing dependents as their dependencies complete,
+ * and returns once every task ran. Without a JobSystem the graph is executed serially in dependency order.
+ */
+class GODOT_EXPORT JobGraph {
+    struct Task {
+        eastl::function<void()> func;
+        Vector<uint32_t> dependents;
+        uint32_t dependency_count = 0;
+    };
+
+    Vector<Task> tasks;
+
+    void _run_task(JobSystem *p_system, JobSystem::Counter *p_counter, std::atomic<uint32_t> *p_remaining, std::atomic<uint32_t> *p_executed, uint32_t p_task);
+
+public:
+    uint32_t add_task(eastl::function<void()> p_func);
+    void add_dependency(uint32_t p_task, uint32_t p_depends_on);
+    int get_task_count() const { return tasks.size(); }
+    void clear() { tasks.clear(); }
+
+    //! Returns ERR_CYCLIC_LINK if some tasks could not run because of circular dependencies.
+    Error execute(JobSystem *p_system = JobSystem::get_singleton());
+};
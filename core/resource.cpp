@@ -38,6 +38,7 @@
 #include "core/map.h"
 #include "core/object_db.h"
 #include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "core/script_language.h"
 #include "core/self_list.h"
 #include "core/object_tooling.h"
@@ -46,15 +47,29 @@
 #include "scene/main/node.h" //only so casting works
 #include "core/method_bind.h"
 #include <QMetaProperty>
+#include <atomic>
 #include <cstdio>
 
 namespace {
-    HashMap<String, Resource *> cached_resources;
+    constexpr uint32_t CACHE_SHARD_COUNT = 32; // power of 2
+
+    struct alignas(64) CacheShard {
+        RWLock *lock = nullptr;
+        HashMap<String, Resource *> resources;
+    };
+    CacheShard cache_shards[CACHE_SHARD_COUNT];
+
+    CacheShard &shard_for(se_string_view p_path) {
+        return cache_shards[StringUtils::hash(p_path) & (CACHE_SHARD_COUNT - 1)];
+    }
+
+    // Resources the cache holds a soft reference to, in eviction order; see ResourceCache::_release_soft.
+    SelfList<Resource>::List soft_cached;
 
 } // end of anonymous namespace
 
 struct Resource::Data {
-    Data(Resource *own) : remapped_list(own) {}
+    Data(Resource *own) : remapped_list(own), soft_cache_item(own) {}
 #ifdef TOOLS_ENABLED
     static HashMap<String, HashMap<String, int> > resource_path_cache; // each tscn has a set of resource paths and IDs
     static RWLock *path_cache_lock;
@@ -62,6 +77,12 @@ struct Resource::Data {
 #endif
     HashSet<ObjectID> owners;
     SelfList<Resource> remapped_list;
+    SelfList<Resource> soft_cache_item;
+    // Written by cache hits without taking ResourceCache::lock.
+    std::atomic<uint64_t> last_used_usec {0};
+    std::atomic<bool> soft_cached {false};
+    std::atomic<bool> soft_referenced {false}; // used since the last eviction pass looked at it
+    uint64_t soft_cached_memory = 0; // usage at the time it was last accounted
     String name;
     String path_cache;
     Node *local_scene = nullptr;
@@ -90,45 +111,17 @@ void Resource::set_path(se_string_view p_path, bool p_take_over) {
         return;
 
     if (!impl_data->path_cache.empty()) {
-
-        ResourceCache::lock->write_lock();
-        cached_resources.erase(impl_data->path_cache);
-        ResourceCache::lock->write_unlock();
+        ResourceCache::_erase(impl_data->path_cache, this);
     }
 
     impl_data->path_cache = "";
 
-    ResourceCache::lock->read_lock();
-    auto lociter = cached_resources.find_as(p_path);
-    bool has_path = cached_resources.end()!=lociter;
-    ResourceCache::lock->read_unlock();
-
-    if (has_path) {
-        if (p_take_over) {
-
-            ResourceCache::lock->write_lock();
-            //TODO: can `lociter` really change between this and previous call ?
-            lociter = cached_resources.find_as(p_path);
-            if(lociter!=cached_resources.end())
-                lociter->second->set_name("");
-            ResourceCache::lock->write_unlock();
-        } else {
-            ResourceCache::lock->read_lock();
-            bool exists = cached_resources.find_as(p_path)!=cached_resources.end();
-            ResourceCache::lock->read_unlock();
-
-            ERR_FAIL_COND_MSG(exists, "Another resource is loaded from path '" + String(p_path) + "' (possible cyclic resource inclusion).");
-        }
+    if (!p_path.empty()) {
+        ERR_FAIL_COND_MSG(!ResourceCache::_insert(p_path, this, p_take_over),
+                "Another resource is loaded from path '" + String(p_path) + "' (possible cyclic resource inclusion).");
     }
     impl_data->path_cache = p_path;
 
-    if (!impl_data->path_cache.empty()) {
-
-        ResourceCache::lock->write_lock();
-        cached_resources[impl_data->path_cache] = this;
-        ResourceCache::lock->write_unlock();
-    }
-
     Object_change_notify(this,"resource_path");
     _resource_path_changed();
 }
@@ -528,9 +521,7 @@ Resource::Resource() :
 Resource::~Resource() {
 
     if (!impl_data->path_cache.empty()) {
-        ResourceCache::lock->write_lock();
-        cached_resources.erase(impl_data->path_cache);
-        ResourceCache::lock->write_unlock();
+        ResourceCache::_erase(impl_data->path_cache, this);
     }
     if (!impl_data->owners.empty()) {
         WARN_PRINT("Resource is still owned.");
@@ -540,18 +531,29 @@ Resource::~Resource() {
 }
 
 RWLock *ResourceCache::lock = nullptr;
+uint64_t ResourceCache::memory_budget = 0;
+uint64_t ResourceCache::soft_cached_memory = 0;
+uint32_t ResourceCache::soft_cached_count = 0;
 
 void ResourceCache::setup() {
 
     lock = RWLock::create();
+    for (CacheShard &shard : cache_shards) {
+        shard.lock = RWLock::create();
+    }
 }
 
 void ResourceCache::clear() {
-    if (!cached_resources.empty()) {
+    release_soft_references();
+    if (get_cached_resource_count() != 0) {
         ERR_PRINT("Resources Still in use at Exit!");
     }
 
-    cached_resources.clear();
+    for (CacheShard &shard : cache_shards) {
+        shard.resources.clear();
+        memdelete(shard.lock);
+        shard.lock = nullptr;
+    }
     memdelete(lock);
 }
 
@@ -565,52 +567,225 @@ void ResourceCache::reload_externals() {
     */
 }
 
-bool ResourceCache::has(se_string_view p_path) {
+bool ResourceCache::_insert(se_string_view p_path, Resource *p_resource, bool p_take_over) {
 
-    lock->read_lock();
-    bool b = cached_resources.find_as(p_path)!=cached_resources.end();
-    lock->read_unlock();
+    CacheShard &shard = shard_for(p_path);
+    RWLockWrite guard(shard.lock);
+    auto iter = shard.resources.find_as(p_path);
+    if (iter == shard.resources.end()) {
+        shard.resources.emplace(String(p_path), p_resource);
+        return true;
+    }
+    if (!p_take_over)
+        return false;
+    iter->second->set_name("");
+    iter->second = p_resource;
+    return true;
+}
 
-    return b;
+void ResourceCache::_erase(se_string_view p_path, Resource *p_resource) {
+
+    CacheShard &shard = shard_for(p_path);
+    RWLockWrite guard(shard.lock);
+    auto iter = shard.resources.find_as(p_path);
+    // the path may have been taken over by another resource since
+    if (iter != shard.resources.end() && iter->second == p_resource)
+        shard.resources.erase(iter);
 }
 
-Resource * ResourceCache::get_unguarded(se_string_view p_path) {
-    return cached_resources.at(String(p_path),nullptr);
+bool ResourceCache::has(se_string_view p_path) {
+
+    CacheShard &shard = shard_for(p_path);
+    RWLockRead guard(shard.lock);
+    return shard.resources.find_as(p_path) != shard.resources.end();
 }
 
 Resource *ResourceCache::get(se_string_view p_path) {
 
-    lock->read_lock();
-
-    Resource *res = cached_resources.at(String(p_path),nullptr);
+    CacheShard &shard = shard_for(p_path);
+    RWLockRead guard(shard.lock);
+    auto iter = shard.resources.find_as(p_path);
+    return iter != shard.resources.end() ? iter->second : nullptr;
+}
 
-    lock->read_unlock();
+Ref<Resource> ResourceCache::get_ref(se_string_view p_path) {
 
+    Ref<Resource> res;
+    CacheShard &shard = shard_for(p_path);
+    RWLockRead guard(shard.lock);
+    auto iter = shard.resources.find_as(p_path);
+    // reference() fails once the count dropped to zero: the destructor is waiting for the shard lock to unregister
+    if (iter != shard.resources.end() && iter->second->reference()) {
+        res = Ref<Resource>(iter->second);
+        iter->second->unreference(); // the Ref took its own
+    }
     return res;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
 
-    lock->read_lock();
-    for(eastl::pair<const String,Resource *> & e :cached_resources) {
-        p_resources->push_back(Ref<Resource>(e.second));
+    for (CacheShard &shard : cache_shards) {
+        RWLockRead guard(shard.lock);
+        for (eastl::pair<const String, Resource *> &e : shard.resources) {
+            if (e.second->reference()) {
+                p_resources->push_back(Ref<Resource>(e.second));
+                e.second->unreference();
+            }
+        }
     }
-    lock->read_unlock();
 }
 
 int ResourceCache::get_cached_resource_count() {
 
+    int rc = 0;
+    for (CacheShard &shard : cache_shards) {
+        RWLockRead guard(shard.lock);
+        rc += shard.resources.size();
+    }
+    return rc;
+}
+
+// Charged for each softly cached resource at least, so types that don't report their usage still count against the
+// budget instead of piling up unbounded.
+static constexpr uint64_t SOFT_CACHE_MIN_ENTRY_COST = 16 * 1024;
+
+static uint64_t _soft_cache_cost(const Resource *p_resource) {
+
+    return MAX(p_resource->get_memory_usage(), SOFT_CACHE_MIN_ENTRY_COST);
+}
+
+void ResourceCache::_release_soft(bool p_all, Vector<Ref<Resource>> &r_released) {
+
+    // write lock is held by the caller; the released references must be dropped after unlocking, as freeing a
+    // resource takes the locks again.
+    // This is a CLOCK approximation of LRU: cache hits only flag the entry (see mark_used), and a flagged or still
+    // used entry gets moved to the back once instead of being dropped. Each entry is looked at most once per pass.
+    for (uint32_t left = soft_cached_count; left && (p_all || soft_cached_memory > memory_budget); left--) {
+
+        SelfList<Resource> *E = soft_cached.first();
+        Resource *r = E->self();
+        Resource::Data *d = r->impl_data;
+        soft_cached.remove(E);
+        soft_cached_memory -= d->soft_cached_memory;
+        bool referenced = d->soft_referenced.exchange(false, std::memory_order_relaxed);
+        if (!p_all && (referenced || r->reference_get_count() > 1)) {
+            d->soft_cached_memory = _soft_cache_cost(r);
+            soft_cached_memory += d->soft_cached_memory;
+            soft_cached.add_last(E);
+            continue;
+        }
+        soft_cached_count--;
+        d->soft_cached.store(false, std::memory_order_release);
+        r_released.emplace_back(r);
+        r->unreference(); // the reference in r_released takes over
+    }
+}
+
+void ResourceCache::set_memory_budget(uint64_t p_bytes) {
+
+    Vector<Ref<Resource>> released;
+    lock->write_lock();
+    memory_budget = p_bytes;
+    _release_soft(memory_budget == 0, released);
+    lock->write_unlock();
+}
+
+uint64_t ResourceCache::get_memory_budget() {
+
+    return memory_budget;
+}
+
+uint64_t ResourceCache::get_soft_cached_memory() {
+
     lock->read_lock();
-    int rc = cached_resources.size();
+    uint64_t usage = soft_cached_memory;
     lock->read_unlock();
+    return usage;
+}
 
-    return rc;
+void ResourceCache::mark_used(Resource *p_resource) {
+
+    if (!memory_budget || p_resource->get_path().empty())
+        return;
+
+    Resource::Data *d = p_resource->impl_data;
+    d->last_used_usec.store(OS::get_singleton()->get_ticks_usec(), std::memory_order_relaxed);
+    if (d->soft_cached.load(std::memory_order_acquire)) {
+        // hits on already cached resources stay off the lock; avoid dirtying the cache line when already set
+        if (!d->soft_referenced.load(std::memory_order_relaxed))
+            d->soft_referenced.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    uint64_t usage = _soft_cache_cost(p_resource);
+    Vector<Ref<Resource>> released;
+
+    lock->write_lock();
+    if (d->soft_cache_item.in_list() || !p_resource->reference()) {
+        // raced with another thread caching it, or being freed
+        lock->write_unlock();
+        return;
+    }
+    d->soft_cached_memory = usage;
+    d->soft_referenced.store(false, std::memory_order_relaxed);
+    soft_cached_memory += usage;
+    soft_cached_count++;
+    soft_cached.add_last(&d->soft_cache_item);
+    d->soft_cached.store(true, std::memory_order_release);
+    _release_soft(false, released);
+    lock->write_unlock();
+}
+
+void ResourceCache::trim() {
+
+    Vector<Ref<Resource>> released;
+    lock->write_lock();
+    if (memory_budget)
+        _release_soft(false, released);
+    lock->write_unlock();
+}
+
+void ResourceCache::release_soft_references() {
+
+    if (!lock)
+        return;
+
+    Vector<Ref<Resource>> released;
+    lock->write_lock();
+    _release_soft(true, released);
+    lock->write_unlock();
+}
+
+void ResourceCache::get_residency(Vector<Residency> &r_residency) {
+
+    // hold a reference to each entry so usage can be queried without the locks, see _release_soft
+    Vector<Ref<Resource>> held;
+    for (CacheShard &shard : cache_shards) {
+        RWLockRead guard(shard.lock);
+        for (eastl::pair<const String, Resource *> &e : shard.resources) {
+            if (e.second->reference()) {
+                held.emplace_back(e.second);
+                e.second->unreference();
+                Residency &r = r_residency.emplace_back();
+                r.path = e.first;
+            }
+        }
+    }
+
+    size_t first = r_residency.size() - held.size();
+    for (size_t i = 0; i < held.size(); i++) {
+        Residency &r = r_residency[first + i];
+        Resource::Data *d = held[i]->impl_data;
+        r.type = held[i]->get_class_name();
+        r.memory_usage = held[i]->get_memory_usage();
+        r.last_used_usec = d->last_used_usec.load(std::memory_order_relaxed);
+        r.soft_cached = d->soft_cached.load(std::memory_order_acquire);
+        r.reference_count = held[i]->reference_get_count() - 1 - (r.soft_cached ? 1 : 0);
+    }
 }
 
 void ResourceCache::dump(se_string_view p_file, bool p_short) {
 #ifdef DEBUG_ENABLED
-    lock->read_lock();
-
     Map<String, int> type_count;
 
     FileAccess *f = nullptr;
@@ -619,19 +794,22 @@ void ResourceCache::dump(se_string_view p_file, bool p_short) {
         ERR_FAIL_COND_MSG(!f, "Cannot create file at path '" + String(p_file) + "'.");
     }
 
-    for (eastl::pair<const String, Resource *> & e : cached_resources) {
+    for (CacheShard &shard : cache_shards) {
+        RWLockRead guard(shard.lock);
+        for (eastl::pair<const String, Resource *> &e : shard.resources) {
 
-        Resource *r = e.second;
+            Resource *r = e.second;
 
-        if (!type_count.contains(r->get_class())) {
-            type_count[r->get_class()] = 0;
-        }
+            if (!type_count.contains(r->get_class())) {
+                type_count[r->get_class()] = 0;
+            }
 
-        type_count[r->get_class()]++;
+            type_count[r->get_class()]++;
 
-        if (!p_short) {
-            if (f)
-                f->store_line(String(r->get_class()) + ": " + r->get_path());
+            if (!p_short) {
+                if (f)
+                    f->store_line(String(r->get_class()) + ": " + r->get_path());
+            }
         }
     }
 
@@ -644,8 +822,5 @@ void ResourceCache::dump(se_string_view p_file, bool p_short) {
         f->close();
         memdelete(f);
     }
-
-    lock->read_unlock();
-
 #endif
 }
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/reference.h"
+#include "core/se_string.h"
 
 namespace eastl {
 template <typename Key, typename T, typename Compare, typename Allocator>
@@ -156,6 +157,9 @@ public:
     bool is_translation_remapped() const;
 
     virtual RID get_rid() const; // some resources may offer conversion to RID
+    // Estimated bytes held by this resource, including video or audio memory it owns; 0 when the type does not report
+    // it. Used for the ResourceCache memory budget and residency stats.
+    virtual uint64_t get_memory_usage() const { return 0; }
 
 #ifdef TOOLS_ENABLED
     //helps keep IDs same number when loading/saving scenes. -1 clears ID and it Returns -1 when no id stored
@@ -172,17 +176,48 @@ using RES = Ref<Resource>;
 class GODOT_EXPORT ResourceCache {
     friend class Resource;
     friend class ResourceLoader; //need the lock
+    // Guards the translation remap list and the soft cache; the path -> resource map is split into shards that are
+    // locked on their own, so lookups of different paths don't contend.
     static RWLock *lock;
     friend void unregister_core_types();
     static void clear();
     friend void register_core_types();
     static void setup();
-    static Resource *get_unguarded(se_string_view p_path);
+    static bool _insert(se_string_view p_path, Resource *p_resource, bool p_take_over);
+    static void _erase(se_string_view p_path, Resource *p_resource);
+    static uint64_t memory_budget;
+    static uint64_t soft_cached_memory;
+    static uint32_t soft_cached_count;
+    static void _release_soft(bool p_all, Vector<Ref<Resource>> &r_released);
 public:
+    struct Residency {
+        String path;
+        StringName type;
+        uint64_t memory_usage;
+        uint64_t last_used_usec; // 0 if never handed out by the loader
+        int reference_count; // not counting the soft reference
+        bool soft_cached;
+    };
+
     static void reload_externals();
     static bool has(se_string_view p_path);
     static Resource *get(se_string_view p_path);
+    // Returns a new reference to the cached resource, or null if it's not cached or is being freed. Only the shard
+    // holding p_path is locked.
+    static Ref<Resource> get_ref(se_string_view p_path);
     static void dump(se_string_view p_file = nullptr, bool p_short = false);
     static void get_cached_resources(List<Ref<Resource>> *p_resources);
     static int get_cached_resource_count();
+
+    // With a budget set, the loader keeps a soft reference to what it hands out so released resources stay loaded
+    // for reuse. Resources held only by that reference are dropped, roughly least recently used first, once the memory
+    // of all softly cached resources exceeds the budget, each one counting for at least 16 KiB so types that don't
+    // report get_memory_usage() are bounded too. 0 disables soft caching.
+    static void set_memory_budget(uint64_t p_bytes);
+    static uint64_t get_memory_budget();
+    static uint64_t get_soft_cached_memory();
+    static void mark_used(Resource *p_resource);
+    static void trim();
+    static void release_soft_references();
+    static void get_residency(Vector<Residency> &r_residency);
 };
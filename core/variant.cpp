@@ -1052,6 +1052,7 @@ void Variant::clear() {
         case VariantType::OBJECT: {
 
             _get_obj().obj = nullptr;
+            _get_obj().id = 0;
             _get_obj().ref.unref();
         } break;
         case VariantType::_RID: {
@@ -1565,7 +1566,7 @@ String Variant::stringify(Vector<const void *> &stack) const {
 #ifdef DEBUG_ENABLED
                 if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
                     //only if debugging!
-                    if (!ObjectDB::instance_validate(_get_obj().obj)) {
+                    if (!is_valid_object()) {
                         return ("[Deleted Object]");
                     }
                 }
@@ -1683,7 +1684,7 @@ Variant::operator RID() const {
     if (type == VariantType::OBJECT && _get_obj().obj) {
 #ifdef DEBUG_ENABLED
         if (ScriptDebugger::get_singleton()) {
-            ERR_FAIL_COND_V_MSG(!ObjectDB::instance_validate(_get_obj().obj), RID(), "Invalid pointer (object was deleted).");
+            ERR_FAIL_COND_V_MSG(!is_valid_object(), RID(), "Invalid pointer (object was deleted).");
         }
 #endif
         Variant::CallError ce;
@@ -2090,6 +2091,7 @@ Variant::Variant(const RefPtr &p_resource) {
     REF *ref = reinterpret_cast<REF *>(p_resource.get_data());
     _get_obj().obj = ref->get();
     _get_obj().ref = p_resource;
+    _get_obj().id = _get_obj().obj ? _get_obj().obj->get_instance_id() : 0;
 }
 
 Variant::Variant(const RID &p_rid) {
@@ -2106,6 +2108,7 @@ Variant::Variant(const Object *p_object) {
 #endif
     memnew_placement(_data._mem, ObjData);
     _get_obj().obj = const_cast<Object *>(p_object);
+    _get_obj().id = p_object ? p_object->get_instance_id() : 0;
 }
 
 Variant::Variant(const Dictionary &p_dictionary) {
@@ -3026,6 +3029,11 @@ bool Variant::is_ref() const {
     return type == VariantType::OBJECT && !_get_obj().ref.is_null();
 }
 
+bool Variant::is_valid_object() const {
+
+    return type == VariantType::OBJECT && _get_obj().obj && ObjectDB::get_instance(_get_obj().id) == _get_obj().obj;
+}
+
 
 void Variant::static_assign(const Variant &p_variant) {
 }
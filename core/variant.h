@@ -137,6 +137,7 @@ enum class VariantType : int8_t {
 class GODOT_EXPORT Variant {
 private:
     friend struct _VariantCall;
+    friend struct _VariantValidated;
     // Variant takes 20 bytes when real_t is float, and 36 if double
     // it only allocates extra memory for aabb/matrix.
 
@@ -146,6 +147,8 @@ private:
 
         Object *obj;
         RefPtr ref;
+        // ObjectID captured on assignment, lets validity checks go through ObjectDB without dereferencing obj.
+        uint64_t id;
     };
 
     _FORCE_INLINE_ ObjData &_get_obj();
@@ -180,6 +183,8 @@ public:
     static bool can_convert_strict(VariantType p_type_from, VariantType p_type_to);
 
     [[nodiscard]] bool is_ref() const;
+    //! true if this holds an object that was not freed since it was stored in this Variant.
+    [[nodiscard]] bool is_valid_object() const;
     _FORCE_INLINE_ bool is_num() const { return type == VariantType::INT || type == VariantType::REAL; }
     _FORCE_INLINE_ bool is_array() const { return type >= VariantType::ARRAY; }
     [[nodiscard]] bool is_shared() const;
@@ -391,6 +396,20 @@ public:
         return res;
     }
 
+    // Validated accessors skip all type dispatch and error checks, callers (e.g. a script compiler that knows the
+    // static types) must guarantee the types they were looked up with.
+    using ValidatedOperatorEvaluator = void (*)(const Variant &p_a, const Variant &p_b, Variant &r_ret);
+    static ValidatedOperatorEvaluator get_validated_operator_evaluator(Operator p_op, VariantType p_type_a, VariantType p_type_b);
+
+    using ValidatedGetter = void (*)(const Variant &p_base, Variant &r_value);
+    using ValidatedSetter = void (*)(Variant &p_base, const Variant &p_value);
+    struct ValidatedMember {
+        ValidatedGetter getter;
+        ValidatedSetter setter; // nullptr for read-only members
+        VariantType type;
+    };
+    static bool get_validated_member(VariantType p_type, const StringName &p_name, ValidatedMember &r_member);
+
     void zero();
     [[nodiscard]] Variant duplicate(bool deep = false) const;
     static void blend(const Variant &a, const Variant &b, float c, Variant &r_dst);
@@ -426,6 +445,11 @@ public:
     static Span<const se_string_view> get_method_argument_names(VariantType p_type, const StringName &p_method);
     static bool is_method_const(VariantType p_type, const StringName &p_method);
 
+    struct ValidatedBuiltinMethod; // opaque handle to an entry of the builtin method tables
+    static const ValidatedBuiltinMethod *get_validated_builtin_method(VariantType p_type, const StringName &p_method);
+    // returns false without calling when an argument's type is not exactly the declared one, callers then use call_ptr.
+    static bool call_validated_builtin_method(const ValidatedBuiltinMethod *p_method, Variant &p_self, const Variant **p_args, int p_argcount, Variant *r_ret);
+
     void set_named(const StringName &p_index, const Variant &p_value, bool *r_valid = nullptr);
     Variant get_named(const StringName &p_index, bool *r_valid = nullptr) const;
 
@@ -57,6 +57,8 @@
 #include "core/rid.h"
 #include "core/container_tools.h"
 
+#include "EASTL/sort.h"
+
 
 using String = String;
 
@@ -177,8 +179,114 @@ struct _VariantCall {
         FuncData func_def;
     };
 
+    // Methods of one builtin type. Entries are appended in registration order
+    // while register_variant_methods() runs and never move afterwards, so
+    // pointers into `functions` stay valid. freeze() then builds a perfect
+    // hash over the precomputed StringName hashes: a lookup is one seed read,
+    // one slot read and one pointer compare.
     struct TypeFunc {
-        HashMap<StringName, FuncData> functions;
+        Vector<StringName> names;
+        Vector<FuncData> functions;
+        Vector<uint32_t> seeds; // per bucket
+        Vector<int> slots; // index into functions, -1 if free
+        uint32_t bucket_mask = 0;
+        uint32_t slot_mask = 0;
+
+        static uint32_t mix(uint32_t p_hash, uint32_t p_seed) {
+            uint32_t h = p_hash ^ (p_seed * 0x9E3779B9u);
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            h *= 0xC2B2AE35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        int find(const StringName &p_name) const {
+            if (slots.empty()) {
+                // not frozen yet (or the hashes could not be separated).
+                for (size_t i = 0; i < names.size(); i++) {
+                    if (names[i] == p_name)
+                        return int(i);
+                }
+                return -1;
+            }
+            const uint32_t h = p_name.hash();
+            const int idx = slots[mix(h, seeds[h & bucket_mask]) & slot_mask];
+            return idx >= 0 && names[idx] == p_name ? idx : -1;
+        }
+
+        FuncData *get(const StringName &p_name) {
+            int idx = find(p_name);
+            return idx < 0 ? nullptr : &functions[idx];
+        }
+
+        void add(const StringName &p_name, const FuncData &p_func) {
+            ERR_FAIL_COND(!slots.empty()); // registering after freeze()
+            int idx = find(p_name);
+            if (idx >= 0) {
+                functions[idx] = p_func;
+                return;
+            }
+            names.push_back(p_name);
+            functions.push_back(p_func);
+        }
+
+        void freeze() {
+            seeds.clear();
+            slots.clear();
+            const uint32_t count = uint32_t(functions.size());
+            if (count == 0)
+                return;
+
+            // twice as many slots as keys and ~4 keys per bucket, so the seed search ends quickly.
+            const uint32_t slot_count = next_power_of_2(count * 2);
+            const uint32_t bucket_count = MAX(slot_count / 8, 1u);
+            bucket_mask = bucket_count - 1;
+            slot_mask = slot_count - 1;
+
+            Vector<Vector<int>> buckets(bucket_count);
+            for (uint32_t i = 0; i < count; i++) {
+                buckets[names[i].hash() & bucket_mask].push_back(int(i));
+            }
+            Vector<uint32_t> order(bucket_count);
+            for (uint32_t i = 0; i < bucket_count; i++) {
+                order[i] = i;
+            }
+            eastl::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+            Vector<int> table(slot_count, -1);
+            Vector<uint32_t> bucket_seeds(bucket_count, 0);
+            Vector<uint32_t> placed;
+            for (uint32_t b : order) {
+                const Vector<int> &keys = buckets[b];
+                if (keys.empty())
+                    break;
+                for (uint32_t seed = 1;; seed++) {
+                    // two names with the same 32 bit hash can never be separated; keep the linear lookup.
+                    ERR_FAIL_COND_MSG(seed > (1u << 16), "Could not build a perfect hash for builtin methods.");
+                    placed.clear();
+                    bool ok = true;
+                    for (int key : keys) {
+                        uint32_t slot = mix(names[key].hash(), seed) & slot_mask;
+                        if (table[slot] >= 0 || eastl::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                            ok = false;
+                            break;
+                        }
+                        placed.push_back(slot);
+                    }
+                    if (!ok)
+                        continue;
+                    for (size_t i = 0; i < keys.size(); i++) {
+                        table[placed[i]] = keys[i];
+                    }
+                    bucket_seeds[b] = seed;
+                    break;
+                }
+            }
+            seeds = eastl::move(bucket_seeds);
+            slots = eastl::move(table);
+        }
     };
 
     static TypeFunc *type_funcs;
@@ -190,17 +298,19 @@ struct _VariantCall {
     static void make_func_return_variant(VariantType p_type, const StringName &p_name) {
 
 #ifdef DEBUG_ENABLED
-        type_funcs[(int)p_type].functions[p_name].returns = true;
+        FuncData *fd = type_funcs[(int)p_type].get(p_name);
+        if (fd)
+            fd->returns = true;
 #endif
     }
     static void addfunc_span(bool p_const, VariantType p_type, VariantType p_return, bool p_has_return, const StringName &p_name, VariantFunc p_func, const
         std::initializer_list<Variant> p_defaultarg, std::initializer_list<const Arg> p_args) {
         FuncData funcdata(p_const,p_return,p_has_return,p_func,p_defaultarg,p_args);
-        type_funcs[(int)p_type].functions[p_name] = funcdata;
+        type_funcs[(int)p_type].add(p_name, funcdata);
     }
     static void addfunc_span(Span<const VariantFuncDef> funcs) {
         for(const VariantFuncDef &fdef : funcs) {
-            type_funcs[(int)fdef.type].functions[fdef.method] = fdef.func_def;
+            type_funcs[(int)fdef.type].add(fdef.method, fdef.func_def);
         }
     }
 
@@ -233,7 +343,7 @@ struct _VariantCall {
                 break;
         }
         funcdata.arg_count = idx;
-        type_funcs[(int)p_type].functions[p_name] = funcdata;
+        type_funcs[(int)p_type].add(p_name, funcdata);
     }
 
 #define VCALL_LOCALMEM0(m_type, m_method) \
@@ -1273,7 +1383,7 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 #ifdef DEBUG_ENABLED
         if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
             //only if debugging!
-            if (!ObjectDB::instance_validate(obj)) {
+            if (!is_valid_object()) {
                 r_error.error = CallError::CALL_ERROR_INSTANCE_IS_NULL;
                 return;
             }
@@ -1288,15 +1398,14 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 
         r_error.error = Variant::CallError::CALL_OK;
 
-        auto E = _VariantCall::type_funcs[(int)type].functions.find(p_method);
+        _VariantCall::FuncData *funcdata = _VariantCall::type_funcs[(int)type].get(p_method);
 #ifdef DEBUG_ENABLED
-        if (E==_VariantCall::type_funcs[(int)type].functions.end()) {
+        if (!funcdata) {
             r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
             return;
         }
 #endif
-        _VariantCall::FuncData &funcdata = E->second;
-        funcdata.call(ret, *this, p_args, p_argcount, r_error);
+        funcdata->call(ret, *this, p_args, p_argcount, r_error);
     }
 
     if (r_error.error == Variant::CallError::CALL_OK && r_ret)
@@ -1449,7 +1558,7 @@ bool Variant::has_method(const StringName &p_method) const {
             return false;
 #ifdef DEBUG_ENABLED
         if (ScriptDebugger::get_singleton()) {
-            if (ObjectDB::instance_validate(obj)) {
+            if (is_valid_object()) {
 #endif
                 return obj->has_method(p_method);
 #ifdef DEBUG_ENABLED
@@ -1459,77 +1568,126 @@ bool Variant::has_method(const StringName &p_method) const {
     }
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)type];
-    return tf.functions.contains(p_method);
+    return tf.find(p_method) >= 0;
 }
 
 Span<const VariantType> Variant::get_method_argument_types(VariantType p_type, const StringName &p_method) {
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
 
-    auto E = tf.functions.find(p_method);
-    if (E==tf.functions.end())
+    int idx = tf.find(p_method);
+    if (idx < 0)
         return {};
+    const _VariantCall::FuncData &fd = tf.functions[idx];
 
-    return E->second.arg_types;
+    return Span<const VariantType>(fd.arg_types, ptrdiff_t(fd.arg_count));
+}
+
+const Variant::ValidatedBuiltinMethod *Variant::get_validated_builtin_method(VariantType p_type, const StringName &p_method) {
+
+    const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
+
+    int idx = tf.find(p_method);
+    if (idx < 0)
+        return nullptr;
+    const _VariantCall::FuncData &fd = tf.functions[idx];
+
+    // the method tables are filled once on startup, so the entry outlives any caller.
+    return reinterpret_cast<const ValidatedBuiltinMethod *>(&fd);
+}
+
+bool Variant::call_validated_builtin_method(const ValidatedBuiltinMethod *p_method, Variant &p_self, const Variant **p_args, int p_argcount, Variant *r_ret) {
+
+    const _VariantCall::FuncData &funcdata = *reinterpret_cast<const _VariantCall::FuncData *>(p_method);
+
+    // static typing only says what the compiler expected, untyped values and nulls can still show up here.
+    if (p_argcount > funcdata.arg_count || p_argcount < funcdata.arg_count - funcdata.def_count)
+        return false;
+    for (int i = 0; i < p_argcount; i++) {
+        if (funcdata.arg_types[i] != VariantType::NIL && funcdata.arg_types[i] != p_args[i]->get_type())
+            return false;
+    }
+
+    Variant ret;
+
+    if (p_argcount < funcdata.arg_count) {
+        const Variant *newargs[VARIANT_ARG_MAX];
+        for (int i = 0; i < p_argcount; i++)
+            newargs[i] = p_args[i];
+        int first_default_arg = funcdata.arg_count - funcdata.def_count;
+        for (int i = p_argcount; i < funcdata.arg_count; i++)
+            newargs[i] = &funcdata.default_args[i - first_default_arg];
+        funcdata.func(ret, p_self, newargs);
+    } else {
+        funcdata.func(ret, p_self, p_args);
+    }
+
+    if (r_ret)
+        *r_ret = eastl::move(ret);
+    return true;
 }
 
 bool Variant::is_method_const(VariantType p_type, const StringName &p_method) {
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
 
-    auto E = tf.functions.find(p_method);
-    if (E==tf.functions.end())
+    int idx = tf.find(p_method);
+    if (idx < 0)
         return false;
+    const _VariantCall::FuncData &fd = tf.functions[idx];
 
-    return E->second._const;
+    return fd._const;
 }
 
 Span<const se_string_view> Variant::get_method_argument_names(VariantType p_type, const StringName &p_method) {
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
 
-    auto E = tf.functions.find(p_method);
-    if (E==tf.functions.end())
+    int idx = tf.find(p_method);
+    if (idx < 0)
         return {};
+    const _VariantCall::FuncData &fd = tf.functions[idx];
 
-    return Span<const se_string_view>(E->second.arg_names, ptrdiff_t(E->second.arg_count));
+    return Span<const se_string_view>(fd.arg_names, ptrdiff_t(fd.arg_count));
 }
 
 VariantType Variant::get_method_return_type(VariantType p_type, const StringName &p_method, bool *r_has_return) {
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
 
-    auto E = tf.functions.find(p_method);
-    if (E==tf.functions.end())
+    int idx = tf.find(p_method);
+    if (idx < 0)
         return VariantType::NIL;
+    const _VariantCall::FuncData &fd = tf.functions[idx];
 
     if (r_has_return)
-        *r_has_return = E->second.returns;
+        *r_has_return = fd.returns;
 
-    return E->second.return_type;
+    return fd.return_type;
 }
 static const Vector<Variant> s_empty;
 
 Span<const Variant> Variant::get_method_default_arguments(VariantType p_type, const StringName &p_method) {
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)p_type];
 
-    auto E = tf.functions.find(p_method);
-    if (E==tf.functions.end())
+    int idx = tf.find(p_method);
+    if (idx < 0)
         return {};
+    const _VariantCall::FuncData &fd = tf.functions[idx];
 
-    return E->second.default_args;
+    return Span<const Variant>(fd.default_args, ptrdiff_t(fd.def_count));
 }
 
 void Variant::get_method_list(Vector<MethodInfo> *p_list) const {
 
     const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[(int)type];
 
-    for (const eastl::pair<const StringName,_VariantCall::FuncData> &E : tf.functions) {
+    for (size_t idx = 0; idx < tf.functions.size(); idx++) {
 
-        const _VariantCall::FuncData &fd = E.second;
+        const _VariantCall::FuncData &fd = tf.functions[idx];
 
         MethodInfo mi;
-        mi.name = E.first;
+        mi.name = tf.names[idx];
 
         if (fd._const) {
             mi.flags |= METHOD_FLAG_CONST;
@@ -2215,6 +2373,10 @@ void register_variant_methods() {
     _VariantCall::add_variant_constant(VariantType::PLANE, "PLANE_XY", Plane(Vector3(0, 0, 1), 0));
 
     _VariantCall::add_variant_constant(VariantType::QUAT, "IDENTITY", Quat(0, 0, 0, 1));
+
+    for (int i = 0; i < int(VariantType::VARIANT_MAX); i++) {
+        _VariantCall::type_funcs[i].freeze();
+    }
 }
 
 void unregister_variant_methods() {
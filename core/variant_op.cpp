@@ -1582,7 +1582,7 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 #ifdef DEBUG_ENABLED
             if (!_get_obj().obj) {
                 break;
-            } else if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !ObjectDB::instance_validate(_get_obj().obj)) {
+            } else if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !is_valid_object()) {
                 break;
             }
 
@@ -1751,7 +1751,7 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
                 return "Instance base is null.";
             } else {
 
-                if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !ObjectDB::instance_validate(_get_obj().obj)) {
+                if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !is_valid_object()) {
                     if (r_valid)
                         *r_valid = false;
                     return "Attempted use of stray pointer object.";
@@ -2241,7 +2241,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 #ifdef DEBUG_ENABLED
                 if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
 
-                    if (!ObjectDB::instance_validate(obj)) {
+                    if (!is_valid_object()) {
                         WARN_PRINT("Attempted use of stray pointer object.");
                         valid = false;
                         return;
@@ -2615,7 +2615,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 #ifdef DEBUG_ENABLED
                 if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
                     //only if debugging!
-                    if (!ObjectDB::instance_validate(obj)) {
+                    if (!is_valid_object()) {
                         valid = false;
                         return "Attempted get on stray pointer.";
                     }
@@ -2680,7 +2680,7 @@ bool Variant::in(const Variant &p_index, bool *r_valid) const {
 #ifdef DEBUG_ENABLED
                 if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
                     //only if debugging!
-                    if (!ObjectDB::instance_validate(obj)) {
+                    if (!is_valid_object()) {
                         if (r_valid) {
                             *r_valid = false;
                         }
@@ -2952,7 +2952,7 @@ void Variant::get_property_list(Vector<PropertyInfo> *p_list) const {
 #ifdef DEBUG_ENABLED
                 if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null()) {
                     //only if debugging!
-                    if (!ObjectDB::instance_validate(obj)) {
+                    if (!is_valid_object()) {
                         WARN_PRINT("Attempted get_property list on stray pointer.");
                         return;
                     }
@@ -3033,7 +3033,7 @@ bool Variant::iter_init(Variant &r_iter, bool &valid) const {
                 return false;
             }
 
-            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !ObjectDB::instance_validate(_get_obj().obj)) {
+            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !is_valid_object()) {
                 valid = false;
                 return false;
             }
@@ -3201,7 +3201,7 @@ bool Variant::iter_next(Variant &r_iter, bool &valid) const {
                 return false;
             }
 
-            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !ObjectDB::instance_validate(_get_obj().obj)) {
+            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !is_valid_object()) {
                 valid = false;
                 return false;
             }
@@ -3360,7 +3360,7 @@ Variant Variant::iter_get(const Variant &r_iter, bool &r_valid) const {
                 return Variant();
             }
 
-            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !ObjectDB::instance_validate(_get_obj().obj)) {
+            if (ScriptDebugger::get_singleton() && _get_obj().ref.is_null() && !is_valid_object()) {
                 r_valid = false;
                 return Variant();
             }
@@ -3865,6 +3865,269 @@ void Variant::interpolate(const Variant &a, const Variant &b, float c, Variant &
     }
 }
 
+struct _VariantValidated {
+
+    template <class T>
+    static _FORCE_INLINE_ const T &get(const Variant &p_v) {
+        return *reinterpret_cast<const T *>(p_v._data._mem);
+    }
+    template <class T>
+    static _FORCE_INLINE_ T &get_mut(Variant &p_v) {
+        return *reinterpret_cast<T *>(p_v._data._mem);
+    }
+    template <class T>
+    static _FORCE_INLINE_ void set(Variant &r_v, VariantType p_type, T p_value) {
+        // only types stored inline go through here, so overwriting in place is enough
+        if (r_v.type == p_type) {
+            *reinterpret_cast<T *>(r_v._data._mem) = p_value;
+        } else {
+            r_v = Variant(p_value);
+        }
+    }
+
+    struct OpAdd { template <class A, class B> static auto apply(const A &a, const B &b) { return a + b; } };
+    struct OpSub { template <class A, class B> static auto apply(const A &a, const B &b) { return a - b; } };
+    struct OpMul { template <class A, class B> static auto apply(const A &a, const B &b) { return a * b; } };
+    struct OpDiv { template <class A, class B> static auto apply(const A &a, const B &b) { return a / b; } };
+    struct OpEq { template <class A, class B> static bool apply(const A &a, const B &b) { return a == b; } };
+    struct OpNe { template <class A, class B> static bool apply(const A &a, const B &b) { return a != b; } };
+    struct OpLt { template <class A, class B> static bool apply(const A &a, const B &b) { return a < b; } };
+    struct OpLe { template <class A, class B> static bool apply(const A &a, const B &b) { return a <= b; } };
+    struct OpGt { template <class A, class B> static bool apply(const A &a, const B &b) { return a > b; } };
+    struct OpGe { template <class A, class B> static bool apply(const A &a, const B &b) { return a >= b; } };
+    struct OpBitAnd { template <class A, class B> static auto apply(const A &a, const B &b) { return a & b; } };
+    struct OpBitOr { template <class A, class B> static auto apply(const A &a, const B &b) { return a | b; } };
+    struct OpBitXor { template <class A, class B> static auto apply(const A &a, const B &b) { return a ^ b; } };
+    // unary operators are compiled with the operand repeated, the second one is ignored
+    struct OpNeg { template <class A, class B> static auto apply(const A &a, const B &) { return -a; } };
+    struct OpPos { template <class A, class B> static auto apply(const A &a, const B &) { return a; } };
+    struct OpBitNeg { template <class A, class B> static auto apply(const A &a, const B &) { return ~a; } };
+    struct OpNot { template <class A, class B> static bool apply(const A &a, const B &) { return !a; } };
+
+    template <class OP, class A, class B, class R, VariantType RT>
+    static void evaluate(const Variant &p_a, const Variant &p_b, Variant &r_ret) {
+        set<R>(r_ret, RT, R(OP::apply(get<A>(p_a), get<B>(p_b))));
+    }
+
+    struct OperatorEntry {
+        Variant::Operator op;
+        VariantType type_a;
+        VariantType type_b;
+        Variant::ValidatedOperatorEvaluator evaluator;
+    };
+
+    template <class T, class M, VariantType MT, M T::*member>
+    static void get_member(const Variant &p_base, Variant &r_value) {
+        set<M>(r_value, MT, get<T>(p_base).*member);
+    }
+    template <class T, class M, M T::*member>
+    static void set_member(Variant &p_base, const Variant &p_value) {
+        get_mut<T>(p_base).*member = get<M>(p_value);
+    }
+    // members stored as real_t take REAL (double) values
+    template <class T, real_t T::*member>
+    static void get_real_member(const Variant &p_base, Variant &r_value) {
+        set<double>(r_value, VariantType::REAL, get<T>(p_base).*member);
+    }
+    template <class T, real_t T::*member>
+    static void set_real_member(Variant &p_base, const Variant &p_value) {
+        get_mut<T>(p_base).*member = get<double>(p_value);
+    }
+    static void get_color_component(const Variant &p_base, Variant &r_value, int p_idx) {
+        set<double>(r_value, VariantType::REAL, get<Color>(p_base).components[p_idx]);
+    }
+    template <int IDX>
+    static void get_color(const Variant &p_base, Variant &r_value) { get_color_component(p_base, r_value, IDX); }
+    template <int IDX>
+    static void set_color(Variant &p_base, const Variant &p_value) { get_mut<Color>(p_base).components[IDX] = get<double>(p_value); }
+    static void get_transform_origin(const Variant &p_base, Variant &r_value) {
+        set<Vector3>(r_value, VariantType::VECTOR3, p_base._data._transform->origin);
+    }
+    static void set_transform_origin(Variant &p_base, const Variant &p_value) {
+        p_base._data._transform->origin = get<Vector3>(p_value);
+    }
+    static void get_transform2d_origin(const Variant &p_base, Variant &r_value) {
+        set<Vector2>(r_value, VariantType::VECTOR2, p_base._data._transform2d->elements[2]);
+    }
+    static void set_transform2d_origin(Variant &p_base, const Variant &p_value) {
+        p_base._data._transform2d->elements[2] = get<Vector2>(p_value);
+    }
+};
+
+#define VALIDATED_OP(m_op, m_fn, m_a, m_ta, m_b, m_tb, m_r, m_tr) \
+    { Variant::m_op, VariantType::m_ta, VariantType::m_tb, &_VariantValidated::evaluate<_VariantValidated::m_fn, m_a, m_b, m_r, VariantType::m_tr> }
+
+#define VALIDATED_OP_CMP(m_a, m_ta, m_b, m_tb)                      \
+    VALIDATED_OP(OP_EQUAL, OpEq, m_a, m_ta, m_b, m_tb, bool, BOOL),         \
+    VALIDATED_OP(OP_NOT_EQUAL, OpNe, m_a, m_ta, m_b, m_tb, bool, BOOL),     \
+    VALIDATED_OP(OP_LESS, OpLt, m_a, m_ta, m_b, m_tb, bool, BOOL),          \
+    VALIDATED_OP(OP_LESS_EQUAL, OpLe, m_a, m_ta, m_b, m_tb, bool, BOOL),    \
+    VALIDATED_OP(OP_GREATER, OpGt, m_a, m_ta, m_b, m_tb, bool, BOOL),       \
+    VALIDATED_OP(OP_GREATER_EQUAL, OpGe, m_a, m_ta, m_b, m_tb, bool, BOOL)
+
+#define VALIDATED_OP_ARITH(m_a, m_ta, m_b, m_tb, m_r, m_tr)               \
+    VALIDATED_OP(OP_ADD, OpAdd, m_a, m_ta, m_b, m_tb, m_r, m_tr),          \
+    VALIDATED_OP(OP_SUBTRACT, OpSub, m_a, m_ta, m_b, m_tb, m_r, m_tr),     \
+    VALIDATED_OP(OP_MULTIPLY, OpMul, m_a, m_ta, m_b, m_tb, m_r, m_tr)
+
+// Division is only validated where the generic path can't fail: debug builds report float division by zero as an
+// error, and integer division by zero is never allowed through.
+#ifdef DEBUG_ENABLED
+#define VALIDATED_OP_FLOAT_DIV(m_a, m_ta, m_b, m_tb, m_r, m_tr)
+#else
+#define VALIDATED_OP_FLOAT_DIV(m_a, m_ta, m_b, m_tb, m_r, m_tr) VALIDATED_OP(OP_DIVIDE, OpDiv, m_a, m_ta, m_b, m_tb, m_r, m_tr),
+#endif
+
+static const _VariantValidated::OperatorEntry _validated_operators[] = {
+    VALIDATED_OP_CMP(bool, BOOL, bool, BOOL),
+    VALIDATED_OP(OP_NOT, OpNot, bool, BOOL, bool, BOOL, bool, BOOL),
+
+    VALIDATED_OP_CMP(int64_t, INT, int64_t, INT),
+    VALIDATED_OP_CMP(int64_t, INT, double, REAL),
+    VALIDATED_OP_CMP(double, REAL, int64_t, INT),
+    VALIDATED_OP_CMP(double, REAL, double, REAL),
+
+    VALIDATED_OP_ARITH(int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP_ARITH(int64_t, INT, double, REAL, double, REAL),
+    VALIDATED_OP_ARITH(double, REAL, int64_t, INT, double, REAL),
+    VALIDATED_OP_ARITH(double, REAL, double, REAL, double, REAL),
+    VALIDATED_OP_FLOAT_DIV(int64_t, INT, double, REAL, double, REAL)
+    VALIDATED_OP_FLOAT_DIV(double, REAL, int64_t, INT, double, REAL)
+    VALIDATED_OP_FLOAT_DIV(double, REAL, double, REAL, double, REAL)
+
+    VALIDATED_OP(OP_NEGATE, OpNeg, int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP(OP_POSITIVE, OpPos, int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP(OP_NEGATE, OpNeg, double, REAL, double, REAL, double, REAL),
+    VALIDATED_OP(OP_POSITIVE, OpPos, double, REAL, double, REAL, double, REAL),
+
+    VALIDATED_OP(OP_BIT_AND, OpBitAnd, int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP(OP_BIT_OR, OpBitOr, int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP(OP_BIT_XOR, OpBitXor, int64_t, INT, int64_t, INT, int64_t, INT),
+    VALIDATED_OP(OP_BIT_NEGATE, OpBitNeg, int64_t, INT, int64_t, INT, int64_t, INT),
+
+    VALIDATED_OP(OP_ADD, OpAdd, Vector2, VECTOR2, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_SUBTRACT, OpSub, Vector2, VECTOR2, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector2, VECTOR2, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_DIVIDE, OpDiv, Vector2, VECTOR2, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector2, VECTOR2, double, REAL, Vector2, VECTOR2),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector2, VECTOR2, int64_t, INT, Vector2, VECTOR2),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, double, REAL, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, int64_t, INT, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP(OP_EQUAL, OpEq, Vector2, VECTOR2, Vector2, VECTOR2, bool, BOOL),
+    VALIDATED_OP(OP_NOT_EQUAL, OpNe, Vector2, VECTOR2, Vector2, VECTOR2, bool, BOOL),
+    VALIDATED_OP(OP_NEGATE, OpNeg, Vector2, VECTOR2, Vector2, VECTOR2, Vector2, VECTOR2),
+    VALIDATED_OP_FLOAT_DIV(Vector2, VECTOR2, double, REAL, Vector2, VECTOR2)
+
+    VALIDATED_OP(OP_ADD, OpAdd, Vector3, VECTOR3, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_SUBTRACT, OpSub, Vector3, VECTOR3, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector3, VECTOR3, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_DIVIDE, OpDiv, Vector3, VECTOR3, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector3, VECTOR3, double, REAL, Vector3, VECTOR3),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Vector3, VECTOR3, int64_t, INT, Vector3, VECTOR3),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, double, REAL, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, int64_t, INT, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP(OP_EQUAL, OpEq, Vector3, VECTOR3, Vector3, VECTOR3, bool, BOOL),
+    VALIDATED_OP(OP_NOT_EQUAL, OpNe, Vector3, VECTOR3, Vector3, VECTOR3, bool, BOOL),
+    VALIDATED_OP(OP_NEGATE, OpNeg, Vector3, VECTOR3, Vector3, VECTOR3, Vector3, VECTOR3),
+    VALIDATED_OP_FLOAT_DIV(Vector3, VECTOR3, double, REAL, Vector3, VECTOR3)
+
+    VALIDATED_OP(OP_ADD, OpAdd, Color, COLOR, Color, COLOR, Color, COLOR),
+    VALIDATED_OP(OP_SUBTRACT, OpSub, Color, COLOR, Color, COLOR, Color, COLOR),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Color, COLOR, Color, COLOR, Color, COLOR),
+    VALIDATED_OP(OP_MULTIPLY, OpMul, Color, COLOR, double, REAL, Color, COLOR),
+};
+
+#undef VALIDATED_OP_FLOAT_DIV
+#undef VALIDATED_OP_ARITH
+#undef VALIDATED_OP_CMP
+#undef VALIDATED_OP
+
+Variant::ValidatedOperatorEvaluator Variant::get_validated_operator_evaluator(Operator p_op, VariantType p_type_a, VariantType p_type_b) {
+
+    for (const _VariantValidated::OperatorEntry &E : _validated_operators) {
+        if (E.op == p_op && E.type_a == p_type_a && E.type_b == p_type_b)
+            return E.evaluator;
+    }
+    return nullptr;
+}
+
+bool Variant::get_validated_member(VariantType p_type, const StringName &p_name, ValidatedMember &r_member) {
+
+    const CoreStringNames *names = CoreStringNames::singleton;
+
+#define VALIDATED_REAL_MEMBER(m_class, m_member, m_field)                                             \
+    if (p_name == names->m_member) {                                                                  \
+        r_member = { &_VariantValidated::get_real_member<m_class, &m_class::m_field>,                  \
+            &_VariantValidated::set_real_member<m_class, &m_class::m_field>, VariantType::REAL };       \
+        return true;                                                                                  \
+    }
+#define VALIDATED_MEMBER(m_class, m_member, m_field, m_type, m_vtype)                                         \
+    if (p_name == names->m_member) {                                                                          \
+        r_member = { &_VariantValidated::get_member<m_class, m_type, VariantType::m_vtype, &m_class::m_field>,         \
+            &_VariantValidated::set_member<m_class, m_type, &m_class::m_field>, VariantType::m_vtype };        \
+        return true;                                                                                          \
+    }
+
+    switch (p_type) {
+        case VariantType::VECTOR2: {
+            VALIDATED_REAL_MEMBER(Vector2, x, x)
+            VALIDATED_REAL_MEMBER(Vector2, y, y)
+        } break;
+        case VariantType::VECTOR3: {
+            VALIDATED_REAL_MEMBER(Vector3, x, x)
+            VALIDATED_REAL_MEMBER(Vector3, y, y)
+            VALIDATED_REAL_MEMBER(Vector3, z, z)
+        } break;
+        case VariantType::QUAT: {
+            VALIDATED_REAL_MEMBER(Quat, x, x)
+            VALIDATED_REAL_MEMBER(Quat, y, y)
+            VALIDATED_REAL_MEMBER(Quat, z, z)
+            VALIDATED_REAL_MEMBER(Quat, w, w)
+        } break;
+        case VariantType::RECT2: {
+            VALIDATED_MEMBER(Rect2, position, position, Vector2, VECTOR2)
+            VALIDATED_MEMBER(Rect2, size, size, Vector2, VECTOR2)
+        } break;
+        case VariantType::COLOR: {
+            if (p_name == names->r) {
+                r_member = { &_VariantValidated::get_color<0>, &_VariantValidated::set_color<0>, VariantType::REAL };
+                return true;
+            }
+            if (p_name == names->g) {
+                r_member = { &_VariantValidated::get_color<1>, &_VariantValidated::set_color<1>, VariantType::REAL };
+                return true;
+            }
+            if (p_name == names->b) {
+                r_member = { &_VariantValidated::get_color<2>, &_VariantValidated::set_color<2>, VariantType::REAL };
+                return true;
+            }
+            if (p_name == names->a) {
+                r_member = { &_VariantValidated::get_color<3>, &_VariantValidated::set_color<3>, VariantType::REAL };
+                return true;
+            }
+        } break;
+        case VariantType::TRANSFORM2D: {
+            if (p_name == names->origin) {
+                r_member = { &_VariantValidated::get_transform2d_origin, &_VariantValidated::set_transform2d_origin, VariantType::VECTOR2 };
+                return true;
+            }
+        } break;
+        case VariantType::TRANSFORM: {
+            if (p_name == names->origin) {
+                r_member = { &_VariantValidated::get_transform_origin, &_VariantValidated::set_transform_origin, VariantType::VECTOR3 };
+                return true;
+            }
+        } break;
+        default: {
+        }
+    }
+
+#undef VALIDATED_MEMBER
+#undef VALIDATED_REAL_MEMBER
+
+    return false;
+}
+
 static const char *_op_names[int8_t(Variant::OP_MAX)] = {
     "==",
     "!=",
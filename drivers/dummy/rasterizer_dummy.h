@@ -122,8 +122,8 @@ class RasterizerStorageDummy : public RasterizerStorage {
 public:
     /* TEXTURE API */
     struct DummyTexture : public RID_Data {
-        int width;
-        int height;
+        int width = 0;
+        int height = 0;
         uint32_t flags;
         Image::Format format;
         Ref<Image> image;
@@ -202,7 +202,7 @@ public:
     }
     uint32_t texture_get_flags(RID p_texture) const {
         DummyTexture *t = texture_owner.getornull(p_texture);
-        ERR_FAIL_COND_V(!t, 0)
+        ERR_FAIL_COND_V(!t, 0);
         return t->flags;
     }
     Image::Format texture_get_format(RID p_texture) const {
@@ -213,8 +213,16 @@ public:
 
     VisualServer::TextureType texture_get_type(RID p_texture) const { return VS::TEXTURE_TYPE_2D; }
     uint32_t texture_get_texid(RID p_texture) const { return 0; }
-    uint32_t texture_get_width(RID p_texture) const { return 0; }
-    uint32_t texture_get_height(RID p_texture) const { return 0; }
+    uint32_t texture_get_width(RID p_texture) const {
+        DummyTexture *t = texture_owner.getornull(p_texture);
+        ERR_FAIL_COND_V(!t, 0);
+        return t->width;
+    }
+    uint32_t texture_get_height(RID p_texture) const {
+        DummyTexture *t = texture_owner.getornull(p_texture);
+        ERR_FAIL_COND_V(!t, 0);
+        return t->height;
+    }
     uint32_t texture_get_depth(RID p_texture) const { return 0; }
     void texture_set_size_override(RID p_texture, int p_width, int p_height, int p_depth_3d) {}
     void texture_bind(RID p_texture, uint32_t p_texture_no) {}
@@ -387,6 +387,7 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
     glDrawElements(GL_TRIANGLES, p_index_count, GL_UNSIGNED_INT, nullptr);
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 
     if (p_bones && p_weights) {
         //not used so often, so disable when used
@@ -441,6 +442,7 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
     glDrawArrays(p_primitive, 0, p_vertex_count);
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -514,6 +516,7 @@ void RasterizerCanvasGLES3::_draw_generic_indices(GLuint p_primitive, const int
     glDrawElements(p_primitive, p_index_count, GL_UNSIGNED_INT, 0);
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -580,6 +583,7 @@ void RasterizerCanvasGLES3::_draw_gui_primitive(int p_points, const Vector2 *p_v
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 }
 
 void _render_line(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::CommandLine *line)
@@ -749,6 +753,7 @@ void RasterizerCanvasGLES3::_render_rect(RasterizerCanvas::Item::CommandRect *re
     }
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 }
 
 void RasterizerCanvasGLES3::_render_ninepatch(RasterizerCanvas::Item::CommandNinePatch *np)
@@ -789,6 +794,7 @@ void RasterizerCanvasGLES3::_render_ninepatch(RasterizerCanvas::Item::CommandNin
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 
     storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 }
 
 void _render_multimesh(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::CommandMultiMesh *mmesh)
@@ -896,6 +902,7 @@ void _render_multimesh(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::Comma
         } else {
             glDrawArraysInstanced(gl_primitive[s->primitive], 0, s->array_len, amount);
         }
+        self->storage->info.render.draw_call_count++;
 
         glBindVertexArray(0);
     }
@@ -975,6 +982,7 @@ void _render_particles(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::Comma
         glVertexAttribDivisor(12, 1);
 
         glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, amount);
+        self->storage->info.render.draw_call_count++;
     } else {
         //split
         int split = int(Math::ceil(particles->phase * particles->amount));
@@ -997,6 +1005,7 @@ void _render_particles(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::Comma
             glVertexAttribDivisor(12, 1);
 
             glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, amount - split);
+            self->storage->info.render.draw_call_count++;
         }
 
         if (split > 0) {
@@ -1017,6 +1026,7 @@ void _render_particles(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::Comma
             glVertexAttribDivisor(12, 1);
 
             glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, split);
+            self->storage->info.render.draw_call_count++;
         }
     }
 
@@ -1029,190 +1039,256 @@ void _render_particles(RasterizerCanvasGLES3 *self,RasterizerCanvas::Item::Comma
     self->_set_texture_rect_mode(false);
 }
 
-void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip) {
+void RasterizerCanvasGLES3::_canvas_item_render_command(Item::Command *c, Item *current_clip, bool &reclip) {
 
-    int cc = p_item->commands.size();
-    Item::Command **commands = p_item->commands.data();
+    switch (c->type) {
+        case Item::Command::TYPE_LINE: {
 
-    for (int i = 0; i < cc; i++) {
+            _render_line(this,static_cast<Item::CommandLine *>(c));
 
-        Item::Command *c = commands[i];
+        } break;
+        case Item::Command::TYPE_POLYLINE: {
 
-        switch (c->type) {
-            case Item::Command::TYPE_LINE: {
+            _render_poly_line(this,static_cast<Item::CommandPolyLine *>(c));
 
-                _render_line(this,static_cast<Item::CommandLine *>(c));
+        } break;
+        case Item::Command::TYPE_RECT: {
 
-            } break;
-            case Item::Command::TYPE_POLYLINE: {
+            _render_rect(static_cast<Item::CommandRect *>(c));
 
-                _render_poly_line(this,static_cast<Item::CommandPolyLine *>(c));
+        } break;
 
-            } break;
-            case Item::Command::TYPE_RECT: {
+        case Item::Command::TYPE_NINEPATCH: {
 
-                _render_rect(static_cast<Item::CommandRect *>(c));
+            _render_ninepatch(static_cast<Item::CommandNinePatch *>(c));
+        } break;
 
-            } break;
+        case Item::Command::TYPE_PRIMITIVE: {
 
-            case Item::Command::TYPE_NINEPATCH: {
+            Item::CommandPrimitive *primitive = static_cast<Item::CommandPrimitive *>(c);
+            _set_texture_rect_mode(false);
 
-                _render_ninepatch(static_cast<Item::CommandNinePatch *>(c));
-            } break;
+            ERR_FAIL_COND(primitive->points.empty());
 
-            case Item::Command::TYPE_PRIMITIVE: {
+            RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(primitive->texture, primitive->normal_map);
 
-                Item::CommandPrimitive *primitive = static_cast<Item::CommandPrimitive *>(c);
-                _set_texture_rect_mode(false);
+            if (texture) {
+                Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
+                state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+            }
+            if (primitive->colors.size() == 1 && primitive->points.size() > 1) {
 
-                ERR_CONTINUE(primitive->points.empty());
+                Color col = primitive->colors[0];
+                glVertexAttrib4f(VS::ARRAY_COLOR, col.r, col.g, col.b, col.a);
 
-                RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(primitive->texture, primitive->normal_map);
+            } else if (primitive->colors.empty()) {
+                glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
+            }
 
-                if (texture) {
-                    Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
-                    state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
-                }
-                if (primitive->colors.size() == 1 && primitive->points.size() > 1) {
+            _draw_gui_primitive(primitive->points.size(), primitive->points.data(), primitive->colors.read().ptr(), primitive->uvs.read().ptr());
+
+        } break;
+        case Item::Command::TYPE_POLYGON: {
 
-                    Color col = primitive->colors[0];
-                    glVertexAttrib4f(VS::ARRAY_COLOR, col.r, col.g, col.b, col.a);
+            Item::CommandPolygon *polygon = static_cast<Item::CommandPolygon *>(c);
+            _set_texture_rect_mode(false);
 
-                } else if (primitive->colors.empty()) {
-                    glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
+            RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(polygon->texture, polygon->normal_map);
+
+            if (texture) {
+                Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
+                state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+            }
+
+            _draw_polygon(polygon->indices.data(), polygon->count, polygon->points.size(), polygon->points.data(), polygon->uvs.read().ptr(), polygon->colors.read().ptr(), polygon->colors.size() == 1, polygon->bones.read().ptr(), polygon->weights.read().ptr());
+#ifdef GLES_OVER_GL
+            if (polygon->antialiased) {
+                glEnable(GL_LINE_SMOOTH);
+                if (polygon->antialiasing_use_indices) {
+                    _draw_generic_indices(GL_LINE_STRIP, polygon->indices.ptr(), polygon->count, polygon->points.size(), polygon->points.ptr(), polygon->uvs.ptr(), polygon->colors.ptr(), polygon->colors.size() == 1);
+                } else {
+                    _draw_generic(GL_LINE_LOOP, polygon->points.size(), polygon->points.ptr(), polygon->uvs.ptr(), polygon->colors.ptr(), polygon->colors.size() == 1);
                 }
+                glDisable(GL_LINE_SMOOTH);
+            }
+#endif
 
-                _draw_gui_primitive(primitive->points.size(), primitive->points.data(), primitive->colors.read().ptr(), primitive->uvs.read().ptr());
+        } break;
+        case Item::Command::TYPE_MESH: {
 
-            } break;
-            case Item::Command::TYPE_POLYGON: {
+            Item::CommandMesh *mesh = static_cast<Item::CommandMesh *>(c);
+            _set_texture_rect_mode(false);
 
-                Item::CommandPolygon *polygon = static_cast<Item::CommandPolygon *>(c);
-                _set_texture_rect_mode(false);
+            RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(mesh->texture, mesh->normal_map);
 
-                RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(polygon->texture, polygon->normal_map);
+            if (texture) {
+                Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
+                state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+            }
 
-                if (texture) {
-                    Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
-                    state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
-                }
+            state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform * mesh->transform);
 
-                _draw_polygon(polygon->indices.data(), polygon->count, polygon->points.size(), polygon->points.data(), polygon->uvs.read().ptr(), polygon->colors.read().ptr(), polygon->colors.size() == 1, polygon->bones.read().ptr(), polygon->weights.read().ptr());
-#ifdef GLES_OVER_GL
-                if (polygon->antialiased) {
-                    glEnable(GL_LINE_SMOOTH);
-                    if (polygon->antialiasing_use_indices) {
-                        _draw_generic_indices(GL_LINE_STRIP, polygon->indices.ptr(), polygon->count, polygon->points.size(), polygon->points.ptr(), polygon->uvs.ptr(), polygon->colors.ptr(), polygon->colors.size() == 1);
+            RasterizerStorageGLES3::Mesh *mesh_data = storage->mesh_owner.getornull(mesh->mesh);
+            if (mesh_data) {
+
+                for (int j = 0; j < mesh_data->surfaces.size(); j++) {
+                    RasterizerStorageGLES3::Surface *s = mesh_data->surfaces[j];
+                    // materials are ignored in 2D meshes, could be added but many things (ie, lighting mode, reading from screen, etc) would break as they are not meant be set up at this point of drawing
+                    glBindVertexArray(s->array_id);
+
+                    glVertexAttrib4f(VS::ARRAY_COLOR, mesh->modulate.r, mesh->modulate.g, mesh->modulate.b, mesh->modulate.a);
+
+                    if (s->index_array_len) {
+                        glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, nullptr);
                     } else {
-                        _draw_generic(GL_LINE_LOOP, polygon->points.size(), polygon->points.ptr(), polygon->uvs.ptr(), polygon->colors.ptr(), polygon->colors.size() == 1);
+                        glDrawArrays(gl_primitive[s->primitive], 0, s->array_len);
                     }
-                    glDisable(GL_LINE_SMOOTH);
+                    storage->info.render.draw_call_count++;
+
+                    glBindVertexArray(0);
                 }
-#endif
+            }
+            state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform);
 
-            } break;
-            case Item::Command::TYPE_MESH: {
+        } break;
+        case Item::Command::TYPE_MULTIMESH: {
 
-                Item::CommandMesh *mesh = static_cast<Item::CommandMesh *>(c);
-                _set_texture_rect_mode(false);
+            _render_multimesh(this,static_cast<Item::CommandMultiMesh *>(c));
 
-                RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(mesh->texture, mesh->normal_map);
+        } break;
+        case Item::Command::TYPE_PARTICLES: {
+            _render_particles(this,static_cast<Item::CommandParticles *>(c));
+        } break;
+        case Item::Command::TYPE_CIRCLE: {
 
-                if (texture) {
-                    Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
-                    state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
-                }
+            _set_texture_rect_mode(false);
 
-                state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform * mesh->transform);
+            Item::CommandCircle *circle = static_cast<Item::CommandCircle *>(c);
+            static const int numpoints = 32;
+            Vector2 points[numpoints + 1];
+            points[numpoints] = circle->pos;
+            int indices[numpoints * 3];
 
-                RasterizerStorageGLES3::Mesh *mesh_data = storage->mesh_owner.getornull(mesh->mesh);
-                if (mesh_data) {
+            for (int j = 0; j < numpoints; j++) {
 
-                    for (int j = 0; j < mesh_data->surfaces.size(); j++) {
-                        RasterizerStorageGLES3::Surface *s = mesh_data->surfaces[j];
-                        // materials are ignored in 2D meshes, could be added but many things (ie, lighting mode, reading from screen, etc) would break as they are not meant be set up at this point of drawing
-                        glBindVertexArray(s->array_id);
+                points[j] = circle->pos + Vector2(Math::sin(j * float(Math_PI) * 2.0f / numpoints), Math::cos(j * float(Math_PI) * 2.0f / numpoints)) * circle->radius;
+                indices[j * 3 + 0] = j;
+                indices[j * 3 + 1] = (j + 1) % numpoints;
+                indices[j * 3 + 2] = numpoints;
+            }
 
-                        glVertexAttrib4f(VS::ARRAY_COLOR, mesh->modulate.r, mesh->modulate.g, mesh->modulate.b, mesh->modulate.a);
+            _bind_canvas_texture(RID(), RID());
+            _draw_polygon(indices, numpoints * 3, numpoints + 1, points, nullptr, &circle->color, true, nullptr, nullptr);
 
-                        if (s->index_array_len) {
-                            glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, nullptr);
-                        } else {
-                            glDrawArrays(gl_primitive[s->primitive], 0, s->array_len);
-                        }
+            //_draw_polygon(numpoints*3,indices,points,nullptr,&circle->color,RID(),true);
+            //canvas_draw_circle(circle->indices.size(),circle->indices.ptr(),circle->points.ptr(),circle->uvs.ptr(),circle->colors.ptr(),circle->texture,circle->colors.size()==1);
+        } break;
+        case Item::Command::TYPE_TRANSFORM: {
 
-                        glBindVertexArray(0);
-                    }
-                }
-                state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform);
+            Item::CommandTransform *transform = static_cast<Item::CommandTransform *>(c);
+            state.extra_matrix = transform->xform;
+            state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX, state.extra_matrix);
 
-            } break;
-            case Item::Command::TYPE_MULTIMESH: {
+        } break;
+        case Item::Command::TYPE_CLIP_IGNORE: {
 
-                _render_multimesh(this,static_cast<Item::CommandMultiMesh *>(c));
+            Item::CommandClipIgnore *ci = static_cast<Item::CommandClipIgnore *>(c);
+            if (current_clip) {
 
-            } break;
-            case Item::Command::TYPE_PARTICLES: {
-                _render_particles(this,static_cast<Item::CommandParticles *>(c));
-            } break;
-            case Item::Command::TYPE_CIRCLE: {
+                if (ci->ignore != reclip) {
+                    if (ci->ignore) {
 
-                _set_texture_rect_mode(false);
+                        glDisable(GL_SCISSOR_TEST);
+                        reclip = true;
+                    } else {
 
-                Item::CommandCircle *circle = static_cast<Item::CommandCircle *>(c);
-                static const int numpoints = 32;
-                Vector2 points[numpoints + 1];
-                points[numpoints] = circle->pos;
-                int indices[numpoints * 3];
+                        glEnable(GL_SCISSOR_TEST);
+                        //glScissor(viewport.x+current_clip->final_clip_rect.pos.x,viewport.y+ (viewport.height-(current_clip->final_clip_rect.pos.y+current_clip->final_clip_rect.size.height)),
+                        //current_clip->final_clip_rect.size.width,current_clip->final_clip_rect.size.height);
+                        int y = storage->frame.current_rt->height - (current_clip->final_clip_rect.position.y + current_clip->final_clip_rect.size.y);
+                        if (storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_VFLIP])
+                            y = current_clip->final_clip_rect.position.y;
 
-                for (int j = 0; j < numpoints; j++) {
+                        glScissor(current_clip->final_clip_rect.position.x, y, current_clip->final_clip_rect.size.x, current_clip->final_clip_rect.size.y);
 
-                    points[j] = circle->pos + Vector2(Math::sin(j * float(Math_PI) * 2.0f / numpoints), Math::cos(j * float(Math_PI) * 2.0f / numpoints)) * circle->radius;
-                    indices[j * 3 + 0] = j;
-                    indices[j * 3 + 1] = (j + 1) % numpoints;
-                    indices[j * 3 + 2] = numpoints;
+                        reclip = false;
+                    }
                 }
+            }
 
-                _bind_canvas_texture(RID(), RID());
-                _draw_polygon(indices, numpoints * 3, numpoints + 1, points, nullptr, &circle->color, true, nullptr, nullptr);
+        } break;
+    }
+}
 
-                //_draw_polygon(numpoints*3,indices,points,nullptr,&circle->color,RID(),true);
-                //canvas_draw_circle(circle->indices.size(),circle->indices.ptr(),circle->points.ptr(),circle->uvs.ptr(),circle->colors.ptr(),circle->texture,circle->colors.size()==1);
-            } break;
-            case Item::Command::TYPE_TRANSFORM: {
+void RasterizerCanvasGLES3::_render_batch(const RasterizerCanvasBatcher::Batch &p_batch) {
 
-                Item::CommandTransform *transform = static_cast<Item::CommandTransform *>(c);
-                state.extra_matrix = transform->xform;
-                state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX, state.extra_matrix);
+    _set_texture_rect_mode(false);
 
-            } break;
-            case Item::Command::TYPE_CLIP_IGNORE: {
+    RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(p_batch.texture, RID());
 
-                Item::CommandClipIgnore *ci = static_cast<Item::CommandClipIgnore *>(c);
-                if (current_clip) {
+    if (texture) {
+        Size2 texpixel_size(1.0f / texture->width, 1.0f / texture->height);
+        state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+    }
 
-                    if (ci->ignore != reclip) {
-                        if (ci->ignore) {
+    using Vertex = RasterizerCanvasBatcher::Vertex;
+    uint32_t buffer_ofs = p_batch.first_vertex * sizeof(Vertex);
 
-                            glDisable(GL_SCISSOR_TEST);
-                            reclip = true;
-                        } else {
+    glBindVertexArray(data.batch_array);
+    glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+    glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), CAST_INT_TO_UCHAR_PTR(buffer_ofs + offsetof(Vertex, pos)));
+    glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), CAST_INT_TO_UCHAR_PTR(buffer_ofs + offsetof(Vertex, uv)));
+    glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), CAST_INT_TO_UCHAR_PTR(buffer_ofs + offsetof(Vertex, color)));
 
-                            glEnable(GL_SCISSOR_TEST);
-                            //glScissor(viewport.x+current_clip->final_clip_rect.pos.x,viewport.y+ (viewport.height-(current_clip->final_clip_rect.pos.y+current_clip->final_clip_rect.size.height)),
-                            //current_clip->final_clip_rect.size.width,current_clip->final_clip_rect.size.height);
-                            int y = storage->frame.current_rt->height - (current_clip->final_clip_rect.position.y + current_clip->final_clip_rect.size.y);
-                            if (storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_VFLIP])
-                                y = current_clip->final_clip_rect.position.y;
+    glDrawElements(GL_TRIANGLES, p_batch.index_count, GL_UNSIGNED_SHORT, CAST_INT_TO_UCHAR_PTR(p_batch.first_index * sizeof(uint16_t)));
 
-                            glScissor(current_clip->final_clip_rect.position.x, y, current_clip->final_clip_rect.size.x, current_clip->final_clip_rect.size.y);
+    storage->frame.canvas_draw_commands++;
+    storage->info.render.draw_call_count++;
 
-                            reclip = false;
-                        }
-                    }
-                }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-            } break;
+void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip) {
+
+    int cc = p_item->commands.size();
+    Item::Command **commands = p_item->commands.data();
+
+    // skinned items keep the per command path, the batch vertices carry no bone data
+    if (!state.use_batching || state.using_skeleton) {
+        for (int i = 0; i < cc; i++) {
+            _canvas_item_render_command(commands[i], current_clip, reclip);
+        }
+        return;
+    }
+
+    if (state.batched_item != p_item) {
+
+        state.batcher.build(p_item, storage);
+        state.batched_item = p_item;
+
+        const Vector<RasterizerCanvasBatcher::Vertex> &vertices = state.batcher.get_vertices();
+        const Vector<uint16_t> &indices = state.batcher.get_indices();
+        if (!vertices.empty()) {
+            // the element buffer binding is part of the vertex array state
+            glBindVertexArray(data.batch_array);
+            glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(RasterizerCanvasBatcher::Vertex), vertices.data(), GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STREAM_DRAW);
+            glBindVertexArray(state.using_texture_rect ? data.canvas_quad_array : 0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    for (const RasterizerCanvasBatcher::Batch &batch : state.batcher.get_batches()) {
+
+        if (batch.merged) {
+            _render_batch(batch);
+            continue;
+        }
+
+        for (int i = batch.first_command; i < batch.first_command + batch.command_count; i++) {
+            _canvas_item_render_command(commands[i], current_clip, reclip);
         }
     }
 }
@@ -1309,6 +1385,7 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
     state.current_tex = RID();
     state.current_tex_ptr = nullptr;
     state.current_normal = RID();
+    state.batched_item = nullptr;
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, storage->resources.white_tex);
 
@@ -2195,6 +2272,23 @@ void RasterizerCanvasGLES3::initialize() {
         data.polygon_index_buffer_size = index_size;
     }
 
+    {
+        //batch buffers, refilled for each canvas item that has commands to merge
+        state.use_batching = GLOBAL_DEF_RST("rendering/quality/2d/use_batching", true);
+        state.batched_item = nullptr;
+
+        glGenBuffers(1, &data.batch_vertex_buffer);
+        glGenBuffers(1, &data.batch_index_buffer);
+        glGenVertexArrays(1, &data.batch_array);
+        glBindVertexArray(data.batch_array);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.batch_index_buffer);
+        glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+        glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+        glEnableVertexAttribArray(VS::ARRAY_COLOR);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
     store_transform(Transform(), state.canvas_item_ubo_data.projection_matrix);
 
     glGenBuffers(1, &state.canvas_item_ubo);
@@ -2222,6 +2316,10 @@ void RasterizerCanvasGLES3::finalize() {
     glDeleteVertexArrays(1, &data.canvas_quad_array);
 
     glDeleteVertexArrays(1, &data.polygon_buffer_pointer_array);
+
+    glDeleteBuffers(1, &data.batch_vertex_buffer);
+    glDeleteBuffers(1, &data.batch_index_buffer);
+    glDeleteVertexArrays(1, &data.batch_array);
 }
 /*
 
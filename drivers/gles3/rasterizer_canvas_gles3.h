@@ -32,6 +32,7 @@
 
 #include "rasterizer_storage_gles3.h"
 #include "servers/visual/rasterizer.h"
+#include "servers/visual/rasterizer_canvas_batcher.h"
 
 #include "gles3/shaders/canvas_shadow.glsl.gen.h"
 #include "gles3/shaders/lens_distorted.glsl.gen.h"
@@ -62,6 +63,10 @@ public:
         GLuint particle_quad_vertices;
         GLuint particle_quad_array;
 
+        GLuint batch_vertex_buffer;
+        GLuint batch_index_buffer;
+        GLuint batch_array;
+
         uint32_t polygon_buffer_size;
         uint32_t polygon_index_buffer_size;
     } data;
@@ -90,6 +95,10 @@ public:
         Transform2D skeleton_transform;
         Transform2D skeleton_transform_inverse;
 
+        bool use_batching;
+        RasterizerCanvasBatcher batcher;
+        const Item *batched_item; // item the batcher and batch buffers currently hold, reused by the light passes
+
     } state;
 
     RasterizerStorageGLES3 *storage;
@@ -135,6 +144,8 @@ public:
     void _render_rect(RasterizerCanvas::Item::CommandRect *rect);
     void _render_ninepatch(RasterizerCanvas::Item::CommandNinePatch *np);
 
+    void _render_batch(const RasterizerCanvasBatcher::Batch &p_batch);
+    void _canvas_item_render_command(Item::Command *c, Item *current_clip, bool &reclip);
     void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip);
     void _copy_texscreen(const Rect2 &p_rect);
 
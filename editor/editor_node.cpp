@@ -1687,7 +1687,7 @@ void EditorNode::push_item(Object *p_object, se_string_view p_property, bool p_i
         return;
     }
 
-    uint32_t id = p_object->get_instance_id();
+    ObjectID id = p_object->get_instance_id();
     if (id != editor_history.get_current()) {
 
         if (p_inspector_only) {
@@ -46,6 +46,7 @@
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/register_core_types.h"
+#include "core/os/job_system.h"
 #include "core/script_debugger_local.h"
 #include "core/script_language.h"
 #include "core/translation.h"
@@ -104,6 +105,7 @@ static PackedData *packed_data = nullptr;
 static FileAccessNetworkClient *file_access_network_client = nullptr;
 static ScriptDebugger *script_debugger = nullptr;
 static MessageQueue *message_queue = nullptr;
+static JobSystem *job_system = nullptr;
 
 // Initialized in setup2()
 static AudioServer *audio_server = nullptr;
@@ -926,6 +928,14 @@ Error Main::setup(bool p_second_phase) {
     ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc",
             PropertyInfo(VariantType::INT, "memory/limits/multithreaded_server/rid_pool_prealloc", PropertyHint::Range,
                     "0,500,1")); // No negative and limit to 500 due to crashes
+    GLOBAL_DEF("memory/limits/resource_cache/budget_mb", 0);
+    ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/resource_cache/budget_mb",
+            PropertyInfo(VariantType::INT, "memory/limits/resource_cache/budget_mb", PropertyHint::Range,
+                    "0,4096,1,or_greater"));
+    {
+        int budget_mb = GLOBAL_GET("memory/limits/resource_cache/budget_mb");
+        ResourceCache::set_memory_budget(uint64_t(MAX(budget_mb, 0)) * 1024 * 1024);
+    }
     GLOBAL_DEF("network/limits/debugger_stdout/max_chars_per_second", 2048);
     ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger_stdout/max_chars_per_second",
             PropertyInfo(VariantType::INT, "network/limits/debugger_stdout/max_chars_per_second", PropertyHint::Range,
@@ -1221,6 +1231,9 @@ Error Main::setup(bool p_second_phase) {
 
     Engine::get_singleton()->set_frame_delay(frame_delay);
 
+    job_system = memnew_args(JobSystem, GLOBAL_DEF("threading/job_system/worker_threads", -1).as<int>());
+    ProjectSettings::get_singleton()->set_custom_property_info("threading/job_system/worker_threads", PropertyInfo(VariantType::INT, "threading/job_system/worker_threads", PropertyHint::Range, "-1,128,1")); // -1 = one per core
+
     message_queue = memnew(MessageQueue);
 
 
@@ -1266,6 +1279,8 @@ error:
 
     if (message_queue)
         memdelete(message_queue);
+    if (job_system)
+        memdelete(job_system);
     OS::get_singleton()->finalize_core();
     locale.clear();
 
@@ -2258,6 +2273,9 @@ void Main::cleanup() {
 
     OS::get_singleton()->delete_main_loop();
 
+    // soft cached resources may still hold server data, free them while the servers exist
+    ResourceCache::release_soft_references();
+
     OS::get_singleton()->_cmdline.clear();
     OS::get_singleton()->_execpath = "";
     OS::get_singleton()->_local_clipboard = "";
@@ -2301,6 +2319,10 @@ void Main::cleanup() {
     finalize_physics();
     finalize_navigation_server();
 
+    // servers are gone, nothing can submit jobs anymore.
+    memdelete(job_system);
+    job_system = nullptr;
+
     if (packed_data)
         memdelete(packed_data);
     if (file_access_network_client)
@@ -82,6 +82,8 @@ void Performance::_bind_methods() {
     BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS)
     BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT)
     BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY)
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_STAGED_MESSAGES)
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_PEAK_BYTES)
 
     BIND_ENUM_CONSTANT(MONITOR_MAX)
 }
@@ -127,6 +129,8 @@ se_string_view Performance::get_monitor_name(Monitor p_monitor) const {
         "physics_3d/collision_pairs",
         "physics_3d/islands",
         "audio/output_latency",
+        "message_queue/staged_messages",
+        "message_queue/peak_bytes",
 
     };
 
@@ -165,6 +169,8 @@ float Performance::get_monitor(Monitor p_monitor) const {
         case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
         case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
         case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+        case MESSAGE_QUEUE_STAGED_MESSAGES: return MessageQueue::get_singleton()->get_staged_message_count();
+        case MESSAGE_QUEUE_PEAK_BYTES: return MessageQueue::get_singleton()->get_frame_peak_buffer_usage();
 
         default: {
         }
@@ -207,6 +213,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
         MONITOR_TYPE_QUANTITY,
         MONITOR_TYPE_QUANTITY,
         MONITOR_TYPE_TIME,
+        MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_MEMORY,
 
     };
 
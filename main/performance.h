@@ -79,6 +79,8 @@ public:
         PHYSICS_3D_ISLAND_COUNT,
         //physics
         AUDIO_OUTPUT_LATENCY,
+        MESSAGE_QUEUE_STAGED_MESSAGES,
+        MESSAGE_QUEUE_PEAK_BYTES,
         MONITOR_MAX
     };
 
@@ -0,0 +1,226 @@
+/*************************************************************************/
+/*  test_animation_compiled.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_animation_compiled.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "scene/resources/animation.h"
+#include "scene/resources/animation_compiled.h"
+
+namespace TestAnimationCompiled {
+
+// the compiled samplers hold reals as double and skip Variant, allow for the rounding that adds
+static bool is_close(real_t p_a, real_t p_b) {
+    return Math::is_equal_approx(p_a, p_b, 1e-4f);
+}
+
+static bool is_close(const Vector2 &p_a, const Vector2 &p_b) {
+    return is_close(p_a.x, p_b.x) && is_close(p_a.y, p_b.y);
+}
+
+static bool is_close(const Vector3 &p_a, const Vector3 &p_b) {
+    return is_close(p_a.x, p_b.x) && is_close(p_a.y, p_b.y) && is_close(p_a.z, p_b.z);
+}
+
+static bool is_close(const Quat &p_a, const Quat &p_b) {
+    return is_close(p_a.x, p_b.x) && is_close(p_a.y, p_b.y) && is_close(p_a.z, p_b.z) && is_close(p_a.w, p_b.w);
+}
+
+static bool is_close(const Color &p_a, const Color &p_b) {
+    return is_close(p_a.r, p_b.r) && is_close(p_a.g, p_b.g) && is_close(p_a.b, p_b.b) && is_close(p_a.a, p_b.a);
+}
+
+static Ref<Animation> make_animation(bool p_loop, bool p_loop_wrap, Animation::InterpolationType p_interp) {
+
+    Ref<Animation> anim(make_ref_counted<Animation>());
+    anim->set_length(2.0f);
+    anim->set_loop(p_loop);
+
+    // keys not starting at zero, one past the length, and eased and held transitions in between
+    int t = anim->add_track(Animation::TYPE_TRANSFORM);
+    anim->transform_track_insert_key(t, 0.1f, Vector3(0, 0, 0), Quat(), Vector3(1, 1, 1));
+    anim->transform_track_insert_key(t, 0.5f, Vector3(1, 2, 0), Quat(Vector3(0, 1, 0), 0.5f), Vector3(2, 1, 1));
+    anim->transform_track_insert_key(t, 1.2f, Vector3(3, 0, -1), Quat(Vector3(1, 0, 0), 1.5f), Vector3(1, 3, 1));
+    anim->transform_track_insert_key(t, 1.9f, Vector3(-2, 1, 4), Quat(Vector3(0, 0, 1), -1.0f), Vector3(0.5f, 1, 2));
+    anim->transform_track_insert_key(t, 2.3f, Vector3(9, 9, 9), Quat(Vector3(0, 1, 0), 2.5f), Vector3(4, 4, 4));
+    anim->track_set_key_transition(t, 1, 0.5f);
+    anim->track_set_key_transition(t, 2, 0.0f);
+
+    const Variant values[5][3] = {
+        { 1.0f, -3.0f, 7.5f },
+        { Vector2(0, 1), Vector2(4, -2), Vector2(-1, 3) },
+        { Vector3(1, 0, 0), Vector3(0, 5, 2), Vector3(-3, 1, 1) },
+        { Quat(), Quat(Vector3(0, 1, 0), 1.0f), Quat(Vector3(1, 0, 0), -2.0f) },
+        { Color(1, 0, 0), Color(0, 1, 0.5f), Color(0.2f, 0.2f, 1, 0.5f) },
+    };
+    for (int i = 0; i < 5; i++) {
+        int v = anim->add_track(Animation::TYPE_VALUE);
+        anim->track_insert_key(v, 0.3f, values[i][0]);
+        anim->track_insert_key(v, 0.8f, values[i][1], 2.0f);
+        anim->track_insert_key(v, 1.5f, values[i][2]);
+    }
+
+    for (int i = 0; i < anim->get_track_count(); i++) {
+        anim->track_set_interpolation_type(i, p_interp);
+        anim->track_set_interpolation_loop_wrap(i, p_loop_wrap);
+    }
+    return anim;
+}
+
+static bool check_track(const Animation *p_anim, const AnimationCompiled *p_compiled, int p_track, float p_time, int &r_cursor) {
+
+    int channel = p_compiled->get_track_channel(p_track);
+    if (channel < 0)
+        return false; // every track of the test animation has to compile
+
+    if (p_anim->track_get_type(p_track) == Animation::TYPE_TRANSFORM) {
+
+        Vector3 loc, scale, c_loc, c_scale;
+        Quat rot, c_rot;
+        bool ok = p_anim->transform_track_interpolate(p_track, p_time, &loc, &rot, &scale) == OK;
+        if (p_compiled->sample_transform(channel, p_time, r_cursor, &c_loc, &c_rot, &c_scale) != ok)
+            return false;
+        return !ok || (is_close(loc, c_loc) && is_close(rot, c_rot) && is_close(scale, c_scale));
+    }
+
+    Variant expected = p_anim->value_track_interpolate(p_track, p_time);
+    Variant value;
+    if (!p_compiled->sample_value(channel, p_time, r_cursor, value))
+        return expected.get_type() == VariantType::NIL;
+
+    switch (expected.get_type()) {
+        case VariantType::REAL: return value.get_type() == VariantType::REAL && is_close(expected.as<real_t>(), value.as<real_t>());
+        case VariantType::VECTOR2: return is_close(expected.as<Vector2>(), value.as<Vector2>());
+        case VariantType::VECTOR3: return is_close(expected.as<Vector3>(), value.as<Vector3>());
+        case VariantType::QUAT: return is_close(expected.as<Quat>(), value.as<Quat>());
+        case VariantType::COLOR: return is_close(expected.as<Color>(), value.as<Color>());
+        default: return false;
+    }
+}
+
+// samples every track at p_times in order with one cursor per track, like AnimationPlayer does
+static bool check_sequence(const Vector<float> &p_times, const char *p_name) {
+
+    const Animation::InterpolationType interps[3] = { Animation::INTERPOLATION_NEAREST, Animation::INTERPOLATION_LINEAR, Animation::INTERPOLATION_CUBIC };
+
+    for (int mode = 0; mode < 4; mode++) {
+        bool loop = mode & 1;
+        bool loop_wrap = mode & 2;
+
+        for (Animation::InterpolationType interp : interps) {
+
+            Ref<Animation> anim = make_animation(loop, loop_wrap, interp);
+            const AnimationCompiled *compiled = anim->get_compiled();
+            Vector<int> cursors(anim->get_track_count(), -1);
+
+            for (float time : p_times) {
+                for (int i = 0; i < anim->get_track_count(); i++) {
+                    if (!check_track(anim.get(), compiled, i, time, cursors[i])) {
+                        OS::get_singleton()->print(FormatVE("\t%s: track %d differs at %f (loop %d, wrap %d, interpolation %d)\n",
+                                p_name, i, time, int(loop), int(loop_wrap), int(interp)));
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool test_forward() {
+
+
+    Vector<float> times;
+    for (int i = 0; i <= 200; i++)
+        times.push_back(i * 0.01f);
+    // and keep playing past the end, wrapping around like a looping player
+    for (int i = 0; i < 300; i++)
+        times.push_back(Math::fposmod(i * 0.037f, 2.0f));
+    return check_sequence(times, "forward");
+}
+
+bool test_backward() {
+
+
+    Vector<float> times;
+    for (int i = 200; i >= 0; i--)
+        times.push_back(i * 0.01f);
+    for (int i = 0; i < 300; i++)
+        times.push_back(Math::fposmod(-i * 0.037f, 2.0f));
+    return check_sequence(times, "backward");
+}
+
+bool test_seek() {
+
+
+    // exact key times and the length itself, then jumps all over the animation
+    Vector<float> times = { 0.0f, 0.1f, 0.5f, 1.2f, 1.9f, 2.0f, 0.3f, 0.8f, 1.5f, 0.0f };
+    uint32_t rnd = 54321;
+    for (int i = 0; i < 500; i++) {
+        rnd = rnd * 1664525u + 1013904223u;
+        times.push_back((rnd >> 8) % 20001 * 0.0001f);
+    }
+    return check_sequence(times, "seek");
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_forward,
+    test_backward,
+    test_seek,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestAnimationCompiled
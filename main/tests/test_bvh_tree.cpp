@@ -0,0 +1,310 @@
+/*************************************************************************/
+/*  test_bvh_tree.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_bvh_tree.h"
+
+#include "core/math/bvh_tree.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/octree.h"
+#include "core/os/os.h"
+#include "core/set.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+
+namespace TestBVHTree {
+
+struct Item {
+    int index;
+};
+
+// deterministic, the checks below compare against brute force so any sequence will do.
+struct Random {
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return uint32_t(state >> 16);
+    }
+    real_t range(real_t p_from, real_t p_to) { return p_from + (p_to - p_from) * (next() & 0xFFFF) / real_t(0xFFFF); }
+    AABB box(real_t p_extent, real_t p_max_size) {
+        Vector3 pos(range(-p_extent, p_extent), range(-p_extent, p_extent), range(-p_extent, p_extent));
+        Vector3 size(range(0.1f, p_max_size), range(0.1f, p_max_size), range(0.1f, p_max_size));
+        return AABB(pos, size);
+    }
+};
+
+struct PairTracker {
+    Set<uint64_t> pairs;
+    bool consistent = true;
+
+    static uint64_t key(const Item *p_A, const Item *p_B) {
+        uint32_t a = p_A->index, b = p_B->index;
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+    static void *pair(void *p_self, uint32_t, Item *p_A, int, uint32_t, Item *p_B, int) {
+        PairTracker *self = (PairTracker *)p_self;
+        self->consistent = self->pairs.insert(key(p_A, p_B)).second && self->consistent;
+        return (void *)uintptr_t(key(p_A, p_B));
+    }
+    static void unpair(void *p_self, uint32_t, Item *p_A, int, uint32_t, Item *p_B, int, void *p_ud) {
+        PairTracker *self = (PairTracker *)p_self;
+        // the userdata returned when pairing must come back unchanged.
+        self->consistent = self->consistent && p_ud == (void *)uintptr_t(key(p_A, p_B)) && self->pairs.erase(key(p_A, p_B)) == 1;
+    }
+};
+
+struct Entry {
+    Item item;
+    AABB aabb;
+    uint32_t id = 0;
+    bool pairable = false;
+    uint32_t type = 0;
+    uint32_t mask = 0;
+};
+
+static bool should_pair(const Entry &p_A, const Entry &p_B) {
+    if (!p_A.pairable && !p_B.pairable)
+        return false;
+    if (!(p_A.type & p_B.mask) && !(p_B.type & p_A.mask))
+        return false;
+    return p_A.aabb.intersects_inclusive(p_B.aabb);
+}
+
+bool test_cull() {
+
+    const int count = 2000;
+    Random rnd;
+    BVHTree<Item, true> tree;
+    Vector<Entry> entries;
+    entries.resize(count);
+    for (int i = 0; i < count; i++) {
+        Entry &e = entries[i];
+        e.item.index = i;
+        e.aabb = rnd.box(100, 4);
+        e.type = 1 << (i % 3);
+        e.pairable = i % 10 == 0;
+        e.id = tree.create(&e.item, e.aabb, i, e.pairable, e.type, 0);
+    }
+    for (int i = 0; i < count; i += 2) {
+        entries[i].aabb = rnd.box(100, 4);
+        tree.move(entries[i].id, entries[i].aabb);
+    }
+
+    Vector<Item *> result;
+    Vector<int> subindices;
+    result.resize(count);
+    subindices.resize(count);
+
+    for (int q = 0; q < 50; q++) {
+        AABB box = rnd.box(100, 40);
+        uint32_t mask = (q % 3) + 1;
+
+        int culled = tree.cull_aabb(box, result.data(), count, subindices.data(), mask);
+        int expected = 0;
+        for (const Entry &e : entries) {
+            if ((e.type & mask) && box.intersects_inclusive(e.aabb))
+                expected++;
+        }
+        if (culled != expected)
+            return false;
+        for (int i = 0; i < culled; i++) {
+            const Entry &e = entries[result[i]->index];
+            if (subindices[i] != e.item.index || !(e.type & mask) || !box.intersects_inclusive(e.aabb))
+                return false;
+        }
+
+        Vector3 from = rnd.box(100, 1).position;
+        Vector3 to = rnd.box(100, 1).position;
+        culled = tree.cull_segment(from, to, result.data(), count);
+        expected = 0;
+        for (const Entry &e : entries) {
+            if (e.aabb.intersects_segment(from, to))
+                expected++;
+        }
+        if (culled != expected)
+            return false;
+
+        CameraMatrix cm;
+        cm.set_perspective(70, 1.5f, 0.1f, 60);
+        Transform xform;
+        xform.origin = rnd.box(50, 1).position;
+        Frustum planes = cm.get_projection_planes(xform);
+        culled = tree.cull_convex(planes, result.data(), count);
+        expected = 0;
+        for (const Entry &e : entries) {
+            if (e.aabb.intersects_convex_shape(planes.data(), planes.size()))
+                expected++;
+        }
+        if (culled != expected)
+            return false;
+    }
+
+    // a full result buffer must stop the query, not overflow it.
+    return tree.cull_aabb(AABB(Vector3(-200, -200, -200), Vector3(400, 400, 400)), result.data(), 10) == 10;
+}
+
+bool test_pairing() {
+
+    const int count = 1500;
+    Random rnd;
+    PairTracker tracker;
+    BVHTree<Item, true> tree;
+    tree.set_pair_callback(PairTracker::pair, &tracker);
+    tree.set_unpair_callback(PairTracker::unpair, &tracker);
+
+    Vector<Entry> entries;
+    entries.resize(count);
+    for (int i = 0; i < count; i++) {
+        Entry &e = entries[i];
+        e.item.index = i;
+        e.aabb = rnd.box(60, 6);
+        // a few "lights" that pair with "geometry", like the visual server does
+        e.pairable = i % 20 == 0;
+        e.type = e.pairable ? 2 : 1;
+        e.mask = e.pairable ? 1 : 2;
+        e.id = tree.create(&e.item, e.aabb, 0, e.pairable, e.type, e.mask);
+    }
+
+    for (int frame = 0; frame < 20; frame++) {
+        for (int i = frame % 3; i < count; i += 3) {
+            Entry &e = entries[i];
+            e.aabb.position += Vector3(rnd.range(-2, 2), rnd.range(-2, 2), rnd.range(-2, 2));
+            tree.move(e.id, e.aabb);
+        }
+        if (frame == 10) {
+            for (int i = 5; i < count; i += 97) {
+                entries[i].pairable = !entries[i].pairable;
+                entries[i].type = entries[i].pairable ? 2 : 1;
+                entries[i].mask = entries[i].pairable ? 1 : 2;
+                tree.set_pairable(entries[i].id, entries[i].pairable, entries[i].type, entries[i].mask);
+            }
+        }
+    }
+    for (int i = 0; i < count; i += 7) {
+        tree.erase(entries[i].id);
+        entries[i].aabb = AABB();
+    }
+
+    Set<uint64_t> expected;
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            if (!entries[i].aabb.has_no_surface() && !entries[j].aabb.has_no_surface() && should_pair(entries[i], entries[j]))
+                expected.insert(PairTracker::key(&entries[i].item, &entries[j].item));
+        }
+    }
+
+    return tracker.consistent && tracker.pairs == expected && tree.get_pair_count() == int(expected.size());
+}
+
+template <class TREE>
+static void bench_moving(const char *p_name, int p_count, int p_frames) {
+
+    Random rnd;
+    TREE tree;
+    Vector<Entry> entries;
+    entries.resize(p_count);
+
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < p_count; i++) {
+        Entry &e = entries[i];
+        e.item.index = i;
+        e.aabb = rnd.box(1000, 2);
+        e.id = tree.create(&e.item, e.aabb, 0, false, 1, 0);
+    }
+    uint64_t insert_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    Vector<Item *> result;
+    result.resize(p_count);
+    CameraMatrix cm;
+    cm.set_perspective(70, 1.5f, 0.1f, 500);
+    uint64_t move_time = 0, cull_time = 0;
+    int culled = 0;
+    for (int frame = 0; frame < p_frames; frame++) {
+        t = OS::get_singleton()->get_ticks_usec();
+        for (Entry &e : entries) {
+            e.aabb.position += Vector3(rnd.range(-0.05f, 0.05f), rnd.range(-0.05f, 0.05f), rnd.range(-0.05f, 0.05f));
+            tree.move(e.id, e.aabb);
+        }
+        move_time += OS::get_singleton()->get_ticks_usec() - t;
+
+        t = OS::get_singleton()->get_ticks_usec();
+        Transform xform;
+        xform.basis.rotate(Vector3(0, 1, 0), frame * 0.3f);
+        culled = tree.cull_convex(cm.get_projection_planes(xform), result.data(), p_count);
+        cull_time += OS::get_singleton()->get_ticks_usec() - t;
+    }
+
+    OS::get_singleton()->print(FormatVE("\t%s: insert %.2f ms, move %.2f ms/frame, cull %.2f ms/frame (%d visible)\n", p_name,
+            insert_time / 1000.0, move_time / 1000.0 / p_frames, cull_time / 1000.0 / p_frames, culled));
+}
+
+bool test_benchmark() {
+
+    // 100k instances drifting every frame, as VisualServerScene::_update_dirty_instance moves them.
+    const int count = 100000;
+    const int frames = 10;
+    bench_moving<Octree<Item, true>>("Octree", count, frames);
+    bench_moving<BVHTree<Item, true>>("BVHTree", count, frames);
+    return true;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_cull,
+    test_pairing,
+    test_benchmark,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestBVHTree
@@ -0,0 +1,227 @@
+/*************************************************************************/
+/*  test_canvas_batcher.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_canvas_batcher.h"
+
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "drivers/dummy/rasterizer_dummy.h"
+#include "servers/visual/rasterizer_canvas_batcher.h"
+
+namespace TestCanvasBatcher {
+
+using Item = RasterizerCanvas::Item;
+
+static RasterizerStorageDummy *storage = nullptr;
+static RID texture_a;
+static RID texture_b;
+
+static RID make_texture(int p_width, int p_height) {
+    RID texture = storage->texture_create();
+    storage->texture_allocate(texture, p_width, p_height, 0, Image::FORMAT_RGBA8);
+    return texture;
+}
+
+static void add_rect(Item &r_item, const Rect2 &p_rect, RID p_texture, uint8_t p_flags = 0) {
+    Item::CommandRect *rect = memnew(Item::CommandRect);
+    rect->rect = p_rect;
+    rect->texture = p_texture;
+    rect->modulate = Color(1, 1, 1, 1);
+    rect->flags = p_flags;
+    r_item.commands.push_back(rect);
+}
+
+static void add_nine_patch(Item &r_item, const Rect2 &p_rect, RID p_texture, VS::NinePatchAxisMode p_axis = VS::NINE_PATCH_STRETCH) {
+    Item::CommandNinePatch *np = memnew(Item::CommandNinePatch);
+    np->rect = p_rect;
+    np->texture = p_texture;
+    for (float &m : np->margin)
+        m = 4;
+    np->color = Color(1, 1, 1, 1);
+    np->axis_x = p_axis;
+    np->axis_y = p_axis;
+    r_item.commands.push_back(np);
+}
+
+static void add_triangle(Item &r_item, const Vector2 &p_offset) {
+    Item::CommandPolygon *polygon = memnew(Item::CommandPolygon);
+    polygon->points = { p_offset, p_offset + Vector2(10, 0), p_offset + Vector2(0, 10) };
+    polygon->indices = { 0, 1, 2 };
+    polygon->count = 3;
+    polygon->colors.push_back(Color(1, 0, 0, 1));
+    polygon->antialiased = false;
+    r_item.commands.push_back(polygon);
+}
+
+static void add_line(Item &r_item) {
+    Item::CommandLine *line = memnew(Item::CommandLine);
+    line->width = 1;
+    line->antialiased = false;
+    r_item.commands.push_back(line);
+}
+
+bool test_rects_merge() {
+
+    Item item;
+    for (int i = 0; i < 3; i++)
+        add_rect(item, Rect2(i * 10, 0, 10, 10), texture_a);
+
+    RasterizerCanvasBatcher batcher;
+    batcher.build(&item, storage);
+    const auto &batches = batcher.get_batches();
+    if (batches.size() != 1 || !batches[0].merged || batches[0].command_count != 3 || batches[0].texture != texture_a)
+        return false;
+    if (batcher.get_vertices().size() != 12 || batcher.get_indices().size() != 18)
+        return false;
+    // the second quad's indices point at its own vertices
+    if (batcher.get_indices()[6] != 4 || batcher.get_vertices()[4].pos != Vector2(10, 0))
+        return false;
+    return batcher.get_draw_call_count() == 1 && batcher.get_merged_command_count() == 3;
+}
+
+bool test_texture_change_splits() {
+
+    Item item;
+    add_rect(item, Rect2(0, 0, 10, 10), texture_a);
+    add_rect(item, Rect2(10, 0, 10, 10), texture_a);
+    add_rect(item, Rect2(20, 0, 10, 10), texture_b);
+    add_rect(item, Rect2(30, 0, 10, 10), texture_b);
+
+    RasterizerCanvasBatcher batcher;
+    batcher.build(&item, storage);
+    const auto &batches = batcher.get_batches();
+    if (batches.size() != 2 || batches[0].texture != texture_a || batches[1].texture != texture_b)
+        return false;
+    if (batches[1].first_command != 2 || batches[1].first_vertex != 8 || batches[1].first_index != 12)
+        return false;
+    return batcher.get_draw_call_count() == 2;
+}
+
+bool test_nine_patches() {
+
+    Item item;
+    add_nine_patch(item, Rect2(0, 0, 32, 32), texture_a);
+    add_nine_patch(item, Rect2(40, 0, 32, 32), texture_a);
+    // tiling needs the nine-patch shader
+    add_nine_patch(item, Rect2(80, 0, 32, 32), texture_a, VS::NINE_PATCH_TILE);
+
+    RasterizerCanvasBatcher batcher;
+    batcher.build(&item, storage);
+    const auto &batches = batcher.get_batches();
+    if (batches.size() != 2 || !batches[0].merged || batches[0].command_count != 2 || batches[1].merged)
+        return false;
+    if (batches[0].vertex_count != 2 * 9 * 4 || batches[0].index_count != 2 * 9 * 6)
+        return false;
+    return batcher.get_draw_call_count() == 2;
+}
+
+bool test_unbatchable_breaks_runs() {
+
+    Item item;
+    add_rect(item, Rect2(0, 0, 10, 10), RID());
+    add_triangle(item, Vector2(20, 0));
+    add_line(item);
+    add_triangle(item, Vector2(40, 0));
+    add_triangle(item, Vector2(60, 0));
+    add_rect(item, Rect2(0, 20, 10, 10), texture_a, RasterizerCanvas::CANVAS_RECT_TILE);
+
+    RasterizerCanvasBatcher batcher;
+    batcher.build(&item, storage);
+    const auto &batches = batcher.get_batches();
+    if (batches.size() != 4)
+        return false;
+    // untextured rects and polygons share a batch
+    if (!batches[0].merged || batches[0].command_count != 2 || batches[0].vertex_count != 4 + 3 || batches[0].index_count != 6 + 3)
+        return false;
+    if (batches[1].merged || batches[1].command_count != 1 || !batches[2].merged || batches[2].command_count != 2 || batches[3].merged)
+        return false;
+    if (batcher.get_vertices()[4].color != Color(1, 0, 0, 1))
+        return false;
+    return batcher.get_draw_call_count() == 4 && batcher.get_merged_command_count() == 4;
+}
+
+bool test_single_command_not_merged() {
+
+    Item item;
+    add_line(item);
+    add_rect(item, Rect2(0, 0, 10, 10), texture_a);
+    add_line(item);
+
+    RasterizerCanvasBatcher batcher;
+    batcher.build(&item, storage);
+    const auto &batches = batcher.get_batches();
+    if (batches.size() != 1 || batches[0].merged || batches[0].command_count != 3)
+        return false;
+    return batcher.get_vertices().empty() && batcher.get_draw_call_count() == 3 && batcher.get_merged_command_count() == 0;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_rects_merge,
+    test_texture_change_splits,
+    test_nine_patches,
+    test_unbatchable_breaks_runs,
+    test_single_command_not_merged,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    storage = memnew(RasterizerStorageDummy);
+    texture_a = make_texture(16, 16);
+    texture_b = make_texture(32, 32);
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    storage->free(texture_a);
+    storage->free(texture_b);
+    memdelete(storage);
+    storage = nullptr;
+
+    return nullptr;
+}
+} // namespace TestCanvasBatcher
@@ -0,0 +1,244 @@
+/*************************************************************************/
+/*  test_class_db.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_class_db.h"
+
+#include "core/class_db.h"
+#include "core/method_bind.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "scene/gui/button.h"
+
+// Gets a method bound after both classes had their flat tables built.
+class TestFlatBase : public Object {
+
+    GDCLASS(TestFlatBase, Object)
+
+public:
+    int late_method() const { return 1; }
+
+protected:
+    static void _bind_methods() {
+    }
+};
+
+class TestFlatDerived : public TestFlatBase {
+
+    GDCLASS(TestFlatDerived, TestFlatBase)
+
+protected:
+    static void _bind_methods() {
+    }
+};
+
+IMPL_GDCLASS(TestFlatBase)
+IMPL_GDCLASS(TestFlatDerived)
+
+namespace TestClassDB {
+
+// Resolves p_name the way ClassDB used to: one method_map at a time, most derived first. Reads the
+// per-class maps directly so it never goes through the flat tables under test.
+static MethodBind *find_declaring_method(const StringName &p_class, const StringName &p_name) {
+
+    auto iter = ClassDB::classes.find(p_class);
+    if (iter == ClassDB::classes.end())
+        return nullptr;
+    for (const ClassDB::ClassInfo *check = &iter->second; check; check = check->inherits_ptr) {
+        MethodBind *method = check->method_map.at(p_name, nullptr);
+        if (method)
+            return method;
+    }
+    return nullptr;
+}
+
+static const ClassDB::FlatTables *published_tables(const StringName &p_class) {
+
+    auto iter = ClassDB::classes.find(p_class);
+    return iter != ClassDB::classes.end() ? iter->second.flat.load() : nullptr;
+}
+
+bool test_inherited_methods() {
+
+    Vector<StringName> classes;
+    ClassDB::get_class_list(&classes);
+
+    int checked = 0;
+    for (const StringName &cls : classes) {
+        Vector<MethodInfo> methods;
+        ClassDB::get_method_list(cls, &methods);
+        for (const MethodInfo &mi : methods) {
+            MethodBind *expected = find_declaring_method(cls, mi.name);
+            if (!expected)
+                continue; // virtual methods are listed but never bound
+            if (ClassDB::get_method(cls, mi.name) != expected) {
+                OS::get_singleton()->print(FormatVE("\t%s::%s resolves to the wrong bind\n", cls.asCString(), mi.name.asCString()));
+                return false;
+            }
+            checked++;
+        }
+        if (ClassDB::get_method(cls, "__no_such_method__") != nullptr)
+            return false;
+    }
+
+    OS::get_singleton()->print(FormatVE("\tchecked %d methods in %d classes\n", checked, classes.size()));
+    return checked > 0;
+}
+
+bool test_late_registration() {
+
+    ClassDB::register_class<TestFlatDerived>();
+    const StringName base("TestFlatBase");
+    const StringName derived("TestFlatDerived");
+    const StringName late_method("late_method");
+
+    // build the tables of both test classes and of an unrelated one before binding.
+    bool ok = ClassDB::get_method(base, late_method) == nullptr;
+    ok = ok && ClassDB::get_method(derived, late_method) == nullptr;
+    ok = ok && ClassDB::get_method("Button", "get_name") != nullptr;
+    const ClassDB::FlatTables *unrelated = published_tables("Button");
+
+    MethodBinder::bind_method(D_METHOD("late_method"), &TestFlatBase::late_method);
+
+    MethodBind *bound = find_declaring_method(base, late_method);
+    ok = ok && bound && ClassDB::get_method(base, late_method) == bound;
+    ok = ok && ClassDB::get_method(derived, late_method) == bound;
+    // only the tables of the class the method went into and of its descendants are replaced.
+    ok = ok && unrelated && published_tables("Button") == unrelated;
+    return ok;
+}
+
+bool test_inherited_properties() {
+
+    Button *button = memnew(Button);
+
+    bool valid = false;
+    button->set("text", "flat", &valid); // Button
+    bool ok = valid && button->get("text") == Variant("flat");
+    button->set("disabled", true, &valid); // BaseButton
+    ok = ok && valid && button->is_disabled();
+    button->set("mouse_filter", Control::MOUSE_FILTER_IGNORE, &valid); // Control
+    ok = ok && valid && button->get_mouse_filter() == Control::MOUSE_FILTER_IGNORE;
+    button->set("name", "flat_button", &valid); // Node
+    ok = ok && valid && button->get_name() == StringName("flat_button");
+
+    // Integer constants are readable as properties from any subclass.
+    ok = ok && int(button->get("FOCUS_ALL", &valid)) == Control::FOCUS_ALL && valid;
+    button->get("__no_such_property__", &valid);
+    ok = ok && !valid;
+
+    memdelete(button);
+    return ok;
+}
+
+static uint64_t time_calls(Object *p_object, const StringName &p_method, int p_count) {
+
+    Variant::CallError ce;
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < p_count; i++) {
+        p_object->call(p_method, nullptr, 0, ce);
+    }
+    return OS::get_singleton()->get_ticks_usec() - t;
+}
+
+static uint64_t time_sets(Object *p_object, const StringName &p_property, int p_count) {
+
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < p_count; i++) {
+        p_object->set(p_property, i & 1);
+    }
+    return OS::get_singleton()->get_ticks_usec() - t;
+}
+
+bool test_benchmark() {
+
+    // Button sits four levels below Node (Button->BaseButton->Control->CanvasItem->Node), so
+    // the same Node/Object level member used to cost four extra hash probes per lookup.
+    // With flattened tables the columns below should be close to each other.
+    const int count = 1000000;
+    Object *object = memnew(Object);
+    Node *node = memnew(Node);
+    Button *button = memnew(Button);
+
+    const StringName get_instance_id("get_instance_id");
+    const StringName is_disabled("is_disabled");
+    const StringName process_priority("process_priority");
+    const StringName disabled("disabled");
+
+    uint64_t obj_call = time_calls(object, get_instance_id, count);
+    uint64_t btn_call = time_calls(button, get_instance_id, count);
+    uint64_t btn_near_call = time_calls(button, is_disabled, count);
+    uint64_t node_set = time_sets(node, process_priority, count);
+    uint64_t btn_set = time_sets(button, process_priority, count);
+    uint64_t btn_near_set = time_sets(button, disabled, count);
+
+    OS::get_singleton()->print(FormatVE("\tcall(): Object::get_instance_id on Object %.1f ns, on Button %.1f ns; BaseButton::is_disabled on Button %.1f ns\n",
+            obj_call * 1000.0 / count, btn_call * 1000.0 / count, btn_near_call * 1000.0 / count));
+    OS::get_singleton()->print(FormatVE("\tset(): Node.process_priority on Node %.1f ns, on Button %.1f ns; BaseButton.disabled on Button %.1f ns\n",
+            node_set * 1000.0 / count, btn_set * 1000.0 / count, btn_near_set * 1000.0 / count));
+
+    memdelete(button);
+    memdelete(node);
+    memdelete(object);
+    return true;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_inherited_methods,
+    test_late_registration,
+    test_inherited_properties,
+    test_benchmark,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestClassDB
@@ -0,0 +1,164 @@
+/*************************************************************************/
+/*  test_file_access.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_file_access.h"
+
+#include "core/io/file_access_memory.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+
+#include <cstring>
+
+namespace TestFileAccess {
+
+static const int data_size = 64;
+
+static void fill(uint8_t *p_data) {
+
+    for (int i = 0; i < data_size; i++) {
+        p_data[i] = uint8_t(i * 3 + 1);
+    }
+}
+
+// p_file holds the fill() data.
+static bool check_reads(FileAccess *p_file, const uint8_t *p_data) {
+
+    // borrowing hands out the bytes in place and advances like a read
+    p_file->seek(8);
+    const uint8_t *borrowed = p_file->borrow_buffer(16);
+    bool ok = borrowed && memcmp(borrowed, p_data + 8, 16) == 0 && int(p_file->get_position()) == 24;
+
+    // more than is left is refused without moving, get_buffer then reads what is there
+    p_file->seek(data_size - 4);
+    ok = ok && !p_file->borrow_buffer(8) && int(p_file->get_position()) == data_size - 4;
+    uint8_t dst[8];
+    memset(dst, 0, sizeof(dst));
+    ok = ok && p_file->get_buffer(dst, 8) == 4 && memcmp(dst, p_data + data_size - 4, 4) == 0 && dst[4] == 0;
+    ok = ok && p_file->get_error() == ERR_FILE_EOF;
+
+    // nothing is left at the end
+    ok = ok && !p_file->borrow_buffer(1) && p_file->get_buffer(dst, 1) == 0;
+    p_file->seek_end();
+    ok = ok && !p_file->borrow_buffer(1);
+    p_file->get_8();
+    ok = ok && p_file->get_buffer(dst, 1) == 0;
+
+    // the whole file at once
+    p_file->seek(0);
+    borrowed = p_file->borrow_buffer(data_size);
+    return ok && borrowed && memcmp(borrowed, p_data, data_size) == 0;
+}
+
+bool test_memory() {
+
+    uint8_t data[data_size];
+    fill(data);
+
+    FileAccessMemory fa;
+    if (fa.open_custom(data, data_size) != OK)
+        return false;
+    bool ok = fa.borrow_buffer(4) == data && int(fa.get_position()) == 4;
+    return ok && check_reads(&fa, data);
+}
+
+bool test_pack() {
+
+    uint8_t data[data_size];
+    fill(data);
+
+    String src_path = PathUtils::plus_file(OS::get_singleton()->get_user_data_dir(), "test_file_access.bin");
+    String pck_path = PathUtils::plus_file(OS::get_singleton()->get_user_data_dir(), "test_file_access.pck");
+    const char *packed_path = "res://test_file_access/data.bin";
+
+    FileAccess *src = FileAccess::open(src_path, FileAccess::WRITE);
+    if (!src)
+        return false;
+    src->store_buffer(data, data_size);
+    memdelete(src);
+
+    // aligned, so the file does not start right after the directory
+    Ref<PCKPacker> packer(make_ref_counted<PCKPacker>());
+    bool ok = packer->pck_start(pck_path, 16) == OK && packer->add_file(packed_path, src_path) == OK && packer->flush() == OK;
+    ok = ok && PackedData::get_singleton() && PackedData::get_singleton()->add_pack(pck_path, true) == OK;
+
+    FileAccess *f = nullptr;
+    if (ok) {
+        bool disabled = PackedData::get_singleton()->is_disabled();
+        PackedData::get_singleton()->set_disabled(false);
+        f = FileAccess::open(packed_path, FileAccess::READ);
+        PackedData::get_singleton()->set_disabled(disabled);
+    }
+
+    // the pack is a plain file, so it is mapped and reads come straight from the mapping
+    ok = ok && f && int(f->get_len()) == data_size && check_reads(f, data);
+
+    if (f)
+        memdelete(f);
+    DirAccess::remove_file_or_error(src_path);
+    DirAccess::remove_file_or_error(pck_path);
+    return ok;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_memory,
+    test_pack,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestFileAccess
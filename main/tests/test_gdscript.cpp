@@ -573,6 +573,21 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<se_str
                     txt += DADDR(3);
                     incr += 5;
 
+                } break;
+                case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+
+                    const GDScriptFunction::ValidatedOperator &vop = func.get_validated_operator(code[ip + 1]);
+                    txt += " op-validated ";
+
+                    String opname = Variant::get_operator_name(vop.op);
+
+                    txt += DADDR(4);
+                    txt += " = ";
+                    txt += DADDR(2);
+                    txt += " " + opname + " ";
+                    txt += DADDR(3);
+                    incr += 5;
+
                 } break;
                 case GDScriptFunction::OPCODE_SET: {
 
@@ -619,6 +634,29 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<se_str
                     txt += "\"]";
                     incr += 4;
 
+                } break;
+                case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+
+                    txt += " set_named-validated ";
+                    txt += DADDR(1);
+                    txt += "[\"";
+                    txt += func.get_global_name(func.get_validated_member(code[ip + 2]).name).asCString();
+                    txt += "\"]=";
+                    txt += DADDR(3);
+                    incr += 4;
+
+                } break;
+                case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+
+                    txt += " get_named-validated ";
+                    txt += DADDR(3);
+                    txt += "=";
+                    txt += DADDR(1);
+                    txt += "[\"";
+                    txt += func.get_global_name(func.get_validated_member(code[ip + 2]).name).asCString();
+                    txt += "\"]";
+                    incr += 4;
+
                 } break;
                 case GDScriptFunction::OPCODE_SET_MEMBER: {
 
@@ -778,6 +816,31 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<se_str
                     txt += func.get_global_name(code[ip + 3]).asCString();
                     txt += "(";
 
+                    for (int i = 0; i < argc; i++) {
+                        if (i > 0)
+                            txt += ", ";
+                        txt += DADDR(4 + i);
+                    }
+                    txt += ")";
+                    txt += " cache " + itos(code[ip + 5 + argc]);
+
+                    incr = 6 + argc;
+
+                } break;
+                case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+
+                    const GDScriptFunction::ValidatedMethod &vm = func.get_validated_method(code[ip + 3]);
+                    txt += " call-validated ";
+
+                    int argc = code[ip + 1];
+                    if (vm.returns) {
+                        txt += DADDR(4 + argc) + "=";
+                    }
+
+                    txt += DADDR(2) + ".";
+                    txt += func.get_global_name(vm.name).asCString();
+                    txt += "(";
+
                     for (int i = 0; i < argc; i++) {
                         if (i > 0)
                             txt += ", ";
@@ -0,0 +1,148 @@
+/*************************************************************************/
+/*  test_job_system.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_job_system.h"
+
+#include "core/os/job_system.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+
+#include <atomic>
+
+namespace TestJobSystem {
+
+bool test_parallel_for(JobSystem *js) {
+    const uint32_t count = 100000;
+    Vector<uint32_t> values;
+    values.resize(count, 0);
+    js->parallel_for(count, [&values](uint32_t i) { values[i] = i * 2; });
+    for (uint32_t i = 0; i < count; ++i) {
+        if (values[i] != i * 2)
+            return false;
+    }
+    return true;
+}
+
+bool test_nested_wait(JobSystem *js) {
+    // jobs waiting on their own sub-jobs must not deadlock the pool.
+    std::atomic<uint32_t> total { 0 };
+    js->parallel_for(64, [js, &total](uint32_t) {
+        JobSystem::Counter inner;
+        for (int i = 0; i < 16; ++i)
+            js->submit([&total]() { total.fetch_add(1); }, &inner);
+        js->wait(&inner);
+    }, 1);
+    return total.load() == 64 * 16;
+}
+
+bool test_graph_order(JobSystem *js) {
+    JobGraph graph;
+    std::atomic<int> stage { 0 };
+    std::atomic<bool> ordered { true };
+    uint32_t a = graph.add_task([&stage]() { stage.store(1); });
+    uint32_t b = graph.add_task([&stage, &ordered]() {
+        if (stage.load() < 1)
+            ordered.store(false);
+    });
+    uint32_t c = graph.add_task([&stage, &ordered]() {
+        if (stage.load() < 1)
+            ordered.store(false);
+    });
+    uint32_t d = graph.add_task([&stage]() { stage.store(2); });
+    graph.add_dependency(b, a);
+    graph.add_dependency(c, a);
+    graph.add_dependency(d, b);
+    graph.add_dependency(d, c);
+    return graph.execute(js) == OK && ordered.load() && stage.load() == 2;
+}
+
+bool test_graph_cycle(JobSystem *js) {
+    JobGraph graph;
+    uint32_t a = graph.add_task([]() {});
+    uint32_t b = graph.add_task([]() {});
+    graph.add_dependency(a, b);
+    graph.add_dependency(b, a);
+    return graph.execute(js) == ERR_CYCLIC_LINK;
+}
+
+bool test_background_not_helped(JobSystem *js) {
+    // the parallel_for wait on this thread must leave the background job to the workers.
+    std::atomic<int> ran_on { -2 };
+    JobSystem::Counter background;
+    js->submit_background([&ran_on]() { ran_on.store(JobSystem::get_current_worker_index()); }, &background);
+    js->parallel_for(1024, [](uint32_t) {}, 1);
+    bool ok = js->get_worker_count() == 0 || ran_on.load() != -1;
+    js->wait_background(&background);
+    return ok && background.is_done() && ran_on.load() != -2;
+}
+
+using TestFunc = bool (*)(JobSystem *);
+
+TestFunc test_funcs[] = {
+
+    test_parallel_for,
+    test_nested_wait,
+    test_graph_order,
+    test_graph_cycle,
+    test_background_not_helped,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    // the engine-wide pool is normally created by Main, make a local one when tests run standalone.
+    JobSystem *local = JobSystem::get_singleton() ? nullptr : memnew(JobSystem);
+    JobSystem *js = JobSystem::get_singleton();
+
+    OS::get_singleton()->print(FormatVE("Job system workers: %d\n", js->get_worker_count()));
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count](js);
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    if (local)
+        memdelete(local);
+    return nullptr;
+}
+} // namespace TestJobSystem
@@ -35,16 +35,29 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation_compiled.h"
 #include "test_astar.h"
+#include "test_bvh_tree.h"
+#include "test_canvas_batcher.h"
+#include "test_class_db.h"
+#include "test_file_access.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
+#include "test_job_system.h"
 #include "test_math.h"
+#include "test_object_db.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
 #include "test_render.h"
+#include "test_resource_binary.h"
+#include "test_resource_cache.h"
+#include "test_resource_loader.h"
+#include "test_scene_tree.h"
 #include "test_shader_lang.h"
+#include "test_timer_wheel.h"
 //#include "test_string.h"
 
 const char **tests_get_names() {
@@ -64,6 +77,19 @@ const char **tests_get_names() {
         "gd_bytecode",
         "ordered_hash_map",
         "astar",
+        "job_system",
+        "bvh_tree",
+        "class_db",
+        "packed_scene",
+        "timer_wheel",
+        "resource_binary",
+        "resource_cache",
+        "canvas_batcher",
+        "animation_compiled",
+        "scene_tree",
+        "resource_loader",
+        "file_access",
+        "object_db",
         nullptr
     };
 
@@ -144,6 +170,71 @@ MainLoop *test_main(const String& p_test, const List<String> &p_args) {
         return TestAStar::test();
     }
 
+    if (p_test == "job_system") {
+
+        return TestJobSystem::test();
+    }
+
+    if (p_test == "bvh_tree") {
+
+        return TestBVHTree::test();
+    }
+
+    if (p_test == "class_db") {
+
+        return TestClassDB::test();
+    }
+
+    if (p_test == "packed_scene") {
+
+        return TestPackedScene::test();
+    }
+
+    if (p_test == "timer_wheel") {
+
+        return TestTimerWheel::test();
+    }
+
+    if (p_test == "resource_binary") {
+
+        return TestResourceBinary::test();
+    }
+
+    if (p_test == "resource_cache") {
+
+        return TestResourceCache::test();
+    }
+
+    if (p_test == "canvas_batcher") {
+
+        return TestCanvasBatcher::test();
+    }
+
+    if (p_test == "animation_compiled") {
+
+        return TestAnimationCompiled::test();
+    }
+
+    if (p_test == "scene_tree") {
+
+        return TestSceneTree::test();
+    }
+
+    if (p_test == "resource_loader") {
+
+        return TestResourceLoader::test();
+    }
+
+    if (p_test == "file_access") {
+
+        return TestFileAccess::test();
+    }
+
+    if (p_test == "object_db") {
+
+        return TestObjectDB::test();
+    }
+
     print_line("Unknown test: " + p_test);
     return nullptr;
 }
@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  test_object_db.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_object_db.h"
+
+#include "core/object.h"
+#include "core/object_db.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "servers/physics_2d_server.h"
+
+namespace TestObjectDB {
+
+bool test_recycled_slot() {
+
+    Object *first = memnew(Object);
+    ObjectID first_id = first->get_instance_id();
+    memdelete(first);
+
+    // the released slot is the next one handed out, under a new generation.
+    Object *second = memnew(Object);
+    ObjectID second_id = second->get_instance_id();
+
+    bool ok = uint32_t(second_id) == uint32_t(first_id) && second_id != first_id;
+    ok = ok && ObjectDB::get_instance(first_id) == nullptr;
+    ok = ok && ObjectDB::get_instance(second_id) == second;
+    // an ID cut down to its slot index must not resolve.
+    ok = ok && ObjectDB::get_instance(uint32_t(second_id)) == nullptr;
+
+    memdelete(second);
+    return ok;
+}
+
+bool test_recycled_body_id() {
+
+    Physics2DServer *ps = Physics2DServer::get_singleton();
+    if (!ps) {
+        OS::get_singleton()->print("\tno Physics2DServer, skipped\n");
+        return true;
+    }
+
+    Object *stale = memnew(Object);
+    memdelete(stale);
+    Object *owner = memnew(Object);
+    Object *canvas = memnew(Object);
+
+    RID body = ps->body_create();
+    ps->body_attach_object_instance_id(body, owner->get_instance_id());
+    ps->body_attach_canvas_instance_id(body, canvas->get_instance_id());
+
+    bool ok = (owner->get_instance_id() >> 32) != 0;
+    ok = ok && ps->body_get_object_instance_id(body) == owner->get_instance_id();
+    ok = ok && ps->body_get_canvas_instance_id(body) == canvas->get_instance_id();
+    ok = ok && ObjectDB::get_instance(ps->body_get_object_instance_id(body)) == owner;
+    ok = ok && ObjectDB::get_instance(ps->body_get_canvas_instance_id(body)) == canvas;
+
+    ps->free_rid(body);
+    memdelete(canvas);
+    memdelete(owner);
+    return ok;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_recycled_slot,
+    test_recycled_body_id,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestObjectDB
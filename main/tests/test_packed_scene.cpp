@@ -0,0 +1,302 @@
+/*************************************************************************/
+/*  test_packed_scene.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_packed_scene.h"
+
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_pool.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/timer.h"
+#include "scene/resources/packed_scene.h"
+
+namespace TestPackedScene {
+
+// A typical projectile prefab: transformed root, a visual child, a lifetime timer and a
+// grouped hitbox node.
+static Ref<PackedScene> make_prefab() {
+
+    Node2D *root = memnew(Node2D);
+    root->set_name("Bullet");
+    root->set_position(Point2(10, 20));
+    root->set_rotation(0.5f);
+
+    Node2D *visual = memnew(Node2D);
+    visual->set_name("Visual");
+    visual->set_z_index(3);
+    root->add_child(visual);
+    visual->set_owner(root);
+
+    Timer *lifetime = memnew(Timer);
+    lifetime->set_name("Lifetime");
+    lifetime->set_wait_time(2.5f);
+    lifetime->set_one_shot(true);
+    root->add_child(lifetime);
+    lifetime->set_owner(root);
+
+    Node2D *hitbox = memnew(Node2D);
+    hitbox->set_name("Hitbox");
+    hitbox->set_position(Point2(0, -4));
+    hitbox->add_to_group("projectiles", true);
+    visual->add_child(hitbox);
+    hitbox->set_owner(root);
+
+    Ref<PackedScene> scene(make_ref_counted<PackedScene>());
+    Error err = scene->pack(root);
+    memdelete(root);
+    return err == OK ? scene : Ref<PackedScene>();
+}
+
+static bool check_instance(Node *p_root) {
+
+    Node2D *root = object_cast<Node2D>(p_root);
+    if (!root || root->get_name() != StringName("Bullet") || root->get_position() != Point2(10, 20) || root->get_child_count() != 2)
+        return false;
+
+    Node2D *visual = object_cast<Node2D>(root->get_node_or_null(NodePath("Visual")));
+    Timer *lifetime = object_cast<Timer>(root->get_node_or_null(NodePath("Lifetime")));
+    Node2D *hitbox = object_cast<Node2D>(root->get_node_or_null(NodePath("Visual/Hitbox")));
+    if (!visual || !lifetime || !hitbox)
+        return false;
+
+    return visual->get_z_index() == 3 && lifetime->get_wait_time() == 2.5f && lifetime->is_one_shot() &&
+           hitbox->get_position() == Point2(0, -4) && hitbox->is_in_group("projectiles") &&
+           visual->get_owner() == root && hitbox->get_owner() == root;
+}
+
+bool test_instance() {
+
+    Ref<PackedScene> scene = make_prefab();
+    if (!scene)
+        return false;
+
+    // first instance builds the plan, second one runs from it.
+    bool ok = true;
+    for (int i = 0; i < 2; i++) {
+        Node *node = scene->instance();
+        ok = ok && check_instance(node);
+        if (node)
+            memdelete(node);
+    }
+
+    // editing the state must drop the plan.
+    Ref<SceneState> state = scene->get_state();
+    int group = state->add_name("enemies");
+    state->add_node_group(0, group);
+    Node *node = scene->instance();
+    ok = ok && check_instance(node) && node->is_in_group("enemies");
+    if (node)
+        memdelete(node);
+
+    return ok;
+}
+
+bool test_pool() {
+
+    Ref<ScenePool> pool(make_ref_counted<ScenePool>());
+    pool->set_scene(make_prefab());
+    pool->prewarm(2);
+    bool ok = pool->get_available_count() == 2;
+
+    Node *first = pool->acquire();
+    ok = ok && check_instance(first) && pool->get_in_use_count() == 1;
+
+    // dirty it the way gameplay code would, then hand it back.
+    Node2D *root = object_cast<Node2D>(first);
+    root->set_position(Point2(-100, 5));
+    object_cast<Timer>(root->get_node(NodePath("Lifetime")))->set_wait_time(0.1f);
+    Node2D *visual = object_cast<Node2D>(root->get_node(NodePath("Visual")));
+    visual->set_rotation(1.0f);
+    pool->release(first);
+    ok = ok && pool->get_in_use_count() == 0 && pool->get_available_count() == 2;
+
+    Node *again = pool->acquire();
+    ok = ok && again == first && check_instance(again) && visual->get_rotation() == 0.0f;
+
+    // a broken instance is dropped rather than handed out again.
+    memdelete(visual);
+    pool->release(again);
+    Node *fresh = pool->acquire();
+    ok = ok && fresh != again && check_instance(fresh);
+    pool->release(fresh);
+
+    pool->clear();
+    ok = ok && pool->get_available_count() == 0;
+    return ok;
+}
+
+bool test_pool_release_twice() {
+
+    Ref<PackedScene> scene = make_prefab();
+    if (!scene)
+        return false;
+    Node *root = scene->instance();
+    root->set_meta("hits", Array());
+    scene->pack(root);
+    memdelete(root);
+
+    Ref<ScenePool> pool(make_ref_counted<ScenePool>());
+    pool->set_scene(scene);
+
+    Node *first = pool->acquire();
+    // containers are shared by reference, in place edits must not leak into the next use.
+    Array hits = first->get_meta("hits");
+    hits.push_back(1);
+    pool->release(first);
+    // a second release of the same node must not put it in the pool twice.
+    pool->release(first);
+    bool ok = pool->get_available_count() == 1 && pool->get_in_use_count() == 0;
+
+    Node *again = pool->acquire();
+    Node *other = pool->acquire();
+    ok = ok && again == first && other != first && again->get_meta("hits").as<Array>().empty();
+    pool->release(again);
+    pool->release(other);
+    return ok;
+}
+
+bool test_pool_release_then_free() {
+
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+    Ref<ScenePool> pool(make_ref_counted<ScenePool>());
+    pool->set_scene(make_prefab());
+
+    // queue_free() after release() must not leave the pooled node flagged for deletion.
+    Node *first = pool->acquire();
+    tree->get_root()->add_child(first);
+    pool->release(first);
+    first->queue_delete();
+    tree->idle(0);
+    bool ok = pool->get_available_count() == 1;
+
+    Node *again = pool->acquire();
+    ok = ok && again == first && !again->is_queued_for_deletion();
+    tree->get_root()->add_child(again);
+    again->queue_delete();
+    tree->idle(0);
+    ok = ok && pool->get_available_count() == 1 && pool->get_in_use_count() == 0 && !first->get_parent();
+
+    // freeing a pooled root, released or not, takes it out of the pool.
+    memdelete(pool->acquire());
+    ok = ok && pool->get_in_use_count() == 0 && pool->get_available_count() == 0;
+    Node *other = pool->acquire();
+    pool->release(other);
+    memdelete(other);
+    ok = ok && pool->get_available_count() == 0;
+    Node *fresh = pool->acquire();
+    ok = ok && check_instance(fresh);
+    pool->release(fresh);
+    pool->clear();
+
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+bool test_benchmark() {
+
+    Ref<PackedScene> scene = make_prefab();
+    if (!scene)
+        return false;
+
+    const int count = 20000;
+    Vector<Node *> spawned;
+    spawned.reserve(count);
+
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < count; i++) {
+        spawned.push_back(scene->instance());
+    }
+    uint64_t spawn_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    t = OS::get_singleton()->get_ticks_usec();
+    for (Node *n : spawned) {
+        memdelete(n);
+    }
+    uint64_t free_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    Ref<ScenePool> pool(make_ref_counted<ScenePool>());
+    pool->set_scene(scene);
+    pool->set_max_size(count);
+    pool->prewarm(count);
+    t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < count; i++) {
+        spawned[i] = pool->acquire();
+    }
+    uint64_t acquire_time = OS::get_singleton()->get_ticks_usec() - t;
+    t = OS::get_singleton()->get_ticks_usec();
+    for (Node *n : spawned) {
+        pool->release(n);
+    }
+    uint64_t release_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    OS::get_singleton()->print(FormatVE("\t%d instances of a 4 node prefab: %.2f us each (%.0f instances/sec), free %.2f us each\n",
+            count, double(spawn_time) / count, count * 1000000.0 / MAX(spawn_time, uint64_t(1)), double(free_time) / count));
+    OS::get_singleton()->print(FormatVE("\tScenePool: acquire %.2f us each, release %.2f us each\n",
+            double(acquire_time) / count, double(release_time) / count));
+    return true;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_instance,
+    test_pool,
+    test_pool_release_twice,
+    test_pool_release_then_free,
+    test_benchmark,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestPackedScene
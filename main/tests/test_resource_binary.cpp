@@ -0,0 +1,322 @@
+/*************************************************************************/
+/*  test_resource_binary.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_binary.h"
+
+#include "core/color.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/math/math_funcs.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/pool_vector.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "scene/resources/animation.h"
+
+namespace TestResourceBinary {
+
+static String test_path() {
+
+    return PathUtils::plus_file(OS::get_singleton()->get_user_data_dir(), "test_resource_binary.res");
+}
+
+// Laid out like an ArrayMesh surface, kept on a plain resource so no rendering server is needed.
+static Ref<Resource> make_mesh(int p_vertices) {
+
+    PoolVector<Vector3> vertices;
+    PoolVector<Vector3> normals;
+    PoolVector<real_t> tangents;
+    PoolVector<Color> colors;
+    PoolVector<Vector2> uvs;
+    PoolVector<int> indices;
+    PoolVector<uint8_t> bones;
+    for (int i = 0; i < p_vertices; i++) {
+        float a = i * 0.01f;
+        vertices.push_back(Vector3(Math::sin(a) * 10, i * 0.001f, Math::cos(a) * 10));
+        normals.push_back(Vector3(Math::sin(a), 0, Math::cos(a)));
+        tangents.push_back(Math::cos(a));
+        tangents.push_back(0);
+        tangents.push_back(-Math::sin(a));
+        tangents.push_back(1);
+        colors.push_back(Color(1, float(i % 256) / 255, 0.5f, 1));
+        uvs.push_back(Vector2(float(i % 1024) / 1024, float(i / 1024) / 1024));
+        indices.push_back(i);
+        indices.push_back((i + 1) % p_vertices);
+        indices.push_back((i + 2) % p_vertices);
+        bones.push_back(i % 4);
+    }
+
+    Array surface;
+    surface.push_back(vertices);
+    surface.push_back(normals);
+    surface.push_back(tangents);
+    surface.push_back(colors);
+    surface.push_back(Variant(uvs));
+    surface.push_back(indices);
+    surface.push_back(bones);
+    // small arrays stay inline
+    PoolVector<int> lods;
+    lods.push_back(p_vertices);
+    surface.push_back(lods);
+
+    Ref<Resource> mesh(make_ref_counted<Resource>());
+    mesh->set_meta("surface", surface);
+    return mesh;
+}
+
+static Ref<Animation> make_animation(int p_tracks, int p_keys) {
+
+    Ref<Animation> anim(make_ref_counted<Animation>());
+    anim->set_length(p_keys / 30.0f);
+    for (int t = 0; t < p_tracks; t++) {
+        int track = anim->add_track(Animation::TYPE_TRANSFORM);
+        anim->track_set_path(track, NodePath(String("Skeleton:bone_") + itos(t)));
+        for (int k = 0; k < p_keys; k++) {
+            float a = (k + t) * 0.05f;
+            anim->transform_track_insert_key(track, k / 30.0f, Vector3(t, Math::sin(a), 0), Quat(Vector3(0, 1, 0), a), Vector3(1, 1, 1));
+        }
+    }
+    return anim;
+}
+
+static bool same_mesh(const Ref<Resource> &p_a, const Ref<Resource> &p_b) {
+
+    if (!p_a || !p_b)
+        return false;
+    Array a = p_a->get_meta("surface");
+    Array b = p_b->get_meta("surface");
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); i++) {
+        if (a[i].get_type() != b[i].get_type() || !bool(Variant::evaluate(Variant::OP_EQUAL, a[i], b[i])))
+            return false;
+    }
+    return true;
+}
+
+static bool same_animation(const Ref<Animation> &p_a, const Ref<Animation> &p_b) {
+
+    if (!p_a || !p_b || p_a->get_track_count() != p_b->get_track_count())
+        return false;
+    for (int t = 0; t < p_a->get_track_count(); t++) {
+        if (p_a->track_get_key_count(t) != p_b->track_get_key_count(t) || p_a->track_get_path(t) != p_b->track_get_path(t))
+            return false;
+        for (int k = 0; k < p_a->track_get_key_count(t); k++) {
+            Vector3 loc_a, loc_b, scale_a, scale_b;
+            Quat rot_a, rot_b;
+            p_a->transform_track_get_key(t, k, &loc_a, &rot_a, &scale_a);
+            p_b->transform_track_get_key(t, k, &loc_b, &rot_b, &scale_b);
+            if (loc_a != loc_b || rot_a != rot_b || scale_a != scale_b || p_a->track_get_key_time(t, k) != p_b->track_get_key_time(t, k))
+                return false;
+        }
+    }
+    return true;
+}
+
+static uint64_t file_size(se_string_view p_path) {
+
+    FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+    return f ? f->get_len() : 0;
+}
+
+static const uint32_t save_modes[] = { 0, ResourceSaver::FLAG_COMPRESS_BULK_ARRAYS, ResourceSaver::FLAG_COMPRESS };
+static const char *save_mode_names[] = { "raw sections", "zstd sections", "compressed file" };
+
+bool test_roundtrip() {
+
+    Ref<Resource> mesh = make_mesh(5000);
+    Ref<Animation> anim = make_animation(8, 200);
+    String path = test_path();
+
+    bool ok = true;
+    for (uint32_t flags : save_modes) {
+        ok = ok && ResourceSaver::save(path, mesh, flags) == OK;
+        ok = ok && same_mesh(mesh, dynamic_ref_cast<Resource>(ResourceLoader::load(path, "", true)));
+        ok = ok && ResourceSaver::save(path, anim, flags) == OK;
+        ok = ok && same_animation(anim, dynamic_ref_cast<Animation>(ResourceLoader::load(path, "", true)));
+    }
+
+    DirAccess::remove_file_or_error(path);
+    return ok;
+}
+
+// Rewrites one field of the first bulk array reference (type 42, array type, length, section) with p_length elements.
+static bool patch_bulk_array(se_string_view p_path, int p_length, int p_field, uint32_t p_value) {
+
+    Vector<uint8_t> data;
+    {
+        FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+        if (!f)
+            return false;
+        data.resize(f->get_len());
+        f->get_buffer(data.data(), data.size());
+    }
+
+    for (size_t i = 0; i + 16 <= data.size(); i++) {
+        if (decode_uint32(&data[i]) != 42 || decode_uint32(&data[i + 8]) != uint32_t(p_length))
+            continue;
+        encode_uint32(p_value, &data[i + 4 + p_field * 4]);
+        FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE);
+        if (!f)
+            return false;
+        f->store_buffer(data.data(), data.size());
+        return true;
+    }
+    return false;
+}
+
+// Rewrites the bulk section table offset in the header (p_count false) or the section count the table starts with.
+static bool patch_bulk_table(se_string_view p_path, bool p_count, uint64_t p_value) {
+
+    Vector<uint8_t> data;
+    {
+        FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+        if (!f)
+            return false;
+        data.resize(f->get_len());
+        f->get_buffer(data.data(), data.size());
+    }
+
+    // magic, endianness, real64, version major, minor and format, then the type name and the metadata offset
+    if (data.size() < 28)
+        return false;
+    uint64_t table_field = 28 + decode_uint32(&data[24]) + 8;
+    if (table_field + 8 > data.size())
+        return false;
+    uint64_t table_ofs = decode_uint64(&data[table_field]);
+    if (!table_ofs || table_ofs + 4 > data.size())
+        return false;
+
+    if (p_count)
+        encode_uint32(uint32_t(p_value), &data[table_ofs]);
+    else
+        encode_uint64(p_value, &data[table_field]);
+
+    FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE);
+    if (!f)
+        return false;
+    f->store_buffer(data.data(), data.size());
+    return true;
+}
+
+bool test_corrupt_bulk_array() {
+
+    // a bogus length or section must be rejected before the array is allocated
+    Ref<Resource> mesh = make_mesh(5000);
+    String path = test_path();
+
+    bool ok = true;
+    const uint32_t patches[][2] = { { 1, 0x7FFFFFFF }, { 1, 4999 }, { 2, 0xFFFF } };
+    for (const auto &patch : patches) {
+        ok = ok && ResourceSaver::save(path, mesh, 0) == OK;
+        ok = ok && patch_bulk_array(path, 5000, patch[0], patch[1]);
+        Error err = OK;
+        RES loaded = ResourceLoader::load(path, "", true, &err);
+        ok = ok && !loaded && err != OK;
+    }
+
+    // a section count or table offset pointing past the end of the file must fail before the table is allocated
+    const uint64_t table_patches[][2] = { { 1, 0xFFFFFFFF }, { 1, 0x10000 }, { 0, 0xFFFFFFFFFFFFull } };
+    for (const auto &patch : table_patches) {
+        ok = ok && ResourceSaver::save(path, mesh, 0) == OK;
+        ok = ok && patch_bulk_table(path, patch[0] != 0, patch[1]);
+        Error err = OK;
+        RES loaded = ResourceLoader::load(path, "", true, &err);
+        ok = ok && !loaded && err != OK;
+    }
+
+    DirAccess::remove_file_or_error(path);
+    return ok;
+}
+
+static void benchmark_load(const char *p_what, const RES &p_res) {
+
+    String path = test_path();
+    const int loads = 10;
+
+    for (int i = 0; i < 3; i++) {
+        ResourceSaver::save(path, p_res, save_modes[i]);
+        uint64_t size = file_size(path);
+
+        uint64_t t = OS::get_singleton()->get_ticks_usec();
+        for (int j = 0; j < loads; j++) {
+            RES loaded = ResourceLoader::load(path, "", true);
+        }
+        uint64_t load_time = OS::get_singleton()->get_ticks_usec() - t;
+
+        OS::get_singleton()->print(FormatVE("\t%s, %s: %.1f KiB, load %.2f ms\n", p_what, save_mode_names[i],
+                size / 1024.0, load_time / 1000.0 / loads));
+    }
+
+    DirAccess::remove_file_or_error(path);
+}
+
+bool test_benchmark() {
+
+    benchmark_load("mesh with 200000 vertices", make_mesh(200000));
+    benchmark_load("animation with 60 tracks of 1000 keys", make_animation(60, 1000));
+    return true;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_roundtrip,
+    test_corrupt_bulk_array,
+    test_benchmark,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestResourceBinary
@@ -0,0 +1,257 @@
+/*************************************************************************/
+/*  test_resource_cache.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_cache.h"
+
+#include "core/image.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/resource.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+#include "core/typedefs.h"
+
+namespace TestResourceCache {
+
+static String test_path(int p_index) {
+
+    return PathUtils::plus_file(OS::get_singleton()->get_user_data_dir(), "test_resource_cache_" + itos(p_index) + ".res");
+}
+
+static bool cached(int p_index) {
+
+    return ResourceCache::has(test_path(p_index));
+}
+
+static void touch(int p_index) {
+
+    RES res = ResourceLoader::load(test_path(p_index));
+}
+
+bool test_budget() {
+
+    const int count = 4;
+    for (int i = 0; i < count; i++) {
+        Ref<Image> img(make_ref_counted<Image>());
+        img->create(512, 512, false, Image::FORMAT_RGBA8); // 1 MiB each
+        if (ResourceSaver::save(test_path(i), img) != OK)
+            return false;
+    }
+
+    uint64_t old_budget = ResourceCache::get_memory_budget();
+    ResourceCache::set_memory_budget(5 * 512 * 1024);
+
+    // released right away, the budget keeps the two most recent
+    for (int i = 0; i < count; i++) {
+        touch(i);
+    }
+    bool ok = !cached(0) && !cached(1) && cached(2) && cached(3);
+    ok = ok && ResourceCache::get_soft_cached_memory() <= ResourceCache::get_memory_budget();
+
+    // reuse moves 2 to the back, so 3 goes when 0 comes back
+    touch(2);
+    touch(0);
+    ok = ok && cached(0) && cached(2) && !cached(3);
+
+    // in use resources are never dropped
+    RES held = ResourceLoader::load(test_path(2));
+    ResourceCache::set_memory_budget(1);
+    ok = ok && cached(2) && !cached(0);
+
+    Vector<ResourceCache::Residency> residency;
+    ResourceCache::get_residency(residency);
+    bool found = false;
+    for (const ResourceCache::Residency &r : residency) {
+        if (r.path == test_path(2)) {
+            found = true;
+            ok = ok && r.soft_cached && r.reference_count == 1 && r.memory_usage >= 512 * 512 * 4 && r.type == StringName("Image");
+        }
+    }
+    ok = ok && found;
+
+    held = RES();
+    ResourceCache::trim();
+    ok = ok && !cached(2);
+
+    ResourceCache::set_memory_budget(old_budget);
+    for (int i = 0; i < count; i++) {
+        DirAccess::remove_file_or_error(test_path(i));
+    }
+    return ok;
+}
+
+bool test_unreported_usage() {
+
+    // plain resources report no memory, the minimum charge per entry still has to evict them
+    const int count = 16;
+    for (int i = 0; i < count; i++) {
+        Ref<Resource> res(make_ref_counted<Resource>());
+        res->set_meta("index", i);
+        if (ResourceSaver::save(test_path(200 + i), res) != OK)
+            return false;
+    }
+
+    uint64_t old_budget = ResourceCache::get_memory_budget();
+    ResourceCache::set_memory_budget(64 * 1024);
+
+    for (int i = 0; i < count; i++) {
+        touch(200 + i);
+    }
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (cached(200 + i))
+            kept++;
+    }
+    bool ok = kept > 0 && kept < count && cached(200 + count - 1);
+    ok = ok && ResourceCache::get_soft_cached_memory() <= ResourceCache::get_memory_budget();
+
+    ResourceCache::set_memory_budget(old_budget);
+    for (int i = 0; i < count; i++) {
+        DirAccess::remove_file_or_error(test_path(200 + i));
+    }
+    return ok;
+}
+
+struct LoadStressThread {
+    const Vector<String> *paths;
+    const Vector<RES> *expected;
+    int iterations;
+    uint32_t seed;
+    int mismatches;
+};
+
+static void load_stress_thread(void *p_userdata) {
+
+    LoadStressThread *t = static_cast<LoadStressThread *>(p_userdata);
+    uint32_t rnd = t->seed;
+    for (int i = 0; i < t->iterations; i++) {
+        rnd = rnd * 1664525 + 1013904223;
+        size_t which = (rnd >> 8) % t->paths->size();
+        RES res = ResourceLoader::load((*t->paths)[which]);
+        if (res != (*t->expected)[which])
+            t->mismatches++;
+    }
+}
+
+// Returns false if any thread got a different resource than the cached one.
+static bool run_load_stress(int p_threads, const Vector<String> &p_paths, const Vector<RES> &p_expected, int p_iterations) {
+
+    Vector<LoadStressThread> data(p_threads);
+    Vector<Thread *> threads;
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < p_threads; i++) {
+        data[i] = { &p_paths, &p_expected, p_iterations, uint32_t(i + 1) * 7919, 0 };
+        Thread *thread = Thread::create(load_stress_thread, &data[i]);
+        if (!thread) {
+            load_stress_thread(&data[i]); // no threading support
+            continue;
+        }
+        threads.push_back(thread);
+    }
+    for (Thread *thread : threads) {
+        Thread::wait_to_finish(thread);
+        memdelete(thread);
+    }
+    uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - t, uint64_t(1));
+
+    int mismatches = 0;
+    for (const LoadStressThread &d : data) {
+        mismatches += d.mismatches;
+    }
+    uint64_t loads = uint64_t(p_threads) * p_iterations;
+    OS::get_singleton()->print(FormatVE("\t%d threads: %d cached loads in %d msec, %d loads/sec\n", p_threads, int(loads),
+            int(usec / 1000), int(loads * 1000000 / usec)));
+    return mismatches == 0;
+}
+
+// Many threads loading already cached resources, the common case when streaming scenes in the background.
+bool test_concurrent_load() {
+
+    const int count = 64;
+    const int iterations = 50000;
+    Vector<String> paths;
+    Vector<RES> expected;
+    for (int i = 0; i < count; i++) {
+        Ref<Image> img(make_ref_counted<Image>());
+        img->create(4, 4, false, Image::FORMAT_RGBA8);
+        paths.push_back(test_path(100 + i));
+        if (ResourceSaver::save(paths.back(), img) != OK)
+            return false;
+        expected.push_back(ResourceLoader::load(paths.back()));
+        if (!expected.back())
+            return false;
+    }
+
+    bool ok = run_load_stress(1, paths, expected, iterations);
+    int thread_count = MAX(OS::get_singleton()->get_processor_count(), 2);
+    ok = ok && run_load_stress(thread_count, paths, expected, iterations);
+
+    expected.clear();
+    for (const String &path : paths) {
+        DirAccess::remove_file_or_error(path);
+    }
+    return ok;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_budget,
+    test_unreported_usage,
+    test_concurrent_load,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestResourceCache
@@ -0,0 +1,258 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_loader.h"
+
+#include "core/image.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/job_system.h"
+#include "core/os/os.h"
+#include "core/resource.h"
+#include "core/string_formatter.h"
+#include "core/string_utils.h"
+
+namespace TestResourceLoader {
+
+static String test_path(const char *p_name) {
+
+    return PathUtils::plus_file(OS::get_singleton()->get_user_data_dir(), String("test_resource_loader_") + p_name + ".res");
+}
+
+// "main" references an image saved at its own path, so it loads as an external dependency.
+static bool save_with_dependency() {
+
+    Ref<Image> img(make_ref_counted<Image>());
+    img->create(16, 16, false, Image::FORMAT_RGBA8);
+    if (ResourceSaver::save(test_path("image"), img) != OK)
+        return false;
+    RES dep = ResourceLoader::load(test_path("image"));
+    if (!dep)
+        return false;
+
+    Ref<Resource> res(make_ref_counted<Resource>());
+    res->set_meta("image", Variant(dep.get_ref_ptr()));
+    return ResourceSaver::save(test_path("main"), res) == OK;
+}
+
+static void remove_files() {
+
+    DirAccess::remove_file_or_error(test_path("image"));
+    DirAccess::remove_file_or_error(test_path("main"));
+    DirAccess::remove_file_or_error(test_path("cycle_a"));
+    DirAccess::remove_file_or_error(test_path("cycle_b"));
+}
+
+static bool has_dependency(const RES &p_res) {
+
+    if (!p_res)
+        return false;
+    Ref<Image> img = refFromVariant<Image>(p_res->get_meta("image"));
+    return img && img->get_path() == test_path("image") && img->get_width() == 16;
+}
+
+bool test_shared_request() {
+
+    if (!save_with_dependency())
+        return false;
+    // nothing may come straight out of the cache
+    ResourceCache::release_soft_references();
+
+    String path = test_path("main");
+    ResourceLoader::load_threaded_request(path);
+    ResourceLoader::load_threaded_request(path);
+    bool ok = ResourceLoader::load_threaded_get_status(path) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+    Error err = FAILED;
+    RES first = ResourceLoader::load_threaded_get(path, &err);
+    ok = ok && err == OK && has_dependency(first);
+    // the second request still holds the result
+    ok = ok && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_LOADED;
+
+    err = FAILED;
+    RES second = ResourceLoader::load_threaded_get(path, &err);
+    ok = ok && err == OK && second == first;
+    ok = ok && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+    first = RES();
+    second = RES();
+    ResourceCache::release_soft_references();
+    remove_files();
+    return ok;
+}
+
+bool test_sub_threads() {
+
+    if (!save_with_dependency())
+        return false;
+    ResourceCache::release_soft_references();
+
+    String path = test_path("main");
+    ResourceLoader::load_threaded_request(path, se_string_view(), true);
+    float progress = -1;
+    ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(path, &progress);
+    bool ok = status != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE && progress >= 0 && progress <= 1;
+
+    Error err = FAILED;
+    RES res = ResourceLoader::load_threaded_get(path, &err);
+    ok = ok && err == OK && has_dependency(res);
+    // the dependency was loaded by its own task, which is gone along with the request
+    ok = ok && ResourceCache::has(test_path("image"));
+    ok = ok && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+    ok = ok && ResourceLoader::load_threaded_get_status(test_path("image")) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+    res = RES();
+    ResourceCache::release_soft_references();
+    remove_files();
+    return ok;
+}
+
+bool test_circular() {
+
+    Ref<Resource> a(make_ref_counted<Resource>());
+    Ref<Resource> b(make_ref_counted<Resource>());
+    a->set_path(test_path("cycle_a"));
+    b->set_path(test_path("cycle_b"));
+    a->set_meta("other", Variant(b.get_ref_ptr()));
+    b->set_meta("other", Variant(a.get_ref_ptr()));
+    bool ok = ResourceSaver::save(test_path("cycle_a"), a) == OK && ResourceSaver::save(test_path("cycle_b"), b) == OK;
+    a->remove_meta("other");
+    b->remove_meta("other");
+    a = Ref<Resource>();
+    b = Ref<Resource>();
+    ResourceCache::release_soft_references();
+    if (!ok) {
+        remove_files();
+        return false;
+    }
+
+    // each task depends on the other; the request has to come back either way
+    String path = test_path("cycle_a");
+    ResourceLoader::load_threaded_request(path, se_string_view(), true);
+    RES res = ResourceLoader::load_threaded_get(path);
+    ok = ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+    if (res) {
+        Ref<Resource> other = refFromVariant<Resource>(res->get_meta("other"));
+        if (other)
+            other->remove_meta("other");
+        res->remove_meta("other");
+    }
+    res = RES();
+    ResourceCache::release_soft_references();
+    remove_files();
+    return ok;
+}
+
+bool test_unrequested() {
+
+    bool ok = ResourceLoader::load_threaded_get_status(test_path("never_requested")) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+
+    // a dependency loaded for someone else does not count as requested either
+    ok = ok && save_with_dependency();
+    ResourceCache::release_soft_references();
+    ResourceLoader::load_threaded_request(test_path("main"), se_string_view(), true);
+    ok = ok && ResourceLoader::load_threaded_get_status(test_path("image")) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+    RES res = ResourceLoader::load_threaded_get(test_path("main"));
+    ok = ok && has_dependency(res);
+
+    res = RES();
+    ResourceCache::release_soft_references();
+    remove_files();
+    return ok;
+}
+
+bool test_no_workers() {
+
+    if (!save_with_dependency())
+        return false;
+    String path = test_path("main");
+
+    // without a job system the request loads right away on the requesting thread
+    JobSystem *previous = JobSystem::replace_singleton(nullptr);
+    ResourceCache::release_soft_references();
+    ResourceLoader::load_threaded_request(path, se_string_view(), true);
+    bool ok = ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_LOADED;
+    RES res = ResourceLoader::load_threaded_get(path);
+    ok = ok && has_dependency(res);
+    res = RES();
+
+    // a job system without workers runs each job as it is submitted, sub tasks included
+    JobSystem *inline_js = memnew_args(JobSystem, 0);
+    JobSystem::replace_singleton(inline_js);
+    ResourceCache::release_soft_references();
+    ResourceLoader::load_threaded_request(path, se_string_view(), true);
+    ok = ok && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_LOADED;
+    res = ResourceLoader::load_threaded_get(path);
+    ok = ok && has_dependency(res);
+    res = RES();
+
+    JobSystem::replace_singleton(previous);
+    memdelete(inline_js);
+    ResourceCache::release_soft_references();
+    remove_files();
+    return ok;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_shared_request,
+    test_sub_threads,
+    test_circular,
+    test_unrequested,
+    test_no_workers,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestResourceLoader
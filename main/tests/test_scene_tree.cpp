@@ -0,0 +1,309 @@
+/*************************************************************************/
+/*  test_scene_tree.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_scene_tree.h"
+
+#include "core/deque.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+// Records how each process notification reaches it, either through the notification chain or the
+// direct callback it registers.
+class TestProcessNode : public Node {
+
+    GDCLASS(TestProcessNode, Node)
+
+public:
+    static Vector<TestProcessNode *> direct_order;
+    int notified = 0;
+    float direct_delta = 0;
+
+protected:
+    static void _bind_methods() {
+    }
+
+    void _notification(int p_what) {
+        if (p_what == NOTIFICATION_PROCESS)
+            notified++;
+    }
+
+    static void _direct_process(Node *p_node, float p_delta) {
+        TestProcessNode *node = static_cast<TestProcessNode *>(p_node);
+        node->direct_delta = p_delta;
+        direct_order.push_back(node);
+    }
+
+public:
+    void use_direct_process() {
+        _set_direct_process_func(NOTIFICATION_PROCESS, _direct_process);
+    }
+};
+
+Vector<TestProcessNode *> TestProcessNode::direct_order;
+
+IMPL_GDCLASS(TestProcessNode)
+
+// Changes the process group while it is being dispatched: turns off a later node, frees an earlier
+// one and removes and re-adds itself.
+class TestMutatingNode : public Node {
+
+    GDCLASS(TestMutatingNode, Node)
+
+public:
+    static Vector<TestMutatingNode *> order;
+    TestMutatingNode *disable_later = nullptr;
+    TestMutatingNode *free_earlier = nullptr;
+
+protected:
+    static void _bind_methods() {
+    }
+
+    void _notification(int p_what) {
+        if (p_what != NOTIFICATION_PROCESS)
+            return;
+        order.push_back(this);
+        if (disable_later) {
+            disable_later->set_process(false);
+            disable_later = nullptr;
+        }
+        if (free_earlier) {
+            free_earlier->get_parent()->remove_child(free_earlier);
+            memdelete(free_earlier);
+            free_earlier = nullptr;
+            set_process(false);
+            set_process(true);
+        }
+    }
+};
+
+Vector<TestMutatingNode *> TestMutatingNode::order;
+
+IMPL_GDCLASS(TestMutatingNode)
+
+// Moves itself and joins a group from its threaded process callback, and records which thread ran
+// its internal processing.
+class TestMovingNode : public Node2D {
+
+    GDCLASS(TestMovingNode, Node2D)
+
+public:
+    Thread::ID internal_thread = 0;
+    int transform_changed = 0;
+
+protected:
+    static void _bind_methods() {
+    }
+
+    void _notification(int p_what) {
+        switch (p_what) {
+            case NOTIFICATION_PROCESS: {
+                set_position(get_position() + Vector2(1, 0));
+                add_to_group("moved");
+            } break;
+            case NOTIFICATION_INTERNAL_PROCESS: {
+                internal_thread = Thread::get_caller_id();
+            } break;
+            case NOTIFICATION_TRANSFORM_CHANGED: {
+                get_global_transform(); // clears the invalid flag, so the next move notifies again
+                transform_changed++;
+            } break;
+        }
+    }
+};
+
+IMPL_GDCLASS(TestMovingNode)
+
+namespace TestSceneTree {
+
+bool test_direct_process() {
+
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+
+    // added out of priority order, with a plain node in between.
+    const int priorities[3] = { 2, -1, 1 };
+    TestProcessNode *direct[3];
+    for (int i = 0; i < 3; i++) {
+        direct[i] = memnew(TestProcessNode);
+        direct[i]->use_direct_process();
+        direct[i]->set_process_priority(priorities[i]);
+        direct[i]->set_process(true);
+        tree->get_root()->add_child(direct[i]);
+    }
+    TestProcessNode *plain = memnew(TestProcessNode);
+    plain->set_process(true);
+    tree->get_root()->add_child(plain);
+
+    TestProcessNode::direct_order.clear();
+    tree->idle(0.25f);
+
+    const Vector<TestProcessNode *> &order = TestProcessNode::direct_order;
+    bool ok = order.size() == 3 && order[0] == direct[1] && order[1] == direct[2] && order[2] == direct[0];
+    for (TestProcessNode *node : direct) {
+        ok = ok && node->notified == 0 && node->direct_delta == 0.25f;
+    }
+    ok = ok && plain->notified == 1;
+
+    TestProcessNode::direct_order.clear();
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+bool test_group_changes_during_dispatch() {
+
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+
+    // added out of priority order, the actor runs in the middle.
+    const int priorities[5] = { 1, -2, 2, 0, -1 };
+    TestMutatingNode *nodes[5];
+    for (int i = 0; i < 5; i++) {
+        nodes[i] = memnew(TestMutatingNode);
+        nodes[i]->set_process_priority(priorities[i]);
+        nodes[i]->set_process(true);
+        tree->get_root()->add_child(nodes[i]);
+    }
+    TestMutatingNode *earlier = nodes[1]; // -2
+    TestMutatingNode *before = nodes[4]; // -1
+    TestMutatingNode *actor = nodes[3]; // 0
+    TestMutatingNode *later = nodes[0]; // 1
+    TestMutatingNode *last = nodes[2]; // 2
+    actor->disable_later = later;
+    actor->free_earlier = earlier;
+
+    // the actor re-added itself past the dispatched range, so it is not notified twice.
+    TestMutatingNode::order.clear();
+    tree->idle(0.1f);
+    const Vector<TestMutatingNode *> &order = TestMutatingNode::order;
+    bool ok = order.size() == 4 && order[0] == earlier && order[1] == before && order[2] == actor && order[3] == last;
+
+    // sorted by priority again on the next dispatch, without the freed and disabled nodes.
+    TestMutatingNode::order.clear();
+    tree->idle(0.1f);
+    ok = ok && order.size() == 3 && order[0] == before && order[1] == actor && order[2] == last;
+
+    // the tombstones were compacted, otherwise the group would not empty out.
+    before->set_process(false);
+    actor->set_process(false);
+    last->set_process(false);
+    ok = ok && !tree->has_group("idle_process");
+
+    TestMutatingNode::order.clear();
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+bool test_threaded_nodes_moving_themselves() {
+
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+
+    const int count = 64;
+    TestMovingNode *nodes[count];
+    TestMovingNode *children[count];
+    for (int i = 0; i < count; i++) {
+        nodes[i] = memnew(TestMovingNode);
+        nodes[i]->set_notify_transform(true);
+        nodes[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+        nodes[i]->set_process(true);
+        nodes[i]->set_process_internal(true);
+        children[i] = memnew(TestMovingNode);
+        children[i]->set_notify_transform(true);
+        nodes[i]->add_child(children[i]);
+        tree->get_root()->add_child(nodes[i]);
+    }
+
+    // the first frame also flushes the notifications queued when entering the tree.
+    tree->idle(0.1f);
+    for (int i = 0; i < count; i++) {
+        nodes[i]->get_global_transform();
+        children[i]->get_global_transform();
+        nodes[i]->transform_changed = 0;
+        children[i]->transform_changed = 0;
+    }
+    tree->idle(0.1f);
+
+    // every move made it into the change list, including the ones queued for the children.
+    bool ok = true;
+    for (int i = 0; i < count; i++) {
+        ok = ok && nodes[i]->get_position() == Vector2(2, 0);
+        ok = ok && nodes[i]->transform_changed == 1 && children[i]->transform_changed == 1;
+        ok = ok && nodes[i]->internal_thread == Thread::get_main_id();
+        ok = ok && nodes[i]->is_in_group("moved") && !children[i]->is_in_group("moved");
+    }
+
+    Deque<Node *> moved;
+    tree->get_nodes_in_group("moved", &moved);
+    ok = ok && moved.size() == count;
+
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_direct_process,
+    test_group_changes_during_dispatch,
+    test_threaded_nodes_moving_themselves,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestSceneTree
@@ -0,0 +1,324 @@
+/*************************************************************************/
+/*  test_timer_wheel.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_timer_wheel.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/string_formatter.h"
+#include "core/vector.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/timer.h"
+#include "scene/main/timer_wheel.h"
+
+// Restarts or stops its Timer and starts a SceneTreeTimer cooldown from a threaded physics process callback.
+class TestTimerOwner : public Node {
+
+    GDCLASS(TestTimerOwner, Node)
+
+public:
+    Timer *timer = nullptr;
+    bool stop_timer = false;
+    Ref<SceneTreeTimer> cooldown;
+
+protected:
+    static void _bind_methods() {
+    }
+
+    void _notification(int p_what) {
+        if (p_what != NOTIFICATION_PHYSICS_PROCESS)
+            return;
+        if (stop_timer)
+            timer->stop();
+        else
+            timer->start(2.0f);
+        cooldown = get_tree()->create_timer(0.5f);
+    }
+};
+
+IMPL_GDCLASS(TestTimerOwner)
+
+namespace TestTimerWheel {
+
+struct TestTimer {
+    TimerWheel::Item item;
+    double deadline = 0;
+    double period = 0; // reschedules itself when not zero
+    int fired = 0;
+    bool late = false;
+
+    static void expire(TimerWheel::Item *p_item, TimerWheel *p_wheel) {
+        TestTimer *timer = static_cast<TestTimer *>(p_item->userdata);
+        timer->fired++;
+        // must fire on the first advance past the deadline, never before
+        if (!(timer->deadline < p_wheel->get_time()))
+            timer->late = true;
+        if (timer->period > 0) {
+            timer->deadline += timer->period;
+            p_wheel->schedule_at(p_item, timer->deadline);
+        }
+    }
+
+    TestTimer() :
+            item(expire, this) {}
+};
+
+static uint32_t next_random(uint32_t &r_state) {
+    r_state = r_state * 1664525u + 1013904223u;
+    return r_state >> 8;
+}
+
+bool test_expiry_matches_linear() {
+
+    // delays up to ~6 hours so the coarsest level and the overflow list are exercised too
+    const int count = 4000;
+    Vector<TestTimer> timers(count);
+    TimerWheel wheel;
+    uint32_t rnd = 12345;
+
+    for (int i = 0; i < count; i++) {
+        double delay;
+        switch (i % 4) {
+            case 0: delay = (next_random(rnd) % 1000) / 1000.0; break;
+            case 1: delay = (next_random(rnd) % 60000) / 1000.0; break;
+            case 2: delay = (next_random(rnd) % 600000) / 100.0; break;
+            default: delay = (next_random(rnd) % 2200000) / 100.0; break;
+        }
+        timers[i].deadline = delay;
+        wheel.schedule(&timers[i].item, delay);
+    }
+
+    double time = 0;
+    while (wheel.get_scheduled_count() > 0) {
+        // uneven frame times, with the occasional long hitch
+        double delta = (next_random(rnd) % 100 == 0) ? 3.5 : 0.016 + (next_random(rnd) % 100) / 10000.0;
+        time += delta;
+        wheel.advance(delta);
+        for (int i = 0; i < count; i++) {
+            const TestTimer &t = timers[i];
+            if ((t.deadline < time) != (t.fired == 1) || t.fired > 1 || t.late) {
+                OS::get_singleton()->print(FormatVE("\ttimer %d (deadline %f) fired %d times at %f\n", i, t.deadline, t.fired, time));
+                return false;
+            }
+        }
+        if (time > 30000) {
+            OS::get_singleton()->print("\ttimers left behind\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_cancel_and_reschedule() {
+
+    TimerWheel wheel;
+    TestTimer periodic, cancelled, moved;
+
+    periodic.deadline = 0.1;
+    periodic.period = 0.1;
+    wheel.schedule(&periodic.item, 0.1);
+    cancelled.deadline = 0.5;
+    wheel.schedule(&cancelled.item, 0.5);
+    moved.deadline = 10;
+    wheel.schedule(&moved.item, 10);
+
+    for (int i = 0; i < 25; i++)
+        wheel.advance(0.01); // 0.25s
+    bool ok = periodic.fired == 2 && cancelled.fired == 0 && moved.fired == 0;
+
+    wheel.cancel(&cancelled.item);
+    ok = ok && !cancelled.item.is_scheduled();
+    // reschedule the long timer closer, relative to the current time
+    moved.deadline = wheel.get_time() + 0.05;
+    wheel.schedule(&moved.item, 0.05);
+    ok = ok && Math::is_equal_approx(moved.item.get_time_left(), 0.05);
+
+    for (int i = 0; i < 100; i++)
+        wheel.advance(0.01); // 1.25s
+    ok = ok && periodic.fired == 12 && cancelled.fired == 0 && moved.fired == 1 && !periodic.late && !moved.late;
+
+    periodic.period = 0;
+    wheel.clear();
+    ok = ok && wheel.get_scheduled_count() == 0 && !periodic.item.is_scheduled();
+    return ok;
+}
+
+bool test_timer_pause_mode() {
+
+    // the pause menu pattern: the tree is paused, then the menu holding the timer is switched to process.
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+    Node *menu = memnew(Node);
+    tree->get_root()->add_child(menu);
+    Timer *timer = memnew(Timer);
+    menu->add_child(timer);
+    timer->start(1.0f);
+
+    tree->set_pause(true);
+    tree->idle(0.25f);
+    bool ok = Math::is_equal_approx(timer->get_time_left(), 1.0f);
+
+    menu->set_pause_mode(Node::PAUSE_MODE_PROCESS);
+    tree->idle(0.25f);
+    ok = ok && Math::is_equal_approx(timer->get_time_left(), 0.75f);
+
+    // stop and process both own the pause state, the timer must still notice the switch.
+    menu->set_pause_mode(Node::PAUSE_MODE_STOP);
+    tree->idle(0.25f);
+    ok = ok && Math::is_equal_approx(timer->get_time_left(), 0.75f);
+
+    menu->set_pause_mode(Node::PAUSE_MODE_INHERIT);
+    tree->set_pause(false);
+    tree->idle(0.25f);
+    ok = ok && Math::is_equal_approx(timer->get_time_left(), 0.5f);
+
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+bool test_timer_threaded_restart() {
+
+    SceneTree *tree = memnew(SceneTree);
+    tree->init();
+    const int count = 64;
+    TestTimerOwner *owners[count];
+    for (int i = 0; i < count; i++) {
+        owners[i] = memnew(TestTimerOwner);
+        owners[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+        owners[i]->stop_timer = i % 2;
+        owners[i]->timer = memnew(Timer);
+        owners[i]->add_child(owners[i]->timer);
+        tree->get_root()->add_child(owners[i]);
+        owners[i]->timer->start(1.0f);
+    }
+    tree->idle(0.25f);
+
+    // the wheels are only touched once the MessageQueue is flushed at the end of the iteration.
+    for (TestTimerOwner *owner : owners)
+        owner->set_physics_process(true);
+    tree->iteration(0.1f);
+    for (TestTimerOwner *owner : owners)
+        owner->set_physics_process(false);
+    tree->idle(0.25f);
+
+    bool ok = true;
+    for (TestTimerOwner *owner : owners) {
+        if (owner->stop_timer)
+            ok = ok && owner->timer->is_stopped();
+        else
+            ok = ok && Math::is_equal_approx(owner->timer->get_time_left(), 1.75f);
+        ok = ok && owner->cooldown && Math::is_equal_approx(owner->cooldown->get_time_left(), 0.25f);
+    }
+    tree->idle(0.3f);
+    for (TestTimerOwner *owner : owners)
+        ok = ok && owner->cooldown->get_time_left() <= 0;
+
+    tree->finish();
+    memdelete(tree);
+    return ok;
+}
+
+bool test_benchmark() {
+
+    // Mostly idle cooldowns: only a handful expire per frame, the rest should cost nothing.
+    const int count = 100000;
+    const int frames = 600;
+    const float delta = 1.0f / 60.0f;
+
+    Vector<TestTimer> timers(count);
+    Vector<float> time_left(count);
+    TimerWheel wheel;
+    uint32_t rnd = 777;
+    for (int i = 0; i < count; i++) {
+        float delay = 5.0f + (next_random(rnd) % 60000) / 100.0f;
+        timers[i].deadline = delay;
+        time_left[i] = delay;
+        wheel.schedule(&timers[i].item, delay);
+    }
+
+    uint64_t t = OS::get_singleton()->get_ticks_usec();
+    int linear_fired = 0;
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < count; i++) {
+            if (time_left[i] < 0)
+                continue;
+            time_left[i] -= delta;
+            if (time_left[i] < 0)
+                linear_fired++;
+        }
+    }
+    uint64_t linear_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    t = OS::get_singleton()->get_ticks_usec();
+    for (int f = 0; f < frames; f++)
+        wheel.advance(delta);
+    uint64_t wheel_time = OS::get_singleton()->get_ticks_usec() - t;
+
+    int wheel_fired = count - wheel.get_scheduled_count();
+    OS::get_singleton()->print(FormatVE("\t%d timers, %d frames: linear walk %.3f ms/frame, wheel %.3f ms/frame (%d and %d expired)\n",
+            count, frames, linear_time / 1000.0 / frames, wheel_time / 1000.0 / frames, linear_fired, wheel_fired));
+    return wheel_fired > 0;
+}
+
+using TestFunc = bool (*)();
+
+TestFunc test_funcs[] = {
+
+    test_expiry_matches_linear,
+    test_cancel_and_reschedule,
+    test_timer_pause_mode,
+    test_timer_threaded_restart,
+    test_benchmark,
+    nullptr
+
+};
+
+MainLoop *test() {
+
+    int count = 0;
+    int passed = 0;
+
+    while (true) {
+        if (!test_funcs[count])
+            break;
+        bool pass = test_funcs[count]();
+        if (pass)
+            passed++;
+        OS::get_singleton()->print(FormatVE("\t%s\n", pass ? "PASS" : "FAILED"));
+
+        count++;
+    }
+
+    OS::get_singleton()->print(FormatVE("Passed %i of %i tests\n", passed, count));
+
+    return nullptr;
+}
+} // namespace TestTimerWheel
@@ -30,6 +30,7 @@
 
 #include "gd_navigation_server.h"
 
+#include "core/os/job_system.h"
 #include "core/os/mutex.h"
 
 #ifndef _3D_DISABLED
@@ -206,6 +207,95 @@ Vector<Vector3> GdNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Ve
     return map->get_path(p_origin, p_destination, p_optimize);
 }
 
+Vector3 GdNavigationServer::map_get_closest_point(RID p_map, const Vector3 &p_point) const {
+    NavMap *map = map_owner.getornull(p_map);
+    ERR_FAIL_COND_V(map == nullptr, Vector3());
+
+    return map->get_closest_point(p_point);
+}
+
+Vector3 GdNavigationServer::map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const {
+    NavMap *map = map_owner.getornull(p_map);
+    ERR_FAIL_COND_V(map == nullptr, Vector3());
+
+    return map->get_closest_point_normal(p_point);
+}
+
+RID GdNavigationServer::map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const {
+    NavMap *map = map_owner.getornull(p_map);
+    ERR_FAIL_COND_V(map == nullptr, RID());
+
+    return map->get_closest_point_owner(p_point);
+}
+
+RID GdNavigationServer::map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver, StringName p_method, Variant p_udata) const {
+    auto mut_this = const_cast<GdNavigationServer *>(this);
+    mut_this->operations_mutex.lock();
+    NavPathQuery *query = memnew(NavPathQuery(p_map, p_origin, p_destination, p_optimize));
+    RID rid = path_query_owner.make_rid(query);
+    query->set_self(rid);
+    mut_this->operations_mutex.unlock();
+
+    query->set_callback(p_receiver == nullptr ? 0 : p_receiver->get_instance_id(), p_method, p_udata);
+
+    path_queries_mutex.lock();
+    mut_this->pending_path_queries.push_back(query);
+    path_queries_mutex.unlock();
+    return rid;
+}
+
+bool GdNavigationServer::path_query_is_done(RID p_query) const {
+    NavPathQuery *query = path_query_owner.getornull(p_query);
+    ERR_FAIL_COND_V(query == nullptr, false);
+
+    return query->is_done();
+}
+
+Vector<Vector3> GdNavigationServer::path_query_get_path(RID p_query) const {
+    NavPathQuery *query = path_query_owner.getornull(p_query);
+    ERR_FAIL_COND_V(query == nullptr, {});
+
+    return query->get_path();
+}
+
+void GdNavigationServer::resolve_path_queries() {
+    path_queries_mutex.lock();
+    resolved_path_queries.swap(pending_path_queries);
+    path_queries_mutex.unlock();
+
+    if (resolved_path_queries.empty()) {
+        return;
+    }
+
+    // The maps are only read from here on, resolve all the queries at once.
+    NavPathQuery **queries = resolved_path_queries.data();
+    auto resolve = [this, queries](uint32_t index) {
+        NavPathQuery *query = queries[index];
+        query->resolve(map_owner.getornull(query->get_map()));
+    };
+    if (JobSystem::get_singleton() && resolved_path_queries.size() > 1) {
+        JobSystem::get_singleton()->parallel_for(resolved_path_queries.size(), resolve);
+    } else {
+        for (uint32_t i(0); i < resolved_path_queries.size(); i++) {
+            resolve(i);
+        }
+    }
+
+    for (NavPathQuery *query : resolved_path_queries) {
+        if (!query->has_callback()) {
+            continue;
+        }
+        query->dispatch_callback();
+
+        // Nobody polls a query that reports through a callback, release it right away.
+        operations_mutex.lock();
+        path_query_owner.free(query->get_self());
+        operations_mutex.unlock();
+        memdelete(query);
+    }
+    resolved_path_queries.clear();
+}
+
 RID GdNavigationServer::region_create() const {
     auto mut_this = const_cast<GdNavigationServer *>(this);
     mut_this->operations_mutex.lock();
@@ -405,6 +495,16 @@ COMMAND_1(free, RID, p_object) {
         map_owner.free(p_object);
         memdelete(map);
 
+    } else if (path_query_owner.owns(p_object)) {
+        NavPathQuery *query = path_query_owner.getornull(p_object);
+
+        path_queries_mutex.lock();
+        pending_path_queries.erase_first(query);
+        path_queries_mutex.unlock();
+
+        path_query_owner.free(p_object);
+        memdelete(query);
+
     } else if (region_owner.owns(p_object)) {
         NavRegion *region = region_owner.getornull(p_object);
 
@@ -463,6 +563,8 @@ void GdNavigationServer::step(real_t p_delta_time) {
         active_maps[i]->step(p_delta_time);
         active_maps[i]->dispatch_callbacks();
     }
+
+    resolve_path_queries();
 }
 
 #undef COMMAND_1
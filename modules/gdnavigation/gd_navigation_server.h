@@ -36,6 +36,7 @@
 #include "servers/navigation_server.h"
 #include "core/os/mutex.h"
 #include "nav_map.h"
+#include "nav_path_query.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
 
@@ -77,6 +78,15 @@ class GdNavigationServer : public NavigationServer {
     mutable RID_Owner<NavMap> map_owner;
     mutable RID_Owner<NavRegion> region_owner;
     mutable RID_Owner<RvoAgent> agent_owner;
+    mutable RID_Owner<NavPathQuery> path_query_owner;
+
+    mutable Mutex path_queries_mutex;
+    /// Path queries waiting for the next step.
+    Vector<NavPathQuery *> pending_path_queries;
+    /// Path queries resolved by the current step.
+    Vector<NavPathQuery *> resolved_path_queries;
+
+    void resolve_path_queries();
 
     bool active;
     Vector<NavMap *> active_maps;
@@ -102,6 +112,14 @@ public:
 
     virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize) const;
 
+    virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const;
+    virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const;
+    virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const;
+
+    virtual RID map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver = nullptr, StringName p_method = StringName(), Variant p_udata = Variant()) const;
+    virtual bool path_query_is_done(RID p_query) const;
+    virtual Vector<Vector3> path_query_get_path(RID p_query) const;
+
     virtual RID region_create() const;
     COMMAND_2(region_set_map, RID, p_region, RID, p_map);
     COMMAND_2(region_set_transform, RID, p_region, Transform, p_transform);
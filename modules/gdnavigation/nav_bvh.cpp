@@ -0,0 +1,170 @@
+/*************************************************************************/
+/*  nav_bvh.cpp                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_bvh.h"
+
+#include "core/math/face3.h"
+#include <algorithm>
+
+static real_t aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+    const Vector3 end = p_aabb.position + p_aabb.size;
+    real_t d = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        if (p_point[axis] < p_aabb.position[axis]) {
+            d += (p_aabb.position[axis] - p_point[axis]) * (p_aabb.position[axis] - p_point[axis]);
+        } else if (p_point[axis] > end[axis]) {
+            d += (p_point[axis] - end[axis]) * (p_point[axis] - end[axis]);
+        }
+    }
+    return d;
+}
+
+void NavBVH::_build(uint32_t p_node, uint32_t p_from, uint32_t p_to) {
+
+    AABB aabb = items[p_from].aabb;
+    AABB centers(items[p_from].center, Vector3());
+    for (uint32_t i = p_from + 1; i < p_to; i++) {
+        aabb.merge_with(items[i].aabb);
+        centers.expand_to(items[i].center);
+    }
+    nodes[p_node].aabb = aabb;
+
+    if (p_to - p_from <= LEAF_SIZE) {
+        nodes[p_node].first = p_from;
+        nodes[p_node].count = p_to - p_from;
+        return;
+    }
+
+    // Median split along the longest axis of the polygon centers.
+    const int axis = centers.get_longest_axis_index();
+    const uint32_t mid = (p_from + p_to) / 2;
+    std::nth_element(items.begin() + p_from, items.begin() + mid, items.begin() + p_to, [axis](const Item &a, const Item &b) {
+        return a.center[axis] < b.center[axis];
+    });
+
+    const uint32_t children = nodes.size();
+    nodes.resize(children + 2);
+    nodes[p_node].first = children;
+    nodes[p_node].count = 0;
+
+    _build(children, p_from, mid);
+    _build(children + 1, mid, p_to);
+}
+
+void NavBVH::build(const std::vector<gd::Polygon> &p_polygons) {
+    clear();
+
+    items.reserve(p_polygons.size());
+    for (size_t i(0); i < p_polygons.size(); i++) {
+        const gd::Polygon &p = p_polygons[i];
+        if (p.points.size() < 3) {
+            continue;
+        }
+
+        Item item;
+        item.aabb = AABB(p.points[0].pos, Vector3());
+        for (size_t point_id = 1; point_id < p.points.size(); point_id++) {
+            item.aabb.expand_to(p.points[point_id].pos);
+        }
+        item.center = item.aabb.position + item.aabb.size * 0.5;
+        item.polygon = i;
+        items.push_back(item);
+    }
+
+    if (items.empty()) {
+        return;
+    }
+
+    nodes.reserve(2 * (items.size() / LEAF_SIZE + 1));
+    nodes.resize(1);
+    _build(0, 0, items.size());
+}
+
+void NavBVH::clear() {
+    nodes.clear();
+    items.clear();
+}
+
+bool NavBVH::get_closest_point(const std::vector<gd::Polygon> &p_polygons, const Vector3 &p_point, gd::ClosestPointQueryResult &r_result) const {
+
+    if (nodes.empty()) {
+        return false;
+    }
+
+    real_t best_d = 1e30;
+
+    // Depth first, nearest child first, so the best distance shrinks quickly
+    // and far away subtrees get culled.
+    uint32_t stack[64];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size) {
+        const Node &node = nodes[stack[--stack_size]];
+        if (aabb_distance_squared(node.aabb, p_point) >= best_d) {
+            continue;
+        }
+
+        if (node.count) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                if (aabb_distance_squared(items[i].aabb, p_point) >= best_d) {
+                    continue;
+                }
+
+                const gd::Polygon &p = p_polygons[items[i].polygon];
+                for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+                    Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+                    Vector3 spoint = f.get_closest_point_to(p_point);
+                    real_t d = spoint.distance_squared_to(p_point);
+                    if (d < best_d) {
+                        best_d = d;
+                        r_result.point = spoint;
+                        r_result.normal = f.get_plane().normal;
+                        r_result.polygon = &p;
+                    }
+                }
+            }
+            continue;
+        }
+
+        const real_t d_first = aabb_distance_squared(nodes[node.first].aabb, p_point);
+        const real_t d_second = aabb_distance_squared(nodes[node.first + 1].aabb, p_point);
+        ERR_FAIL_COND_V(stack_size + 2 > 64, r_result.polygon != nullptr);
+        if (d_first < d_second) {
+            stack[stack_size++] = node.first + 1;
+            stack[stack_size++] = node.first;
+        } else {
+            stack[stack_size++] = node.first;
+            stack[stack_size++] = node.first + 1;
+        }
+    }
+
+    return r_result.polygon != nullptr;
+}
@@ -0,0 +1,81 @@
+/*************************************************************************/
+/*  nav_bvh.h                                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_BVH_H
+#define NAV_BVH_H
+
+#include "core/math/aabb.h"
+#include "nav_utils.h"
+#include <vector>
+
+/// Static bounding volume hierarchy over the polygons of a `NavMap`.
+///
+/// It's rebuilt from scratch each time the map polygons change, queries are
+/// read only and can run on many threads at once.
+class NavBVH {
+
+    enum {
+        LEAF_SIZE = 4
+    };
+
+    struct Node {
+        AABB aabb;
+        /// Leaf: first entry in `items`. Internal: index of the first child,
+        /// the second one follows it.
+        uint32_t first;
+        /// Amount of polygons of a leaf, 0 for internal nodes.
+        uint32_t count;
+    };
+
+    struct Item {
+        AABB aabb;
+        Vector3 center;
+        uint32_t polygon;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Item> items;
+
+    void _build(uint32_t p_node, uint32_t p_from, uint32_t p_to);
+
+public:
+    void build(const std::vector<gd::Polygon> &p_polygons);
+    void clear();
+
+    bool is_empty() const {
+        return nodes.empty();
+    }
+
+    /// Finds the point on the polygons closest to `p_point`.
+    /// Returns false when there are no polygons.
+    bool get_closest_point(const std::vector<gd::Polygon> &p_polygons, const Vector3 &p_point, gd::ClosestPointQueryResult &r_result) const;
+};
+
+#endif // NAV_BVH_H
@@ -30,11 +30,12 @@
 
 #include "nav_map.h"
 
-#include "core/os/threaded_array_processor.h"
+#include "core/os/job_system.h"
 #include "nav_region.h"
 #include "core/map.h"
 #include "rvo_agent.h"
 #include <algorithm>
+#include <atomic>
 
 /**
     @author AndreaCatania
@@ -80,46 +81,50 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
     return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize) const {
-
-    const gd::Polygon *begin_poly = NULL;
-    const gd::Polygon *end_poly = NULL;
-    Vector3 begin_point;
-    Vector3 end_point;
-    float begin_d = 1e20;
-    float end_d = 1e20;
+/// An entry of the A* open list. Improving a polygon pushes it again, so the
+/// entry is outdated when its distance doesn't match the polygon anymore.
+struct NavOpenEntry {
+    float cost;
+    float traveled_distance;
+    uint32_t id;
 
-    // Find the initial poly and the end poly on this map.
-    for (size_t i(0); i < polygons.size(); i++) {
-        const gd::Polygon &p = polygons[i];
-
-        // For each point cast a face and check the distance between the origin/destination
-        for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-
-            Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-            Vector3 spoint = f.get_closest_point_to(p_origin);
-            float dpoint = spoint.distance_to(p_origin);
-            if (dpoint < begin_d) {
-                begin_d = dpoint;
-                begin_poly = &p;
-                begin_point = spoint;
-            }
-
-            spoint = f.get_closest_point_to(p_destination);
-            dpoint = spoint.distance_to(p_destination);
-            if (dpoint < end_d) {
-                end_d = dpoint;
-                end_poly = &p;
-                end_point = spoint;
-            }
+    bool operator<(const NavOpenEntry &p_other) const {
+        // Reversed, the std heap functions keep the greatest element on top.
+        return cost > p_other.cost;
+    }
+};
+
+static Vector3 get_closest_point_on_polygon(const gd::Polygon &p_polygon, const Vector3 &p_point) {
+    Vector3 closest;
+    float closest_d = 1e20;
+    for (size_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+        Face3 f(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+        Vector3 spoint = f.get_closest_point_to(p_point);
+        float dpoint = spoint.distance_squared_to(p_point);
+        if (dpoint < closest_d) {
+            closest = spoint;
+            closest_d = dpoint;
         }
     }
+    return closest;
+}
+
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize) const {
 
-    if (!begin_poly || !end_poly) {
+    // Find the initial poly and the end poly on this map.
+    const gd::ClosestPointQueryResult begin = get_closest_point_info(p_origin);
+    const gd::ClosestPointQueryResult end = get_closest_point_info(p_destination);
+
+    if (!begin.polygon || !end.polygon) {
         // No path
         return {};
     }
 
+    const gd::Polygon *begin_poly = begin.polygon;
+    const gd::Polygon *end_poly = end.polygon;
+    const Vector3 begin_point = begin.point;
+    Vector3 end_point = end.point;
+
     if (begin_poly == end_poly) {
         Vector<Vector3> path {
             begin_point,
@@ -131,9 +136,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
     Vector<gd::NavigationPoly> navigation_polys;
     navigation_polys.reserve(polygons.size() * 0.75);
 
+    // The `navigation_polys` index of each map polygon, -1 if not reached yet.
+    std::vector<int> polygon_nav_ids(polygons.size(), -1);
+
     // The elements indices in the `navigation_polys`.
     int least_cost_id(-1);
-    List<uint32_t> open_list;
+    std::vector<NavOpenEntry> open_list;
     bool found_route = false;
 
     navigation_polys.push_back(gd::NavigationPoly(begin_poly));
@@ -142,14 +150,23 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
         gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
         least_cost_poly->self_id = least_cost_id;
         least_cost_poly->entry = begin_point;
+        polygon_nav_ids[begin_poly->id] = least_cost_id;
     }
 
-    open_list.push_back(0);
-
     const gd::Polygon *reachable_end = NULL;
     float reachable_d = 1e30;
     bool is_reachable = true;
 
+    auto push_open = [&](const gd::NavigationPoly &np) {
+#ifdef USE_ENTRY_POINT
+        const float cost = np.traveled_distance + np.entry.distance_to(end_point);
+#else
+        const float cost = np.traveled_distance + np.poly->center.distance_to(end_point);
+#endif
+        open_list.push_back({ cost, np.traveled_distance, np.self_id });
+        std::push_heap(open_list.begin(), open_list.end());
+    };
+
     while (found_route == false) {
 
         {
@@ -173,21 +190,22 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
                 const float new_distance = least_cost_poly->poly->center.distance_to(edge.other_polygon->center) + least_cost_poly->traveled_distance;
 #endif
 
-                auto it = std::find(
-                        navigation_polys.begin(),
-                        navigation_polys.end(),
-                        gd::NavigationPoly(edge.other_polygon));
+                const int other_id = polygon_nav_ids[edge.other_polygon->id];
 
-                if (it != navigation_polys.end()) {
+                if (other_id != -1) {
                     // Oh this was visited already, can we win the cost?
-                    if (it->traveled_distance > new_distance) {
+                    gd::NavigationPoly &other = navigation_polys[other_id];
+                    if (other.traveled_distance > new_distance) {
 
-                        it->prev_navigation_poly_id = least_cost_id;
-                        it->back_navigation_edge = edge.other_edge;
-                        it->traveled_distance = new_distance;
+                        other.prev_navigation_poly_id = least_cost_id;
+                        other.back_navigation_edge = edge.other_edge;
+                        other.traveled_distance = new_distance;
 #ifdef USE_ENTRY_POINT
-                        it->entry = new_entry;
+                        other.entry = new_entry;
 #endif
+                        if (!other.closed) {
+                            push_open(other);
+                        }
                     }
                 } else {
                     // Add to open neighbours
@@ -202,15 +220,30 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 #ifdef USE_ENTRY_POINT
                     np->entry = new_entry;
 #endif
-                    open_list.push_back(navigation_polys.size() - 1);
+                    polygon_nav_ids[edge.other_polygon->id] = np->self_id;
+                    push_open(*np);
                 }
             }
         }
 
         // Removes the least cost polygon from the open list so we can advance.
-        open_list.remove(least_cost_id);
+        navigation_polys[least_cost_id].closed = true;
+
+        // Now take the new least_cost_poly from the open list.
+        least_cost_id = -1;
+        while (!open_list.empty()) {
+            std::pop_heap(open_list.begin(), open_list.end());
+            const NavOpenEntry entry = open_list.back();
+            open_list.pop_back();
+
+            const gd::NavigationPoly &np = navigation_polys[entry.id];
+            if (!np.closed && np.traveled_distance == entry.traveled_distance) {
+                least_cost_id = entry.id;
+                break;
+            }
+        }
 
-        if (open_list.empty()) {
+        if (least_cost_id == -1) {
             // When the open list is empty at this point the End Polygon is not reachable
             // so use the further reachable polygon
             ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -222,47 +255,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
             // Set as end point the furthest reachable point.
             end_poly = reachable_end;
-            end_d = 1e20;
-            for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
-                Face3 f(end_poly->points[point_id - 2].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
-                Vector3 spoint = f.get_closest_point_to(p_destination);
-                float dpoint = spoint.distance_to(p_destination);
-                if (dpoint < end_d) {
-                    end_point = spoint;
-                    end_d = dpoint;
-                }
-            }
+            end_point = get_closest_point_on_polygon(*end_poly, p_destination);
 
             // Reset open and navigation_polys
+            for (const gd::NavigationPoly &np : navigation_polys) {
+                polygon_nav_ids[np.poly->id] = -1;
+            }
             gd::NavigationPoly np = navigation_polys[0];
+            np.closed = false;
             navigation_polys.clear();
             navigation_polys.push_back(np);
+            polygon_nav_ids[np.poly->id] = 0;
             open_list.clear();
-            open_list.push_back(0);
+            least_cost_id = 0;
 
             reachable_end = NULL;
 
             continue;
         }
 
-        // Now take the new least_cost_poly from the open list.
-        least_cost_id = -1;
-        float least_cost = 1e30f;
-
-        for (uint32_t element : open_list) {
-            gd::NavigationPoly *np = &navigation_polys[element];
-            float cost = np->traveled_distance;
-#ifdef USE_ENTRY_POINT
-            cost += np->entry.distance_to(end_point);
-#else
-            cost += np->poly->center.distance_to(end_point);
-#endif
-            if (cost < least_cost) {
-                least_cost_id = np->self_id;
-                least_cost = cost;
-            }
-        }
-
         // Stores the further reachable end polygon, in case our goal is not reachable.
         if (is_reachable) {
             float d = navigation_polys[least_cost_id].entry.distance_to(p_destination);
@@ -272,8 +283,6 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
             }
         }
 
-        ERR_BREAK(least_cost_id == -1);
-
         // Check if we reached the end
         if (navigation_polys[least_cost_id].poly == end_poly) {
             // Yep, done!!
@@ -397,6 +406,25 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
     return {};
 }
 
+gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
+    gd::ClosestPointQueryResult result;
+    polygons_bvh.get_closest_point(polygons, p_point, result);
+    return result;
+}
+
+Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
+    return get_closest_point_info(p_point).point;
+}
+
+Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
+    return get_closest_point_info(p_point).normal;
+}
+
+RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
+    const gd::ClosestPointQueryResult result = get_closest_point_info(p_point);
+    return result.polygon ? result.polygon->owner->get_self() : RID();
+}
+
 void NavMap::add_region(NavRegion *p_region) {
     regions.push_back(p_region);
     regenerate_links = true;
@@ -451,10 +479,22 @@ void NavMap::sync() {
         regenerate_links = true;
     }
 
-    for (size_t r(0); r < regions.size(); r++) {
+    // Regions rebuild their polygons independently of each other.
+    std::atomic<bool> regions_changed { false };
+    auto sync_region = [this, &regions_changed](uint32_t r) {
         if (regions[r]->sync()) {
-            regenerate_links = true;
+            regions_changed.store(true, std::memory_order_relaxed);
         }
+    };
+    if (JobSystem::get_singleton() && regions.size() > 1) {
+        JobSystem::get_singleton()->parallel_for(regions.size(), sync_region, 1);
+    } else {
+        for (size_t r(0); r < regions.size(); r++) {
+            sync_region(r);
+        }
+    }
+    if (regions_changed.load()) {
+        regenerate_links = true;
     }
 
     if (regenerate_links) {
@@ -476,6 +516,11 @@ void NavMap::sync() {
             count += regions[r]->get_polygons().size();
         }
 
+        for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
+            polygons[poly_id].id = poly_id;
+        }
+        polygons_bvh.build(polygons);
+
         // Connects the `Edges` of all the `Polygons` of all `Regions` each other.
         HashMap<gd::EdgeKey, gd::Connection> connections;
 
@@ -612,12 +657,18 @@ void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
 
 void NavMap::step(real_t p_deltatime) {
     deltatime = p_deltatime;
-    if (controlled_agents.size() > 0) {
-        thread_process_array(
-                controlled_agents.size(),
-                this,
-                &NavMap::compute_single_step,
-                controlled_agents.data());
+    if (controlled_agents.empty()) {
+        return;
+    }
+    RvoAgent **agents_ptr = controlled_agents.data();
+    if (JobSystem::get_singleton()) {
+        JobSystem::get_singleton()->parallel_for(controlled_agents.size(), [this, agents_ptr](uint32_t index) {
+            compute_single_step(index, agents_ptr);
+        });
+    } else {
+        for (uint32_t i(0); i < controlled_agents.size(); i++) {
+            compute_single_step(i, agents_ptr);
+        }
     }
 }
 
@@ -34,6 +34,7 @@
 #include "nav_rid.h"
 
 #include "core/math/math_defs.h"
+#include "nav_bvh.h"
 #include "nav_utils.h"
 #include <rvo2/KdTree.h>
 
@@ -65,6 +66,9 @@ class NavMap : public NavRid {
     /// Map polygons
     std::vector<gd::Polygon> polygons;
 
+    /// Spatial index over `polygons`, rebuilt with them.
+    NavBVH polygons_bvh;
+
     /// Rvo world
     RVO::KdTree rvo;
 
@@ -105,6 +109,11 @@ public:
 
     Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize) const;
 
+    gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
+    Vector3 get_closest_point(const Vector3 &p_point) const;
+    Vector3 get_closest_point_normal(const Vector3 &p_point) const;
+    RID get_closest_point_owner(const Vector3 &p_point) const;
+
     void add_region(NavRegion *p_region);
     void remove_region(NavRegion *p_region);
     const std::vector<NavRegion *> &get_regions() const {
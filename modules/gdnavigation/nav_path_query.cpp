@@ -0,0 +1,81 @@
+/*************************************************************************/
+/*  nav_path_query.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_path_query.h"
+
+#include "core/object_db.h"
+#include "nav_map.h"
+
+NavPathQuery::NavPathQuery(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, bool p_optimize) :
+        map(p_map),
+        origin(p_origin),
+        destination(p_destination),
+        optimize(p_optimize),
+        done(false) {
+    callback.id = ObjectID(0);
+}
+
+void NavPathQuery::set_callback(ObjectID p_id, const StringName &p_method, const Variant &p_udata) {
+    callback.id = p_id;
+    callback.method = p_method;
+    callback.udata = p_udata;
+}
+
+void NavPathQuery::resolve(const NavMap *p_map) {
+    if (p_map) {
+        path = p_map->get_path(origin, destination, optimize);
+    }
+    done.store(true, std::memory_order_release);
+}
+
+Vector<Vector3> NavPathQuery::get_path() const {
+    if (!is_done()) {
+        return {};
+    }
+    return path;
+}
+
+void NavPathQuery::dispatch_callback() {
+    if (callback.id == 0) {
+        return;
+    }
+    Object *obj = ObjectDB::get_instance(callback.id);
+    callback.id = ObjectID(0);
+    if (obj == nullptr) {
+        return;
+    }
+
+    Variant::CallError responseCallError;
+
+    const Variant result(path);
+    const Variant *vp[2] = { &result, &callback.udata };
+    int argc = (callback.udata.get_type() == VariantType::NIL) ? 1 : 2;
+    obj->call(callback.method, vp, argc, responseCallError);
+}
@@ -0,0 +1,85 @@
+/*************************************************************************/
+/*  nav_path_query.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "core/object.h"
+#include "core/vector.h"
+#include "nav_rid.h"
+#include <atomic>
+
+class NavMap;
+
+/// A path request queued on the server, resolved together with the other
+/// pending requests during the server step.
+class NavPathQuery : public NavRid {
+    struct ResolvedCallback {
+        ObjectID id;
+        StringName method;
+        Variant udata;
+    };
+
+    RID map;
+    Vector3 origin;
+    Vector3 destination;
+    bool optimize;
+    ResolvedCallback callback;
+
+    Vector<Vector3> path;
+    /// Written by the server step, read by any thread polling the query.
+    std::atomic<bool> done;
+
+public:
+    NavPathQuery(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, bool p_optimize);
+
+    RID get_map() const {
+        return map;
+    }
+
+    void set_callback(ObjectID p_id, const StringName &p_method, const Variant &p_udata);
+
+    bool has_callback() const {
+        return callback.id != 0;
+    }
+
+    /// Finds the path on `p_map`, the map is only read so many queries can
+    /// be resolved at once.
+    void resolve(const NavMap *p_map);
+
+    bool is_done() const {
+        return done.load(std::memory_order_acquire);
+    }
+
+    /// Empty until the query is done.
+    Vector<Vector3> get_path() const;
+
+    void dispatch_callback();
+};
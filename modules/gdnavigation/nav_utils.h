@@ -101,6 +101,9 @@ struct Edge {
 struct Polygon {
 	NavRegion *owner;
 
+	/// Index of this `Polygon` in the map polygons.
+	uint32_t id;
+
 	/// The points of this `Polygon`
 	std::vector<Point> points;
 
@@ -141,13 +144,16 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	float traveled_distance;
+	/// Already expanded, it's no longer in the open list.
+	bool closed;
 
 	NavigationPoly(const Polygon *p_poly) :
 			self_id(0),
 			poly(p_poly),
 			prev_navigation_poly_id(-1),
 			back_navigation_edge(0),
-			traveled_distance(0.0) {
+			traveled_distance(0.0),
+			closed(false) {
 	}
 
 	bool operator==(const NavigationPoly &other) const {
@@ -159,6 +165,12 @@ struct NavigationPoly {
 	}
 };
 
+struct ClosestPointQueryResult {
+	Vector3 point;
+	Vector3 normal;
+	const Polygon *polygon = nullptr;
+};
+
 struct FreeEdge {
 	bool is_free;
 	Polygon *poly;
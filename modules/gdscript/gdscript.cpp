@@ -957,6 +957,7 @@ GDScript::~GDScript() {
     for (eastl::pair<const StringName,GDScriptFunction *> &E : member_functions) {
         memdelete(E.second);
     }
+    GDScriptLanguage::get_singleton()->invalidate_call_caches();
 
     _save_orphaned_subclasses();
 
@@ -2152,6 +2153,7 @@ GDScriptWarning::Code GDScriptWarning::get_code_from_name(const String &p_name)
 GDScriptLanguage::GDScriptLanguage() {
 
     calls = 0;
+    call_cache_epoch = 0;
     ERR_FAIL_COND(singleton);
     singleton = this;
     strings._init = StringName("_init");
@@ -368,9 +368,14 @@ class GDScriptLanguage : public ScriptLanguage {
     uint64_t script_frame_time;
 
     Map<String, ObjectID> orphan_subclasses;
+    std::atomic<uint32_t> call_cache_epoch;
 public:
     int calls;
 
+    // Called whenever compiled functions are freed, so the call caches in the bytecode drop the pointers they hold.
+    void invalidate_call_caches() { call_cache_epoch.fetch_add(1, std::memory_order_acq_rel); }
+    uint32_t get_call_cache_epoch() const { return call_cache_epoch.load(std::memory_order_acquire); }
+
     bool debug_break(se_string_view p_error, bool p_allow_continue = true);
     bool debug_break_parse(se_string_view p_file, int p_line, se_string_view p_error);
 
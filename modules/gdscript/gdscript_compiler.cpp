@@ -93,6 +93,35 @@ void GDScriptCompiler::_set_error(const char *p_error, const GDScriptParser::Nod
     }
 }
 
+bool GDScriptCompiler::_get_builtin_type(const GDScriptParser::Node *p_node, VariantType &r_type) {
+
+    GDScriptParser::DataType datatype = p_node->get_datatype();
+    if (!datatype.has_type || datatype.is_meta_type || datatype.kind != GDScriptParser::DataType::BUILTIN)
+        return false;
+    if (datatype.builtin_type == VariantType::NIL || datatype.builtin_type == VariantType::OBJECT)
+        return false;
+
+    r_type = datatype.builtin_type;
+    return true;
+}
+
+void GDScriptCompiler::_push_operator(CodeGen &codegen, Variant::Operator p_op, const GDScriptParser::Node *p_left, const GDScriptParser::Node *p_right) {
+
+    VariantType left_type, right_type;
+    if (_get_builtin_type(p_left, left_type) && _get_builtin_type(p_right, right_type)) {
+
+        Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(p_op, left_type, right_type);
+        if (evaluator) {
+            codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_VALIDATED); // operand types known, skip dispatch
+            codegen.opcodes.push_back(codegen.get_validated_operator_pos(p_op, left_type, right_type, evaluator));
+            return;
+        }
+    }
+
+    codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+    codegen.opcodes.push_back(p_op); //which operator
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
     ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -101,8 +130,7 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
     if (src_address_a < 0)
         return false;
 
-    codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-    codegen.opcodes.push_back(op); //which operator
+    _push_operator(codegen, op, on->arguments[0], on->arguments[0]);
     codegen.opcodes.push_back(src_address_a); // argument 1
     codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
     //codegen.opcodes.push_back(GDScriptFunction::ADDR_TYPE_NIL); // argument 2 (unary only takes one parameter)
@@ -123,8 +151,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
     if (src_address_b < 0)
         return false;
 
-    codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-    codegen.opcodes.push_back(op); //which operator
+    _push_operator(codegen, op, on->arguments[0], on->arguments[1]);
     codegen.opcodes.push_back(src_address_a); // argument 1
     codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
     return true;
@@ -543,6 +570,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
             //hell breaks loose
 
             const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(p_expression);
+            int call_cache = -1;
             switch (on->op) {
 
                 //call/constructor operator
@@ -677,11 +705,42 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
                             arguments.push_back(ret);
                         }
 
-                        codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+                        // builtin base with statically matching arguments, resolve the method now
+                        const GDScriptParser::IdentifierNode *method_id = static_cast<const GDScriptParser::IdentifierNode *>(on->arguments[1]);
+                        int argc = on->arguments.size() - 2;
+                        VariantType base_type;
+                        const Variant::ValidatedBuiltinMethod *method = nullptr;
+                        if (_get_builtin_type(instance, base_type)) {
+                            method = Variant::get_validated_builtin_method(base_type, method_id->name);
+                        }
+                        if (method) {
+                            Span<const VariantType> arg_types = Variant::get_method_argument_types(base_type, method_id->name);
+                            int default_count = Variant::get_method_default_arguments(base_type, method_id->name).size();
+                            if (argc > int(arg_types.size()) || argc < int(arg_types.size()) - default_count) {
+                                method = nullptr;
+                            }
+                            for (int i = 0; method && i < argc; i++) {
+                                VariantType arg_type;
+                                if (arg_types[i] != VariantType::NIL && (!_get_builtin_type(on->arguments[i + 2], arg_type) || arg_type != arg_types[i])) {
+                                    method = nullptr;
+                                }
+                            }
+                        }
+
+                        if (method) {
+                            codegen.opcodes.push_back(GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED);
+                            arguments[1] = codegen.get_validated_method_pos(base_type, method_id->name, !p_root, method);
+                        } else {
+                            codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+                        }
                         codegen.opcodes.push_back(on->arguments.size() - 2);
                         codegen.alloc_call(on->arguments.size() - 2);
                         for (int i = 0; i < arguments.size(); i++)
                             codegen.opcodes.push_back(arguments[i]);
+                        if (!method) {
+                            // the return address is appended by the caller, the call cache goes after it
+                            call_cache = codegen.call_cache_count++;
+                        }
                     }
                 } break;
                 case GDScriptParser::OperatorNode::OP_YIELD: {
@@ -725,6 +784,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
                         return from;
 
                     int index;
+                    StringName index_name;
                     if (p_index_addr != 0) {
                         index = p_index_addr;
                     } else if (named) {
@@ -747,14 +807,15 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
                             }
                         }
 
-                        index = codegen.get_name_map_pos(static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+                        index_name = static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name;
+                        index = codegen.get_name_map_pos(index_name);
 
                     } else {
 
                         if (on->arguments[1]->type == GDScriptParser::Node::TYPE_CONSTANT && static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value.get_type() == VariantType::STRING) {
                             //also, somehow, named (speed up anyway)
-                            StringName name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
-                            index = codegen.get_name_map_pos(name);
+                            index_name = static_cast<const GDScriptParser::ConstantNode *>(on->arguments[1])->value;
+                            index = codegen.get_name_map_pos(index_name);
                             named = true;
 
                         } else {
@@ -770,9 +831,17 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
                         }
                     }
 
-                    codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
-                    codegen.opcodes.push_back(from); // argument 1
-                    codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+                    VariantType base_type;
+                    Variant::ValidatedMember member;
+                    if (named && !index_name.empty() && _get_builtin_type(on->arguments[0], base_type) && Variant::get_validated_member(base_type, index_name, member)) {
+                        codegen.opcodes.push_back(GDScriptFunction::OPCODE_GET_NAMED_VALIDATED);
+                        codegen.opcodes.push_back(from); // argument 1
+                        codegen.opcodes.push_back(codegen.get_validated_member_pos(base_type, index_name, member));
+                    } else {
+                        codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
+                        codegen.opcodes.push_back(from); // argument 1
+                        codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+                    }
 
                 } break;
                 case GDScriptParser::OperatorNode::OP_AND: {
@@ -1119,9 +1188,18 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
                         if (set_value < 0) //error
                             return set_value;
 
-                        codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
-                        codegen.opcodes.push_back(prev_pos);
-                        codegen.opcodes.push_back(set_index);
+                        VariantType base_type;
+                        Variant::ValidatedMember member;
+                        if (named && _get_builtin_type(op->arguments[0], base_type) &&
+                                Variant::get_validated_member(base_type, static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name, member) && member.setter) {
+                            codegen.opcodes.push_back(GDScriptFunction::OPCODE_SET_NAMED_VALIDATED);
+                            codegen.opcodes.push_back(prev_pos);
+                            codegen.opcodes.push_back(codegen.get_validated_member_pos(base_type, static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name, member));
+                        } else {
+                            codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
+                            codegen.opcodes.push_back(prev_pos);
+                            codegen.opcodes.push_back(set_index);
+                        }
                         codegen.opcodes.push_back(set_value);
 
                         for (size_t i = 0; i < setchain.size(); i++) {
@@ -1272,6 +1350,8 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
             int dst_addr = (p_stack_level) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
             codegen.opcodes.push_back(dst_addr); // append the stack level as destination address of the opcode
+            if (call_cache >= 0)
+                codegen.opcodes.push_back(call_cache);
             codegen.alloc_stack(p_stack_level);
             return dst_addr;
         }
@@ -1600,6 +1680,7 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
     codegen.stack_max = 0;
     codegen.current_line = 0;
     codegen.call_max = 0;
+    codegen.call_cache_count = 0;
     codegen.debug_stack = ScriptDebugger::get_singleton() != nullptr;
     Vector<StringName> argnames;
 
@@ -1745,6 +1826,21 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
         gdfunc->_global_names_count = 0;
     }
 
+    //validated operands
+    gdfunc->validated_operators = codegen.validated_operators;
+    gdfunc->_operators_ptr = gdfunc->validated_operators.data();
+    gdfunc->_operators_count = gdfunc->validated_operators.size();
+    gdfunc->validated_members = codegen.validated_members;
+    gdfunc->_members_ptr = gdfunc->validated_members.data();
+    gdfunc->_members_count = gdfunc->validated_members.size();
+    gdfunc->validated_methods = codegen.validated_methods;
+    gdfunc->_methods_ptr = gdfunc->validated_methods.data();
+    gdfunc->_methods_count = gdfunc->validated_methods.size();
+    if (codegen.call_cache_count) {
+        gdfunc->_call_caches = memnew_arr(GDScriptFunction::CallCache, codegen.call_cache_count);
+        gdfunc->_call_cache_count = codegen.call_cache_count;
+    }
+
 #ifdef TOOLS_ENABLED
     // Named globals
     if (!codegen.named_globals.empty()) {
@@ -1864,6 +1960,7 @@ Error GDScriptCompiler::_parse_class_level(GDScript *p_script, const GDScriptPar
         memdelete(E.second);
     }
     p_script->member_functions.clear();
+    GDScriptLanguage::get_singleton()->invalidate_call_caches();
     p_script->member_indices.clear();
     p_script->member_info.clear();
     p_script->_signals.clear();
@@ -121,6 +121,42 @@ class GDScriptCompiler {
             return pos;
         }
 
+        Vector<GDScriptFunction::ValidatedOperator> validated_operators;
+        Vector<GDScriptFunction::ValidatedMember> validated_members;
+        Vector<GDScriptFunction::ValidatedMethod> validated_methods;
+
+        int get_validated_operator_pos(Variant::Operator p_op, VariantType p_left, VariantType p_right, Variant::ValidatedOperatorEvaluator p_evaluator) {
+            for (size_t i = 0; i < validated_operators.size(); i++) {
+                const GDScriptFunction::ValidatedOperator &E = validated_operators[i];
+                if (E.op == p_op && E.left_type == p_left && E.right_type == p_right)
+                    return i;
+            }
+            validated_operators.push_back({ p_evaluator, p_op, p_left, p_right });
+            return validated_operators.size() - 1;
+        }
+
+        int get_validated_member_pos(VariantType p_base, const StringName &p_name, const Variant::ValidatedMember &p_member) {
+            int name = get_name_map_pos(p_name);
+            for (size_t i = 0; i < validated_members.size(); i++) {
+                const GDScriptFunction::ValidatedMember &E = validated_members[i];
+                if (E.base_type == p_base && E.name == name)
+                    return i;
+            }
+            validated_members.push_back({ p_member, p_base, name });
+            return validated_members.size() - 1;
+        }
+
+        int get_validated_method_pos(VariantType p_base, const StringName &p_name, bool p_returns, const Variant::ValidatedBuiltinMethod *p_method) {
+            int name = get_name_map_pos(p_name);
+            for (size_t i = 0; i < validated_methods.size(); i++) {
+                const GDScriptFunction::ValidatedMethod &E = validated_methods[i];
+                if (E.base_type == p_base && E.name == name && E.returns == p_returns)
+                    return i;
+            }
+            validated_methods.push_back({ p_method, p_base, p_returns, name });
+            return validated_methods.size() - 1;
+        }
+
         Vector<int> opcodes;
         void alloc_stack(int p_level) {
             if (p_level >= stack_max) stack_max = p_level + 1;
@@ -132,6 +168,7 @@ class GDScriptCompiler {
         int current_line;
         int stack_max;
         int call_max;
+        int call_cache_count;
     };
 
     bool _is_class_member_property(CodeGen &codegen, const StringName &p_name);
@@ -140,6 +177,8 @@ class GDScriptCompiler {
     void _set_error(se_string_view p_error, const GDScriptParser::Node *p_node);
     void _set_error(const char *p_error, const GDScriptParser::Node *p_node);
 
+    static bool _get_builtin_type(const GDScriptParser::Node *p_node, VariantType &r_type);
+    void _push_operator(CodeGen &codegen, Variant::Operator p_op, const GDScriptParser::Node *p_left, const GDScriptParser::Node *p_right);
     bool _create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
     bool _create_binary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false, int p_index_addr=0);
 
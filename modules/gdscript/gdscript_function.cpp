@@ -30,6 +30,8 @@
 
 #include "gdscript_function.h"
 
+#include "core/class_db.h"
+#include "core/core_string_names.h"
 #include "core/method_bind.h"
 #include "core/string_formatter.h"
 #include "core/os/mutex.h"
@@ -148,7 +150,7 @@ static String _get_var_type(const Variant *p_var) {
         if (!bobj) {
             basestr = "null instance";
         } else {
-            if (ObjectDB::instance_validate(bobj)) {
+            if (p_var->is_valid_object()) {
                 if (bobj->get_script_instance())
                     basestr = String(bobj->get_class()) + " (" + PathUtils::get_file(bobj->get_script_instance()->get_script()->get_path()) + ")";
                 else
@@ -196,16 +198,143 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, se_str
     return err_text;
 }
 
+// Calls p_method on p_obj the way Object::call would, resolving the target through the call site's inline cache.
+// Returns false when the receiver can't be cached (script of another language, placeholder, Script resources that
+// override call(), 'free', unknown method, megamorphic site); the caller then takes the generic path, which also keeps
+// the error reporting in one place.
+bool GDScriptFunction::_call_cached(CallCache &p_cache, Object *p_obj, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Variant::CallError &r_err) const {
+
+    GDScriptInstance *instance = nullptr;
+    const GDScript *script = nullptr;
+    ScriptInstance *si = p_obj->get_script_instance();
+    if (si) {
+        if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton())
+            return false;
+        instance = static_cast<GDScriptInstance *>(si);
+        script = instance->script.get();
+    }
+    const TypeInfo *type = p_obj->get_type_info();
+    uint32_t epoch = GDScriptLanguage::get_singleton()->get_call_cache_epoch();
+
+    GDScriptFunction *function = nullptr;
+    MethodBind *method = nullptr;
+    bool hit = false;
+    bool full = false;
+
+    // reader side of the sequence lock, a write in progress counts as a miss
+    uint32_t seq = p_cache.sequence.load(std::memory_order_acquire);
+    if (!(seq & 1) && p_cache.epoch.load(std::memory_order_relaxed) == epoch) {
+        int used = p_cache.used.load(std::memory_order_relaxed);
+        for (int i = 0; i < used; i++) {
+            const CallCache::Slot &slot = p_cache.slots[i];
+            if (slot.type.load(std::memory_order_relaxed) == type && slot.script.load(std::memory_order_relaxed) == script) {
+                function = slot.function.load(std::memory_order_relaxed);
+                method = slot.method.load(std::memory_order_relaxed);
+                hit = true;
+                break;
+            }
+        }
+        full = used == CallCache::SLOT_COUNT;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (p_cache.sequence.load(std::memory_order_relaxed) != seq) {
+            hit = false;
+            full = false;
+        }
+    }
+
+    if (!hit) {
+        if (full || p_method == CoreStringNames::get_singleton()->_free)
+            return false;
+        // GDScript::call looks at the script's static functions before the native binds, so Scripts are never cached
+        // and a hit can't be one.
+        if (object_cast<Script>(p_obj))
+            return false;
+
+        for (const GDScript *sptr = script; sptr && !function; sptr = sptr->_base) {
+            auto E = sptr->member_functions.find(p_method);
+            if (E != sptr->member_functions.end())
+                function = E->second;
+        }
+        if (!function) {
+            method = ClassDB::get_method(p_obj->get_class_name(), p_method);
+            if (!method)
+                return false;
+        }
+
+        // writer side, if another thread is filling this cache just skip it, the next call will try again
+        if (!(seq & 1) && p_cache.sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+            std::atomic_thread_fence(std::memory_order_release);
+            if (p_cache.epoch.load(std::memory_order_relaxed) != epoch) {
+                p_cache.used.store(0, std::memory_order_relaxed);
+                p_cache.epoch.store(epoch, std::memory_order_relaxed);
+            }
+            int used = p_cache.used.load(std::memory_order_relaxed);
+            if (used < CallCache::SLOT_COUNT) {
+                CallCache::Slot &slot = p_cache.slots[used];
+                slot.script.store(script, std::memory_order_relaxed);
+                slot.type.store(type, std::memory_order_relaxed);
+                slot.function.store(function, std::memory_order_relaxed);
+                slot.method.store(method, std::memory_order_relaxed);
+                p_cache.used.store(used + 1, std::memory_order_relaxed);
+            }
+            p_cache.sequence.store(seq + 2, std::memory_order_release);
+        }
+    }
+
+#ifdef DEBUG_ENABLED
+    _ObjectDebugLock debug_lock(p_obj);
+#endif
+    r_err.error = Variant::CallError::CALL_OK;
+    Variant ret;
+    if (function) {
+        ret = function->call(instance, p_args, p_argcount, r_err);
+    } else {
+        ret = method->call(p_obj, p_args, p_argcount, r_err);
+    }
+    if (r_err.error == Variant::CallError::CALL_OK && r_ret)
+        *r_ret = ret;
+    return true;
+}
+
+// Generic operator path, shared by OPCODE_OPERATOR and the fallback of OPCODE_OPERATOR_VALIDATED.
+static _FORCE_INLINE_ bool _evaluate_operator(Variant::Operator p_op, const Variant *p_a, const Variant *p_b, Variant *r_dst, String &r_err_text) {
+
+    bool valid;
+#ifdef DEBUG_ENABLED
+
+    Variant ret;
+    Variant::evaluate(p_op, *p_a, *p_b, ret, valid);
+    if (!valid) {
+
+        if (ret.get_type() == VariantType::STRING) {
+            //return a string when invalid with the error
+            r_err_text = ret.as<String>();
+            r_err_text += String(" in operator '") + Variant::get_operator_name(p_op) + "'.";
+        } else {
+            r_err_text = "Invalid operands '" + String(Variant::get_type_name(p_a->get_type())) + "' and '" + Variant::get_type_name(p_b->get_type()) + "' in operator '" + Variant::get_operator_name(p_op) + "'.";
+        }
+        return false;
+    }
+    *r_dst = ret;
+#else
+    Variant::evaluate(p_op, *p_a, *p_b, *r_dst, valid);
+#endif
+    return true;
+}
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                         \
     static const void *switch_table_ops[] = { \
         &&OPCODE_OPERATOR,                    \
+        &&OPCODE_OPERATOR_VALIDATED,          \
         &&OPCODE_EXTENDS_TEST,                \
         &&OPCODE_IS_BUILTIN,                  \
         &&OPCODE_SET,                         \
         &&OPCODE_GET,                         \
         &&OPCODE_SET_NAMED,                   \
+        &&OPCODE_SET_NAMED_VALIDATED,         \
         &&OPCODE_GET_NAMED,                   \
+        &&OPCODE_GET_NAMED_VALIDATED,         \
         &&OPCODE_SET_MEMBER,                  \
         &&OPCODE_GET_MEMBER,                  \
         &&OPCODE_ASSIGN,                      \
@@ -222,6 +351,7 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, se_str
         &&OPCODE_CONSTRUCT_DICTIONARY,        \
         &&OPCODE_CALL,                        \
         &&OPCODE_CALL_RETURN,                 \
+        &&OPCODE_CALL_BUILTIN_TYPE_VALIDATED, \
         &&OPCODE_CALL_BUILT_IN,               \
         &&OPCODE_CALL_SELF,                   \
         &&OPCODE_CALL_SELF_BASE,              \
@@ -452,7 +582,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
                 CHECK_SPACE(5);
 
-                bool valid;
                 Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
                 GD_ERR_BREAK(op >= Variant::OP_MAX);
 
@@ -460,27 +589,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
                 GET_VARIANT_PTR(b, 3);
                 GET_VARIANT_PTR(dst, 4);
 
-#ifdef DEBUG_ENABLED
+                if (!_evaluate_operator(op, a, b, dst, err_text)) {
+                    OPCODE_BREAK;
+                }
+                ip += 5;
+            }
+            DISPATCH_OPCODE;
 
-                Variant ret;
-                Variant::evaluate(op, *a, *b, ret, valid);
-#else
-                Variant::evaluate(op, *a, *b, *dst, valid);
-#endif
-#ifdef DEBUG_ENABLED
-                if (!valid) {
+            OPCODE(OPCODE_OPERATOR_VALIDATED) {
 
-                    if (ret.get_type() == VariantType::STRING) {
-                        //return a string when invalid with the error
-                        err_text = ret.as<String>();
-                        err_text += String(" in operator '") + Variant::get_operator_name(op) + "'.";
-                    } else {
-                        err_text = "Invalid operands '" + String(Variant::get_type_name(a->get_type())) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
-                    }
+                CHECK_SPACE(5);
+
+                int operator_idx = _code_ptr[ip + 1];
+                GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operators_count);
+                const ValidatedOperator &vop = _operators_ptr[operator_idx];
+
+                GET_VARIANT_PTR(a, 2);
+                GET_VARIANT_PTR(b, 3);
+                GET_VARIANT_PTR(dst, 4);
+
+                if (likely(a->get_type() == vop.left_type && b->get_type() == vop.right_type)) {
+                    vop.evaluator(*a, *b, *dst);
+                } else if (!_evaluate_operator(vop.op, a, b, dst, err_text)) {
                     OPCODE_BREAK;
                 }
-                *dst = ret;
-#endif
                 ip += 5;
             }
             DISPATCH_OPCODE;
@@ -506,7 +638,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
                     Object *obj_A = *a;
                     Object *obj_B = *b;
 #ifdef DEBUG_ENABLED
-                    if (!ObjectDB::instance_validate(obj_A)) {
+                    if (!a->is_valid_object()) {
                         err_text = "Left operand of 'is' was already freed.";
                         OPCODE_BREAK;
                     }
@@ -654,6 +786,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
             }
             DISPATCH_OPCODE;
 
+            OPCODE(OPCODE_SET_NAMED_VALIDATED) {
+
+                CHECK_SPACE(3);
+
+                GET_VARIANT_PTR(dst, 1);
+                GET_VARIANT_PTR(value, 3);
+
+                int member_idx = _code_ptr[ip + 2];
+                GD_ERR_BREAK(member_idx < 0 || member_idx >= _members_count);
+                const ValidatedMember &vm = _members_ptr[member_idx];
+
+                if (likely(dst->get_type() == vm.base_type && value->get_type() == vm.member.type)) {
+                    vm.member.setter(*dst, *value);
+                } else {
+                    const StringName *index = &_global_names_ptr[vm.name];
+
+                    bool valid;
+                    dst->set_named(*index, *value, &valid);
+
+#ifdef DEBUG_ENABLED
+                    if (!valid) {
+                        err_text = "Invalid set index '" + String(*index) + "' (on base: '" + _get_var_type(dst) + "') with value of type '" + _get_var_type(value) + "'.";
+                        OPCODE_BREAK;
+                    }
+#endif
+                }
+                ip += 4;
+            }
+            DISPATCH_OPCODE;
+
             OPCODE(OPCODE_GET_NAMED) {
 
                 CHECK_SPACE(4);
@@ -689,6 +851,38 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
             }
             DISPATCH_OPCODE;
 
+            OPCODE(OPCODE_GET_NAMED_VALIDATED) {
+
+                CHECK_SPACE(4);
+
+                GET_VARIANT_PTR(src, 1);
+                GET_VARIANT_PTR(dst, 3);
+
+                int member_idx = _code_ptr[ip + 2];
+                GD_ERR_BREAK(member_idx < 0 || member_idx >= _members_count);
+                const ValidatedMember &vm = _members_ptr[member_idx];
+
+                if (likely(src->get_type() == vm.base_type)) {
+                    vm.member.getter(*src, *dst);
+                } else {
+                    const StringName *index = &_global_names_ptr[vm.name];
+
+                    bool valid;
+#ifdef DEBUG_ENABLED
+                    Variant ret = src->get_named(*index, &valid);
+                    if (!valid) {
+                        err_text = FormatVE("Invalid get index '%s' (on base: '%s').",index->asCString(),_get_var_type(src).c_str());
+                        OPCODE_BREAK;
+                    }
+                    *dst = ret;
+#else
+                    *dst = src->get_named(*index, &valid);
+#endif
+                }
+                ip += 4;
+            }
+            DISPATCH_OPCODE;
+
             OPCODE(OPCODE_SET_MEMBER) {
 
                 CHECK_SPACE(3);
@@ -1066,7 +1260,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
                 GD_ERR_BREAK(argc < 0);
                 ip += 4;
-                CHECK_SPACE(argc + 1);
+                CHECK_SPACE(argc + 2);
                 Variant **argptrs = call_args;
 
                 for (int i = 0; i < argc; i++) {
@@ -1083,13 +1277,22 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #endif
                 Variant::CallError err;
+                Variant *ret = nullptr;
                 if (call_ret) {
+                    GET_VARIANT_PTR(r, argc);
+                    ret = r;
+                }
 
-                    GET_VARIANT_PTR(ret, argc);
+                int cache_idx = _code_ptr[ip + argc + 1];
+                GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _call_cache_count);
+                Object *obj = base->get_type() == VariantType::OBJECT ? (Object *)*base : nullptr;
+#ifdef DEBUG_ENABLED
+                if (obj && ScriptDebugger::get_singleton() && !base->is_ref() && !base->is_valid_object()) {
+                    obj = nullptr; // let the generic path report the freed instance
+                }
+#endif
+                if (!obj || !_call_cached(_call_caches[cache_idx], obj, *methodname, (const Variant **)argptrs, argc, ret, err)) {
                     base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
-                } else {
-
-                    base->call_ptr(*methodname, (const Variant **)argptrs, argc, nullptr, err);
                 }
 #ifdef DEBUG_ENABLED
                 if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1128,6 +1331,51 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
                 //_call_func(NULL,base,*methodname,ip,argc,p_instance,stack);
+                ip += argc + 2;
+            }
+            DISPATCH_OPCODE;
+
+            OPCODE(OPCODE_CALL_BUILTIN_TYPE_VALIDATED) {
+
+                CHECK_SPACE(4);
+
+                int argc = _code_ptr[ip + 1];
+                GET_VARIANT_PTR(base, 2);
+                int method_idx = _code_ptr[ip + 3];
+
+                GD_ERR_BREAK(method_idx < 0 || method_idx >= _methods_count);
+                const ValidatedMethod &vm = _methods_ptr[method_idx];
+
+                GD_ERR_BREAK(argc < 0);
+                ip += 4;
+                CHECK_SPACE(argc + 1);
+                Variant **argptrs = call_args;
+
+                for (int i = 0; i < argc; i++) {
+                    GET_VARIANT_PTR(v, i);
+                    argptrs[i] = v;
+                }
+
+                Variant *ret = nullptr;
+                if (vm.returns) {
+                    GET_VARIANT_PTR(r, argc);
+                    ret = r;
+                }
+
+                bool called = base->get_type() == vm.base_type && Variant::call_validated_builtin_method(vm.method, *base, (const Variant **)argptrs, argc, ret);
+                if (unlikely(!called)) {
+                    const StringName *methodname = &_global_names_ptr[vm.name];
+
+                    Variant::CallError err;
+                    base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+#ifdef DEBUG_ENABLED
+                    if (err.error != Variant::CallError::CALL_OK) {
+                        err_text = _get_call_error(err, "function '" + String(*methodname) + "' in base '" + _get_var_type(base) + "'", (const Variant **)argptrs);
+                        OPCODE_BREAK;
+                    }
+#endif
+                }
+
                 ip += argc + 1;
             }
             DISPATCH_OPCODE;
@@ -1311,7 +1559,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
                         OPCODE_BREAK;
                     }
                     if (ScriptDebugger::get_singleton()) {
-                        if (!ObjectDB::instance_validate(obj)) {
+                        if (!argobj->is_valid_object()) {
                             err_text = "First argument of yield() is a previously freed instance.";
                             OPCODE_BREAK;
                         }
@@ -1650,6 +1898,24 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
     return global_names[p_idx];
 }
 
+const GDScriptFunction::ValidatedOperator &GDScriptFunction::get_validated_operator(int p_idx) const {
+
+    CRASH_BAD_INDEX(p_idx, validated_operators.size());
+    return validated_operators[p_idx];
+}
+
+const GDScriptFunction::ValidatedMember &GDScriptFunction::get_validated_member(int p_idx) const {
+
+    CRASH_BAD_INDEX(p_idx, validated_members.size());
+    return validated_members[p_idx];
+}
+
+const GDScriptFunction::ValidatedMethod &GDScriptFunction::get_validated_method(int p_idx) const {
+
+    CRASH_BAD_INDEX(p_idx, validated_methods.size());
+    return validated_methods[p_idx];
+}
+
 int GDScriptFunction::get_default_argument_count() const {
 
     return _default_arg_count;
@@ -1749,6 +2015,14 @@ GDScriptFunction::GDScriptFunction() :
 
     _stack_size = 0;
     _call_size = 0;
+    _operators_ptr = nullptr;
+    _operators_count = 0;
+    _members_ptr = nullptr;
+    _members_count = 0;
+    _methods_ptr = nullptr;
+    _methods_count = 0;
+    _call_caches = nullptr;
+    _call_cache_count = 0;
     rpc_mode = MultiplayerAPI_RPCMode(0);
     name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -1777,6 +2051,9 @@ GDScriptFunction::GDScriptFunction() :
 }
 
 GDScriptFunction::~GDScriptFunction() {
+    if (_call_caches) {
+        memdelete_arr(_call_caches);
+    }
 #ifdef DEBUG_ENABLED
     if (GDScriptLanguage::get_singleton()->lock) {
         GDScriptLanguage::get_singleton()->lock->lock();
@@ -1936,10 +2213,10 @@ bool GDScriptDataType::is_type(const Variant &p_variant, bool p_allow_implicit_c
         if (p_variant.get_type() != VariantType::OBJECT) {
             return false;
         }
-        Object *obj = p_variant.operator Object *();
-        if (!obj || !ObjectDB::instance_validate(obj)) {
+        if (!p_variant.is_valid_object()) {
             return false;
         }
+        Object *obj = p_variant.operator Object *();
         if (!ClassDB::is_parent_class(obj->get_class_name(), native_type)) {
             // Try with underscore prefix
             StringName underscore_native_type = StringName(String("_") + native_type);
@@ -1957,10 +2234,10 @@ bool GDScriptDataType::is_type(const Variant &p_variant, bool p_allow_implicit_c
         if (p_variant.get_type() != VariantType::OBJECT) {
             return false;
         }
-        Object *obj = p_variant.operator Object *();
-        if (!obj || !ObjectDB::instance_validate(obj)) {
+        if (!p_variant.is_valid_object()) {
             return false;
         }
+        Object *obj = p_variant.operator Object *();
         Ref<Script> base = obj->get_script_instance() ? obj->get_script_instance()->get_script() : Ref<Script>();
         bool valid = false;
         while (base) {
@@ -39,8 +39,11 @@
 #include "core/variant.h"
 #include "core/list.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
+class MethodBind;
 
 struct GDScriptDataType {
     bool has_type;
@@ -93,12 +96,15 @@ class GDScriptFunction {
 public:
     enum Opcode {
         OPCODE_OPERATOR,
+        OPCODE_OPERATOR_VALIDATED,
         OPCODE_EXTENDS_TEST,
         OPCODE_IS_BUILTIN,
         OPCODE_SET,
         OPCODE_GET,
         OPCODE_SET_NAMED,
+        OPCODE_SET_NAMED_VALIDATED,
         OPCODE_GET_NAMED,
+        OPCODE_GET_NAMED_VALIDATED,
         OPCODE_SET_MEMBER,
         OPCODE_GET_MEMBER,
         OPCODE_ASSIGN,
@@ -115,6 +121,7 @@ public:
         OPCODE_CONSTRUCT_DICTIONARY,
         OPCODE_CALL,
         OPCODE_CALL_RETURN,
+        OPCODE_CALL_BUILTIN_TYPE_VALIDATED,
         OPCODE_CALL_BUILT_IN,
         OPCODE_CALL_SELF,
         OPCODE_CALL_SELF_BASE,
@@ -150,6 +157,49 @@ public:
         ADDR_TYPE_NIL = 9
     };
 
+    // Operands of the *_VALIDATED opcodes. The compiler emits them when the static types are known; the VM still
+    // checks the runtime types and takes the generic path when they don't match.
+    struct ValidatedOperator {
+        Variant::ValidatedOperatorEvaluator evaluator;
+        Variant::Operator op;
+        VariantType left_type;
+        VariantType right_type;
+    };
+
+    struct ValidatedMember {
+        Variant::ValidatedMember member;
+        VariantType base_type;
+        int name; // global name index, used by the generic path
+    };
+
+    struct ValidatedMethod {
+        const Variant::ValidatedBuiltinMethod *method;
+        VariantType base_type;
+        bool returns;
+        int name; // global name index, used by the generic path
+    };
+
+    // Inline cache of one OPCODE_CALL / OPCODE_CALL_RETURN site. Each slot maps the receiver's script and native class
+    // to the GDScriptFunction or MethodBind that Object::call would end up in. Slots are only appended, under a sequence
+    // lock; the cache is emptied once GDScriptLanguage's call cache epoch moves (some script was recompiled or freed).
+    struct CallCache {
+        enum {
+            SLOT_COUNT = 4 // more receiver kinds than this and the site is treated as megamorphic
+        };
+
+        struct Slot {
+            std::atomic<const GDScript *> script { nullptr };
+            std::atomic<const TypeInfo *> type { nullptr };
+            std::atomic<GDScriptFunction *> function { nullptr };
+            std::atomic<MethodBind *> method { nullptr };
+        };
+
+        std::atomic<uint32_t> sequence { 0 };
+        std::atomic<uint32_t> epoch { 0 };
+        std::atomic<int> used { 0 };
+        Slot slots[SLOT_COUNT];
+    };
+
     struct StackDebug {
 
         int line;
@@ -172,6 +222,14 @@ private:
     const StringName *_named_globals_ptr;
     int _named_globals_count;
 #endif
+    const ValidatedOperator *_operators_ptr;
+    int _operators_count;
+    const ValidatedMember *_members_ptr;
+    int _members_count;
+    const ValidatedMethod *_methods_ptr;
+    int _methods_count;
+    CallCache *_call_caches;
+    int _call_cache_count;
     const int *_default_arg_ptr;
     int _default_arg_count;
     const int *_code_ptr;
@@ -191,6 +249,9 @@ private:
 #ifdef TOOLS_ENABLED
     Vector<StringName> named_globals;
 #endif
+    Vector<ValidatedOperator> validated_operators;
+    Vector<ValidatedMember> validated_members;
+    Vector<ValidatedMethod> validated_methods;
     Vector<int> default_arguments;
     Vector<int> code;
     Vector<GDScriptDataType> argument_types;
@@ -204,6 +265,7 @@ private:
 
     Variant *_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
     String _get_call_error(const Variant::CallError &p_err, se_string_view p_where, const Variant **argptrs) const;
+    bool _call_cached(CallCache &p_cache, Object *p_obj, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Variant::CallError &r_err) const;
 
     friend class GDScriptLanguage;
 
@@ -249,6 +311,10 @@ public:
     int get_code_size() const;
     Variant get_constant(int p_idx) const;
     StringName get_global_name(int p_idx) const;
+    const ValidatedOperator &get_validated_operator(int p_idx) const;
+    const ValidatedMember &get_validated_member(int p_idx) const;
+    const ValidatedMethod &get_validated_method(int p_idx) const;
+    int get_call_cache_count() const { return _call_cache_count; }
     StringName get_name() const;
     int get_max_stack_size() const;
     int get_default_argument_count() const;
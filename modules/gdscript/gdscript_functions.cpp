@@ -1469,8 +1469,7 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
             if (p_args[0]->get_type() != VariantType::OBJECT) {
                 r_ret = false;
             } else {
-                Object *obj = *p_args[0];
-                r_ret = ObjectDB::instance_validate(obj);
+                r_ret = p_args[0]->is_valid_object();
             }
 
         } break;
@@ -41,6 +41,11 @@
 Error ImageLoaderPNG::load_image(ImageData &p_image, FileAccess *f, LoadParams params) {
 
     const size_t buffer_size = f->get_len();
+    if (const uint8_t *mapped = f->borrow_buffer(buffer_size)) {
+        Error err = PNGDriverCommon::png_to_image(mapped, buffer_size, p_image);
+        f->close();
+        return err;
+    }
     PoolVector<uint8_t> file_buffer;
     Error err = file_buffer.resize(buffer_size);
     if (err) {
@@ -104,6 +104,11 @@ Error ImageLoaderWEBP::load_image(ImageData &p_image, FileAccess *f, LoadParams
     PoolVector<uint8_t> src_image;
     int src_image_len = f->get_len();
     ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+    if (const uint8_t *mapped = f->borrow_buffer(src_image_len)) {
+        Error err = webp_load_image_from_buffer(p_image, mapped, src_image_len);
+        f->close();
+        return err;
+    }
     src_image.resize(src_image_len);
 
     PoolVector<uint8_t>::Write w = src_image.write();
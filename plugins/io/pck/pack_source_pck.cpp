@@ -3,8 +3,12 @@
 #include "core/os/file_access.h"
 
 #include "core/io/file_access_pack.h"
+#include "core/project_settings.h"
 #include "core/version.h"
 
+#include <QFile>
+#include <cstring>
+
 class FileAccessPack : public FileAccess {
 
     PackedDataFile pf;
@@ -12,6 +16,8 @@ class FileAccessPack : public FileAccess {
     mutable size_t pos;
     mutable bool eof;
 
+    // Either the file contents inside a mapped pack, or the pack opened through FileAccess.
+    const uint8_t *mapped;
     FileAccess *f;
     Error _open(se_string_view p_path, int p_mode_flags) override;
     uint64_t _get_modified_time(se_string_view p_file) override { return 0; }
@@ -32,6 +38,7 @@ public:
     uint8_t get_8() const override;
 
     int get_buffer(uint8_t *p_dst, int p_length) const override;
+    const uint8_t *borrow_buffer(uint64_t p_length) const override;
 
     void set_endian_swap(bool p_swap) override;
 
@@ -44,7 +51,7 @@ public:
 
     bool file_exists(se_string_view p_name) override;
 
-    FileAccessPack(se_string_view p_path, const PackedDataFile &p_file);
+    FileAccessPack(se_string_view p_path, const PackedDataFile &p_file, const uint8_t *p_mapped);
     ~FileAccessPack() override;
 };
 //////////////////////////////////////////////////////////////////
@@ -57,12 +64,14 @@ Error FileAccessPack::_open(se_string_view p_path, int p_mode_flags) {
 
 void FileAccessPack::close() {
 
-    f->close();
+    if (f)
+        f->close();
+    mapped = nullptr;
 }
 
 bool FileAccessPack::is_open() const {
 
-    return f->is_open();
+    return f ? f->is_open() : mapped != nullptr;
 }
 
 void FileAccessPack::seek(size_t p_position) {
@@ -73,7 +82,8 @@ void FileAccessPack::seek(size_t p_position) {
         eof = false;
     }
 
-    f->seek(pf.offset + p_position);
+    if (f)
+        f->seek(pf.offset + p_position);
     pos = p_position;
 }
 void FileAccessPack::seek_end(int64_t p_position) {
@@ -100,6 +110,9 @@ uint8_t FileAccessPack::get_8() const {
         return 0;
     }
 
+    if (mapped)
+        return mapped[pos++];
+
     pos++;
     return f->get_8();
 }
@@ -109,24 +122,40 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
     if (eof)
         return 0;
 
-    uint64_t to_read = p_length;
+    int64_t to_read = p_length;
     if (to_read + pos > pf.size) {
         eof = true;
         to_read = int64_t(pf.size) - int64_t(pos);
     }
 
+    // a short read still moves the position by the full length, like the other FileAccess implementations
+    const uint8_t *src = mapped ? mapped + pos : nullptr;
     pos += p_length;
 
     if (to_read <= 0)
         return 0;
-    f->get_buffer(p_dst, to_read);
+    if (mapped)
+        memcpy(p_dst, src, to_read);
+    else
+        f->get_buffer(p_dst, to_read);
 
     return to_read;
 }
 
+const uint8_t *FileAccessPack::borrow_buffer(uint64_t p_length) const {
+
+    if (!mapped || eof || pos > pf.size || p_length > pf.size - pos)
+        return nullptr;
+
+    const uint8_t *ret = mapped + pos;
+    pos += p_length;
+    return ret;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
     FileAccess::set_endian_swap(p_swap);
-    f->set_endian_swap(p_swap);
+    if (f)
+        f->set_endian_swap(p_swap);
 }
 
 Error FileAccessPack::get_error() const {
@@ -156,15 +185,20 @@ bool FileAccessPack::file_exists(se_string_view p_name) {
     return false;
 }
 
-FileAccessPack::FileAccessPack(se_string_view p_path, const PackedDataFile &p_file) :
+FileAccessPack::FileAccessPack(se_string_view p_path, const PackedDataFile &p_file, const uint8_t *p_mapped) :
         pf(p_file),
-        f(FileAccess::open(pf.pack, FileAccess::READ)) {
+        pos(0),
+        eof(false),
+        mapped(p_mapped),
+        f(nullptr) {
+
+    if (mapped)
+        return;
 
-    ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + pf.pack + "'."); 
+    f = FileAccess::open(pf.pack, FileAccess::READ);
+    ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + pf.pack + "'.");
 
     f->seek(pf.offset);
-    pos = 0;
-    eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
@@ -257,7 +291,45 @@ bool PackedSourcePCK::try_open_pack(se_string_view p_path, bool p_replace_files)
 };
 
 
+const PackedSourcePCK::PackMapping &PackedSourcePCK::_map_pack(const String &p_pack) {
+
+    MutexLock guard(mappings_mutex);
+
+    auto E = mappings.find(p_pack);
+    if (E != mappings.end())
+        return E->second;
+
+    PackMapping &m = mappings[p_pack];
+
+    // packs nested in the resource tree are not plain files, those keep going through FileAccess
+    String path = ProjectSettings::get_singleton()->globalize_path(p_pack);
+    m.file = memnew(QFile(QString::fromUtf8(path.data(), path.size())));
+    if (m.file->open(QIODevice::ReadOnly)) {
+        m.size = m.file->size();
+        m.data = m.size ? m.file->map(0, m.size) : nullptr;
+    }
+    if (!m.data) {
+        memdelete(m.file);
+        m.file = nullptr;
+        m.size = 0;
+    }
+    return m;
+}
+
 FileAccess *PackedSourcePCK::get_file(se_string_view p_path, PackedDataFile *p_file) {
 
-    return memnew_basic(FileAccessPack(p_path, *p_file));
+    const PackMapping &m = _map_pack(p_file->pack);
+    const uint8_t *mapped = nullptr;
+    if (m.data && p_file->offset <= m.size && p_file->size <= m.size - p_file->offset)
+        mapped = m.data + p_file->offset;
+
+    return memnew_basic(FileAccessPack(p_path, *p_file, mapped));
 };
+
+PackedSourcePCK::~PackedSourcePCK() {
+
+    for (eastl::pair<const String, PackMapping> &E : mappings) {
+        if (E.second.file)
+            memdelete(E.second.file); // unmaps
+    }
+}
@@ -1,12 +1,33 @@
 #pragma once
 
 #include "core/plugin_interfaces/PluginDeclarations.h"
+#include "core/hash_map.h"
+#include "core/os/mutex.h"
+#include "core/se_string.h"
+
+class QFile;
 
 class PackedSourcePCK : public QObject, public PackSourceInterface {
     Q_PLUGIN_METADATA(IID "org.godot.PackSourcePCK")
     Q_INTERFACES(PackSourceInterface)
     Q_OBJECT
+
+    // Read-only mapping of a whole pack, shared by every file opened from it. data is null if the pack could not be
+    // mapped, files are then read through FileAccess.
+    struct PackMapping {
+        QFile *file = nullptr;
+        const uint8_t *data = nullptr;
+        uint64_t size = 0;
+    };
+
+    HashMap<String, PackMapping> mappings;
+    Mutex mappings_mutex;
+
+    const PackMapping &_map_pack(const String &p_pack);
+
 public:
     bool try_open_pack(se_string_view p_path, bool p_replace_files) override;
     FileAccess *get_file(se_string_view p_path, PackedDataFile *p_file) override;
+
+    ~PackedSourcePCK() override;
 };
@@ -605,7 +605,7 @@ void CanvasItem::_notification(int p_what) {
             }
             _enter_canvas();
             if (!block_transform_notify && !xform_change.in_list()) {
-                get_tree()->xform_change_list.add(&xform_change);
+                get_tree()->_add_xform_change(&xform_change);
             }
         } break;
         case NOTIFICATION_MOVED_IN_PARENT: {
@@ -624,7 +624,7 @@ void CanvasItem::_notification(int p_what) {
         } break;
         case NOTIFICATION_EXIT_TREE: {
             if (xform_change.in_list())
-                get_tree()->xform_change_list.remove(&xform_change);
+                get_tree()->_remove_xform_change(&xform_change);
             _exit_canvas();
             if (C!=List<CanvasItem *>::iterator()) {
                 object_cast<CanvasItem>(get_parent())->children_items.erase(C);
@@ -992,7 +992,7 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
     if (p_node->notify_transform && !p_node->xform_change.in_list()) {
         if (!p_node->block_transform_notify) {
             if (p_node->is_inside_tree())
-                get_tree()->xform_change_list.add(&p_node->xform_change);
+                get_tree()->_add_xform_change(&p_node->xform_change);
         }
     }
 
@@ -1142,7 +1142,7 @@ void CanvasItem::force_update_transform() {
         return;
     }
 
-    get_tree()->xform_change_list.remove(&xform_change);
+    get_tree()->_remove_xform_change(&xform_change);
 
     notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -41,6 +41,21 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
     return NavigationServer::get_singleton()->map_get_path(map, p_start, p_end, p_optimize);
 }
 
+Vector3 Navigation::get_closest_point(const Vector3 &p_point) const {
+
+    return NavigationServer::get_singleton()->map_get_closest_point(map, p_point);
+}
+
+Vector3 Navigation::get_closest_point_normal(const Vector3 &p_point) const {
+
+    return NavigationServer::get_singleton()->map_get_closest_point_normal(map, p_point);
+}
+
+RID Navigation::get_closest_point_owner(const Vector3 &p_point) const {
+
+    return NavigationServer::get_singleton()->map_get_closest_point_owner(map, p_point);
+}
+
 void Navigation::set_up_vector(const Vector3 &p_up) {
 
     up = p_up;
@@ -67,6 +82,9 @@ void Navigation::_bind_methods() {
     MethodBinder::bind_method(D_METHOD("get_rid"), &Navigation::get_rid);
 
     MethodBinder::bind_method(D_METHOD("get_simple_path", {"start", "end", "optimize"}),&Navigation::get_simple_path, {DEFVAL(true)});
+    MethodBinder::bind_method(D_METHOD("get_closest_point", {"to_point"}),&Navigation::get_closest_point);
+    MethodBinder::bind_method(D_METHOD("get_closest_point_normal", {"to_point"}),&Navigation::get_closest_point_normal);
+    MethodBinder::bind_method(D_METHOD("get_closest_point_owner", {"to_point"}),&Navigation::get_closest_point_owner);
 
     MethodBinder::bind_method(D_METHOD("set_up_vector", {"up"}),&Navigation::set_up_vector);
     MethodBinder::bind_method(D_METHOD("get_up_vector"), &Navigation::get_up_vector);
@@ -87,7 +87,7 @@ void Spatial::_notify_dirty() {
     if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 
 #endif
-        get_tree()->xform_change_list.add(&xform_change);
+        get_tree()->_add_xform_change(&xform_change);
     }
 }
 
@@ -120,7 +120,7 @@ void Spatial::_propagate_transform_changed(Spatial *p_origin) {
 #else
     if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 #endif
-        get_tree()->xform_change_list.add(&xform_change);
+        get_tree()->_add_xform_change(&xform_change);
     }
     data.dirty |= DIRTY_GLOBAL;
 
@@ -159,7 +159,7 @@ void Spatial::_notification(int p_what) {
 
             notification(NOTIFICATION_EXIT_WORLD, true);
             if (xform_change.in_list())
-                get_tree()->xform_change_list.remove(&xform_change);
+                get_tree()->_remove_xform_change(&xform_change);
 
             if (data.parent)
                 data.parent->data.children.erase_first(this);
@@ -735,7 +735,7 @@ void Spatial::force_update_transform() {
     if (!xform_change.in_list()) {
         return; //nothing to update
     }
-    get_tree()->xform_change_list.remove(&xform_change);
+    get_tree()->_remove_xform_change(&xform_change);
 
     notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -33,7 +33,7 @@
 #include "scene/resources/texture.h"
 #include "core/os/os.h"
 #include "core/string_utils.h"
-#include "core/os/threaded_array_processor.h"
+#include "core/os/job_system.h"
 #include "core/print_string.h"
 
 #include <cstdlib>
@@ -1888,15 +1888,25 @@ Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh
     {
         LightMap *lightmap_ptr = lightmap.data();
         uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
-        volatile int lines = 0;
-
-        // make sure our OS-level rng is seeded
-
-        for (int i = 0; i < height; i++) {
-
-            thread_process_array(width, this, &VoxelLightBaker::_lightmap_bake_point, &lightmap_ptr[i * width]);
+        int lines = 0;
+        JobSystem *js = JobSystem::get_singleton();
+        // bake several lines per step so every worker has pixels to trace, progress is still reported per step.
+        const int lines_per_step = js ? MAX(1, js->get_worker_count() + 1) : 1;
+
+        for (int i = 0; i < height; i += lines_per_step) {
+
+            const int step_lines = MIN(lines_per_step, height - i);
+            LightMap *step_ptr = &lightmap_ptr[i * width];
+            if (js) {
+                js->parallel_for(step_lines * width, [this, step_ptr](uint32_t p_pixel) {
+                    _lightmap_bake_point(p_pixel, step_ptr);
+                });
+            } else {
+                for (int j = 0; j < step_lines * width; j++)
+                    _lightmap_bake_point(j, step_ptr);
+            }
 
-            lines = MAX(lines, i); //for multithread
+            lines = i + step_lines - 1;
             if (p_bake_time_func) {
                 uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin_time;
                 float elapsed_sec = double(elapsed) / 1000000.0;
@@ -34,6 +34,7 @@
 #include "core/method_bind.h"
 #include "core/message_queue.h"
 #include "core/object_tooling.h"
+#include "scene/resources/animation_compiled.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 #include "EASTL/sort.h"
@@ -240,15 +241,17 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
     Animation *a = p_anim->animation.operator->();
 
     p_anim->node_cache.resize(a->get_track_count());
+    p_anim->property_cache.resize(a->get_track_count());
 
     for (int i = 0; i < a->get_track_count(); i++) {
 
         p_anim->node_cache[i] = nullptr;
+        p_anim->property_cache[i] = nullptr;
         RES resource;
         Vector<StringName> leftover_path;
         Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
         ERR_CONTINUE_MSG(!child, "On Animation: '" + p_anim->name + "', couldn't resolve track:  '" + String(a->track_get_path(i)) + "'."); // couldn't find the child node
-        uint32_t id = resource ? resource->get_instance_id() : child->get_instance_id();
+        ObjectID id = resource ? resource->get_instance_id() : child->get_instance_id();
         int bone_idx = -1;
 
         if (a->track_get_path(i).get_subname_count() == 1 && object_cast<Skeleton>(child)) {
@@ -323,6 +326,7 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
                 }
                 p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
             }
+            p_anim->property_cache[i] = &p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()];
         }
 
         if (a->track_get_type(i) == Animation::TYPE_BEZIER && !leftover_path.empty()) {
@@ -367,6 +371,16 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
         if (a->track_get_key_count(i) == 0)
             continue; // do nothing if track is empty
 
+        // Fetched per track rather than once, as a method track may have edited the animation.
+        const AnimationCompiled *compiled = nullptr;
+        int channel = -1;
+        if (playback_compiled) {
+            compiled = a->get_compiled();
+            channel = compiled->get_track_channel(i);
+            if (p_anim->compiled_cursors.size() != compiled->get_channel_count())
+                p_anim->compiled_cursors.resize(compiled->get_channel_count(), 0);
+        }
+
         switch (a->track_get_type(i)) {
 
             case Animation::TYPE_TRANSFORM: {
@@ -378,7 +392,11 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
                 Quat rot;
                 Vector3 scale;
 
-                Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+                Error err;
+                if (channel >= 0)
+                    err = compiled->sample_transform(channel, p_time, p_anim->compiled_cursors[channel], &loc, &rot, &scale) ? OK : ERR_UNAVAILABLE;
+                else
+                    err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
                 //ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
                 if (err != OK)
@@ -405,12 +423,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
                 if (!nc->node)
                     continue;
 
-                //StringName property=a->track_get_path(i).get_property();
-
-                HashMap<StringName, TrackNodeCache::PropertyAnim>::iterator E = nc->property_anim.find(a->track_get_path(i).get_concatenated_subnames());
-                ERR_CONTINUE(E==nc->property_anim.end()); //should it continue, or create a new one?
-
-                TrackNodeCache::PropertyAnim *pa = &E->second;
+                TrackNodeCache::PropertyAnim *pa = p_anim->property_cache[i];
+                ERR_CONTINUE(!pa);
 
                 Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
@@ -458,7 +472,13 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
                 if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-                    Variant value = a->value_track_interpolate(i, p_time);
+                    Variant value;
+                    if (channel >= 0) {
+                        if (!compiled->sample_value(channel, p_time, p_anim->compiled_cursors[channel], value))
+                            continue;
+                    } else {
+                        value = a->value_track_interpolate(i, p_time);
+                    }
 
                     if (value == Variant())
                         continue;
@@ -1306,6 +1326,16 @@ float AnimationPlayer::get_speed_scale() const {
 
     return speed_scale;
 }
+
+void AnimationPlayer::set_playback_compiled(bool p_enabled) {
+
+    playback_compiled = p_enabled;
+}
+
+bool AnimationPlayer::is_playback_compiled() const {
+
+    return playback_compiled;
+}
 float AnimationPlayer::get_playing_speed() const {
 
     if (!playing) {
@@ -1406,6 +1436,7 @@ void AnimationPlayer::clear_caches() {
     for (eastl::pair<const StringName,AnimationData> &E : animation_set) {
 
         E.second.node_cache.clear();
+        E.second.property_cache.clear();
     }
 
     cache_update_size = 0;
@@ -1648,6 +1679,9 @@ void AnimationPlayer::_bind_methods() {
 
     MethodBinder::bind_method(D_METHOD("set_speed_scale", {"speed"}), &AnimationPlayer::set_speed_scale);
     MethodBinder::bind_method(D_METHOD("get_speed_scale"), &AnimationPlayer::get_speed_scale);
+
+    MethodBinder::bind_method(D_METHOD("set_playback_compiled", {"enabled"}), &AnimationPlayer::set_playback_compiled);
+    MethodBinder::bind_method(D_METHOD("is_playback_compiled"), &AnimationPlayer::is_playback_compiled);
     MethodBinder::bind_method(D_METHOD("get_playing_speed"), &AnimationPlayer::get_playing_speed);
 
     MethodBinder::bind_method(D_METHOD("set_autoplay", {"name"}), &AnimationPlayer::set_autoplay);
@@ -1684,6 +1718,7 @@ void AnimationPlayer::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(VariantType::REAL, "playback_default_blend_time", PropertyHint::Range, "0,4096,0.01"), "set_default_blend_time", "get_default_blend_time");
     ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "playback_active", PropertyHint::None, "", 0), "set_active", "is_active");
     ADD_PROPERTY(PropertyInfo(VariantType::REAL, "playback_speed", PropertyHint::Range, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
+    ADD_PROPERTY(PropertyInfo(VariantType::BOOL, "playback_compiled"), "set_playback_compiled", "is_playback_compiled");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "method_call_mode", PropertyHint::Enum, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
     ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(VariantType::STRING, "anim_name")));
@@ -1715,6 +1750,7 @@ AnimationPlayer::AnimationPlayer() {
     root = SceneStringNames::get_singleton()->path_pp;
     playing = false;
     active = true;
+    playback_compiled = false;
     playback.seeked = false;
     playback.started = false;
 }
@@ -162,7 +162,7 @@ private:
 
     struct TrackNodeCacheKey {
 
-        uint32_t id;
+        ObjectID id;
         int bone_idx;
 
         inline bool operator<(const TrackNodeCacheKey &p_right) const {
@@ -194,6 +194,8 @@ private:
         String name;
         StringName next;
         Vector<TrackNodeCache *> node_cache;
+        Vector<TrackNodeCache::PropertyAnim *> property_cache; // per value track, filled with node_cache
+        Vector<int> compiled_cursors; // per compiled channel, key search hints for compiled playback
         Ref<Animation> animation;
     };
 
@@ -257,6 +259,7 @@ private:
     AnimationMethodCallMode method_call_mode;
     bool processing;
     bool active;
+    bool playback_compiled;
 
     NodePath root;
 
@@ -326,6 +329,9 @@ public:
 
     void set_speed_scale(float p_speed);
     float get_speed_scale() const;
+
+    void set_playback_compiled(bool p_enabled);
+    bool is_playback_compiled() const;
     float get_playing_speed() const;
 
     void set_autoplay(se_string_view p_name);
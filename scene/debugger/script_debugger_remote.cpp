@@ -109,7 +109,7 @@ void ScriptDebuggerRemote::_put_variable(se_string_view p_name, const Variant &p
     packet_peer_stream->put_var(p_name);
 
     Variant var = p_variable;
-    if (p_variable.get_type() == VariantType::OBJECT && !ObjectDB::instance_validate(p_variable)) {
+    if (p_variable.get_type() == VariantType::OBJECT && !p_variable.is_valid_object()) {
         var = Variant();
     }
 
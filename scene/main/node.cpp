@@ -45,6 +45,7 @@
 #include "core/script_language.h"
 #include "core/string_formatter.h"
 #include "core/ustring.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/resources/packed_scene.h"
 #include "scene/scene_string_names.h"
@@ -61,6 +62,7 @@ IMPL_GDCLASS(Node)
 VARIANT_ENUM_CAST(MultiplayerAPI_RPCMode);
 
 VARIANT_ENUM_CAST(Node::PauseMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::DuplicateFlags);
 
 int Node::orphan_node_count = 0;
@@ -97,12 +99,18 @@ struct Node::PrivData {
 
     PauseMode pause_mode;
     Node *pause_owner;
+    ProcessThreadGroup process_thread_group;
+    bool process_threaded; // resolved process_thread_group, valid while inside the tree
 
     int network_master;
     HashMap<StringName, MultiplayerAPI_RPCMode> rpc_methods;
     HashMap<StringName, MultiplayerAPI_RPCMode> rpc_properties;
 
 
+    ScenePool *scene_pool = nullptr;
+    // indexed by _direct_process_slot
+    Node::DirectProcessFunc direct_process[4] = {};
+
     bool ready_notified; //this is a small hack, so if a node is added during _ready() to the tree, it correctly gets the _ready() notification
     bool ready_first;
     // variables used to properly sort the node when processing, ignored otherwise
@@ -164,6 +172,11 @@ void Node::_notification(int p_notification) {
                 data->pause_owner = this;
             }
 
+            if (data->process_thread_group == PROCESS_THREAD_GROUP_INHERIT)
+                _set_process_threaded(data->parent && data->parent->data->process_threaded);
+            else
+                _set_process_threaded(data->process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD);
+
             if (data->input)
                 add_to_group(StringName("_vp_input" + itos(get_viewport()->get_instance_id())));
             if (data->unhandled_input)
@@ -190,6 +203,7 @@ void Node::_notification(int p_notification) {
                 remove_from_group(StringName("_vp_unhandled_key_input" + itos(get_viewport()->get_instance_id())));
 
             data->pause_owner = nullptr;
+            _set_process_threaded(false);
             if (data->path_cache) {
                 memdelete(data->path_cache);
                 data->path_cache = nullptr;
@@ -235,6 +249,10 @@ void Node::_notification(int p_notification) {
         } break;
         case NOTIFICATION_PREDELETE: {
 
+            // a pooled root freed by game code, the pool must not hand it out or free it again.
+            if (data->scene_pool)
+                data->scene_pool->_forget(this);
+
             set_owner(nullptr);
 
             while (!data->owned.empty()) {
@@ -516,13 +534,10 @@ void Node::set_pause_mode(PauseMode p_mode) {
     if (data->pause_mode == p_mode)
         return;
 
-    bool prev_inherits = data->pause_mode == PAUSE_MODE_INHERIT;
     data->pause_mode = p_mode;
     if (!is_inside_tree())
         return; //pointless
-    if ((data->pause_mode == PAUSE_MODE_INHERIT) == prev_inherits)
-        return; ///nothing changed
-
+    // also propagated when going between stop and process: the owner stays, but nodes below are notified.
     Node *owner = nullptr;
 
     if (data->pause_mode == PAUSE_MODE_INHERIT) {
@@ -546,6 +561,7 @@ void Node::_propagate_pause_owner(Node *p_owner) {
     if (this != p_owner && data->pause_mode != PAUSE_MODE_INHERIT)
         return;
     data->pause_owner = p_owner;
+    notification(NOTIFICATION_PAUSE_OWNER_CHANGED);
     for (int i = 0; i < data->children.size(); i++) {
 
         data->children[i]->_propagate_pause_owner(p_owner);
@@ -948,6 +964,58 @@ int Node::get_process_priority() const {
     return process_priority;
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_group) {
+
+    if (data->process_thread_group == p_group)
+        return;
+
+    data->process_thread_group = p_group;
+    if (!is_inside_tree())
+        return; //resolved on enter tree
+
+    bool threaded;
+    if (p_group == PROCESS_THREAD_GROUP_INHERIT)
+        threaded = data->parent && data->parent->data->process_threaded;
+    else
+        threaded = p_group == PROCESS_THREAD_GROUP_SUB_THREAD;
+
+    _set_process_threaded(threaded);
+    for (int i = 0; i < data->children.size(); i++) {
+
+        data->children[i]->_propagate_process_threaded(threaded);
+    }
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+
+    return data->process_thread_group;
+}
+
+bool Node::is_process_threaded() const {
+
+    return data->process_threaded;
+}
+
+void Node::_propagate_process_threaded(bool p_threaded) {
+
+    if (data->process_thread_group != PROCESS_THREAD_GROUP_INHERIT)
+        return;
+    _set_process_threaded(p_threaded);
+    for (int i = 0; i < data->children.size(); i++) {
+
+        data->children[i]->_propagate_process_threaded(p_threaded);
+    }
+}
+
+void Node::_set_process_threaded(bool p_threaded) {
+
+    if (data->process_threaded == p_threaded)
+        return;
+    data->process_threaded = p_threaded;
+    //lets SceneTree skip looking for threaded nodes while there are none
+    tree->process_threaded_count += p_threaded ? 1 : -1;
+}
+
 void Node::set_process_input(bool p_enable) {
 
     if (p_enable == data->input)
@@ -1255,6 +1323,44 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
     add_child_notify(p_child);
 }
 
+void Node::_reserve_children(int p_count) {
+
+    data->children.reserve(data->children.size() + p_count);
+}
+
+ScenePool *Node::_get_scene_pool() const {
+
+    return data->scene_pool;
+}
+
+void Node::_set_scene_pool(ScenePool *p_pool) {
+
+    data->scene_pool = p_pool;
+}
+
+static int _direct_process_slot(int p_notification) {
+    switch (p_notification) {
+        case Node::NOTIFICATION_PHYSICS_PROCESS: return 0;
+        case Node::NOTIFICATION_PROCESS: return 1;
+        case Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS: return 2;
+        case Node::NOTIFICATION_INTERNAL_PROCESS: return 3;
+    }
+    return -1;
+}
+
+void Node::_set_direct_process_func(int p_notification, DirectProcessFunc p_func) {
+
+    int slot = _direct_process_slot(p_notification);
+    ERR_FAIL_COND_MSG(slot < 0, "Direct callbacks are only supported for process notifications.");
+    data->direct_process[slot] = p_func;
+}
+
+Node::DirectProcessFunc Node::_get_direct_process_func(int p_notification) const {
+
+    int slot = _direct_process_slot(p_notification);
+    return slot < 0 ? nullptr : data->direct_process[slot];
+}
+
 void Node::add_child(Node *p_child, bool p_legible_unique_name) {
 
     ERR_FAIL_NULL(p_child);
@@ -1767,6 +1873,13 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 
     ERR_FAIL_COND(!p_identifier.asString().length());
 
+    if (tree && tree->threaded_dispatch) {
+        // groups are frozen while threaded process callbacks run (e.g. set_process() called from one),
+        // the change is applied once the MessageQueue is flushed.
+        MessageQueue::get_singleton()->push_call(get_instance_id(), "add_to_group", p_identifier, p_persistent);
+        return;
+    }
+
     if (data->grouped.contains(p_identifier))
         return;
 
@@ -1785,6 +1898,11 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 
 void Node::remove_from_group(const StringName &p_identifier) {
 
+    if (tree && tree->threaded_dispatch) {
+        MessageQueue::get_singleton()->push_call(get_instance_id(), "remove_from_group", p_identifier);
+        return;
+    }
+
     ERR_FAIL_COND(!data->grouped.contains(p_identifier));
 
     HashMap<StringName, GroupData>::iterator E = data->grouped.find(p_identifier);
@@ -2850,6 +2968,9 @@ void Node::_bind_methods() {
     MethodBinder::bind_method(D_METHOD("set_process", {"enable"}), &Node::set_process);
     MethodBinder::bind_method(D_METHOD("set_process_priority", {"priority"}), &Node::set_process_priority);
     MethodBinder::bind_method(D_METHOD("get_process_priority"), &Node::get_process_priority);
+    MethodBinder::bind_method(D_METHOD("set_process_thread_group", {"group"}), &Node::set_process_thread_group);
+    MethodBinder::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+    MethodBinder::bind_method(D_METHOD("is_process_threaded"), &Node::is_process_threaded);
     MethodBinder::bind_method(D_METHOD("is_processing"), &Node::is_processing);
     MethodBinder::bind_method(D_METHOD("set_process_input", {"enable"}), &Node::set_process_input);
     MethodBinder::bind_method(D_METHOD("is_processing_input"), &Node::is_processing_input);
@@ -2941,6 +3062,7 @@ void Node::_bind_methods() {
     BIND_CONSTANT(NOTIFICATION_PATH_CHANGED)
     BIND_CONSTANT(NOTIFICATION_INTERNAL_PROCESS)
     BIND_CONSTANT(NOTIFICATION_INTERNAL_PHYSICS_PROCESS)
+    BIND_CONSTANT(NOTIFICATION_PAUSE_OWNER_CHANGED)
 
     BIND_CONSTANT(NOTIFICATION_WM_MOUSE_ENTER)
     BIND_CONSTANT(NOTIFICATION_WM_MOUSE_EXIT)
@@ -2961,6 +3083,10 @@ void Node::_bind_methods() {
     BIND_ENUM_CONSTANT(PAUSE_MODE_STOP)
     BIND_ENUM_CONSTANT(PAUSE_MODE_PROCESS)
 
+    BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT)
+    BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD)
+    BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD)
+
     BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS)
     BIND_ENUM_CONSTANT(DUPLICATE_GROUPS)
     BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS)
@@ -2986,6 +3112,7 @@ void Node::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "multiplayer", PropertyHint::ResourceType, "MultiplayerAPI", 0), "", "get_multiplayer");
     ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "custom_multiplayer", PropertyHint::ResourceType, "MultiplayerAPI", 0), "set_custom_multiplayer", "get_custom_multiplayer");
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "process_priority"), "set_process_priority", "get_process_priority");
+    ADD_PROPERTY(PropertyInfo(VariantType::INT, "process_thread_group", PropertyHint::Enum, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 
     BIND_VMETHOD(MethodInfo("_process", PropertyInfo(VariantType::REAL, "delta")))
@@ -3022,6 +3149,8 @@ Node::Node() {
     data->unhandled_key_input = false;
     data->pause_mode = PAUSE_MODE_INHERIT;
     data->pause_owner = nullptr;
+    data->process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+    data->process_threaded = false;
     data->network_master = 1; //server by default
     data->path_cache = nullptr;
     parent_owned = false;
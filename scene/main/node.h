@@ -37,6 +37,7 @@
 
 class Viewport;
 class SceneState;
+class ScenePool;
 class MultiplayerAPI;
 class SceneTree;
 class Resource;
@@ -62,6 +63,13 @@ public:
         PAUSE_MODE_PROCESS
     };
 
+    enum ProcessThreadGroup : int8_t {
+
+        PROCESS_THREAD_GROUP_INHERIT,
+        PROCESS_THREAD_GROUP_MAIN_THREAD,
+        PROCESS_THREAD_GROUP_SUB_THREAD
+    };
+
     enum DuplicateFlags {
 
         DUPLICATE_SIGNALS = 1,
@@ -132,6 +140,8 @@ public:
     void _propagate_validate_owner();
     void _print_stray_nodes();
     void _propagate_pause_owner(Node *p_owner);
+    void _propagate_process_threaded(bool p_threaded);
+    void _set_process_threaded(bool p_threaded);
     Array _get_node_and_resource(const NodePath &p_path);
 
     void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -171,6 +181,18 @@ protected:
     friend class SceneState;
 
     void _add_child_nocheck(Node *p_child, const StringName &p_name);
+    void _reserve_children(int p_count);
+
+    friend class ScenePool;
+    // pool that takes this node back instead of SceneTree freeing it, see ScenePool.
+    ScenePool *_get_scene_pool() const;
+    void _set_scene_pool(ScenePool *p_pool);
+
+    // Native fast path for the process notifications: SceneTree calls p_func(this, delta) instead of
+    // going through the _notificationv chain. Ignored while a script is attached.
+    using DirectProcessFunc = void (*)(Node *p_node, float p_delta);
+    void _set_direct_process_func(int p_notification, DirectProcessFunc p_func);
+    DirectProcessFunc _get_direct_process_func(int p_notification) const;
     void _set_owner_nocheck(Node *p_owner);
     void _set_name_nocheck(const StringName &p_name);
 
@@ -196,6 +218,7 @@ public:
         NOTIFICATION_INTERNAL_PROCESS = 25,
         NOTIFICATION_INTERNAL_PHYSICS_PROCESS = 26,
         NOTIFICATION_POST_ENTER_TREE = 27,
+        NOTIFICATION_PAUSE_OWNER_CHANGED = 28,
         //keep these linked to node
         NOTIFICATION_WM_MOUSE_ENTER = MainLoop::NOTIFICATION_WM_MOUSE_ENTER,
         NOTIFICATION_WM_MOUSE_EXIT = MainLoop::NOTIFICATION_WM_MOUSE_EXIT,
@@ -310,6 +333,11 @@ public:
     void set_process_priority(int p_priority);
     int get_process_priority() const;
 
+    void set_process_thread_group(ProcessThreadGroup p_group);
+    ProcessThreadGroup get_process_thread_group() const;
+    //! True when the process callbacks of this node run on JobSystem workers, after resolving inheritance.
+    bool is_process_threaded() const;
+
     void set_process_input(bool p_enable);
     bool is_processing_input() const;
 
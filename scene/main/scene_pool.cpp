@@ -0,0 +1,274 @@
+/*************************************************************************/
+/*  scene_pool.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "scene_pool.h"
+
+#include "core/core_string_names.h"
+#include "core/method_bind.h"
+#include "core/object_db.h"
+#include "scene/main/node.h"
+
+IMPL_GDCLASS(ScenePool)
+
+bool ScenePool::_make_entry(Entry &r_entry) {
+
+    ERR_FAIL_COND_V_MSG(!scene || !scene->can_instance(), false, "ScenePool has no scene to instance.");
+
+    Node *root = scene->instance();
+    ERR_FAIL_COND_V(!root, false);
+
+    Ref<SceneState> state = scene->get_state();
+    const int nc = state->get_node_count();
+    const bool snapshot = reset_state.empty();
+    if (snapshot)
+        reset_state.resize(nc);
+
+    r_entry.root = root;
+    r_entry.nodes.resize(nc);
+    for (int i = 0; i < nc; i++) {
+        Node *node = root->get_node_or_null(state->get_node_path(i));
+        if (!node) {
+            // nodes of instanced sub-scenes that vanished, nothing we can reset reliably.
+            memdelete(root);
+            reset_state.clear();
+            ERR_FAIL_V_MSG(false, "ScenePool can't track every node of the scene.");
+        }
+        r_entry.nodes[i] = node->get_instance_id();
+
+        if (!snapshot)
+            continue;
+
+        // Resources (local to scene ones included) and scripts stay as instanced.
+        Vector<PropertyInfo> props;
+        node->get_property_list(&props);
+        for (const PropertyInfo &pi : props) {
+            if (!(pi.usage & PROPERTY_USAGE_STORAGE) || pi.type == VariantType::OBJECT || pi.name == CoreStringNames::get_singleton()->_script)
+                continue;
+            // arrays and dictionaries are shared by reference, the snapshot gets its own copy.
+            reset_state[i].push_back({ pi.name, node->get(pi.name).duplicate(true) });
+        }
+    }
+
+    root->_set_scene_pool(this);
+    return true;
+}
+
+bool ScenePool::_reset_entry(const Entry &p_entry) const {
+
+    for (size_t i = 0; i < p_entry.nodes.size(); i++) {
+        Node *node = object_cast<Node>(ObjectDB::get_instance(p_entry.nodes[i]));
+        // game code freed or moved part of the instance, it can't be reused.
+        if (!node || (i > 0 && !p_entry.root->is_a_parent_of(node)))
+            return false;
+
+        for (const ResetProperty &rp : reset_state[i]) {
+            node->set(rp.name, rp.value.duplicate(true));
+        }
+        node->request_ready();
+    }
+    return true;
+}
+
+void ScenePool::_free_entry(const Entry &p_entry) {
+
+    // nodes[0] is the root; once it no longer resolves the root was freed already.
+    if (p_entry.nodes.empty() || ObjectDB::get_instance(p_entry.nodes[0]) != p_entry.root)
+        return;
+    // let go first, so the predelete of the root doesn't come back to _forget() it.
+    p_entry.root->_set_scene_pool(nullptr);
+    memdelete(p_entry.root);
+}
+
+void ScenePool::_forget(Node *p_root) {
+
+    p_root->_set_scene_pool(nullptr);
+    in_use.erase(p_root->get_instance_id());
+    for (size_t i = 0; i < available.size(); i++) {
+        if (available[i].root == p_root) {
+            available.erase(available.begin() + i);
+            break;
+        }
+    }
+}
+
+bool ScenePool::_recycle(Node *p_root) {
+
+    auto E = in_use.find(p_root->get_instance_id());
+    if (E == in_use.end()) {
+        // already back, e.g. queue_free() called twice or release() followed by queue_free().
+        for (const Entry &e : available) {
+            if (e.root == p_root) {
+                p_root->cancelDeleteLater();
+                return true;
+            }
+        }
+        ERR_FAIL_V_MSG(false, "Node was not handed out by this ScenePool.");
+    }
+
+    if (int(available.size()) >= max_size) {
+        _forget(p_root);
+        return false;
+    }
+
+    Entry entry;
+    entry.root = p_root;
+    entry.nodes = eastl::move(E->second);
+    in_use.erase(E);
+
+    if (p_root->get_parent())
+        p_root->get_parent()->remove_child(p_root);
+    p_root->cancelDeleteLater();
+    available.emplace_back(eastl::move(entry));
+    return true;
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+
+    if (scene == p_scene)
+        return;
+    clear();
+    reset_state.clear();
+    scene = p_scene;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+
+    return scene;
+}
+
+void ScenePool::set_max_size(int p_size) {
+
+    ERR_FAIL_COND(p_size < 0);
+    max_size = p_size;
+    while (int(available.size()) > max_size) {
+        Entry entry = eastl::move(available.back());
+        available.pop_back();
+        _free_entry(entry);
+    }
+}
+
+int ScenePool::get_max_size() const {
+
+    return max_size;
+}
+
+Node *ScenePool::acquire() {
+
+    Entry entry;
+    while (!available.empty()) {
+        entry = eastl::move(available.back());
+        available.pop_back();
+        if (_reset_entry(entry))
+            break;
+        _free_entry(entry);
+        entry.root = nullptr;
+    }
+
+    if (!entry.root && !_make_entry(entry))
+        return nullptr;
+
+    Node *root = entry.root;
+    root->_set_scene_pool(this);
+    // released and then queue_free()d before the deletion queue got flushed.
+    root->cancelDeleteLater();
+    in_use[root->get_instance_id()] = eastl::move(entry.nodes);
+    return root;
+}
+
+void ScenePool::release(Node *p_root) {
+
+    ERR_FAIL_NULL(p_root);
+    ERR_FAIL_COND_MSG(p_root->_get_scene_pool() != this, "Node was not handed out by this ScenePool.");
+
+    if (!_recycle(p_root)) {
+        // pool is full; the node may be inside a callback, so let SceneTree free it.
+        p_root->queue_delete();
+    }
+}
+
+void ScenePool::prewarm(int p_count) {
+
+    ERR_FAIL_COND(p_count < 0);
+    for (int i = 0; i < p_count && int(available.size()) < max_size; i++) {
+        Entry entry;
+        if (!_make_entry(entry))
+            return;
+        available.emplace_back(eastl::move(entry));
+    }
+}
+
+void ScenePool::clear() {
+
+    Vector<Entry> entries(eastl::move(available));
+    available.clear();
+    for (const Entry &e : entries) {
+        _free_entry(e);
+    }
+
+    // instances still out in the game become ordinary nodes.
+    for (auto &E : in_use) {
+        Node *node = object_cast<Node>(ObjectDB::get_instance(E.first));
+        if (node)
+            node->_set_scene_pool(nullptr);
+    }
+    in_use.clear();
+}
+
+int ScenePool::get_available_count() const {
+
+    return available.size();
+}
+
+int ScenePool::get_in_use_count() const {
+
+    return in_use.size();
+}
+
+void ScenePool::_bind_methods() {
+
+    MethodBinder::bind_method(D_METHOD("set_scene", {"scene"}), &ScenePool::set_scene);
+    MethodBinder::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+    MethodBinder::bind_method(D_METHOD("set_max_size", {"size"}), &ScenePool::set_max_size);
+    MethodBinder::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+    MethodBinder::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+    MethodBinder::bind_method(D_METHOD("release", {"node"}), &ScenePool::release);
+    MethodBinder::bind_method(D_METHOD("prewarm", {"count"}), &ScenePool::prewarm);
+    MethodBinder::bind_method(D_METHOD("clear"), &ScenePool::clear);
+    MethodBinder::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+    MethodBinder::bind_method(D_METHOD("get_in_use_count"), &ScenePool::get_in_use_count);
+
+    ADD_PROPERTY(PropertyInfo(VariantType::OBJECT, "scene", PropertyHint::ResourceType, "PackedScene"), "set_scene", "get_scene");
+    ADD_PROPERTY(PropertyInfo(VariantType::INT, "max_size", PropertyHint::Range, "0,4096,1"), "set_max_size", "get_max_size");
+}
+
+ScenePool::~ScenePool() {
+
+    clear();
+}
@@ -0,0 +1,95 @@
+/*************************************************************************/
+/*  scene_pool.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/hash_map.h"
+#include "core/reference.h"
+#include "scene/resources/packed_scene.h"
+
+class Node;
+
+// Keeps detached instances of one PackedScene warm so short-lived nodes (projectiles, hit effects)
+// can be handed out again instead of being instanced and freed every time. Nodes handed out by
+// acquire() go back to the pool through release(), or through queue_free(), which SceneTree turns
+// into a release when the deletion queue is flushed.
+class GODOT_EXPORT ScenePool : public RefCounted {
+
+    GDCLASS(ScenePool, RefCounted)
+
+    struct Entry {
+        Node *root;
+        Vector<ObjectID> nodes; // in SceneState order
+    };
+
+    // Stored properties of every scene node as a fresh instance has them, applied on reuse.
+    struct ResetProperty {
+        StringName name;
+        Variant value;
+    };
+
+    Ref<PackedScene> scene;
+    Vector<Vector<ResetProperty> > reset_state;
+    Vector<Entry> available;
+    HashMap<ObjectID, Vector<ObjectID> > in_use;
+    int max_size = 64;
+
+    bool _make_entry(Entry &r_entry);
+    bool _reset_entry(const Entry &p_entry) const;
+    void _free_entry(const Entry &p_entry);
+
+    friend class Node;
+    // called by a pooled root that is being freed, and when a full pool lets one go.
+    void _forget(Node *p_root);
+
+    friend class SceneTree;
+    bool _recycle(Node *p_root);
+
+protected:
+    static void _bind_methods();
+
+public:
+    void set_scene(const Ref<PackedScene> &p_scene);
+    Ref<PackedScene> get_scene() const;
+
+    void set_max_size(int p_size);
+    int get_max_size() const;
+
+    Node *acquire();
+    void release(Node *p_root);
+    void prewarm(int p_count);
+    void clear();
+
+    int get_available_count() const;
+    int get_in_use_count() const;
+
+    ScenePool() = default;
+    ~ScenePool() override;
+};
@@ -38,6 +38,7 @@
 #include "core/object_db.h"
 #include "core/os/mutex.h"
 #include "core/os/dir_access.h"
+#include "core/os/job_system.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
@@ -49,6 +50,7 @@
 #include "main/input_default.h"
 #include "node.h"
 #include "scene/debugger/script_debugger_remote.h"
+#include "scene/main/scene_pool.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -427,15 +429,22 @@ void SceneTreeTimer::_bind_methods() {
 }
 
 void SceneTreeTimer::set_time_left(float p_time) {
-    time_left = p_time;
+    if (tree)
+        tree->_schedule_timer(this, p_time);
+    else
+        time_left = p_time;
 }
 
 float SceneTreeTimer::get_time_left() const {
-    return time_left;
+    return wheel_item.is_scheduled() ? wheel_item.get_time_left() : time_left;
 }
 
 void SceneTreeTimer::set_pause_mode_process(bool p_pause_mode_process) {
+    if (process_pause == p_pause_mode_process)
+        return;
     process_pause = p_pause_mode_process;
+    if (tree) //moves to the other wheel
+        tree->_schedule_timer(this, get_time_left());
 }
 
 bool SceneTreeTimer::is_pause_mode_process() {
@@ -452,7 +461,18 @@ void SceneTreeTimer::release_connections() {
     }
 }
 
-SceneTreeTimer::SceneTreeTimer() {
+void SceneTreeTimer::_timeout(TimerWheel::Item *p_item, TimerWheel *p_wheel) {
+
+    SceneTreeTimer *timer = static_cast<SceneTreeTimer *>(p_item->userdata);
+    timer->time_left = p_item->deadline - p_wheel->get_time();
+    timer->tree = nullptr;
+    timer->emit_signal("timeout");
+    if (timer->unreference())
+        memdelete(timer);
+}
+
+SceneTreeTimer::SceneTreeTimer() :
+        wheel_item(_timeout, this) {
     time_left = 0;
     process_pause = true;
 }
@@ -493,6 +513,8 @@ void SceneTree::node_renamed(Node *p_node) {
 
 SceneTreeGroup *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
 
+    ERR_FAIL_COND_V_MSG(threaded_dispatch, nullptr, "Groups can't be changed from a threaded process callback, use call_deferred().");
+
     HashMap<StringName, SceneTreeGroup>::iterator E = group_map.find(p_group);
     if (E==group_map.end()) {
         E = group_map.emplace(p_group, SceneTreeGroup()).first;
@@ -507,11 +529,24 @@ SceneTreeGroup *SceneTree::add_to_group(const StringName &p_group, Node *p_node)
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 
+    ERR_FAIL_COND_MSG(threaded_dispatch, "Groups can't be changed from a threaded process callback, use call_deferred().");
+
     HashMap<StringName, SceneTreeGroup>::iterator E = group_map.find(p_group);
     ERR_FAIL_COND(E==group_map.end());
 
-    E->second.nodes.erase_first(p_node);
-    if (E->second.nodes.empty())
+    SceneTreeGroup &g = E->second;
+    if (g.iterating) {
+        // Keep indices stable for the dispatch loop in progress, _compact_group cleans up after it.
+        auto iter = eastl::find(g.nodes.begin(), g.nodes.end(), p_node);
+        if (iter != g.nodes.end()) {
+            *iter = nullptr;
+            g.tombstones++;
+        }
+        return;
+    }
+
+    g.nodes.erase_first(p_node);
+    if (g.nodes.empty())
         group_map.erase(E);
 }
 
@@ -521,6 +556,29 @@ void SceneTree::make_group_changed(const StringName &p_group) {
         E->second.changed = true;
 }
 
+void SceneTree::_add_xform_change(SelfList<Node> *p_item) {
+
+    if (!threaded_dispatch) {
+        xform_change_list.add(p_item);
+        return;
+    }
+    // moving a node also queues its children, which may be processed by another worker
+    std::lock_guard<std::mutex> guard(xform_change_mutex);
+    if (!p_item->in_list())
+        xform_change_list.add(p_item);
+}
+
+void SceneTree::_remove_xform_change(SelfList<Node> *p_item) {
+
+    if (!threaded_dispatch) {
+        xform_change_list.remove(p_item);
+        return;
+    }
+    std::lock_guard<std::mutex> guard(xform_change_mutex);
+    if (p_item->in_list())
+        xform_change_list.remove(p_item);
+}
+
 void SceneTree::flush_transform_notifications() {
 
     SelfList<Node> *n = xform_change_list.first();
@@ -560,6 +618,8 @@ void SceneTree::_update_group_order(SceneTreeGroup &g, bool p_use_priority) {
         return;
     if (g.nodes.empty())
         return;
+    if (g.iterating) //sorting would shuffle the nodes under a running dispatch, next one will pick it up
+        return;
 
     Node **nodes = g.nodes.data();
     int node_count = g.nodes.size();
@@ -574,6 +634,31 @@ void SceneTree::_update_group_order(SceneTreeGroup &g, bool p_use_priority) {
     g.changed = false;
 }
 
+Vector<Node *> SceneTree::_copy_group_nodes(const SceneTreeGroup &g) {
+
+    Vector<Node *> nodes_copy = g.nodes;
+    if (g.tombstones)
+        nodes_copy.erase(eastl::remove(nodes_copy.begin(), nodes_copy.end(), nullptr), nodes_copy.end());
+    return nodes_copy;
+}
+
+void SceneTree::_compact_group(const StringName &p_group) {
+
+    // looked up again, dispatch may have added groups and rehashed group_map.
+    HashMap<StringName, SceneTreeGroup>::iterator E = group_map.find(p_group);
+    if (E == group_map.end())
+        return;
+    SceneTreeGroup &g = E->second;
+    if (g.iterating || g.tombstones == 0)
+        return;
+
+    // eastl::remove is stable, so the priority order of the survivors is kept.
+    g.nodes.erase(eastl::remove(g.nodes.begin(), g.nodes.end(), nullptr), g.nodes.end());
+    g.tombstones = 0;
+    if (g.nodes.empty())
+        group_map.erase(E);
+}
+
 void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
 
     HashMap<StringName, SceneTreeGroup>::iterator E = group_map.find(p_group);
@@ -609,7 +694,7 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 
     _update_group_order(g);
 
-    Vector<Node *> nodes_copy = g.nodes;
+    Vector<Node *> nodes_copy = _copy_group_nodes(g);
     Node **nodes = nodes_copy.data();
     int node_count = nodes_copy.size();
 
@@ -664,7 +749,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 
     _update_group_order(g);
 
-    Vector<Node *> nodes_copy = g.nodes;
+    Vector<Node *> nodes_copy = _copy_group_nodes(g);
     Node **nodes = nodes_copy.data();
     int node_count = nodes_copy.size();
 
@@ -713,7 +798,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
     _update_group_order(g);
 
-    Vector<Node *> nodes_copy = g.nodes;
+    Vector<Node *> nodes_copy = _copy_group_nodes(g);
     Node **nodes = nodes_copy.data();
     int node_count = nodes_copy.size();
 
@@ -850,6 +935,7 @@ bool SceneTree::iteration(float p_time) {
 
     _notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
     _notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
+    physics_timers.advance(p_time);
     _flush_ugc();
     MessageQueue::get_singleton()->flush(); //small little hack
     flush_transform_notifications();
@@ -913,27 +999,10 @@ bool SceneTree::idle(float p_time) {
 
     _flush_delete_queue();
 
-    //go through timers
-
-    auto L = &timers.back(); //last element
-    //break on last, so if new timers were added during list traversal, ignore them.
-    for (auto E = timers.begin(); E!=timers.end() && (&(*E) == L);) {
-
-        if (pause && !(*E)->is_pause_mode_process()) {
-            ++E;
-            continue;
-        }
-        float time_left = (*E)->get_time_left();
-        time_left -= p_time;
-        (*E)->set_time_left(time_left);
-
-        if (time_left < 0) {
-            (*E)->emit_signal("timeout");
-            E=timers.erase(E);
-        }
-        else
-            ++E;
-    }
+    //go through timers, only the ones expiring this frame are touched
+    idle_timers.advance(p_time);
+    if (!pause)
+        idle_timers_pausable.advance(p_time);
 
     flush_transform_notifications(); //additional transforms after timers update
 
@@ -987,10 +1056,15 @@ void SceneTree::finish() {
         root = nullptr;
     }
     // cleanup timers
-    for (const Ref<SceneTreeTimer> &E : timers) {
-        E->release_connections();
-    }
-    timers.clear();
+    auto release_timer = [](TimerWheel::Item *p_item, TimerWheel *) {
+        SceneTreeTimer *timer = static_cast<SceneTreeTimer *>(p_item->userdata);
+        timer->tree = nullptr;
+        timer->release_connections();
+        if (timer->unreference())
+            memdelete(timer);
+    };
+    idle_timers.clear(release_timer);
+    idle_timers_pausable.clear(release_timer);
 }
 
 void SceneTree::quit(int p_exit_code) {
@@ -1278,7 +1352,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 
     //copy, so copy on write happens in case something is removed from process while being called
     //performance is not lost because only if something is added/removed the vector is copied.
-    Vector<Node *> nodes_copy = g.nodes;
+    Vector<Node *> nodes_copy = _copy_group_nodes(g);
 
     int node_count = nodes_copy.size();
     Node **nodes = nodes_copy.data();
@@ -1309,6 +1383,38 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
         call_skip.clear();
 }
 
+void SceneTree::_dispatch_process(Node *p_node, int p_notification, float p_delta) {
+
+    Node::DirectProcessFunc func = p_node->_get_direct_process_func(p_notification);
+    if (func && !p_node->get_script_instance())
+        func(p_node, p_delta);
+    else
+        p_node->notification(p_notification);
+}
+
+// Threaded nodes of a group run before the main thread ones, all at once and in no particular order.
+// Anything they do to other nodes or servers is expected to go through call_deferred(), whose off-thread
+// pushes are staged per thread by the MessageQueue and flushed after the process groups.
+void SceneTree::_process_threaded_nodes(int p_notification, float p_delta) {
+
+    int count = threaded_process_nodes.size();
+    if (count == 0)
+        return;
+
+    Node **nodes = threaded_process_nodes.data();
+    JobSystem *job_system = JobSystem::get_singleton();
+
+    threaded_dispatch = true;
+    if (job_system && count > 1) {
+        job_system->parallel_for(count, [nodes, p_notification, p_delta](uint32_t i) { _dispatch_process(nodes[i], p_notification, p_delta); });
+    } else {
+        for (int i = 0; i < count; i++)
+            _dispatch_process(nodes[i], p_notification, p_delta);
+    }
+    threaded_dispatch = false;
+    _flush_pending_timers();
+}
+
 void SceneTree::_notify_group_pause(const StringName &p_group, int p_notification) {
 
     HashMap<StringName, SceneTreeGroup>::iterator E = group_map.find(p_group);
@@ -1318,32 +1424,60 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
     if (g.nodes.empty())
         return;
 
-    _update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+    // Only ever called for the four process groups, which are kept in priority order.
+    _update_group_order(g, true);
 
-    //copy, so copy on write happens in case something is removed from process while being called
-    //performance is not lost because only if something is added/removed the vector is copied.
-    Vector<Node *> nodes_copy = g.nodes;
+    const bool physics = p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS;
+    const float delta = physics ? get_physics_process_time() : get_idle_process_time();
+    //only script-level processing goes wide; internal processing of engine nodes stays on the main thread
+    const bool threaded = process_threaded_count && (p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS);
 
-    int node_count = nodes_copy.size();
-    Node **nodes = nodes_copy.data();
+    //no copy: nodes removed while dispatching are tombstoned in place, nodes added are appended
+    //past node_count and wait for the next frame. data() is re-read since push_back may reallocate.
+    int node_count = g.nodes.size();
 
     call_lock++;
+    g.iterating++;
+
+    if (threaded) {
+
+        threaded_process_nodes.clear();
+        for (int i = 0; i < node_count; i++) {
+
+            Node *n = g.nodes[i];
+            if (!n || !n->is_process_threaded())
+                continue;
+            if (call_skip.contains(n))
+                continue;
+            if (!n->can_process() || !n->can_process_notification(p_notification))
+                continue;
+            threaded_process_nodes.push_back(n);
+        }
+        _process_threaded_nodes(p_notification, delta);
+    }
 
     for (int i = 0; i < node_count; i++) {
 
-        Node *n = nodes[i];
+        Node *n = g.nodes[i];
+        if (!n)
+            continue;
         if (call_lock && call_skip.contains(n))
             continue;
+        if (threaded && n->is_process_threaded())
+            continue;
 
         if (!n->can_process())
             continue;
         if (!n->can_process_notification(p_notification))
             continue;
 
-        n->notification(p_notification);
+        _dispatch_process(n, p_notification, delta);
         //ERR_FAIL_COND();
     }
 
+    g.iterating--;
+    _compact_group(p_group);
+
     call_lock--;
     if (call_lock == 0)
         call_skip.clear();
@@ -1428,10 +1562,14 @@ Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
     ret.resize(nc);
 
     Node **ptr = E->second.nodes.data();
+    int count = 0;
     for (int i = 0; i < nc; i++) {
 
-        ret[i] = Variant(ptr[i]);
+        if (ptr[i])
+            ret[count++] = Variant(ptr[i]);
     }
+    if (count != nc)
+        ret.resize(count);
 
     return ret;
 }
@@ -1453,7 +1591,8 @@ void SceneTree::get_nodes_in_group(const StringName &p_group, Deque<Node *> *p_l
     Node **ptr = E->second.nodes.data();
     for (int i = 0; i < nc; i++) {
 
-        p_list->push_back(ptr[i]);
+        if (ptr[i])
+            p_list->push_back(ptr[i]);
     }
 }
 
@@ -1463,7 +1602,12 @@ void SceneTree::_flush_delete_queue() {
 
     for(ObjectID id : delete_queue) {
         Object *obj = ObjectDB::get_instance(id);
-        if (obj) {
+        // skips entries of pooled nodes that were released and handed out again since.
+        if (obj && obj->is_queued_for_deletion()) {
+            // pooled instances are detached and handed back instead of freed.
+            Node *node = object_cast<Node>(obj);
+            if (node && node->_get_scene_pool() && node->_get_scene_pool()->_recycle(node))
+                continue;
             memdelete(obj);
         }
     }
@@ -1474,6 +1618,8 @@ void SceneTree::queue_delete(Object *p_object) {
 
     _THREAD_SAFE_METHOD_
     ERR_FAIL_NULL(p_object);
+    if (p_object->is_queued_for_deletion())
+        return;
     p_object->deleteLater();
     delete_queue.push_back(p_object->get_instance_id());
 }
@@ -1700,11 +1846,48 @@ Ref<SceneTreeTimer> SceneTree::create_timer(float p_delay_sec, bool p_process_pa
 
     Ref<SceneTreeTimer> stt(make_ref_counted<SceneTreeTimer>());
     stt->set_pause_mode_process(p_process_pause);
-    stt->set_time_left(p_delay_sec);
-    timers.push_back(stt);
+    _schedule_timer(stt.get(), p_delay_sec);
     return stt;
 }
 
+void SceneTree::_schedule_timer(SceneTreeTimer *p_timer, float p_delay) {
+
+    if (threaded_dispatch) {
+        // the wheels are not shared with the workers, see _flush_pending_timers()
+        std::lock_guard<std::mutex> guard(pending_timers_mutex);
+        p_timer->time_left = p_delay;
+        if (!p_timer->schedule_pending) {
+            p_timer->schedule_pending = true;
+            p_timer->reference();
+            pending_timers.push_back(p_timer);
+        }
+        return;
+    }
+
+    TimerWheel &wheel = p_timer->process_pause ? idle_timers : idle_timers_pausable;
+    TimerWheel::Item *item = &p_timer->wheel_item;
+
+    if (!p_timer->tree) {
+        // scheduled timers stay alive until they time out, like they did while stored in a list
+        p_timer->reference();
+        p_timer->tree = this;
+    } else if (item->wheel != &wheel) {
+        item->wheel->cancel(item);
+    }
+    wheel.schedule(item, p_delay);
+}
+
+void SceneTree::_flush_pending_timers() {
+
+    for (SceneTreeTimer *timer : pending_timers) {
+        timer->schedule_pending = false;
+        _schedule_timer(timer, timer->time_left);
+        if (timer->unreference())
+            memdelete(timer);
+    }
+    pending_timers.clear();
+}
+
 void SceneTree::_network_peer_connected(int p_id) {
 
     emit_signal("network_peer_connected", p_id);
@@ -2034,6 +2217,8 @@ SceneTree::SceneTree() {
     node_renamed_name = "node_renamed";
     ugc_locked = false;
     call_lock = 0;
+    process_threaded_count = 0;
+    threaded_dispatch = false;
     root_lock = 0;
     node_count = 0;
 
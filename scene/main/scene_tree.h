@@ -36,12 +36,16 @@
 #include "scene/resources/world.h"
 #include "scene/resources/world_2d.h"
 #include "scene/main/scene_tree_notifications.h"
+#include "scene/main/timer_wheel.h"
 #include "core/hash_map.h"
 #include "core/hash_set.h"
 #include "core/deque.h"
 
+#include <mutex>
+
 class PackedScene;
 class Node;
+class SceneTree;
 class Viewport;
 class Material;
 class Mesh;
@@ -79,8 +83,14 @@ public:
 class SceneTreeTimer : public RefCounted {
     GDCLASS(SceneTreeTimer,RefCounted)
 
-    float time_left;
+    TimerWheel::Item wheel_item;
+    SceneTree *tree = nullptr; // set while scheduled, the tree holds a reference until timeout
+    float time_left; // used while not scheduled, or as the delay while schedule_pending is set
     bool process_pause;
+    bool schedule_pending = false; // waits in SceneTree::pending_timers
+
+    friend class SceneTree;
+    static void _timeout(TimerWheel::Item *p_item, TimerWheel *p_wheel);
 
 protected:
     static void _bind_methods();
@@ -100,6 +110,9 @@ struct SceneTreeGroup
 {
     Vector<Node *> nodes;
     //uint64_t last_tree_version;
+    // While the group is being dispatched, removals leave nullptr slots that are compacted afterwards.
+    int iterating = 0;
+    int tombstones = 0;
     bool changed=false;
 };
 
@@ -180,6 +193,12 @@ private:
     int call_lock;
     HashSet<Node *> call_skip; //skip erased nodes
 
+    // nodes in the tree whose processing runs on JobSystem workers, see Node::set_process_thread_group
+    int process_threaded_count;
+    // set while threaded nodes are processed, the group structure must not change during that time
+    bool threaded_dispatch;
+    Vector<Node *> threaded_process_nodes;
+
     StretchMode stretch_mode;
     StretchAspect stretch_aspect;
     Size2i stretch_min;
@@ -195,6 +214,10 @@ private:
     void _flush_ugc();
 
     _FORCE_INLINE_ void _update_group_order(SceneTreeGroup &g, bool p_use_priority = false);
+    static Vector<Node *> _copy_group_nodes(const SceneTreeGroup &g);
+    void _compact_group(const StringName &p_group);
+    static void _dispatch_process(Node *p_node, int p_notification, float p_delta);
+    void _process_threaded_nodes(int p_notification, float p_delta);
     void _update_listener();
 
 
@@ -213,7 +236,20 @@ private:
     void _change_scene(Node *p_to);
     //void _call_group(uint32_t p_call_flags,const StringName& p_group,const StringName& p_function,const Variant& p_arg1,const Variant& p_arg2);
 
-    List<Ref<SceneTreeTimer> > timers;
+    // SceneTreeTimers and idle Timer nodes run on idle_timers, the pausable wheel is only advanced while
+    // the tree is not paused. Timer nodes that stop while paused leave their wheel instead.
+    TimerWheel idle_timers;
+    TimerWheel idle_timers_pausable;
+    TimerWheel physics_timers;
+
+    // SceneTreeTimers scheduled from threaded process callbacks, each holding a reference, added to their
+    // wheel once the threaded nodes are done.
+    Vector<SceneTreeTimer *> pending_timers;
+    std::mutex pending_timers_mutex;
+
+    void _schedule_timer(SceneTreeTimer *p_timer, float p_delay);
+    void _flush_pending_timers();
+    TimerWheel *_get_timer_wheel(bool p_physics) { return p_physics ? &physics_timers : &idle_timers; }
 
     ///network///
 
@@ -233,8 +269,14 @@ private:
     friend class CanvasItem;
     friend class Spatial;
     friend class Viewport;
+    friend class SceneTreeTimer;
+    friend class Timer;
 
     SelfList<Node>::List xform_change_list;
+    // threaded nodes moving themselves add to xform_change_list from several workers at once
+    std::mutex xform_change_mutex;
+    void _add_xform_change(SelfList<Node> *p_item);
+    void _remove_xform_change(SelfList<Node> *p_item);
 
     friend class ScriptDebuggerRemote;
 
@@ -31,6 +31,7 @@
 #include "timer.h"
 
 #include "core/engine.h"
+#include "core/message_queue.h"
 #include "core/method_bind.h"
 #include "scene/main/scene_tree.h"
 
@@ -52,38 +53,92 @@ void Timer::_notification(int p_what) {
                 autostart = false;
             }
         } break;
-        case NOTIFICATION_INTERNAL_PROCESS: {
-            if (timer_process_mode == TIMER_PROCESS_PHYSICS || !is_processing_internal())
-                return;
-            time_left -= get_process_delta_time();
-
-            if (time_left < 0) {
-                if (!one_shot)
-                    time_left += wait_time;
-                else
-                    stop();
-
-                emit_signal("timeout");
-            }
-
+        case NOTIFICATION_ENTER_TREE:
+        case NOTIFICATION_PAUSED:
+        case NOTIFICATION_UNPAUSED:
+        case NOTIFICATION_PAUSE_OWNER_CHANGED: {
+            _update_schedule();
         } break;
-        case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-            if (timer_process_mode == TIMER_PROCESS_IDLE || !is_physics_processing_internal())
-                return;
-            time_left -= get_physics_process_delta_time();
-
-            if (time_left < 0) {
-                if (!one_shot)
-                    time_left += wait_time;
-                else
-                    stop();
-                emit_signal("timeout");
-            }
-
+        case NOTIFICATION_EXIT_TREE: {
+            _unschedule();
         } break;
     }
 }
 
+// The wheels are shared by the whole tree, so timers started or stopped from a threaded process callback
+// only update them once the MessageQueue is flushed, the same way group changes are deferred.
+bool Timer::_defer_schedule(bool p_reset) {
+
+    if (!is_inside_tree() || !get_tree()->threaded_dispatch)
+        return false;
+
+    reset_deferred = reset_deferred || p_reset;
+    if (!schedule_deferred) {
+        schedule_deferred = true;
+        MessageQueue::get_singleton()->push_call(get_instance_id(), "_flush_schedule");
+    }
+    return true;
+}
+
+void Timer::_flush_schedule() {
+
+    schedule_deferred = false;
+    if (reset_deferred) {
+        reset_deferred = false;
+        _reset_schedule();
+    }
+    _update_schedule();
+}
+
+void Timer::_update_schedule() {
+
+    if (_defer_schedule(false))
+        return;
+
+    // can_process() covers the pause mode, it is reevaluated whenever the tree is paused or unpaused
+    TimerWheel *wheel = nullptr;
+    if (processing && !paused && is_inside_tree() && can_process())
+        wheel = get_tree()->_get_timer_wheel(timer_process_mode == TIMER_PROCESS_PHYSICS);
+
+    if (wheel_item.wheel == wheel)
+        return;
+    _unschedule();
+    if (wheel)
+        wheel->schedule(&wheel_item, time_left);
+}
+
+void Timer::_unschedule() {
+
+    if (_defer_schedule(false))
+        return;
+
+    if (!wheel_item.is_scheduled())
+        return;
+    time_left = wheel_item.get_time_left();
+    wheel_item.wheel->cancel(&wheel_item);
+}
+
+// Drops the remaining time of a running timer, the caller sets time_left.
+void Timer::_reset_schedule() {
+
+    if (_defer_schedule(true))
+        return;
+
+    if (wheel_item.is_scheduled())
+        wheel_item.wheel->cancel(&wheel_item);
+}
+
+void Timer::_timeout(TimerWheel::Item *p_item, TimerWheel *p_wheel) {
+
+    Timer *timer = static_cast<Timer *>(p_item->userdata);
+    if (!timer->one_shot)
+        p_wheel->schedule_at(p_item, p_item->deadline + timer->wait_time);
+    else
+        timer->stop();
+
+    timer->emit_signal("timeout");
+}
+
 void Timer::set_wait_time(float p_time) {
     ERR_FAIL_COND_MSG(p_time <= 0, "Time should be greater than zero."); 
     wait_time = p_time;
@@ -117,11 +172,13 @@ void Timer::start(float p_time) {
     if (p_time > 0) {
         set_wait_time(p_time);
     }
+    _reset_schedule(); //restart from the full wait time
     time_left = wait_time;
     _set_process(true);
 }
 
 void Timer::stop() {
+    _reset_schedule();
     time_left = -1;
     _set_process(false);
     autostart = false;
@@ -145,7 +202,8 @@ bool Timer::is_stopped() const {
 
 float Timer::get_time_left() const {
 
-    return time_left > 0 ? time_left : 0;
+    double left = wheel_item.is_scheduled() && !reset_deferred ? wheel_item.get_time_left() : time_left;
+    return left > 0 ? left : 0;
 }
 
 void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
@@ -153,21 +211,8 @@ void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
     if (timer_process_mode == p_mode)
         return;
 
-    switch (timer_process_mode) {
-        case TIMER_PROCESS_PHYSICS:
-            if (is_physics_processing_internal()) {
-                set_physics_process_internal(false);
-                set_process_internal(true);
-            }
-            break;
-        case TIMER_PROCESS_IDLE:
-            if (is_processing_internal()) {
-                set_process_internal(false);
-                set_physics_process_internal(true);
-            }
-            break;
-    }
     timer_process_mode = p_mode;
+    _update_schedule(); //moves a running timer to the other wheel
 }
 
 Timer::TimerProcessMode Timer::get_timer_process_mode() const {
@@ -176,11 +221,8 @@ Timer::TimerProcessMode Timer::get_timer_process_mode() const {
 }
 
 void Timer::_set_process(bool p_process, bool p_force) {
-    switch (timer_process_mode) {
-        case TIMER_PROCESS_PHYSICS: set_physics_process_internal(p_process && !paused); break;
-        case TIMER_PROCESS_IDLE: set_process_internal(p_process && !paused); break;
-    }
     processing = p_process;
+    _update_schedule();
 }
 
 void Timer::_bind_methods() {
@@ -207,6 +249,8 @@ void Timer::_bind_methods() {
     MethodBinder::bind_method(D_METHOD("set_timer_process_mode", {"mode"}), &Timer::set_timer_process_mode);
     MethodBinder::bind_method(D_METHOD("get_timer_process_mode"), &Timer::get_timer_process_mode);
 
+    MethodBinder::bind_method(D_METHOD("_flush_schedule"), &Timer::_flush_schedule);
+
     ADD_SIGNAL(MethodInfo("timeout"));
 
     ADD_PROPERTY(PropertyInfo(VariantType::INT, "process_mode", PropertyHint::Enum, "Physics,Idle"), "set_timer_process_mode", "get_timer_process_mode");
@@ -220,12 +264,19 @@ void Timer::_bind_methods() {
     BIND_ENUM_CONSTANT(TIMER_PROCESS_IDLE)
 }
 
-Timer::Timer() {
+Timer::Timer() :
+        wheel_item(_timeout, this) {
     timer_process_mode = TIMER_PROCESS_IDLE;
     autostart = false;
     wait_time = 1;
     one_shot = false;
     time_left = -1;
+    schedule_deferred = false;
+    reset_deferred = false;
     processing = false;
     paused = false;
 }
+
+Timer::~Timer() {
+    _unschedule();
+}
@@ -32,6 +32,7 @@
 #define TIMER_H
 
 #include "scene/main/node.h"
+#include "scene/main/timer_wheel.h"
 
 class Timer : public Node {
 
@@ -43,7 +44,19 @@ class Timer : public Node {
 	bool processing;
 	bool paused;
 
+	// Running timers sit in the tree's timer wheel, time_left is only kept up to date while they are not.
+	TimerWheel::Item wheel_item;
 	double time_left;
+	// Set while a wheel change made from a threaded process callback waits for the MessageQueue flush.
+	bool schedule_deferred;
+	bool reset_deferred;
+
+	bool _defer_schedule(bool p_reset);
+	void _flush_schedule();
+	void _update_schedule();
+	void _unschedule();
+	void _reset_schedule();
+	static void _timeout(TimerWheel::Item *p_item, TimerWheel *p_wheel);
 
 protected:
 	void _notification(int p_what);
@@ -77,6 +90,7 @@ public:
 	void set_timer_process_mode(TimerProcessMode p_mode);
 	TimerProcessMode get_timer_process_mode() const;
 	Timer();
+	~Timer() override;
 
 private:
 	TimerProcessMode timer_process_mode;
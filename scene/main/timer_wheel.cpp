@@ -0,0 +1,205 @@
+/*************************************************************************/
+/*  timer_wheel.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "timer_wheel.h"
+
+#include "core/error_macros.h"
+
+static uint64_t _time_to_tick(double p_time) {
+    // millisecond resolution, the exact deadline is compared once a timer reaches the pending list
+    return p_time > 0 ? uint64_t(p_time * 1000.0) : 0;
+}
+
+double TimerWheel::Item::get_time_left() const {
+
+    return wheel ? deadline - wheel->get_time() : 0;
+}
+
+void TimerWheel::_link(ItemList &p_list, Item *p_item) {
+
+    p_item->prev = nullptr;
+    p_item->next = p_list.first;
+    if (p_list.first)
+        p_list.first->prev = p_item;
+    p_list.first = p_item;
+    p_item->list = &p_list;
+}
+
+void TimerWheel::_unlink(Item *p_item) {
+
+    if (p_item->prev)
+        p_item->prev->next = p_item->next;
+    else
+        p_item->list->first = p_item->next;
+    if (p_item->next)
+        p_item->next->prev = p_item->prev;
+    p_item->prev = nullptr;
+    p_item->next = nullptr;
+    p_item->list = nullptr;
+}
+
+void TimerWheel::_insert(Item *p_item) {
+
+    uint64_t tick = p_item->deadline_tick;
+    if (tick <= current_tick) {
+        _link(pending, p_item);
+        return;
+    }
+
+    // Finest level whose span still reaches the deadline, a slot of level N is cascaded when the
+    // clock enters it, so comparing block indices avoids slots aliasing with the current one.
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        int shift = level * SLOT_BITS;
+        if ((tick >> shift) - (current_tick >> shift) < SLOT_COUNT) {
+            _link(slots[level][(tick >> shift) & SLOT_MASK], p_item);
+            return;
+        }
+    }
+    _link(overflow, p_item);
+}
+
+void TimerWheel::_cascade(ItemList &p_list) {
+
+    Item *item = p_list.first;
+    p_list.first = nullptr;
+    while (item) {
+        Item *next = item->next;
+        item->prev = nullptr;
+        item->next = nullptr;
+        item->list = nullptr;
+        _insert(item);
+        item = next;
+    }
+}
+
+void TimerWheel::schedule_at(Item *p_item, double p_deadline) {
+
+    ERR_FAIL_NULL(p_item);
+    ERR_FAIL_COND_MSG(p_item->wheel && p_item->wheel != this, "Timer is scheduled on another wheel.");
+
+    if (p_item->wheel)
+        _unlink(p_item);
+    else
+        count++;
+
+    p_item->wheel = this;
+    p_item->deadline = p_deadline;
+    p_item->deadline_tick = _time_to_tick(p_deadline);
+    _insert(p_item);
+}
+
+void TimerWheel::cancel(Item *p_item) {
+
+    ERR_FAIL_NULL(p_item);
+    if (!p_item->wheel)
+        return;
+    ERR_FAIL_COND_MSG(p_item->wheel != this, "Timer is scheduled on another wheel.");
+
+    _unlink(p_item);
+    p_item->wheel = nullptr;
+    count--;
+}
+
+void TimerWheel::advance(double p_delta) {
+
+    time += p_delta;
+    uint64_t target = _time_to_tick(time);
+
+    if (count == 0) {
+        current_tick = MAX(current_tick, target);
+        return;
+    }
+
+    while (current_tick < target) {
+
+        current_tick++;
+
+        if ((current_tick & SLOT_MASK) == 0) {
+            // cascade from the coarsest level that wrapped around, so items land in the finest level
+            int top = 1;
+            while (top < LEVEL_COUNT && (current_tick & ((uint64_t(1) << ((top + 1) * SLOT_BITS)) - 1)) == 0)
+                top++;
+            if (top == LEVEL_COUNT)
+                _cascade(overflow);
+            for (int level = MIN(top, LEVEL_COUNT - 1); level > 0; level--)
+                _cascade(slots[level][(current_tick >> (level * SLOT_BITS)) & SLOT_MASK]);
+        }
+
+        // everything in this slot is due on this tick
+        _cascade(slots[0][current_tick & SLOT_MASK]);
+    }
+
+    Item *item = pending.first;
+    while (item) {
+        Item *next = item->next;
+        if (item->deadline < time) {
+            _unlink(item);
+            _link(expired, item);
+        }
+        item = next;
+    }
+
+    // expire functions may schedule or cancel anything, including items still waiting in this list
+    while (expired.first) {
+        Item *due = expired.first;
+        _unlink(due);
+        due->wheel = nullptr;
+        count--;
+        if (due->expire)
+            due->expire(due, this);
+    }
+}
+
+void TimerWheel::clear(ExpireFunc p_func) {
+
+    auto clear_list = [this, p_func](ItemList &p_list) {
+        while (p_list.first) {
+            Item *item = p_list.first;
+            _unlink(item);
+            item->wheel = nullptr;
+            count--;
+            if (p_func)
+                p_func(item, this);
+        }
+    };
+
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        for (int slot = 0; slot < SLOT_COUNT; slot++)
+            clear_list(slots[level][slot]);
+    }
+    clear_list(overflow);
+    clear_list(pending);
+    clear_list(expired);
+}
+
+TimerWheel::~TimerWheel() {
+
+    clear();
+}
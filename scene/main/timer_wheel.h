@@ -0,0 +1,116 @@
+/*************************************************************************/
+/*  timer_wheel.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#include <cstdint>
+
+class TimerWheel;
+
+// Hierarchical timing wheel on a clock that only moves through advance(). Timers are keyed on
+// absolute deadlines in millisecond ticks, spread over LEVEL_COUNT levels of SLOT_COUNT slots;
+// coarser levels are cascaded into finer ones as the clock reaches them, so advancing costs a
+// constant amount per elapsed tick plus the work for the timers that actually expire.
+// Items are intrusive and owned by the caller, scheduling and cancelling are O(1).
+class GODOT_EXPORT TimerWheel {
+public:
+    struct Item;
+    struct ItemList {
+        Item *first = nullptr;
+    };
+
+    using ExpireFunc = void (*)(Item *p_item, TimerWheel *p_wheel);
+
+    struct Item {
+        ExpireFunc expire = nullptr;
+        void *userdata = nullptr;
+        double deadline = 0;
+        uint64_t deadline_tick = 0;
+        Item *prev = nullptr;
+        Item *next = nullptr;
+        ItemList *list = nullptr;
+        TimerWheel *wheel = nullptr; // set while scheduled
+
+        bool is_scheduled() const { return wheel != nullptr; }
+        double get_time_left() const;
+
+        Item() = default;
+        Item(ExpireFunc p_expire, void *p_userdata) :
+                expire(p_expire),
+                userdata(p_userdata) {}
+        Item(const Item &) = delete;
+        Item &operator=(const Item &) = delete;
+    };
+
+private:
+    enum {
+        SLOT_BITS = 6,
+        SLOT_COUNT = 1 << SLOT_BITS,
+        SLOT_MASK = SLOT_COUNT - 1,
+        LEVEL_COUNT = 4, // 64ms, 4s, 4.4min and 4.7h spans, later deadlines wait in overflow
+    };
+
+    ItemList slots[LEVEL_COUNT][SLOT_COUNT];
+    ItemList overflow;
+    // deadlines within the current tick, checked against the exact time on every advance
+    ItemList pending;
+    ItemList expired;
+
+    double time = 0;
+    uint64_t current_tick = 0;
+    int count = 0;
+
+    static void _link(ItemList &p_list, Item *p_item);
+    static void _unlink(Item *p_item);
+    void _insert(Item *p_item);
+    void _cascade(ItemList &p_list);
+
+public:
+    // Schedules p_item to expire p_delay seconds from now, rescheduling it if it was already scheduled.
+    void schedule(Item *p_item, double p_delay) { schedule_at(p_item, time + p_delay); }
+    void schedule_at(Item *p_item, double p_deadline);
+    void cancel(Item *p_item);
+
+    // Moves the clock forward and calls the expire function of every item whose deadline passed.
+    // Items scheduled from an expire function are not considered before the next advance.
+    void advance(double p_delta);
+    // Cancels every item, calling p_func for each of them if not null.
+    void clear(ExpireFunc p_func = nullptr);
+
+    double get_time() const { return time; }
+    int get_scheduled_count() const { return count; }
+
+    TimerWheel() = default;
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+    ~TimerWheel();
+};
@@ -128,6 +128,7 @@
 #include "scene/main/http_request.h"
 #include "scene/main/instance_placeholder.h"
 #include "scene/main/resource_preloader.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/timer.h"
 #include "scene/main/viewport.h"
@@ -356,6 +357,7 @@ void register_scene_types() {
     CircleShape2D::initialize_class();
     ArrayMesh::initialize_class();
     PackedScene::initialize_class();
+    ScenePool::initialize_class();
     Environment::initialize_class();
     Curve::initialize_class();
     Curve2D::initialize_class();
@@ -1091,6 +1093,7 @@ void register_scene_types() {
 
     ClassDB::register_virtual_class<SceneState>();
     ClassDB::register_class<PackedScene>();
+    ClassDB::register_class<ScenePool>();
 
     ClassDB::register_class<SceneTree>();
     ClassDB::register_virtual_class<SceneTreeTimer>(); //sorry, you can't create it
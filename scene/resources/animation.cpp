@@ -36,6 +36,7 @@
 #include "core/pool_vector.h"
 
 #include "core/math/geometry.h"
+#include "scene/resources/animation_compiled.h"
 
 IMPL_GDCLASS(Animation)
 RES_BASE_EXTENSION_IMPL(Animation,"anim")
@@ -81,6 +82,8 @@ namespace {
 }
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
+    _invalidate_compiled();
+
     if (StringUtils::begins_with(p_name,"tracks/")) {
 
         int track = StringUtils::to_int(StringUtils::get_slice(p_name,'/', 1));
@@ -710,7 +713,7 @@ int Animation::add_track(TrackType p_type, int p_at_pos) {
             ERR_PRINT("Unknown track type");
         }
     }
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
     return p_at_pos;
 }
@@ -762,7 +765,7 @@ void Animation::remove_track(int p_track) {
 
     memdelete(t);
     tracks.erase_at(p_track);
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -781,7 +784,7 @@ void Animation::track_set_path(int p_track, const NodePath &p_path) {
 
     ERR_FAIL_INDEX(p_track, tracks.size());
     tracks[p_track]->path = p_path;
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -806,7 +809,7 @@ void Animation::track_set_interpolation_type(int p_track, InterpolationType p_in
     ERR_FAIL_INDEX(p_track, tracks.size());
     ERR_FAIL_INDEX(p_interp, 3);
     tracks[p_track]->interpolation = p_interp;
-    emit_changed();
+    _changed();
 }
 
 Animation::InterpolationType Animation::track_get_interpolation_type(int p_track) const {
@@ -818,7 +821,7 @@ Animation::InterpolationType Animation::track_get_interpolation_type(int p_track
 void Animation::track_set_interpolation_loop_wrap(int p_track, bool p_enable) {
     ERR_FAIL_INDEX(p_track, tracks.size());
     tracks[p_track]->loop_wrap = p_enable;
-    emit_changed();
+    _changed();
 }
 
 bool Animation::track_get_interpolation_loop_wrap(int p_track) const {
@@ -920,7 +923,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
     tkey.value.scale = p_scale;
 
     int ret = _insert(p_time, tt->transforms, tkey);
-    emit_changed();
+    _changed();
     return ret;
 }
 
@@ -981,7 +984,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
         } break;
     }
 
-    emit_changed();
+    _changed();
 }
 
 int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
@@ -1165,7 +1168,7 @@ void Animation::track_insert_key(int p_track, float p_time, const Variant &p_key
         } break;
     }
 
-    emit_changed();
+    _changed();
 }
 
 int Animation::track_get_key_count(int p_track) const {
@@ -1342,6 +1345,7 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 
     ERR_FAIL_INDEX(p_track, tracks.size());
+    _invalidate_compiled();
     Track *t = tracks[p_track];
 
     switch (t->type) {
@@ -1538,7 +1542,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
         } break;
     }
 
-    emit_changed();
+    _changed();
 }
 
 void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_transition) {
@@ -1575,7 +1579,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
         } break;
     }
 
-    emit_changed();
+    _changed();
 }
 
 Animation::TransformKey Animation::_interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const {
@@ -2025,6 +2029,7 @@ void Animation::value_track_set_update_mode(int p_track, UpdateMode p_mode) {
 
     ValueTrack *vt = static_cast<ValueTrack *>(t);
     vt->update_mode = p_mode;
+    _invalidate_compiled();
 }
 
 Animation::UpdateMode Animation::value_track_get_update_mode(int p_track) const {
@@ -2315,7 +2320,7 @@ int Animation::bezier_track_insert_key(int p_track, float p_time, float p_value,
 
     int key = _insert(p_time, bt->values, k);
 
-    emit_changed();
+    _changed();
 
     return key;
 }
@@ -2331,7 +2336,7 @@ void Animation::bezier_track_set_key_value(int p_track, int p_index, float p_val
     ERR_FAIL_INDEX(p_index, bt->values.size());
 
     bt->values[p_index].value.value = p_value;
-    emit_changed();
+    _changed();
 }
 
 void Animation::bezier_track_set_key_in_handle(int p_track, int p_index, const Vector2 &p_handle) {
@@ -2348,7 +2353,7 @@ void Animation::bezier_track_set_key_in_handle(int p_track, int p_index, const V
     if (bt->values[p_index].value.in_handle.x > 0) {
         bt->values[p_index].value.in_handle.x = 0;
     }
-    emit_changed();
+    _changed();
 }
 void Animation::bezier_track_set_key_out_handle(int p_track, int p_index, const Vector2 &p_handle) {
 
@@ -2364,7 +2369,7 @@ void Animation::bezier_track_set_key_out_handle(int p_track, int p_index, const
     if (bt->values[p_index].value.out_handle.x < 0) {
         bt->values[p_index].value.out_handle.x = 0;
     }
-    emit_changed();
+    _changed();
 }
 float Animation::bezier_track_get_key_value(int p_track, int p_index) const {
 
@@ -2501,7 +2506,7 @@ int Animation::audio_track_insert_key(int p_track, float p_time, const RES &p_st
 
     int key = _insert(p_time, at->values, k);
 
-    emit_changed();
+    _changed();
 
     return key;
 }
@@ -2518,7 +2523,7 @@ void Animation::audio_track_set_key_stream(int p_track, int p_key, const RES &p_
 
     at->values[p_key].value.stream = p_stream;
 
-    emit_changed();
+    _changed();
 }
 
 void Animation::audio_track_set_key_start_offset(int p_track, int p_key, float p_offset) {
@@ -2536,7 +2541,7 @@ void Animation::audio_track_set_key_start_offset(int p_track, int p_key, float p
 
     at->values[p_key].value.start_offset = p_offset;
 
-    emit_changed();
+    _changed();
 }
 
 void Animation::audio_track_set_key_end_offset(int p_track, int p_key, float p_offset) {
@@ -2554,7 +2559,7 @@ void Animation::audio_track_set_key_end_offset(int p_track, int p_key, float p_o
 
     at->values[p_key].value.end_offset = p_offset;
 
-    emit_changed();
+    _changed();
 }
 
 RES Animation::audio_track_get_key_stream(int p_track, int p_key) const {
@@ -2610,7 +2615,7 @@ int Animation::animation_track_insert_key(int p_track, float p_time, const Strin
 
     int key = _insert(p_time, at->values, k);
 
-    emit_changed();
+    _changed();
 
     return key;
 }
@@ -2627,7 +2632,7 @@ void Animation::animation_track_set_key_animation(int p_track, int p_key, const
 
     at->values[p_key].value = p_animation;
 
-    emit_changed();
+    _changed();
 }
 
 StringName Animation::animation_track_get_key_animation(int p_track, int p_key) const {
@@ -2649,7 +2654,7 @@ void Animation::set_length(float p_length) {
         p_length = ANIM_MIN_LENGTH;
     }
     length = p_length;
-    emit_changed();
+    _changed();
 }
 float Animation::get_length() const {
 
@@ -2659,13 +2664,42 @@ float Animation::get_length() const {
 void Animation::set_loop(bool p_enabled) {
 
     loop = p_enabled;
-    emit_changed();
+    _changed();
 }
 bool Animation::has_loop() const {
 
     return loop;
 }
 
+uint64_t Animation::get_memory_usage() const {
+
+    uint64_t usage = sizeof(Animation);
+    for (const Track *t : tracks) {
+
+        switch (t->type) {
+            case TYPE_TRANSFORM: {
+                usage += sizeof(TransformTrack) + static_cast<const TransformTrack *>(t)->transforms.capacity() * sizeof(TKey<TransformKey>);
+            } break;
+            case TYPE_VALUE: {
+                usage += sizeof(ValueTrack) + static_cast<const ValueTrack *>(t)->values.capacity() * sizeof(TKey<Variant>);
+            } break;
+            case TYPE_METHOD: {
+                usage += sizeof(MethodTrack) + static_cast<const MethodTrack *>(t)->methods.capacity() * sizeof(MethodKey);
+            } break;
+            case TYPE_BEZIER: {
+                usage += sizeof(BezierTrack) + static_cast<const BezierTrack *>(t)->values.capacity() * sizeof(TKey<BezierKey>);
+            } break;
+            case TYPE_AUDIO: {
+                usage += sizeof(AudioTrack) + static_cast<const AudioTrack *>(t)->values.capacity() * sizeof(TKey<AudioKey>);
+            } break;
+            case TYPE_ANIMATION: {
+                usage += sizeof(AnimationTrack) + static_cast<const AnimationTrack *>(t)->values.capacity() * sizeof(TKey<StringName>);
+            } break;
+        }
+    }
+    return usage;
+}
+
 void Animation::track_set_imported(int p_track, bool p_imported) {
 
     ERR_FAIL_INDEX(p_track, tracks.size());
@@ -2682,7 +2716,7 @@ void Animation::track_set_enabled(int p_track, bool p_enabled) {
 
     ERR_FAIL_INDEX(p_track, tracks.size());
     tracks[p_track]->enabled = p_enabled;
-    emit_changed();
+    _changed();
 }
 
 bool Animation::track_is_enabled(int p_track) const {
@@ -2698,7 +2732,7 @@ void Animation::track_move_up(int p_track) {
         SWAP(tracks[p_track], tracks[p_track + 1]);
     }
 
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2709,7 +2743,7 @@ void Animation::track_move_down(int p_track) {
         SWAP(tracks[p_track], tracks[p_track - 1]);
     }
 
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2725,7 +2759,7 @@ void Animation::track_move_to(int p_track, int p_to_index) {
     // Take into account that the position of the tracks that come after the one removed will change.
     tracks.insert_at(p_to_index > p_track ? p_to_index - 1 : p_to_index, track);
 
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -2737,14 +2771,14 @@ void Animation::track_swap(int p_track, int p_with_track) {
         return;
     SWAP(tracks[p_track], tracks[p_with_track]);
 
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
 void Animation::set_step(float p_step) {
 
     step = p_step;
-    emit_changed();
+    _changed();
 }
 
 float Animation::get_step() const {
@@ -2886,7 +2920,7 @@ void Animation::clear() {
     tracks.clear();
     loop = false;
     length = 1;
-    emit_changed();
+    _changed();
     emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
 
@@ -3065,6 +3099,7 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
     ERR_FAIL_INDEX(p_idx, tracks.size());
     ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
     TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+    _invalidate_compiled();
     bool prev_erased = false;
     TKey<TransformKey> first_erased;
 
@@ -3119,8 +3154,37 @@ Animation::Animation() {
     length = 1;
 }
 
+void Animation::_invalidate_compiled() {
+
+    AnimationCompiled *old = compiled.exchange(nullptr);
+    if (old)
+        memdelete(old);
+}
+
+void Animation::_changed() {
+
+    _invalidate_compiled();
+    emit_changed();
+}
+
+const AnimationCompiled *Animation::get_compiled() const {
+
+    AnimationCompiled *c = compiled.load(std::memory_order_acquire);
+    if (c)
+        return c;
+
+    MutexLock guard(compiled_mutex);
+    c = compiled.load(std::memory_order_relaxed);
+    if (!c) {
+        c = memnew(AnimationCompiled(this));
+        compiled.store(c, std::memory_order_release);
+    }
+    return c;
+}
+
 Animation::~Animation() {
 
+    _invalidate_compiled();
     for (int i = 0; i < tracks.size(); i++)
         memdelete(tracks[i]);
 }
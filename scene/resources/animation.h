@@ -35,6 +35,11 @@
 #include "core/math/vector2.h"
 #include "core/math/quat.h"
 #include "core/node_path.h"
+#include "core/os/mutex.h"
+
+#include <atomic>
+
+class AnimationCompiled;
 
 class GODOT_EXPORT Animation : public Resource {
 
@@ -42,6 +47,8 @@ class GODOT_EXPORT Animation : public Resource {
 
     RES_BASE_EXTENSION("anim")
 
+    friend class AnimationCompiled;
+
 public:
     enum TrackType {
         TYPE_VALUE, ///< Set a value in a property, can be interpolated.
@@ -216,6 +223,12 @@ private:
     float step;
     bool loop;
 
+    mutable std::atomic<AnimationCompiled *> compiled { nullptr };
+    mutable Mutex compiled_mutex;
+
+    void _invalidate_compiled();
+    void _changed();
+
     // bind helpers
 public:
     Array transform_track_interpolate(int p_track, float p_time) const {
@@ -329,6 +342,8 @@ public:
     void set_loop(bool p_enabled);
     bool has_loop() const;
 
+    uint64_t get_memory_usage() const override;
+
     void set_step(float p_step);
     float get_step() const;
 
@@ -336,6 +351,9 @@ public:
 
     void optimize(float p_allowed_linear_err = 0.05f, float p_allowed_angular_err = 0.01f, float p_max_optimizable_angle = Math_PI * 0.125f);
 
+    //! Typed copy of the interpolable tracks, built on first use and dropped on any change.
+    const AnimationCompiled *get_compiled() const;
+
     Animation();
     ~Animation() override;
 };
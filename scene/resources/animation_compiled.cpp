@@ -0,0 +1,400 @@
+/*************************************************************************/
+/*  animation_compiled.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "animation_compiled.h"
+
+#include "core/error_macros.h"
+#include "core/math/math_funcs.h"
+
+namespace {
+    // Same test Animation's key search uses to decide a key has been reached.
+    _FORCE_INLINE_ bool _key_reached(float p_key_time, float p_time) {
+        return p_key_time < p_time || Math::is_equal_approx(p_time, p_key_time);
+    }
+}
+
+int AnimationCompiled::_find_key(const Channel &p_channel, float p_time, int &r_cursor) const {
+
+    const float *key_times = times.data() + p_channel.first_key;
+    const int count = p_channel.key_count;
+
+    int cursor = r_cursor;
+    if (cursor < -1 || cursor >= count)
+        cursor = -1;
+
+    int low;
+    int high;
+
+    if (cursor < 0 || _key_reached(key_times[cursor], p_time)) {
+        // playing forward, the key is usually the cursor or the one right after it
+        for (int i = 0; i < 2; i++) {
+            if (cursor + 1 >= count || !_key_reached(key_times[cursor + 1], p_time)) {
+                r_cursor = cursor;
+                return cursor;
+            }
+            cursor++;
+        }
+        low = cursor + 1;
+        high = count - 1;
+    } else {
+        // playing backwards or wrapped around a loop
+        if (cursor == 0 || _key_reached(key_times[cursor - 1], p_time)) {
+            r_cursor = cursor - 1;
+            return cursor - 1;
+        }
+        low = 0;
+        high = cursor - 2;
+    }
+
+    // last key reached within [low, high], everything before low is known to be reached
+    int found = low - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (_key_reached(key_times[middle], p_time)) {
+            found = middle;
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    r_cursor = found;
+    return found;
+}
+
+bool AnimationCompiled::_find_segment(const Channel &p_channel, float p_time, int &r_cursor, Segment &r_segment) const {
+
+    // mirrors Animation::_interpolate(), minus the value blending
+
+    const float *key_times = times.data() + p_channel.first_key;
+    const int len = p_channel.valid_count;
+
+    if (len <= 0)
+        return false;
+
+    if (len == 1) {
+        r_segment.idx = r_segment.next = 0;
+        return true;
+    }
+
+    int idx = _find_key(p_channel, p_time, r_cursor);
+    int next = 0;
+    float c = 0;
+
+    if (loop && p_channel.loop_wrap) {
+
+        if (idx >= 0) {
+
+            float delta;
+            if ((idx + 1) < len) {
+                next = idx + 1;
+                delta = key_times[next] - key_times[idx];
+            } else {
+                next = 0;
+                delta = (length - key_times[idx]) + key_times[next];
+            }
+            float from = p_time - key_times[idx];
+
+            c = Math::is_zero_approx(delta) ? 0 : from / delta;
+
+        } else {
+            // on loop, behind first key
+            idx = len - 1;
+            next = 0;
+            float endtime = (length - key_times[idx]);
+            if (endtime < 0) // may be keys past the end
+                endtime = 0;
+            float delta = endtime + key_times[next];
+            float from = endtime + p_time;
+
+            c = Math::is_zero_approx(delta) ? 0 : from / delta;
+        }
+
+    } else {
+
+        if (idx >= 0) {
+
+            if ((idx + 1) < len) {
+                next = idx + 1;
+                float delta = key_times[next] - key_times[idx];
+                float from = p_time - key_times[idx];
+
+                c = Math::is_zero_approx(delta) ? 0 : from / delta;
+            } else {
+                next = idx;
+            }
+
+        } else if (loop) {
+            // only allow extending first key to anim start if looping
+            idx = next = 0;
+        } else {
+            return false;
+        }
+    }
+
+    float tr = transitions[p_channel.first_key + idx];
+
+    if (tr == 0 || idx == next || p_channel.interpolation == Animation::INTERPOLATION_NEAREST) {
+        r_segment.idx = r_segment.next = idx;
+        return true;
+    }
+
+    if (tr != 1.0f)
+        c = Math::ease(c, tr);
+
+    r_segment.idx = idx;
+    r_segment.next = next;
+    r_segment.pre = MAX(idx - 1, 0);
+    r_segment.post = (next + 1) < len ? next + 1 : next;
+    r_segment.c = c;
+    return true;
+}
+
+bool AnimationCompiled::sample_transform(int p_channel, float p_time, int &r_cursor, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+
+    ERR_FAIL_INDEX_V(p_channel, channels.size(), false);
+    const Channel &ch = channels[p_channel];
+    ERR_FAIL_COND_V(ch.type != CHANNEL_TRANSFORM, false);
+
+    Segment s;
+    if (!_find_segment(ch, p_time, r_cursor, s))
+        return false;
+
+    const Vector3 *loc = locations.data() + ch.first_value;
+    const Quat *rot = rotations.data() + ch.first_value;
+    const Vector3 *scale = scales.data() + ch.first_value;
+
+    if (s.idx == s.next) {
+        *r_loc = loc[s.idx];
+        *r_rot = rot[s.idx];
+        *r_scale = scale[s.idx];
+    } else if (ch.interpolation == Animation::INTERPOLATION_CUBIC) {
+        *r_loc = loc[s.idx].cubic_interpolate(loc[s.next], loc[s.pre], loc[s.post], s.c);
+        *r_rot = rot[s.idx].cubic_slerp(rot[s.next], rot[s.pre], rot[s.post], s.c);
+        *r_scale = scale[s.idx].cubic_interpolate(scale[s.next], scale[s.pre], scale[s.post], s.c);
+    } else {
+        *r_loc = loc[s.idx].linear_interpolate(loc[s.next], s.c);
+        *r_rot = rot[s.idx].slerp(rot[s.next], s.c);
+        *r_scale = scale[s.idx].linear_interpolate(scale[s.next], s.c);
+    }
+    return true;
+}
+
+bool AnimationCompiled::sample_value(int p_channel, float p_time, int &r_cursor, Variant &r_value) const {
+
+    ERR_FAIL_INDEX_V(p_channel, channels.size(), false);
+    const Channel &ch = channels[p_channel];
+    ERR_FAIL_COND_V(ch.type == CHANNEL_TRANSFORM, false);
+
+    Segment s;
+    if (!_find_segment(ch, p_time, r_cursor, s))
+        return false;
+
+    const bool held = s.idx == s.next;
+    const bool cubic = ch.interpolation == Animation::INTERPOLATION_CUBIC;
+
+    switch (ch.type) {
+
+        case CHANNEL_REAL: {
+
+            const double *v = reals.data() + ch.first_value;
+            if (held) {
+                r_value = v[s.idx];
+            } else if (cubic) {
+                real_t p0 = v[s.pre];
+                real_t p1 = v[s.idx];
+                real_t p2 = v[s.next];
+                real_t p3 = v[s.post];
+
+                float t = s.c;
+                float t2 = t * t;
+                float t3 = t2 * t;
+
+                r_value = 0.5f * ((p1 * 2.0f) +
+                                         (-p0 + p2) * t +
+                                         (2.0f * p0 - 5.0f * p1 + 4 * p2 - p3) * t2 +
+                                         (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+            } else {
+                real_t va = v[s.idx];
+                real_t vb = v[s.next];
+                r_value = va + (vb - va) * s.c;
+            }
+        } break;
+        case CHANNEL_VECTOR2: {
+
+            const Vector2 *v = vector2s.data() + ch.first_value;
+            if (held)
+                r_value = v[s.idx];
+            else if (cubic)
+                r_value = v[s.idx].cubic_interpolate(v[s.next], v[s.pre], v[s.post], s.c);
+            else
+                r_value = v[s.idx].linear_interpolate(v[s.next], s.c);
+        } break;
+        case CHANNEL_VECTOR3: {
+
+            const Vector3 *v = vector3s.data() + ch.first_value;
+            if (held)
+                r_value = v[s.idx];
+            else if (cubic)
+                r_value = v[s.idx].cubic_interpolate(v[s.next], v[s.pre], v[s.post], s.c);
+            else
+                r_value = v[s.idx].linear_interpolate(v[s.next], s.c);
+        } break;
+        case CHANNEL_QUAT: {
+
+            const Quat *v = quats.data() + ch.first_value;
+            if (held)
+                r_value = v[s.idx];
+            else if (cubic)
+                r_value = v[s.idx].cubic_slerp(v[s.next], v[s.pre], v[s.post], s.c);
+            else
+                r_value = v[s.idx].slerp(v[s.next], s.c);
+        } break;
+        case CHANNEL_COLOR: {
+
+            // colors have no cubic form, Animation falls back to linear for them too
+            const Color *v = colors.data() + ch.first_value;
+            r_value = held ? v[s.idx] : v[s.idx].linear_interpolate(v[s.next], s.c);
+        } break;
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+AnimationCompiled::AnimationCompiled(const Animation *p_animation) :
+        length(p_animation->length),
+        loop(p_animation->loop) {
+
+    const Vector<Animation::Track *> &tracks = p_animation->tracks;
+    track_channels.resize(tracks.size(), -1);
+
+    for (int i = 0; i < tracks.size(); i++) {
+
+        const Animation::Track *t = tracks[i];
+        if (!t->enabled)
+            continue;
+
+        Channel ch;
+        ch.track = i;
+        ch.interpolation = t->interpolation;
+        ch.loop_wrap = t->loop_wrap;
+        ch.first_key = times.size();
+
+        if (t->type == Animation::TYPE_TRANSFORM) {
+
+            const Animation::TransformTrack *tt = static_cast<const Animation::TransformTrack *>(t);
+            if (tt->transforms.empty())
+                continue;
+
+            ch.type = CHANNEL_TRANSFORM;
+            ch.key_count = tt->transforms.size();
+            ch.first_value = locations.size();
+            for (const Animation::TKey<Animation::TransformKey> &k : tt->transforms) {
+                times.push_back(k.time);
+                transitions.push_back(k.transition);
+                locations.push_back(k.value.loc);
+                rotations.push_back(k.value.rot);
+                scales.push_back(k.value.scale);
+            }
+
+        } else if (t->type == Animation::TYPE_VALUE) {
+
+            const Animation::ValueTrack *vt = static_cast<const Animation::ValueTrack *>(t);
+            // discrete, trigger and capture tracks depend on playback state, the player handles them
+            if (vt->update_mode != Animation::UPDATE_CONTINUOUS || vt->values.empty())
+                continue;
+
+            VariantType type = vt->values[0].value.get_type();
+            bool uniform = true;
+            for (const Animation::TKey<Variant> &k : vt->values) {
+                if (k.value.get_type() != type) {
+                    uniform = false;
+                    break;
+                }
+            }
+            if (!uniform)
+                continue;
+
+            switch (type) {
+                case VariantType::REAL: {
+                    ch.type = CHANNEL_REAL;
+                    ch.first_value = reals.size();
+                    for (const Animation::TKey<Variant> &k : vt->values)
+                        reals.push_back(k.value.as<double>());
+                } break;
+                case VariantType::VECTOR2: {
+                    ch.type = CHANNEL_VECTOR2;
+                    ch.first_value = vector2s.size();
+                    for (const Animation::TKey<Variant> &k : vt->values)
+                        vector2s.push_back(k.value);
+                } break;
+                case VariantType::VECTOR3: {
+                    ch.type = CHANNEL_VECTOR3;
+                    ch.first_value = vector3s.size();
+                    for (const Animation::TKey<Variant> &k : vt->values)
+                        vector3s.push_back(k.value);
+                } break;
+                case VariantType::QUAT: {
+                    ch.type = CHANNEL_QUAT;
+                    ch.first_value = quats.size();
+                    for (const Animation::TKey<Variant> &k : vt->values)
+                        quats.push_back(k.value.as<Quat>());
+                } break;
+                case VariantType::COLOR: {
+                    ch.type = CHANNEL_COLOR;
+                    ch.first_value = colors.size();
+                    for (const Animation::TKey<Variant> &k : vt->values)
+                        colors.push_back(k.value);
+                } break;
+                default: {
+                    continue; // not worth a typed channel, interpolated through Variant
+                }
+            }
+
+            ch.key_count = vt->values.size();
+            for (const Animation::TKey<Variant> &k : vt->values) {
+                times.push_back(k.time);
+                transitions.push_back(k.transition);
+            }
+
+        } else {
+            continue;
+        }
+
+        // keys past the length are held but never interpolated towards, like Animation::_interpolate
+        int last = -1;
+        ch.valid_count = _find_key(ch, length, last) + 1;
+
+        track_channels[i] = channels.size();
+        channels.push_back(ch);
+    }
+}
@@ -0,0 +1,113 @@
+/*************************************************************************/
+/*  animation_compiled.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "core/color.h"
+#include "core/math/quat.h"
+#include "core/math/vector2.h"
+#include "core/math/vector3.h"
+#include "core/variant.h"
+#include "core/vector.h"
+#include "scene/resources/animation.h"
+
+/**
+ * Structure-of-arrays copy of the interpolable tracks of an Animation: transform tracks, and
+ * continuous value tracks whose keys are all float, Vector2, Vector3, Quat or Color.
+ * Sampling follows Animation::transform_track_interpolate() and value_track_interpolate() step
+ * for step and matches them up to rounding, as reals are held as double and not interpolated
+ * through Variant. It reads typed arrays instead of Variant keys and starts the key search from
+ * a caller-owned cursor, so forward playback finds its key in constant time.
+ * Built by Animation::get_compiled() and never modified afterwards.
+ */
+class GODOT_EXPORT AnimationCompiled {
+public:
+    enum ChannelType : uint8_t {
+        CHANNEL_TRANSFORM,
+        CHANNEL_REAL,
+        CHANNEL_VECTOR2,
+        CHANNEL_VECTOR3,
+        CHANNEL_QUAT,
+        CHANNEL_COLOR,
+    };
+
+    struct Channel {
+        int track;
+        ChannelType type;
+        Animation::InterpolationType interpolation;
+        bool loop_wrap;
+        int first_key; // index of the first key in times/transitions
+        int key_count;
+        int valid_count; // keys up to the animation length, the rest is never interpolated towards
+        int first_value; // index of the first key in the value arrays of the channel type
+    };
+
+private:
+    struct Segment {
+        int idx;
+        int next;
+        int pre;
+        int post;
+        float c;
+    };
+
+    Vector<Channel> channels;
+    Vector<int> track_channels; // channel of each track, -1 when the track was not compiled
+
+    Vector<float> times;
+    Vector<float> transitions;
+
+    Vector<Vector3> locations;
+    Vector<Quat> rotations;
+    Vector<Vector3> scales;
+    Vector<double> reals; // Variant precision, so held keys come out unchanged
+    Vector<Vector2> vector2s;
+    Vector<Vector3> vector3s;
+    Vector<Quat> quats;
+    Vector<Color> colors;
+
+    float length;
+    bool loop;
+
+    int _find_key(const Channel &p_channel, float p_time, int &r_cursor) const;
+    bool _find_segment(const Channel &p_channel, float p_time, int &r_cursor, Segment &r_segment) const;
+
+public:
+    int get_channel_count() const { return channels.size(); }
+    const Channel &get_channel(int p_channel) const { return channels[p_channel]; }
+    //! Channel sampling track p_track, or -1 if the track has to go through Animation.
+    int get_track_channel(int p_track) const { return p_track < track_channels.size() ? track_channels[p_track] : -1; }
+
+    // r_cursor may hold any value, it is only used as a search hint and updated to the key found.
+    bool sample_transform(int p_channel, float p_time, int &r_cursor, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+    bool sample_value(int p_channel, float p_time, int &r_cursor, Variant &r_value) const;
+
+    explicit AnimationCompiled(const Animation *p_animation);
+};
@@ -504,6 +504,11 @@ void AudioStreamSample::set_data(Span<const uint8_t> p_data) {
 
     AudioServer::get_singleton()->unlock();
 }
+uint64_t AudioStreamSample::get_memory_usage() const {
+
+    return sizeof(AudioStreamSample) + (data ? data_bytes : 0);
+}
+
 PoolVector<uint8_t> AudioStreamSample::get_data() const {
 
     PoolVector<uint8_t> pv;
@@ -141,6 +141,7 @@ public:
 
     void set_data(Span<const uint8_t> p_data);
     PoolVector<uint8_t> get_data() const;
+    uint64_t get_memory_usage() const override;
 
     Error save_to_wav(se_string_view p_path);
 
@@ -783,6 +783,9 @@ void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const
     Surface s;
     s.aabb = p_aabb;
     s.is_2d = p_format & ARRAY_FLAG_USE_2D_VERTICES;
+    s.memory_usage = p_array.size() + p_index_array.size();
+    for (const PoolVector<uint8_t> &blend_shape : p_blend_shapes)
+        s.memory_usage += blend_shape.size();
     surfaces.emplace_back(eastl::move(s));
     _recompute_aabb();
 
@@ -839,7 +842,7 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, SurfaceArrays
         _recompute_aabb();
     }
     VisualServer::get_singleton()->mesh_add_surface_from_arrays(mesh, (VS::PrimitiveType)p_primitive, eastl::move(p_arrays), eastl::move(p_blend_shapes), p_flags);
-
+    surfaces.back().memory_usage = _surface_memory_usage(surfaces.size() - 1);
 
 
     clear_cache();
@@ -1023,11 +1026,35 @@ void ArrayMesh::add_surface_from_mesh_data(Geometry::MeshData &&p_mesh_data) {
     clear_cache();
 
     surfaces.emplace_back(eastl::move(s));
+    surfaces.back().memory_usage = _surface_memory_usage(surfaces.size() - 1);
     Object_change_notify(this);
 
     emit_changed();
 }
 
+uint64_t ArrayMesh::_surface_memory_usage(int p_idx) const {
+
+    // the arrays were compressed and packed by the VisualServer, ask it for the resulting layout once
+    VisualServer *vs = VisualServer::get_singleton();
+    uint32_t format = vs->mesh_surface_get_format(mesh, p_idx);
+    int vertex_len = vs->mesh_surface_get_array_len(mesh, p_idx);
+    int index_len = vs->mesh_surface_get_array_index_len(mesh, p_idx);
+
+    uint64_t usage = uint64_t(vs->mesh_surface_get_format_stride(format, vertex_len, index_len)) * vertex_len;
+    usage *= 1 + blend_shapes.size(); // each blend shape is a full copy of the vertex array
+    if (index_len > 0)
+        usage += uint64_t(index_len) * (vertex_len <= (1 << 16) ? 2 : 4);
+    return usage;
+}
+
+uint64_t ArrayMesh::get_memory_usage() const {
+
+    uint64_t usage = sizeof(ArrayMesh) + surfaces.capacity() * sizeof(Surface);
+    for (const Surface &s : surfaces)
+        usage += s.memory_usage;
+    return usage;
+}
+
 RID ArrayMesh::get_rid() const {
 
     return mesh;
@@ -173,6 +173,7 @@ private:
         String name;
         AABB aabb;
         Ref<Material> material;
+        uint64_t memory_usage = 0; // vertex, index and blend shape bytes given to the VisualServer
         bool is_2d;
     };
     Vector<Surface> surfaces;
@@ -183,6 +184,7 @@ private:
     AABB custom_aabb;
 
     void _recompute_aabb();
+    uint64_t _surface_memory_usage(int p_idx) const;
 
 protected:
     virtual bool _is_generated() const { return false; }
@@ -241,6 +243,7 @@ public:
 
     AABB get_aabb() const override;
     RID get_rid() const override;
+    uint64_t get_memory_usage() const override;
 
     void regen_normalmaps();
 
@@ -35,6 +35,7 @@
 #include "core/engine.h"
 #include "core/script_language.h"
 #include "core/string_formatter.h"
+#include "core/string_utils.h"
 #include "core/io/resource_loader.h"
 #include "core/project_settings.h"
 #include "scene/2d/node_2d.h"
@@ -69,8 +70,71 @@ bool SceneState::can_instance() const {
     return !nodes.empty();
 }
 
+static void _set_instanced_property(Node *node, Node *base, const StringName &p_name, const Variant &p_value, SceneState::GenEditState p_edit_state, Map<Ref<Resource>, Ref<Resource> > &resources_local_to_scene) {
+
+    bool valid;
+
+    if (p_name == CoreStringNames::get_singleton()->_script) {
+        //work around to avoid old script variables from disappearing, should be the proper fix to:
+        //https://github.com/godotengine/godot/issues/2958
+
+        //store old state
+        Vector<Pair<StringName, Variant> > old_state;
+        if (node->get_script_instance()) {
+            node->get_script_instance()->get_property_state(old_state);
+        }
+
+        node->set(p_name, p_value, &valid);
+
+        //restore old state for new script, if exists
+        for (const Pair<StringName, Variant> &E : old_state) {
+            node->set(E.first, E.second);
+        }
+        return;
+    }
+
+    Variant value = p_value;
+
+    if (value.get_type() == VariantType::OBJECT) {
+        //handle resources that are local to scene by duplicating them if needed
+        Ref<Resource> res(value);
+        if (res) {
+            if (res->is_local_to_scene()) {
+
+                Map<Ref<Resource>, Ref<Resource> >::iterator E = resources_local_to_scene.find(res);
+
+                if (E!=resources_local_to_scene.end()) {
+                    value = E->second;
+                } else {
+
+                    if (p_edit_state == SceneState::GEN_EDIT_STATE_MAIN) {
+                        //for the main scene, use the resource as is
+                        res->configure_for_local_scene(base, resources_local_to_scene);
+                        resources_local_to_scene[res] = res;
+
+                    } else {
+                        //for instances, a copy must be made
+                        Ref<Resource> local_dupe = res->duplicate_for_local_scene(base, resources_local_to_scene);
+                        resources_local_to_scene[res] = local_dupe;
+                        res = local_dupe;
+                        value = local_dupe;
+                    }
+                }
+                //must make a copy, because this res is local to scene
+            }
+        }
+    } else if (p_edit_state == SceneState::GEN_EDIT_STATE_INSTANCE) {
+        value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
+    }
+    node->set(p_name, value, &valid);
+}
+
 Node *SceneState::instance(GenEditState p_edit_state) const {
 
+    // runtime instancing of self-contained scenes skips per-node class and property lookups.
+    if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint() && _ensure_instance_plan())
+        return _instance_from_plan();
+
     // nodes where instancing failed (because something is missing)
     Vector<Node *> stray_instances;
 
@@ -213,66 +277,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
                 for (int j = 0; j < nprop_count; j++) {
 
-                    bool valid;
                     ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
                     ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
 
-                    if (snames[nprops[j].name] == CoreStringNames::get_singleton()->_script) {
-                        //work around to avoid old script variables from disappearing, should be the proper fix to:
-                        //https://github.com/godotengine/godot/issues/2958
-
-                        //store old state
-                        Vector<Pair<StringName, Variant> > old_state;
-                        if (node->get_script_instance()) {
-                            node->get_script_instance()->get_property_state(old_state);
-                        }
-
-                        node->set(snames[nprops[j].name], props[nprops[j].value], &valid);
-
-                        //restore old state for new script, if exists
-                        for (const Pair<StringName, Variant> &E : old_state) {
-                            node->set(E.first, E.second);
-                        }
-                    } else {
-
-                        Variant value = props[nprops[j].value];
-
-                        if (value.get_type() == VariantType::OBJECT) {
-                            //handle resources that are local to scene by duplicating them if needed
-                            Ref<Resource> res(value);
-                            if (res) {
-                                if (res->is_local_to_scene()) {
-
-                                    Map<Ref<Resource>, Ref<Resource> >::iterator E = resources_local_to_scene.find(res);
-
-                                    if (E!=resources_local_to_scene.end()) {
-                                        value = E->second;
-                                    } else {
-
-                                        Node *base = i == 0 ? node : ret_nodes[0];
-
-                                        if (p_edit_state == GEN_EDIT_STATE_MAIN) {
-                                            //for the main scene, use the resource as is
-                                            res->configure_for_local_scene(base, resources_local_to_scene);
-                                            resources_local_to_scene[res] = res;
-
-                                        } else {
-                                            //for instances, a copy must be made
-                                            Node *base2 = i == 0 ? node : ret_nodes[0];
-                                            Ref<Resource> local_dupe = res->duplicate_for_local_scene(base2, resources_local_to_scene);
-                                            resources_local_to_scene[res] = local_dupe;
-                                            res = local_dupe;
-                                            value = local_dupe;
-                                        }
-                                    }
-                                    //must make a copy, because this res is local to scene
-                                }
-                            }
-                        } else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
-                            value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
-                        }
-                        node->set(snames[nprops[j].name], value, &valid);
-                    }
+                    _set_instanced_property(node, i == 0 ? node : ret_nodes[0], snames[nprops[j].name], props[nprops[j].value], p_edit_state, resources_local_to_scene);
                 }
             }
 
@@ -323,6 +331,15 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
         }
     }
 
+    return _finish_instance(ret_nodes, nc, stray_instances, resources_local_to_scene);
+}
+
+
+Node *SceneState::_finish_instance(Node **ret_nodes, int nc, const Vector<Node *> &stray_instances, Map<Ref<Resource>, Ref<Resource> > &resources_local_to_scene) const {
+
+    const StringName *snames = names.data();
+    const Variant *props = variants.data();
+
     for (eastl::pair<const Ref<Resource>,Ref<Resource> > &E : resources_local_to_scene) {
 
         E.second->setup_local_to_scene();
@@ -372,6 +389,154 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
     return ret_nodes[0];
 }
 
+// Setter bind for a property that Object::set would hand straight to ClassDB::set_property, or
+// nullptr when the value needs the generic path (scripts, metadata, resources, indexed or unbound
+// setters, or properties the class does not declare at all).
+static MethodBind *_resolve_plan_setter(const StringName &p_class, const StringName &p_property, const Variant &p_value) {
+
+    if (p_value.get_type() == VariantType::OBJECT || p_property == CoreStringNames::get_singleton()->_script || p_property == CoreStringNames::get_singleton()->_meta)
+        return nullptr;
+
+    bool valid = false;
+    if (ClassDB::get_property_index(p_class, p_property, &valid) >= 0 || !valid)
+        return nullptr;
+
+    StringName setter = ClassDB::get_property_setter(p_class, p_property);
+    if (setter.empty())
+        return nullptr;
+
+    MethodBind *mb = ClassDB::get_method(p_class, setter);
+    return mb && mb->get_argument_count() == 1 ? mb : nullptr;
+}
+
+bool SceneState::_build_instance_plan() const {
+
+    // Only self-contained scenes qualify: no inherited root, no instanced or placeholder
+    // sub-scenes and no parents or owners referenced by path. Those keep the generic path,
+    // which also takes care of reporting broken data.
+    instance_plan.nodes.clear();
+    instance_plan.properties.clear();
+
+    const int nc = nodes.size();
+    if (nc == 0 || base_scene_idx >= 0)
+        return false;
+
+    instance_plan.nodes.resize(nc);
+
+    for (int i = 0; i < nc; i++) {
+
+        const NodeData &n = nodes[i];
+        if (n.instance >= 0 || n.type == TYPE_INSTANCED || n.type < 0 || n.type >= int(names.size()))
+            return false;
+        if (i > 0 && (n.parent < 0 || (n.parent & FLAG_ID_IS_PATH) || n.parent >= i))
+            return false;
+        if (n.owner >= 0 && ((n.owner & FLAG_ID_IS_PATH) || n.owner >= i))
+            return false;
+
+        const StringName &type = names[n.type];
+        if (!ClassDB::is_parent_class(type, "Node"))
+            return false;
+
+        InstancePlan::PlanNode &pn = instance_plan.nodes[i];
+        pn.creator = ClassDB::get_creation_func(type);
+        if (!pn.creator)
+            return false;
+        pn.parent = i > 0 ? n.parent : -1;
+        pn.owner = n.owner;
+        pn.child_count = 0;
+        pn.first_property = instance_plan.properties.size();
+        if (i > 0)
+            instance_plan.nodes[n.parent].child_count++;
+
+        for (const NodeData::Property &p : n.properties) {
+            if (p.name < 0 || p.name >= int(names.size()) || p.value < 0 || p.value >= int(variants.size()))
+                return false;
+            instance_plan.properties.push_back({ p.name, p.value, _resolve_plan_setter(type, names[p.name], variants[p.value]) });
+        }
+        for (int group : n.groups) {
+            if (group < 0 || group >= int(names.size()))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool SceneState::_ensure_instance_plan() const {
+
+    int state = instance_plan_state.load(std::memory_order_acquire);
+    if (state != PLAN_DIRTY)
+        return state == PLAN_READY;
+
+    MutexLock guard(instance_plan_mutex);
+    state = instance_plan_state.load(std::memory_order_relaxed);
+    if (state == PLAN_DIRTY) {
+        state = _build_instance_plan() ? PLAN_READY : PLAN_UNSUPPORTED;
+        instance_plan_state.store(state, std::memory_order_release);
+    }
+    return state == PLAN_READY;
+}
+
+void SceneState::_invalidate_instance_plan() {
+
+    MutexLock guard(instance_plan_mutex);
+    instance_plan_state.store(PLAN_DIRTY, std::memory_order_release);
+}
+
+Node *SceneState::_instance_from_plan() const {
+
+    const int nc = instance_plan.nodes.size();
+    const StringName *snames = names.data();
+    const Variant *props = variants.data();
+    const InstancePlan::PlanProperty *plan_props = instance_plan.properties.data();
+
+    Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+    Map<Ref<Resource>, Ref<Resource> > resources_local_to_scene;
+
+    for (int i = 0; i < nc; i++) {
+
+        const InstancePlan::PlanNode &pn = instance_plan.nodes[i];
+        const NodeData &n = nodes[i];
+
+        Node *node = static_cast<Node *>(pn.creator());
+        if (pn.child_count)
+            node->_reserve_children(pn.child_count);
+
+        for (int j = 0; j < n.properties.size(); j++) {
+
+            const InstancePlan::PlanProperty &pp = plan_props[pn.first_property + j];
+            // a script attached by an earlier property gets the first chance at every later one.
+            if (pp.setter && !node->get_script_instance()) {
+                const Variant *arg[1] = { &props[pp.value] };
+                Variant::CallError ce;
+                pp.setter->call(node, arg, 1, ce);
+            } else {
+                _set_instanced_property(node, i == 0 ? node : ret_nodes[0], snames[pp.name], props[pp.value], GEN_EDIT_STATE_DISABLED, resources_local_to_scene);
+            }
+        }
+
+        for (int group : n.groups) {
+            node->add_to_group(snames[group], true);
+        }
+
+        if (i > 0) {
+            Node *parent = ret_nodes[pn.parent];
+            parent->_add_child_nocheck(node, snames[n.name]);
+            if (n.index >= 0 && n.index < parent->get_child_count() - 1)
+                parent->move_child(node, n.index);
+        } else {
+            node->_set_name_nocheck(snames[n.name]);
+        }
+
+        if (pn.owner >= 0)
+            node->_set_owner_nocheck(ret_nodes[pn.owner]);
+
+        ret_nodes[i] = node;
+    }
+
+    return _finish_instance(ret_nodes, nc, Vector<Node *>(), resources_local_to_scene);
+}
+
 static int _nm_get_string(const StringName &p_string, Map<StringName, int> &name_map) {
 
     if (name_map.contains(p_string))
@@ -956,6 +1121,7 @@ void SceneState::clear() {
     node_paths.clear();
     editable_instances.clear();
     base_scene_idx = -1;
+    _invalidate_instance_plan();
 }
 
 Ref<SceneState> SceneState::_get_base_scene_state() const {
@@ -1107,6 +1273,8 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
+    _invalidate_instance_plan();
+
     ERR_FAIL_COND(!p_dictionary.has("names"));
     ERR_FAIL_COND(!p_dictionary.has("variants"));
     ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1591,6 +1759,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
     nd.index = p_index;
 
     nodes.push_back(nd);
+    _invalidate_instance_plan();
 
     return nodes.size() - 1;
 }
@@ -1604,17 +1773,20 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
     prop.name = p_name;
     prop.value = p_value;
     nodes[p_node].properties.push_back(prop);
+    _invalidate_instance_plan();
 }
 void SceneState::add_node_group(int p_node, int p_group) {
 
     ERR_FAIL_INDEX(p_node, nodes.size());
     ERR_FAIL_INDEX(p_group, names.size());
     nodes[p_node].groups.push_back(p_group);
+    _invalidate_instance_plan();
 }
 void SceneState::set_base_scene(int p_idx) {
 
     ERR_FAIL_INDEX(p_idx, variants.size());
     base_scene_idx = p_idx;
+    _invalidate_instance_plan();
 }
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, Vector<int> &&p_binds) {
 
@@ -1638,6 +1810,34 @@ void SceneState::add_editable_instance(const NodePath &p_path) {
     editable_instances.push_back(p_path);
 }
 
+uint64_t SceneState::get_memory_usage() const {
+
+    uint64_t usage = sizeof(SceneState);
+    usage += names.capacity() * sizeof(StringName) + variants.capacity() * sizeof(Variant);
+    usage += (node_paths.capacity() + editable_instances.capacity()) * sizeof(NodePath);
+    usage += nodes.capacity() * sizeof(NodeData) + connections.capacity() * sizeof(ConnectionData);
+    for (const NodeData &nd : nodes) {
+        usage += nd.properties.capacity() * sizeof(NodeData::Property) + nd.groups.capacity() * sizeof(int);
+    }
+    for (const ConnectionData &cd : connections) {
+        usage += cd.binds.capacity() * sizeof(int);
+    }
+    if (instance_plan_state.load(std::memory_order_acquire) == PLAN_READY) {
+        usage += instance_plan.nodes.capacity() * sizeof(InstancePlan::PlanNode);
+        usage += instance_plan.properties.capacity() * sizeof(InstancePlan::PlanProperty);
+    }
+
+    // built-in resources (meshes, textures...) live only through this state, external ones are cached on their own
+    for (const Variant &v : variants) {
+        if (v.get_type() != VariantType::OBJECT)
+            continue;
+        RES res(refFromVariant<Resource>(v));
+        if (res && (res->get_path().empty() || PathUtils::is_internal_path(res->get_path())))
+            usage += res->get_memory_usage();
+    }
+    return usage;
+}
+
 PoolVector<String> SceneState::_get_node_groups(int p_idx) const {
 
     Vector<StringName> groups = get_node_groups(p_idx);
@@ -1763,6 +1963,11 @@ void PackedScene::set_path(se_string_view p_path, bool p_take_over) {
     Resource::set_path(p_path, p_take_over);
 }
 
+uint64_t PackedScene::get_memory_usage() const {
+
+    return sizeof(PackedScene) + state->get_memory_usage();
+}
+
 void PackedScene::_bind_methods() {
 
     MethodBinder::bind_method(D_METHOD("pack", {"path"}), &PackedScene::pack);
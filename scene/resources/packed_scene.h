@@ -34,8 +34,12 @@
 #include "core/se_string.h"
 #include "core/map.h"
 #include "core/hash_map.h"
+#include "core/os/mutex.h"
 #include "scene/main/node.h"
 
+#include <atomic>
+
+class MethodBind;
 class PackedScene;
 
 class SceneState : public RefCounted {
@@ -96,6 +100,45 @@ class SceneState : public RefCounted {
 
     Vector<ConnectionData> connections;
 
+    // Pre-resolved form of `nodes` for runtime instancing: constructors, setter binds, parent
+    // indices and child counts. Built on the first eligible instance() and dropped whenever the
+    // state is edited; see _build_instance_plan() for which scenes qualify.
+    struct InstancePlan {
+
+        struct PlanProperty {
+            int name;
+            int value;
+            MethodBind *setter; // nullptr when the value has to go through Object::set
+        };
+
+        struct PlanNode {
+            Object *(*creator)();
+            int parent;
+            int owner;
+            int child_count;
+            int first_property;
+        };
+
+        Vector<PlanNode> nodes;
+        Vector<PlanProperty> properties;
+    };
+
+    enum InstancePlanState {
+        PLAN_DIRTY,
+        PLAN_READY,
+        PLAN_UNSUPPORTED,
+    };
+
+    mutable InstancePlan instance_plan;
+    mutable std::atomic<int> instance_plan_state { PLAN_DIRTY };
+    mutable Mutex instance_plan_mutex;
+
+    bool _build_instance_plan() const;
+    bool _ensure_instance_plan() const;
+    void _invalidate_instance_plan();
+    Node *_instance_from_plan() const;
+    Node *_finish_instance(Node **ret_nodes, int nc, const Vector<Node *> &stray_instances, Map<Ref<Resource>, Ref<Resource> > &resources_local_to_scene) const;
+
     Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, Hasher<Variant>, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
     Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, Hasher<Variant>, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -193,6 +236,9 @@ public:
     virtual void set_last_modified_time(uint64_t p_time) { last_modified_time = p_time; }
     uint64_t get_last_modified_time() const { return last_modified_time; }
 
+    // Bytes held by the packed data and the built-in resources it owns, see Resource::get_memory_usage().
+    uint64_t get_memory_usage() const;
+
     SceneState();
 };
 
@@ -230,6 +276,7 @@ public:
     void replace_state(Ref<SceneState> p_by);
 
     void set_path(se_string_view p_path, bool p_take_over = false) override;
+    uint64_t get_memory_usage() const override;
 #ifdef TOOLS_ENABLED
     void set_last_modified_time(uint64_t p_time) override { state->set_last_modified_time(p_time); }
 
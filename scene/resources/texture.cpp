@@ -359,6 +359,15 @@ RID ImageTexture::get_rid() const {
     return texture;
 }
 
+uint64_t ImageTexture::get_memory_usage() const {
+
+    // estimated video memory of the texture
+    uint64_t usage = sizeof(ImageTexture);
+    if (w && h)
+        usage += Image::get_image_data_size(w, h, format, flags & FLAG_MIPMAPS);
+    return usage;
+}
+
 bool ImageTexture::has_alpha() const {
 
     return (format == Image::FORMAT_LA8 || format == Image::FORMAT_RGBA8);
@@ -661,13 +670,18 @@ Error StreamTexture::_load_data(se_string_view p_path, int &tw, int &th, int &tw
                 size = f->get_32();
             }
 
-            pv.resize(size);
-            f->get_buffer(pv.data(), size);
+            // decode straight from the pack mapping when the file allows it
+            const uint8_t *src = f->borrow_buffer(size);
+            if (!src) {
+                pv.resize(size);
+                f->get_buffer(pv.data(), size);
+                src = pv.data();
+            }
             Ref<Image> img;
             if (df & FORMAT_BIT_LOSSLESS) {
-                img = Image::lossless_unpacker(pv);
+                img = Image::lossless_unpacker(src, size);
             } else {
-                img = Image::lossy_unpacker(pv);
+                img = Image::lossy_unpacker(src, size);
             }
 
             if (not img || img->empty()) {
@@ -834,6 +848,14 @@ RID StreamTexture::get_rid() const {
     return m_impl_data->texture;
 }
 
+uint64_t StreamTexture::get_memory_usage() const {
+
+    uint64_t usage = sizeof(StreamTexture) + sizeof(StreamTextureData);
+    if (m_impl_data->w && m_impl_data->h)
+        usage += Image::get_image_data_size(m_impl_data->w, m_impl_data->h, m_impl_data->format, m_impl_data->flags & FLAG_MIPMAPS);
+    return usage;
+}
+
 void StreamTexture::draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate, bool p_transpose, const Ref<Texture> &p_normal_map) const {
 
     if ((m_impl_data->w | m_impl_data->h) == 0)
@@ -2484,10 +2506,14 @@ RES ResourceFormatLoaderTextureLayered::load(se_string_view p_path, se_string_vi
                 uint32_t size = f->get_32();
 
                 Vector<uint8_t> pv;
-                pv.resize(size);
-                f->get_buffer(pv.data(), size);
+                const uint8_t *src = f->borrow_buffer(size);
+                if (!src) {
+                    pv.resize(size);
+                    f->get_buffer(pv.data(), size);
+                    src = pv.data();
+                }
 
-                Ref<Image> img = Image::lossless_unpacker(pv);
+                Ref<Image> img = Image::lossless_unpacker(src, size);
 
                 if (not img || img->empty() || format != img->get_format()) {
                     if (r_error) {
@@ -138,6 +138,7 @@ public:
     int get_height() const override;
 
     RID get_rid() const override;
+    uint64_t get_memory_usage() const override;
 
     bool has_alpha() const override;
     void draw(RID p_canvas_item, const Point2 &p_pos, const Color &p_modulate = Color(1, 1, 1), bool p_transpose = false, const Ref<Texture> &p_normal_map = Ref<Texture>()) const override;
@@ -211,6 +212,7 @@ public:
     int get_width() const override;
     int get_height() const override;
     RID get_rid() const override;
+    uint64_t get_memory_usage() const override;
 
     void set_path(se_string_view p_path, bool p_take_over) override;
 
@@ -53,6 +53,13 @@ void NavigationServer::_bind_methods() {
     MethodBinder::bind_method(D_METHOD("map_set_edge_connection_margin", {"map", "margin"}),&NavigationServer::map_set_edge_connection_margin);
     MethodBinder::bind_method(D_METHOD("map_get_edge_connection_margin", {"map"}),&NavigationServer::map_get_edge_connection_margin);
     MethodBinder::bind_method(D_METHOD("map_get_path", {"map", "origin", "destination", "optimize"}),&NavigationServer::map_get_path);
+    MethodBinder::bind_method(D_METHOD("map_get_closest_point", {"map", "to_point"}),&NavigationServer::map_get_closest_point);
+    MethodBinder::bind_method(D_METHOD("map_get_closest_point_normal", {"map", "to_point"}),&NavigationServer::map_get_closest_point_normal);
+    MethodBinder::bind_method(D_METHOD("map_get_closest_point_owner", {"map", "to_point"}),&NavigationServer::map_get_closest_point_owner);
+    MethodBinder::bind_method(D_METHOD("map_query_path_async", {"map", "origin", "destination", "optimize", "receiver", "method", "userdata"}),&NavigationServer::map_query_path_async, {DEFVAL(Variant()), DEFVAL(StringName()), DEFVAL(Variant())});
+
+    MethodBinder::bind_method(D_METHOD("path_query_is_done", {"query"}),&NavigationServer::path_query_is_done);
+    MethodBinder::bind_method(D_METHOD("path_query_get_path", {"query"}),&NavigationServer::path_query_get_path);
 
     MethodBinder::bind_method(D_METHOD("region_create"), &NavigationServer::region_create);
     MethodBinder::bind_method(D_METHOD("region_set_map", {"region", "map"}),&NavigationServer::region_set_map);
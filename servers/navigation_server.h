@@ -89,6 +89,29 @@ public:
     /// Returns the navigation path to reach the destination from the origin.
     virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize) const = 0;
 
+    /// Returns the point of the map navigation mesh closest to the given point.
+    virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
+
+    /// Returns the surface normal of the navigation mesh at the point closest to the given point.
+    virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
+
+    /// Returns the region owning the navigation mesh point closest to the given point.
+    virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const = 0;
+
+    /// Queues a path query, all the pending queries are resolved in parallel
+    /// during the next `step`, once the maps are synced.
+    /// When a receiver is given, its method is called with the path (and the
+    /// user data, if any) at the end of that step, and the query is freed
+    /// right after the call; freeing it earlier cancels it. Otherwise poll the
+    /// returned query, and release it with `free` once done.
+    virtual RID map_query_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, Object *p_receiver = nullptr, StringName p_method = StringName(), Variant p_udata = Variant()) const = 0;
+
+    /// Returns true once the path query got resolved.
+    virtual bool path_query_is_done(RID p_query) const = 0;
+
+    /// Returns the path found by the query, empty while it's pending.
+    virtual Vector<Vector3> path_query_get_path(RID p_query) const = 0;
+
     /// Creates a new region.
     virtual RID region_create() const = 0;
 
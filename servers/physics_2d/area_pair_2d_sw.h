@@ -44,6 +44,7 @@ class AreaPair2DSW : public Constraint2DSW {
 	bool colliding;
 
 public:
+	bool is_island_local() const override { return false; }
 	bool setup(real_t p_step) override;
 	void solve(real_t p_step) override;
 
@@ -60,6 +61,7 @@ class Area2Pair2DSW : public Constraint2DSW {
 	bool colliding;
 
 public:
+	bool is_island_local() const override { return false; }
 	bool setup(real_t p_step) override;
 	void solve(real_t p_step) override;
 
@@ -540,7 +540,8 @@ void Body2DSW::integrate_forces(real_t p_step) {
     biased_linear_velocity = Vector2();
 
     if (do_motion) { //shapes temporarily extend for raycast
-        _update_shapes_with_motion(motion);
+        shape_motion = motion;
+        shape_motion_pending = true;
     }
 
     // damp_area=NULL; // clear the area, so it is set in the next frame
@@ -548,6 +549,15 @@ void Body2DSW::integrate_forces(real_t p_step) {
     contact_count = 0;
 }
 
+void Body2DSW::update_shapes_with_motion() {
+
+    if (!shape_motion_pending)
+        return;
+
+    shape_motion_pending = false;
+    _update_shapes_with_motion(shape_motion);
+}
+
 void Body2DSW::integrate_velocities(real_t p_step) {
 
     if (mode == Physics2DServer::BODY_MODE_STATIC)
@@ -698,6 +708,7 @@ Body2DSW::Body2DSW() :
     contact_count = 0;
     gravity_scale = 1.0;
     first_integration = false;
+    shape_motion_pending = false;
 
     still_time = 0;
     continuous_cd_mode = Physics2DServer::CCD_MODE_DISABLED;
@@ -81,6 +81,8 @@ class Body2DSW : public CollisionObject2DSW {
     bool can_sleep;
     bool first_time_kinematic;
     bool first_integration;
+    bool shape_motion_pending;
+    Vector2 shape_motion;
     void _update_inertia();
     void _shapes_changed() override;
     Transform2D new_transform;
@@ -206,8 +208,12 @@ public:
         linear_velocity += p_impulse * _inv_mass;
     }
 
+    // Static and kinematic bodies have no inverse mass, skipping them also keeps islands solved on different threads
+    // from writing to the bodies they share.
     _FORCE_INLINE_ void apply_impulse(const Vector2 &p_offset, const Vector2 &p_impulse) {
 
+        if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+            return;
         linear_velocity += p_impulse * _inv_mass;
         angular_velocity += _inv_inertia * p_offset.cross(p_impulse);
     }
@@ -218,6 +224,8 @@ public:
 
     _FORCE_INLINE_ void apply_bias_impulse(const Vector2 &p_pos, const Vector2 &p_j) {
 
+        if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+            return;
         biased_linear_velocity += p_j * _inv_mass;
         biased_angular_velocity += _inv_inertia * p_pos.cross(p_j);
     }
@@ -275,7 +283,10 @@ public:
     _FORCE_INLINE_ real_t get_linear_damp() const { return linear_damp; }
     _FORCE_INLINE_ real_t get_angular_damp() const { return angular_damp; }
 
+    // Only writes to the body itself, so different bodies can be integrated concurrently. Extending the shapes in the
+    // broadphase by the resulting motion is left to update_shapes_with_motion().
     void integrate_forces(real_t p_step);
+    void update_shapes_with_motion();
     void integrate_velocities(real_t p_step);
 
     _FORCE_INLINE_ Vector2 get_motion() const {
@@ -391,6 +391,12 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
             //Vector2 crB( -B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x );
 
+            // a reporting static or kinematic body may be shared with an island being set up on another thread
+            bool shared = (gather_A && A->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC) || (gather_B && B->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC);
+            std::unique_lock<Mutex> shared_lock(space->get_shared_body_mutex(), std::defer_lock);
+            if (shared)
+                shared_lock.lock();
+
             global_A += offset_A;
             global_B += offset_A;
 
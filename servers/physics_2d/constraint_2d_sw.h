@@ -70,6 +70,11 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Islands are set up and solved concurrently, which is only safe for constraints that write to nothing but their
+	// own dynamic bodies. Constraints that also touch shared objects (areas, for instance) return false here and are
+	// processed serially instead.
+	virtual bool is_island_local() const { return true; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
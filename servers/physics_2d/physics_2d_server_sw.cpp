@@ -759,7 +759,7 @@ Physics2DServerSW::CCDMode Physics2DServerSW::body_get_continuous_collision_dete
     return body->get_continuous_collision_detection_mode();
 }
 
-void Physics2DServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_id) {
+void Physics2DServerSW::body_attach_object_instance_id(RID p_body, ObjectID p_id) {
 
     Body2DSW *body = body_owner.get(p_body);
     ERR_FAIL_COND(!body);
@@ -767,7 +767,7 @@ void Physics2DServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_id
     body->set_instance_id(p_id);
 };
 
-uint32_t Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
+ObjectID Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
 
     Body2DSW *body = body_owner.get(p_body);
     ERR_FAIL_COND_V(!body, 0);
@@ -775,7 +775,7 @@ uint32_t Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
     return body->get_instance_id();
 };
 
-void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, uint32_t p_id) {
+void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, ObjectID p_id) {
 
     Body2DSW *body = body_owner.get(p_body);
     ERR_FAIL_COND(!body);
@@ -783,7 +783,7 @@ void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, uint32_t p_id
     body->set_canvas_instance_id(p_id);
 };
 
-uint32_t Physics2DServerSW::body_get_canvas_instance_id(RID p_body) const {
+ObjectID Physics2DServerSW::body_get_canvas_instance_id(RID p_body) const {
 
     Body2DSW *body = body_owner.get(p_body);
     ERR_FAIL_COND_V(!body, 0);
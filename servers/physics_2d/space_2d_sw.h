@@ -38,9 +38,12 @@
 #include "broad_phase_2d_sw.h"
 #include "collision_object_2d_sw.h"
 #include "core/hash_map.h"
+#include "core/os/mutex.h"
 #include "core/project_settings.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 class Physics2DDirectSpaceStateSW : public Physics2DDirectSpaceState {
 
     GDCLASS(Physics2DDirectSpaceStateSW,Physics2DDirectSpaceState)
@@ -125,7 +128,9 @@ private:
     int collision_pairs;
 
     Vector<Vector2> contact_debug;
-    int contact_debug_count;
+    std::atomic<int> contact_debug_count;
+
+    Mutex shared_body_mutex;
 
     int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb);
 
@@ -192,11 +197,16 @@ public:
     void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
     bool is_debugging_contacts() const { return !contact_debug.empty(); }
     void add_debug_contact(Vector2 p_contact) {
-        if (contact_debug_count < contact_debug.size())
-            contact_debug[contact_debug_count++] = p_contact;
+        int index = contact_debug_count.fetch_add(1, std::memory_order_relaxed);
+        if (index < contact_debug.size())
+            contact_debug[index] = p_contact;
     }
     const Vector<Vector2> &get_debug_contacts() { return contact_debug; }
-    int get_debug_contact_count() { return contact_debug_count; }
+    int get_debug_contact_count() { return MIN(contact_debug_count.load(std::memory_order_relaxed), int(contact_debug.size())); }
+
+    // Islands are set up on several threads, static and kinematic bodies can belong to more than one of them.
+    // Writes to such bodies during setup must hold this lock.
+    Mutex &get_shared_body_mutex() { return shared_body_mutex; }
 
     Physics2DDirectSpaceStateSW *get_direct_state();
 
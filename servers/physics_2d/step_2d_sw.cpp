@@ -29,8 +29,23 @@
 /*************************************************************************/
 
 #include "step_2d_sw.h"
+#include "core/os/job_system.h"
 #include "core/os/os.h"
 
+// Runs p_func for every index on the job system when there is one and enough work to split, serially otherwise.
+template <class F>
+static void _for_each_index(int p_count, F &&p_func) {
+
+    JobSystem *job_system = JobSystem::get_singleton();
+    if (job_system && job_system->get_worker_count() > 0 && p_count > 1) {
+        job_system->parallel_for(p_count, p_func);
+    } else {
+        for (int i = 0; i < p_count; i++) {
+            p_func(i);
+        }
+    }
+}
+
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
 
     p_body->set_island_step(_step);
@@ -43,6 +58,10 @@ void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constrain
         if (c->get_island_step() == _step)
             continue; //already processed
         c->set_island_step(_step);
+        if (!c->is_island_local()) {
+            serial_constraints.push_back(c);
+            continue;
+        }
         c->set_island_next(*p_constraint_island);
         *p_constraint_island = c;
 
@@ -144,14 +163,17 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
     uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
     uint64_t profile_endtime = 0;
 
-    int active_count = 0;
+    active_bodies.clear();
+    for (const SelfList<Body2DSW> *b = body_list->first(); b; b = b->next()) {
+        active_bodies.push_back(b->self());
+    }
+    int active_count = active_bodies.size();
 
-    const SelfList<Body2DSW> *b = body_list->first();
-    while (b) {
+    _for_each_index(active_count, [this, p_delta](uint32_t i) { active_bodies[i]->integrate_forces(p_delta); });
 
-        b->self()->integrate_forces(p_delta);
-        b = b->next();
-        active_count++;
+    // the broadphase isn't thread safe, moving shapes by the integrated motion happens here
+    for (Body2DSW *body : active_bodies) {
+        body->update_shapes_with_motion();
     }
 
     p_space->set_active_objects(active_count);
@@ -165,13 +187,10 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
     /* GENERATE CONSTRAINT ISLANDS */
 
     Body2DSW *island_list = nullptr;
-    Constraint2DSW *constraint_island_list = nullptr;
-    b = body_list->first();
+    constraint_islands.clear();
+    serial_constraints.clear();
 
-    int island_count = 0;
-
-    while (b) {
-        Body2DSW *body = b->self();
+    for (Body2DSW *body : active_bodies) {
 
         if (body->get_island_step() != _step) {
 
@@ -183,15 +202,12 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
             island_list = island;
 
             if (constraint_island) {
-                constraint_island->set_island_list_next(constraint_island_list);
-                constraint_island_list = constraint_island;
-                island_count++;
+                constraint_islands.push_back(constraint_island);
             }
         }
-        b = b->next();
     }
 
-    p_space->set_island_count(island_count);
+    p_space->set_island_count(constraint_islands.size());
 
     const SelfList<Area2DSW>::List &aml = p_space->get_moved_area_list();
 
@@ -202,8 +218,11 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
                 continue;
             c->set_island_step(_step);
             c->set_island_next(nullptr);
-            c->set_island_list_next(constraint_island_list);
-            constraint_island_list = c;
+            if (c->is_island_local()) {
+                constraint_islands.push_back(c);
+            } else {
+                serial_constraints.push_back(c);
+            }
         }
         p_space->area_remove_from_moved_list((SelfList<Area2DSW> *)aml.first()); //faster to remove here
     }
@@ -217,41 +236,30 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
     /* SETUP CONSTRAINT ISLANDS */
 
     {
-        Constraint2DSW *ci = constraint_island_list;
-        Constraint2DSW *prev_ci = nullptr;
-        while (ci) {
-
-            if (_setup_island(ci, p_delta)) {
-
-                //removed the root from the island graph because it is not to be processed
-
-                Constraint2DSW *next = ci->get_island_next();
-
-                if (next) {
-                    //root from list being deleted no longer exists, replace by next
-                    next->set_island_list_next(ci->get_island_list_next());
-                    if (prev_ci) {
-                        prev_ci->set_island_list_next(next);
-                    } else {
-                        constraint_island_list = next;
-                    }
-                    prev_ci = next;
-                } else {
-
-                    //list is empty, just skip
-                    if (prev_ci) {
-                        prev_ci->set_island_list_next(ci->get_island_list_next());
+        // constraints touching shared objects first, keeping only the ones that still need solving
+        int serial_count = 0;
+        for (Constraint2DSW *c : serial_constraints) {
+            if (c->setup(p_delta)) {
+                serial_constraints[serial_count++] = c;
+            }
+        }
+        serial_constraints.resize(serial_count);
 
-                    } else {
-                        constraint_island_list = ci->get_island_list_next();
-                    }
-                }
-            } else {
-                prev_ci = ci;
+        _for_each_index(constraint_islands.size(), [this, p_delta](uint32_t i) {
+            Constraint2DSW *&island = constraint_islands[i];
+            if (_setup_island(island, p_delta)) {
+                //removed the root from the island graph because it is not to be processed, replace by next (if any)
+                island = island->get_island_next();
             }
+        });
 
-            ci = ci->get_island_list_next();
+        int island_count = 0;
+        for (Constraint2DSW *island : constraint_islands) {
+            if (island) {
+                constraint_islands[island_count++] = island;
+            }
         }
+        constraint_islands.resize(island_count);
     }
 
     { //profile
@@ -263,11 +271,13 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
     /* SOLVE CONSTRAINT ISLANDS */
 
     {
-        Constraint2DSW *ci = constraint_island_list;
-        while (ci) {
-            //iterating each island separatedly improves cache efficiency
-            _solve_island(ci, p_iterations, p_delta);
-            ci = ci->get_island_list_next();
+        //iterating each island separatedly improves cache efficiency, and islands share no dynamic bodies
+        _for_each_index(constraint_islands.size(), [this, p_iterations, p_delta](uint32_t i) { _solve_island(constraint_islands[i], p_iterations, p_delta); });
+
+        for (int i = 0; i < p_iterations; i++) {
+            for (Constraint2DSW *c : serial_constraints) {
+                c->solve(p_delta);
+            }
         }
     }
 
@@ -279,7 +289,8 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
     /* INTEGRATE VELOCITIES */
 
-    b = body_list->first();
+    // stays serial, integrating moves the body in the broadphase and may take it off the active list
+    const SelfList<Body2DSW> *b = body_list->first();
     while (b) {
 
         const SelfList<Body2DSW> *n = b->next();
@@ -37,6 +37,11 @@ class Step2DSW {
 
 	uint64_t _step;
 
+	// scratch buffers reused between steps
+	Vector<Body2DSW *> active_bodies;
+	Vector<Constraint2DSW *> constraint_islands;
+	Vector<Constraint2DSW *> serial_constraints;
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
 	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
 	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
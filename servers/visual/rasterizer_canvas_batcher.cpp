@@ -0,0 +1,308 @@
+/*************************************************************************/
+/*  rasterizer_canvas_batcher.cpp                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "rasterizer_canvas_batcher.h"
+
+using Item = RasterizerCanvas::Item;
+
+bool RasterizerCanvasBatcher::_get_batch_info(const Item::Command *p_command, RasterizerStorage *p_storage, RID &r_texture, Size2 &r_texture_size, int &r_vertex_count) const {
+
+    r_texture_size = Size2();
+
+    switch (p_command->type) {
+        case Item::Command::TYPE_RECT: {
+
+            const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+            if (rect->normal_map.is_valid() || rect->flags & (RasterizerCanvas::CANVAS_RECT_TILE | RasterizerCanvas::CANVAS_RECT_CLIP_UV))
+                return false;
+
+            r_texture = rect->texture;
+            if (r_texture.is_valid()) {
+                r_texture_size = Size2(p_storage->texture_get_width(r_texture), p_storage->texture_get_height(r_texture));
+                if (r_texture_size.width <= 0 || r_texture_size.height <= 0)
+                    return false;
+            }
+            r_vertex_count = 4;
+            return true;
+        }
+        case Item::Command::TYPE_NINEPATCH: {
+
+            // only stretched axes map linearly to the source, tiling needs the nine-patch shader
+            const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+            if (np->normal_map.is_valid() || !np->texture.is_valid() || np->axis_x != VS::NINE_PATCH_STRETCH || np->axis_y != VS::NINE_PATCH_STRETCH)
+                return false;
+            if (np->rect.size.width == 0 || np->rect.size.height == 0)
+                return false;
+
+            r_texture = np->texture;
+            r_texture_size = Size2(p_storage->texture_get_width(r_texture), p_storage->texture_get_height(r_texture));
+            if (r_texture_size.width <= 0 || r_texture_size.height <= 0)
+                return false;
+
+            Size2 source_size = np->source != Rect2() ? np->source.size : r_texture_size;
+            if (source_size.width <= 0 || source_size.height <= 0)
+                return false;
+            if (np->margin[(int8_t)Margin::Left] + np->margin[(int8_t)Margin::Right] > source_size.width || np->margin[(int8_t)Margin::Top] + np->margin[(int8_t)Margin::Bottom] > source_size.height)
+                return false;
+
+            r_vertex_count = 9 * 4;
+            return true;
+        }
+        case Item::Command::TYPE_POLYGON: {
+
+            const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(p_command);
+            if (polygon->normal_map.is_valid() || polygon->antialiased || polygon->bones.size() || polygon->weights.size())
+                return false;
+            int point_count = polygon->points.size();
+            if (polygon->count <= 0 || polygon->count > (int)polygon->indices.size())
+                return false;
+            if (polygon->uvs.size() && polygon->uvs.size() != point_count)
+                return false;
+            if (polygon->colors.size() > 1 && polygon->colors.size() != point_count)
+                return false;
+
+            r_texture = polygon->texture;
+            r_vertex_count = point_count;
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void RasterizerCanvasBatcher::_push_quad(const Vector2 &p_from, const Vector2 &p_to, const Vector2 &p_uv_from, const Vector2 &p_uv_to, const Color &p_color, bool p_transpose, Batch &r_batch) {
+
+    // same corner order as the canvas quad: (0,0), (0,1), (1,1), (1,0)
+    static const Vector2 corners[4] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0) };
+
+    uint16_t base = r_batch.vertex_count;
+    for (const Vector2 &c : corners) {
+        Vector2 uv_c = p_transpose ? Vector2(c.y, c.x) : c;
+        Vector2 pos(Math::lerp(p_from.x, p_to.x, c.x), Math::lerp(p_from.y, p_to.y, c.y));
+        vertices.push_back({ pos, p_uv_from + (p_uv_to - p_uv_from) * uv_c, p_color });
+    }
+    const uint16_t quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+    for (uint16_t idx : quad_indices) {
+        indices.push_back(base + idx);
+    }
+    r_batch.vertex_count += 4;
+    r_batch.index_count += 6;
+}
+
+void RasterizerCanvasBatcher::_add_rect(const Item::CommandRect *p_rect, const Size2 &p_texture_size, Batch &r_batch) {
+
+    // mirrors the texture rect path of the canvas shader, see RasterizerCanvasGLES3::_render_rect
+    Rect2 dst_rect = p_rect->rect;
+    if (dst_rect.size.width < 0) {
+        dst_rect.position.x += dst_rect.size.width;
+        dst_rect.size.width *= -1;
+    }
+    if (dst_rect.size.height < 0) {
+        dst_rect.position.y += dst_rect.size.height;
+        dst_rect.size.height *= -1;
+    }
+
+    Vector2 from = dst_rect.position;
+    Vector2 to = dst_rect.position + dst_rect.size;
+    Rect2 src_rect(0, 0, 1, 1);
+    bool transpose = false;
+
+    if (p_rect->texture.is_valid()) {
+        if (p_rect->flags & RasterizerCanvas::CANVAS_RECT_REGION) {
+            src_rect = Rect2(p_rect->source.position / p_texture_size, p_rect->source.size / p_texture_size);
+        }
+        // a negative source size flips the quad in the shader, swapping the ends of the destination
+        bool flip_h = (src_rect.size.x < 0) != bool(p_rect->flags & RasterizerCanvas::CANVAS_RECT_FLIP_H);
+        bool flip_v = (src_rect.size.y < 0) != bool(p_rect->flags & RasterizerCanvas::CANVAS_RECT_FLIP_V);
+        src_rect.size = src_rect.size.abs();
+        if (flip_h) {
+            SWAP(from.x, to.x);
+        }
+        if (flip_v) {
+            SWAP(from.y, to.y);
+        }
+        transpose = p_rect->flags & RasterizerCanvas::CANVAS_RECT_TRANSPOSE;
+    }
+
+    _push_quad(from, to, src_rect.position, src_rect.position + src_rect.size, p_rect->modulate, transpose, r_batch);
+}
+
+void RasterizerCanvasBatcher::_add_nine_patch(const Item::CommandNinePatch *p_nine_patch, const Size2 &p_texture_size, Batch &r_batch) {
+
+    // Stretched nine-patches are piecewise linear, so each of the nine cells is a quad. This mirrors
+    // map_ninepatch_axis() in the canvas shader.
+    Rect2 source = p_nine_patch->source != Rect2() ? p_nine_patch->source : Rect2(Vector2(), p_texture_size);
+    Rect2 uv_rect(source.position / p_texture_size, source.size / p_texture_size);
+    Size2 draw_size = p_nine_patch->rect.size.abs();
+
+    real_t s_ratio = MAX(1.0f, MAX(source.size.width / draw_size.width, source.size.height / draw_size.height));
+    const float *margin = p_nine_patch->margin;
+
+    real_t pos_x[4] = { 0, margin[(int8_t)Margin::Left] / s_ratio, draw_size.width - margin[(int8_t)Margin::Right] / s_ratio, draw_size.width };
+    real_t pos_y[4] = { 0, margin[(int8_t)Margin::Top] / s_ratio, draw_size.height - margin[(int8_t)Margin::Bottom] / s_ratio, draw_size.height };
+    real_t uv_x[4] = { 0, margin[(int8_t)Margin::Left] / source.size.width, 1 - margin[(int8_t)Margin::Right] / source.size.width, 1 };
+    real_t uv_y[4] = { 0, margin[(int8_t)Margin::Top] / source.size.height, 1 - margin[(int8_t)Margin::Bottom] / source.size.height, 1 };
+
+    for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3; x++) {
+            if (x == 1 && y == 1 && !p_nine_patch->draw_center)
+                continue;
+            if (pos_x[x] == pos_x[x + 1] || pos_y[y] == pos_y[y + 1])
+                continue;
+
+            Vector2 from = p_nine_patch->rect.position + Vector2(pos_x[x], pos_y[y]);
+            Vector2 to = p_nine_patch->rect.position + Vector2(pos_x[x + 1], pos_y[y + 1]);
+            Vector2 uv_from = uv_rect.position + Vector2(uv_x[x], uv_y[y]) * uv_rect.size;
+            Vector2 uv_to = uv_rect.position + Vector2(uv_x[x + 1], uv_y[y + 1]) * uv_rect.size;
+            _push_quad(from, to, uv_from, uv_to, p_nine_patch->color, false, r_batch);
+        }
+    }
+}
+
+void RasterizerCanvasBatcher::_add_polygon(const Item::CommandPolygon *p_polygon, Batch &r_batch) {
+
+    int point_count = p_polygon->points.size();
+    PoolVector<Point2>::Read uvs = p_polygon->uvs.read();
+    PoolVector<Color>::Read colors = p_polygon->colors.read();
+    bool single_color = p_polygon->colors.size() == 1;
+    bool has_colors = p_polygon->colors.size() != 0;
+    bool has_uvs = p_polygon->uvs.size() != 0;
+
+    for (int i = 0; i < point_count; i++) {
+        Color color = has_colors ? colors[single_color ? 0 : i] : Color(1, 1, 1, 1);
+        vertices.push_back({ p_polygon->points[i], has_uvs ? uvs[i] : Vector2(), color });
+    }
+
+    uint16_t base = r_batch.vertex_count;
+    for (int i = 0; i < p_polygon->count; i++) {
+        int idx = p_polygon->indices[i];
+        // out of range indices are clamped instead of reading past the batch
+        indices.push_back(base + uint16_t(CLAMP(idx, 0, point_count - 1)));
+    }
+    r_batch.vertex_count += point_count;
+    r_batch.index_count += p_polygon->count;
+}
+
+void RasterizerCanvasBatcher::_close_batch() {
+
+    if (batches.empty())
+        return;
+
+    Batch &last = batches.back();
+    if (!last.merged || last.command_count > 1)
+        return;
+
+    // a single command gains nothing from the merged path, hand it back to the driver
+    vertices.resize(last.first_vertex);
+    indices.resize(last.first_index);
+    last.merged = false;
+    last.texture = RID();
+    last.vertex_count = 0;
+    last.index_count = 0;
+    merged_command_count--;
+
+    if (batches.size() > 1 && !batches[batches.size() - 2].merged) {
+        batches[batches.size() - 2].command_count += last.command_count;
+        batches.pop_back();
+    }
+}
+
+void RasterizerCanvasBatcher::build(const Item *p_item, RasterizerStorage *p_storage) {
+
+    clear();
+
+    int command_count = p_item->commands.size();
+    Item::Command *const *commands = p_item->commands.data();
+
+    for (int i = 0; i < command_count; i++) {
+
+        const Item::Command *c = commands[i];
+
+        RID texture;
+        Size2 texture_size;
+        int vertex_count = 0;
+        bool batchable = _get_batch_info(c, p_storage, texture, texture_size, vertex_count) && vertex_count <= MAX_BATCH_VERTICES;
+
+        if (!batchable) {
+            _close_batch();
+            if (batches.empty() || batches.back().merged) {
+                batches.push_back({ i, 0, false, RID(), 0, 0, 0, 0 });
+            }
+            batches.back().command_count++;
+            continue;
+        }
+
+        if (batches.empty() || !batches.back().merged || batches.back().texture != texture || batches.back().vertex_count + vertex_count > MAX_BATCH_VERTICES) {
+            _close_batch();
+            batches.push_back({ i, 0, true, texture, int(vertices.size()), 0, int(indices.size()), 0 });
+        }
+
+        Batch &batch = batches.back();
+        switch (c->type) {
+            case Item::Command::TYPE_RECT: {
+                _add_rect(static_cast<const Item::CommandRect *>(c), texture_size, batch);
+            } break;
+            case Item::Command::TYPE_NINEPATCH: {
+                _add_nine_patch(static_cast<const Item::CommandNinePatch *>(c), texture_size, batch);
+            } break;
+            case Item::Command::TYPE_POLYGON: {
+                _add_polygon(static_cast<const Item::CommandPolygon *>(c), batch);
+            } break;
+            default: {
+            }
+        }
+        batch.command_count++;
+        merged_command_count++;
+    }
+
+    _close_batch();
+}
+
+void RasterizerCanvasBatcher::clear() {
+
+    batches.clear();
+    vertices.clear();
+    indices.clear();
+    merged_command_count = 0;
+}
+
+int RasterizerCanvasBatcher::get_draw_call_count() const {
+
+    int count = 0;
+    for (const Batch &batch : batches) {
+        if (batch.merged) {
+            count++;
+        } else {
+            count += batch.command_count;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,90 @@
+/*************************************************************************/
+/*  rasterizer_canvas_batcher.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#pragma once
+
+#include "servers/visual/rasterizer.h"
+
+// Merges runs of consecutive rect, nine-patch and polygon commands of a canvas item that sample the same texture into
+// one indexed triangle list, so a driver can draw each run with a single call. Everything else about the draw state
+// (material, blend mode, transform, clipping) is constant within an item, which is why runs never cross items.
+// Commands that can't be expressed as plain triangles (tiled or UV clipped rects, tiled nine-patches, normal maps,
+// skinned or antialiased polygons, ...) are left for the driver to draw on its own, as is any run of one command.
+class GODOT_EXPORT RasterizerCanvasBatcher {
+public:
+    struct Vertex {
+        Vector2 pos;
+        Vector2 uv;
+        Color color;
+    };
+
+    // A run of consecutive commands of the item. Merged runs own vertices [first_vertex, first_vertex + vertex_count)
+    // and indices [first_index, first_index + index_count), the indices being relative to first_vertex.
+    struct Batch {
+        int first_command;
+        int command_count;
+        bool merged;
+        RID texture;
+        int first_vertex;
+        int vertex_count;
+        int first_index;
+        int index_count;
+    };
+
+    enum {
+        MAX_BATCH_VERTICES = 65536 // indices are 16 bit
+    };
+
+private:
+    Vector<Batch> batches;
+    Vector<Vertex> vertices;
+    Vector<uint16_t> indices;
+    int merged_command_count = 0;
+
+    bool _get_batch_info(const RasterizerCanvas::Item::Command *p_command, RasterizerStorage *p_storage, RID &r_texture, Size2 &r_texture_size, int &r_vertex_count) const;
+    void _push_quad(const Vector2 &p_from, const Vector2 &p_to, const Vector2 &p_uv_from, const Vector2 &p_uv_to, const Color &p_color, bool p_transpose, Batch &r_batch);
+    void _add_rect(const RasterizerCanvas::Item::CommandRect *p_rect, const Size2 &p_texture_size, Batch &r_batch);
+    void _add_nine_patch(const RasterizerCanvas::Item::CommandNinePatch *p_nine_patch, const Size2 &p_texture_size, Batch &r_batch);
+    void _add_polygon(const RasterizerCanvas::Item::CommandPolygon *p_polygon, Batch &r_batch);
+    void _close_batch();
+
+public:
+    // Texture sizes are queried from p_storage, commands whose texture reports no size are not merged.
+    void build(const RasterizerCanvas::Item *p_item, RasterizerStorage *p_storage);
+    void clear();
+
+    const Vector<Batch> &get_batches() const { return batches; }
+    const Vector<Vertex> &get_vertices() const { return vertices; }
+    const Vector<uint16_t> &get_indices() const { return indices; }
+    // Number of commands of the last build that are drawn as part of a merged batch.
+    int get_merged_command_count() const { return merged_command_count; }
+    // Draw calls needed for the last build, counting one per merged batch and one per remaining command.
+    int get_draw_call_count() const;
+};
@@ -533,6 +533,7 @@ public:
     BIND2(scenario_set_debug, RID, VS::ScenarioDebugMode)
     BIND2(scenario_set_environment, RID, RID)
     BIND3(scenario_set_reflection_atlas_size, RID, int, int)
+    BIND2(scenario_set_use_bvh, RID, bool)
     BIND2(scenario_set_fallback_environment, RID, RID)
 
     /* INSTANCING API */
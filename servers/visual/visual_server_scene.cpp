@@ -35,9 +35,11 @@
 
 #include "core/ecs_registry.h"
 #include "core/external_profiler.h"
+#include "core/os/job_system.h"
 #include "core/os/mutex.h"
 #include "core/os/os.h"
 #include "core/map.h"
+#include "core/project_settings.h"
 #include <new>
 
 namespace {
@@ -393,6 +395,22 @@ void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance
     }
 }
 
+void VisualServerScene::_scenario_set_spatial_partitioning(Scenario *p_scenario, bool p_use_bvh) {
+
+    if (p_scenario->sps)
+        memdelete(p_scenario->sps);
+
+    using SceneBVH = SpatialPartitioningSceneImpl<BVHTree<Instance, true>>;
+    using SceneOctree = SpatialPartitioningSceneImpl<Octree<Instance, true>>;
+    if (p_use_bvh)
+        p_scenario->sps = memnew(SceneBVH);
+    else
+        p_scenario->sps = memnew(SceneOctree);
+    p_scenario->use_bvh = p_use_bvh;
+    p_scenario->sps->set_pair_callback(_instance_pair, this);
+    p_scenario->sps->set_unpair_callback(_instance_unpair, this);
+}
+
 RID VisualServerScene::scenario_create() {
 
     Scenario *scenario = memnew(Scenario);
@@ -400,8 +418,7 @@ RID VisualServerScene::scenario_create() {
     RID scenario_rid = scenario_owner.make_rid(scenario);
     scenario->self = scenario_rid;
 
-    scenario->octree.set_pair_callback(_instance_pair, this);
-    scenario->octree.set_unpair_callback(_instance_unpair, this);
+    _scenario_set_spatial_partitioning(scenario, GLOBAL_GET("rendering/quality/spatial_partitioning/use_bvh").as<bool>());
     scenario->reflection_probe_shadow_atlas = VSG::scene_render->shadow_atlas_create();
     VSG::scene_render->shadow_atlas_set_size(scenario->reflection_probe_shadow_atlas, 1024); //make enough shadows for close distance, don't bother with rest
     VSG::scene_render->shadow_atlas_set_quadrant_subdivision(scenario->reflection_probe_shadow_atlas, 0, 4);
@@ -420,6 +437,16 @@ void VisualServerScene::scenario_set_debug(RID p_scenario, VS::ScenarioDebugMode
     scenario->debug = p_debug_mode;
 }
 
+void VisualServerScene::scenario_set_use_bvh(RID p_scenario, bool p_enable) {
+
+    Scenario *scenario = scenario_owner.get(p_scenario);
+    ERR_FAIL_COND(!scenario);
+    if (scenario->use_bvh == p_enable)
+        return;
+    ERR_FAIL_COND_MSG(scenario->instances.first(), "Spatial partitioning can only be changed while the scenario has no instances.");
+    _scenario_set_spatial_partitioning(scenario, p_enable);
+}
+
 void VisualServerScene::scenario_set_environment(RID p_scenario, RID p_environment) {
 
     Scenario *scenario = scenario_owner.get(p_scenario);
@@ -493,9 +520,9 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
             }
         }
 
-        if (scenario && instance->octree_id) {
-            scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-            instance->octree_id = 0;
+        if (scenario && instance->spatial_partition_id) {
+            scenario->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial index go away
+            instance->spatial_partition_id = 0;
         }
 
         switch (instance->base_type) {
@@ -650,9 +677,9 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 
         old_scene->instances.remove(&instance->scenario_item);
 
-        if (instance->octree_id) {
-            old_scene->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-            instance->octree_id = 0;
+        if (instance->spatial_partition_id) {
+            old_scene->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial index go away
+            instance->spatial_partition_id = 0;
         }
 
         switch (instance->base_type) {
@@ -804,26 +831,26 @@ void VisualServerScene::instance_set_visible(RID p_instance, bool p_visible) {
 
     switch (instance->base_type) {
         case VS::INSTANCE_LIGHT: {
-            if (VSG::storage->light_get_type(instance->base) != VS::LIGHT_DIRECTIONAL && instance->octree_id && instance->scenario) {
-                instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+            if (VSG::storage->light_get_type(instance->base) != VS::LIGHT_DIRECTIONAL && instance->spatial_partition_id && instance->scenario) {
+                instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_LIGHT, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
             }
 
         } break;
         case VS::INSTANCE_REFLECTION_PROBE: {
-            if (instance->octree_id && instance->scenario) {
-                instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+            if (instance->spatial_partition_id && instance->scenario) {
+                instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_REFLECTION_PROBE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
             }
 
         } break;
         case VS::INSTANCE_LIGHTMAP_CAPTURE: {
-            if (instance->octree_id && instance->scenario) {
-                instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
+            if (instance->spatial_partition_id && instance->scenario) {
+                instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? VS::INSTANCE_GEOMETRY_MASK : 0);
             }
 
         } break;
         case VS::INSTANCE_GI_PROBE: {
-            if (instance->octree_id && instance->scenario) {
-                instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
+            if (instance->spatial_partition_id && instance->scenario) {
+                instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << VS::INSTANCE_GI_PROBE, p_visible ? (VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)) : 0);
             }
 
         } break;
@@ -920,7 +947,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_aabb(const AABB &p_aabb, RID
     const_cast<VisualServerScene *>(this)->update_dirty_instances(); // check dirty instances before culling
 
     Instance *cull[1024];
-    int culled = scenario->octree.cull_aabb(p_aabb, cull, 1024);
+    int culled = scenario->sps->cull_aabb(p_aabb, cull, 1024);
 
     instances.reserve(culled/2);
 
@@ -944,7 +971,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_ray(const Vector3 &p_from, co
     const_cast<VisualServerScene *>(this)->update_dirty_instances(); // check dirty instances before culling
 
     Instance *cull[1024];
-    int culled = scenario->octree.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
+    int culled = scenario->sps->cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
 
     instances.reserve(culled/2);
     for (int i = 0; i < culled; i++) {
@@ -968,7 +995,7 @@ Vector<ObjectID> VisualServerScene::instances_cull_convex(Span<const Plane> p_co
     int culled = 0;
     Instance *cull[1024];
 
-    culled = scenario->octree.cull_convex(p_convex, cull, 1024);
+    culled = scenario->sps->cull_convex(p_convex, cull, 1024);
 
     for (int i = 0; i < culled; i++) {
 
@@ -1096,7 +1123,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
         return;
     }
 
-    if (p_instance->octree_id == 0) {
+    if (p_instance->spatial_partition_id == 0) {
 
         uint32_t base_type = 1 << p_instance->base_type;
         uint32_t pairable_mask = 0;
@@ -1114,8 +1141,8 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
             pairable = true;
         }
 
-        // not inside octree
-        p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+        // not inside the spatial index yet
+        p_instance->spatial_partition_id = p_instance->scenario->sps->create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
 
     } else {
 
@@ -1124,7 +1151,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
             return;
         */
 
-        p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+        p_instance->scenario->sps->move(p_instance->spatial_partition_id, new_aabb);
     }
 }
 
@@ -1438,15 +1465,48 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
     }
 }
 
-bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
+int VisualServerScene::_cull_convex(Scenario *p_scenario, Span<const Plane> p_planes, Vector<Instance *> &r_result, uint32_t p_mask) {
+
+    if (r_result.size() < INITIAL_INSTANCE_CULL) {
+        r_result.resize(INITIAL_INSTANCE_CULL);
+    }
+    while (true) {
+        int count = p_scenario->sps->cull_convex(p_planes, r_result.data(), r_result.size(), p_mask);
+        if (count < int(r_result.size()))
+            return count;
+        // the buffer filled up, so some instances may have been left out
+        r_result.resize(r_result.size() * 2);
+    }
+}
+
+VisualServerScene::ShadowPass &VisualServerScene::_push_shadow_pass(Instance *p_light) {
+
+    if (shadow_pass_count == int(shadow_passes.size())) {
+        shadow_passes.push_back(ShadowPass());
+    }
+    ShadowPass &pass = shadow_passes[shadow_pass_count++];
+    pass.light = p_light;
+    pass.pass = 0;
+    pass.render = true;
+    pass.directional = false;
+    pass.animated_material_found = false;
+    pass.plane_count = 0;
+    pass.projection = CameraMatrix();
+    pass.transform = Transform();
+    pass.far = 0;
+    pass.split = 0;
+    pass.bias_scale = 1.0f;
+    pass.caster_count = 0;
+    return pass;
+}
+
+void VisualServerScene::_light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, Scenario *p_scenario) {
 
     InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
     Transform light_transform = p_instance->transform;
     light_transform.orthonormalize(); //scale does not count on lights
 
-    bool animated_material_found = false;
-
     switch (VSG::storage->light_get_type(p_instance->base)) {
 
         case VS::LIGHT_DIRECTIONAL: {
@@ -1464,7 +1524,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
             if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
                 //optimize min/max
                 Frustum planes = p_cam_projection.get_projection_planes(p_cam_transform);
-                int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+                int cull_count = _cull_convex(p_scenario, planes, instance_shadow_cull_result, VS::INSTANCE_GEOMETRY_MASK);
                 Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
                 //check distance max and min
 
@@ -1483,10 +1543,6 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
                     if(!cm_geom.can_cast_shadows)
                         continue;
 
-                    if (cm_geom.material_is_animated) {
-                        animated_material_found = true;
-                    }
-
                     float max, min;
                     get_component<InstanceBoundsComponent>(instance->self).transformed_aabb.project_range_in_plane(base, min, max);
 
@@ -1665,47 +1721,27 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
                 light_frustum_planes[4] = Plane(z_vec, z_max + 1e6f);
                 light_frustum_planes[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-                int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
-                // a pre pass will need to be needed to determine the actual z-near to be used
-
-                Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-
-                for (int j = 0; j < cull_count; j++) {
-
-                    float min, max;
-                    Instance *instance = instance_shadow_cull_result[j];
-                    if (!instance->visible || !has_component<GeometryComponent>(instance->self.eid) ||
-                            !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                        cull_count--;
-                        SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                        j--;
-                        continue;
-                    }
-
-                    get_component<InstanceBoundsComponent>(instance->self).transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-                    instance->depth = near_plane.distance_to(instance->transform.origin);
-                    instance->depth_layer = 0;
-                    if (max > z_max)
-                        z_max = max;
-                }
-
-                {
-
-                    CameraMatrix ortho_camera;
-                    real_t half_x = (x_max_cam - x_min_cam) * 0.5f;
-                    real_t half_y = (y_max_cam - y_min_cam) * 0.5f;
-
-                    ortho_camera.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (z_max - z_min_cam));
-
-                    Transform ortho_transform;
-                    ortho_transform.basis = transform.basis;
-                    ortho_transform.origin = x_vec * (x_min_cam + half_x) + y_vec * (y_min_cam + half_y) + z_vec * z_max;
-
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, distances[i + 1], i, bias_scale);
+                ShadowPass &pass = _push_shadow_pass(p_instance);
+                pass.pass = i;
+                pass.directional = true;
+                for (int j = 0; j < 6; j++) {
+                    pass.planes[j] = light_frustum_planes[j];
                 }
-
-                VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+                pass.plane_count = 6;
+                // a pre pass will need to be needed to determine the actual z-near to be used
+                pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+                pass.transform.basis = transform.basis;
+                pass.split = distances[i + 1];
+                pass.bias_scale = bias_scale;
+                pass.x_vec = x_vec;
+                pass.y_vec = y_vec;
+                pass.z_vec = z_vec;
+                pass.x_min_cam = x_min_cam;
+                pass.x_max_cam = x_max_cam;
+                pass.y_min_cam = y_min_cam;
+                pass.y_max_cam = y_max_cam;
+                pass.z_min_cam = z_min_cam;
+                pass.z_max = z_max;
             }
 
         } break;
@@ -1730,29 +1766,15 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
                         light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius))
                     };
 
-                    int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-                    Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-                    for (int j = 0; j < cull_count; j++) {
-
-                        Instance *instance = instance_shadow_cull_result[j];
-                        if (!instance->visible || !has_component<GeometryComponent>(instance->self.eid) ||
-                                !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                            cull_count--;
-                            SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                            j--;
-                        } else {
-                            if (get_component<GeometryComponent>(instance->self).material_is_animated) {
-                                animated_material_found = true;
-                            }
-
-                            instance->depth = near_plane.distance_to(instance->transform.origin);
-                            instance->depth_layer = 0;
-                        }
+                    ShadowPass &pass = _push_shadow_pass(p_instance);
+                    pass.pass = i;
+                    for (int j = 0; j < 5; j++) {
+                        pass.planes[j] = planes[j];
                     }
-
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
-                    VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+                    pass.plane_count = 5;
+                    pass.near_plane = Plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
+                    pass.transform = light_transform;
+                    pass.far = radius;
                 }
             } else { //shadow cube
 
@@ -1785,32 +1807,23 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
                     Frustum planes = cm.get_projection_planes(xform);
 
-                    int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
-                    Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-                    for (int j = 0; j < cull_count; j++) {
-
-                        Instance *instance = instance_shadow_cull_result[j];
-                        if (!instance->visible || !has_component<GeometryComponent>(instance->self.eid) ||
-                                !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                            cull_count--;
-                            SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                            j--;
-                        } else {
-                            if (get_component<GeometryComponent>(instance->self).material_is_animated) {
-                                animated_material_found = true;
-                            }
-                            instance->depth = near_plane.distance_to(instance->transform.origin);
-                            instance->depth_layer = 0;
-                        }
+                    ShadowPass &pass = _push_shadow_pass(p_instance);
+                    pass.pass = i;
+                    for (int j = 0; j < 6; j++) {
+                        pass.planes[j] = planes[j];
                     }
-
-                    VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
-                    VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+                    pass.plane_count = 6;
+                    pass.near_plane = Plane(xform.origin, -xform.basis.get_axis(2));
+                    pass.projection = cm;
+                    pass.transform = xform;
+                    pass.far = radius;
                 }
 
                 //restore the regular DP matrix
-                VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
+                ShadowPass &restore = _push_shadow_pass(p_instance);
+                restore.render = false;
+                restore.transform = light_transform;
+                restore.far = radius;
             }
 
         } break;
@@ -1823,33 +1836,101 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
             cm.set_perspective(angle * 2.0f, 1.0, 0.01f, radius);
 
             Frustum planes = cm.get_projection_planes(light_transform);
-            int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+            ShadowPass &pass = _push_shadow_pass(p_instance);
+            for (int j = 0; j < 6; j++) {
+                pass.planes[j] = planes[j];
+            }
+            pass.plane_count = 6;
+            pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+            pass.projection = cm;
+            pass.transform = light_transform;
+            pass.far = radius;
 
-            Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-            for (int j = 0; j < cull_count; j++) {
+        } break;
+    }
+}
 
-                Instance *instance = instance_shadow_cull_result[j];
-                if (!instance->visible || !has_component<GeometryComponent>(instance->self.eid) ||
-                        !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
-                    cull_count--;
-                    SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-                    j--;
-                } else {
-                    if (get_component<GeometryComponent>(instance->self).material_is_animated) {
-                        animated_material_found = true;
-                    }
-                    instance->depth = near_plane.distance_to(instance->transform.origin);
-                    instance->depth_layer = 0;
-                }
-            }
+void VisualServerScene::_cull_shadow_pass(ShadowPass &p_pass, Scenario *p_scenario) {
 
-            VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
-            VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+    if (!p_pass.render)
+        return;
 
-        } break;
+    int cull_count = _cull_convex(p_scenario, Span<const Plane>(p_pass.planes, p_pass.plane_count), p_pass.casters, VS::INSTANCE_GEOMETRY_MASK);
+    Instance **casters = p_pass.casters.data();
+
+    for (int j = 0; j < cull_count; j++) {
+
+        Instance *instance = casters[j];
+        if (!instance->visible || !has_component<GeometryComponent>(instance->self.eid) ||
+                !get_component<GeometryComponent>(instance->self).can_cast_shadows) {
+            cull_count--;
+            SWAP(casters[j], casters[cull_count]);
+            j--;
+            continue;
+        }
+
+        if (p_pass.directional) {
+            float min, max;
+            get_component<InstanceBoundsComponent>(instance->self).transformed_aabb.project_range_in_plane(Plane(p_pass.z_vec, 0), min, max);
+            if (max > p_pass.z_max)
+                p_pass.z_max = max;
+        } else if (get_component<GeometryComponent>(instance->self).material_is_animated) {
+            p_pass.animated_material_found = true;
+        }
+    }
+    p_pass.caster_count = cull_count;
+
+    if (p_pass.directional) {
+
+        real_t half_x = (p_pass.x_max_cam - p_pass.x_min_cam) * 0.5f;
+        real_t half_y = (p_pass.y_max_cam - p_pass.y_min_cam) * 0.5f;
+
+        p_pass.projection.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (p_pass.z_max - p_pass.z_min_cam));
+        p_pass.transform.origin = p_pass.x_vec * (p_pass.x_min_cam + half_x) + p_pass.y_vec * (p_pass.y_min_cam + half_y) + p_pass.z_vec * p_pass.z_max;
+    }
+}
+
+void VisualServerScene::_cull_shadow_passes(Scenario *p_scenario) {
+
+    // passes only read the scenario, each one owns its caster buffer.
+    JobSystem *job_system = JobSystem::get_singleton();
+    if (job_system && shadow_pass_count > 1 && p_scenario->sps->supports_concurrent_cull()) {
+        job_system->parallel_for(shadow_pass_count, [this, p_scenario](uint32_t i) { _cull_shadow_pass(shadow_passes[i], p_scenario); }, 1);
+    } else {
+        for (int i = 0; i < shadow_pass_count; i++) {
+            _cull_shadow_pass(shadow_passes[i], p_scenario);
+        }
     }
+}
+
+void VisualServerScene::_render_shadow_passes(RID p_shadow_atlas) {
+
+    bool animated_material_found = false;
+
+    for (int i = 0; i < shadow_pass_count; i++) {
+
+        ShadowPass &pass = shadow_passes[i];
+        InstanceLightData *light = static_cast<InstanceLightData *>(pass.light->base_data);
+
+        VSG::scene_render->light_instance_set_shadow_transform(light->instance, pass.projection, pass.transform, pass.far, pass.split, pass.pass, pass.bias_scale);
+
+        if (pass.render) {
+            for (int j = 0; j < pass.caster_count; j++) {
+                Instance *instance = pass.casters[j];
+                instance->depth = pass.near_plane.distance_to(instance->transform.origin);
+                instance->depth_layer = 0;
+            }
+            VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, pass.pass, (RasterizerScene::InstanceBase **)pass.casters.data(), pass.caster_count);
+            animated_material_found = animated_material_found || pass.animated_material_found;
+        }
 
-    return animated_material_found;
+        if (i + 1 == shadow_pass_count || shadow_passes[i + 1].light != pass.light) {
+            // last pass of this light, omni and spot shadows with animated casters are redrawn next frame
+            if (!pass.directional)
+                light->shadow_dirty = animated_material_found;
+            animated_material_found = false;
+        }
+    }
 }
 
 void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas) {
@@ -2009,20 +2090,13 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
     float z_far = p_cam_projection.get_z_far();
 
     /* STEP 2 - CULL */
-    instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+    instance_cull_count = _cull_convex(scenario, planes, instance_cull_result);
     light_cull_count = 0;
 
     reflection_probe_cull_count = 0;
 
     //light_samplers_culled=0;
 
-    /*
-    print_line("OT: "+rtos( (OS::get_singleton()->get_ticks_usec()-t)/1000.0));
-    print_line("OTO: "+itos(p_scenario->octree.get_octant_count()));
-    print_line("OTE: "+itos(p_scenario->octree.get_elem_count()));
-    print_line("OTP: "+itos(p_scenario->octree.get_pair_count()));
-    */
-
     /* STEP 3 - PROCESS PORTALS, VALIDATE ROOMS */
     //removed, will replace with culling
 
@@ -2176,6 +2250,8 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
     /* STEP 5 - PROCESS LIGHTS */
 
+    shadow_pass_count = 0;
+
     RID *directional_light_ptr = &light_instance_cull_result[light_cull_count];
     directional_light_count = 0;
 
@@ -2211,7 +2287,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
         for (int i = 0; i < directional_shadow_count; i++) {
 
-            _light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+            _light_instance_setup_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario);
         }
     }
 
@@ -2310,10 +2386,14 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
             if (redraw) {
                 //must redraw!
-                light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+                _light_instance_setup_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario);
             }
         }
     }
+
+    // cull every shadow pass (in parallel when the index allows it), then render them in order
+    _cull_shadow_passes(scenario);
+    _render_shadow_passes(p_shadow_atlas);
 }
 
 void VisualServerScene::_render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
@@ -2333,7 +2413,7 @@ void VisualServerScene::_render_scene(const Transform p_cam_transform, const Cam
 
     /* PROCESS GEOMETRY AND DRAW SCENE */
 
-    VSG::scene_render->render_scene(p_cam_transform, p_cam_projection, p_cam_orthogonal, (RasterizerScene::InstanceBase **)instance_cull_result, instance_cull_count, light_instance_cull_result, light_cull_count + directional_light_count, reflection_probe_instance_cull_result, reflection_probe_cull_count, environment, p_shadow_atlas, scenario->reflection_atlas, p_reflection_probe, p_reflection_probe_pass);
+    VSG::scene_render->render_scene(p_cam_transform, p_cam_projection, p_cam_orthogonal, (RasterizerScene::InstanceBase **)instance_cull_result.data(), instance_cull_count, light_instance_cull_result, light_cull_count + directional_light_count, reflection_probe_instance_cull_result, reflection_probe_cull_count, environment, p_shadow_atlas, scenario->reflection_atlas, p_reflection_probe, p_reflection_probe_pass);
 }
 
 void VisualServerScene::render_empty_scene(RID p_scenario, RID p_shadow_atlas) {
@@ -32,6 +32,7 @@
 
 #include "servers/visual/rasterizer.h"
 
+#include "core/math/bvh_tree.h"
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
@@ -46,7 +47,7 @@ class VisualServerScene {
 public:
     enum {
 
-        MAX_INSTANCE_CULL = 65536,
+        INITIAL_INSTANCE_CULL = 1024, // cull buffers grow past this as needed
         MAX_LIGHTS_CULLED = 4096,
         MAX_REFLECTION_PROBES_CULLED = 4096,
         MAX_ROOM_CULL = 32,
@@ -94,12 +95,67 @@ public:
 
     struct Instance;
 
+    //! Spatial index of a scenario, either the Octree or a BVHTree (see scenario_set_use_bvh).
+    class SpatialPartitioningScene {
+    public:
+        using PairCallback = void *(*)(void *, OctreeElementID, Instance *, int, OctreeElementID, Instance *, int);
+        using UnpairCallback = void (*)(void *, OctreeElementID, Instance *, int, OctreeElementID, Instance *, int, void *);
+
+        virtual OctreeElementID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) = 0;
+        virtual void move(OctreeElementID p_id, const AABB &p_aabb) = 0;
+        virtual void set_pairable(OctreeElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) = 0;
+        virtual void erase(OctreeElementID p_id) = 0;
+
+        virtual int cull_convex(Span<const Plane> p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) = 0;
+        virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) = 0;
+        virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) = 0;
+
+        virtual void set_pair_callback(PairCallback p_callback, void *p_userdata) = 0;
+        virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) = 0;
+        virtual int get_pair_count() const = 0;
+        //! Whether cull_* may be called from several threads at once (while nothing is inserted or moved).
+        virtual bool supports_concurrent_cull() const = 0;
+
+        virtual ~SpatialPartitioningScene() = default;
+    };
+
+    template <class TREE>
+    class SpatialPartitioningSceneImpl final : public SpatialPartitioningScene {
+        TREE tree;
+
+    public:
+        OctreeElementID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) override {
+            return tree.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+        }
+        void move(OctreeElementID p_id, const AABB &p_aabb) override { tree.move(p_id, p_aabb); }
+        void set_pairable(OctreeElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) override {
+            tree.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask);
+        }
+        void erase(OctreeElementID p_id) override { tree.erase(p_id); }
+
+        int cull_convex(Span<const Plane> p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask) override {
+            return tree.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+        }
+        int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) override {
+            return tree.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+        }
+        int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) override {
+            return tree.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+        }
+
+        void set_pair_callback(PairCallback p_callback, void *p_userdata) override { tree.set_pair_callback(p_callback, p_userdata); }
+        void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) override { tree.set_unpair_callback(p_callback, p_userdata); }
+        int get_pair_count() const override { return tree.get_pair_count(); }
+        bool supports_concurrent_cull() const override { return TREE::CONCURRENT_CULL; }
+    };
+
     struct Scenario : RID_Data {
 
         VS::ScenarioDebugMode debug;
         RID self;
 
-        Octree<Instance, true> octree;
+        SpatialPartitioningScene *sps = nullptr;
+        bool use_bvh = false;
 
         Vector<Instance *> directional_lights;
         RID environment;
@@ -110,6 +166,10 @@ public:
         SelfList<Instance>::List instances;
 
         Scenario() { debug = VS::SCENARIO_DEBUG_DISABLED; }
+        ~Scenario() {
+            if (sps)
+                memdelete(sps);
+        }
     };
 
     mutable RID_Owner<Scenario> scenario_owner;
@@ -117,12 +177,14 @@ public:
     static void *_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int);
     static void _instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *);
 
+    void _scenario_set_spatial_partitioning(Scenario *p_scenario, bool p_use_bvh);
     RID scenario_create();
 
     void scenario_set_debug(RID p_scenario, VS::ScenarioDebugMode p_debug_mode);
     void scenario_set_environment(RID p_scenario, RID p_environment);
     void scenario_set_fallback_environment(RID p_scenario, RID p_environment);
     void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv);
+    void scenario_set_use_bvh(RID p_scenario, bool p_enable);
 
     /* INSTANCING API */
 
@@ -137,11 +199,11 @@ public:
         //scenario stuff
         Scenario *scenario = nullptr;
         SelfList<Instance> scenario_item;
-        OctreeElementID octree_id = 0;
+        OctreeElementID spatial_partition_id = 0;
 
         //aabb stuff
 
-        uint32_t object_id=0;
+        ObjectID object_id=0;
 
         float lod_begin;
         float lod_end;
@@ -356,9 +418,38 @@ public:
         InstanceLightmapCaptureData() {}
     };
 
+    //! A single shadow map render of a light: a directional split, an omni paraboloid half or cube face, or a spot.
+    //! Passes are set up in order, culled concurrently and then rendered in the same order.
+    struct ShadowPass {
+        Instance *light = nullptr;
+        int pass = 0;
+        bool render = true; // false for passes that only set the shadow transform
+        bool directional = false;
+        bool animated_material_found = false;
+
+        Plane planes[6];
+        int plane_count = 0;
+        Plane near_plane; // casters' depth is measured from this
+
+        CameraMatrix projection;
+        Transform transform;
+        float far = 0;
+        float split = 0;
+        float bias_scale = 1.0f;
+
+        // directional lights finish their projection once the casters' depth range is known
+        Vector3 x_vec, y_vec, z_vec;
+        float x_min_cam = 0, x_max_cam = 0, y_min_cam = 0, y_max_cam = 0, z_min_cam = 0, z_max = 0;
+
+        Vector<Instance *> casters;
+        int caster_count = 0;
+    };
+
     int instance_cull_count;
-    Instance *instance_cull_result[MAX_INSTANCE_CULL];
-    Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+    Vector<Instance *> instance_cull_result;
+    Vector<Instance *> instance_shadow_cull_result; //used for the directional shadow depth range
+    Vector<ShadowPass> shadow_passes; // entries are reused between frames to keep the caster buffers
+    int shadow_pass_count = 0;
     Instance *light_cull_result[MAX_LIGHTS_CULLED];
     RID light_instance_cull_result[MAX_LIGHTS_CULLED];
     int light_cull_count;
@@ -404,8 +495,13 @@ public:
     void _update_instance_material(Instance *p_instance);
     _FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
-    _FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform,
-            const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
+    static int _cull_convex(Scenario *p_scenario, Span<const Plane> p_planes, Vector<Instance *> &r_result, uint32_t p_mask = 0xFFFFFFFF);
+    ShadowPass &_push_shadow_pass(Instance *p_light);
+    void _light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform,
+            const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, Scenario *p_scenario);
+    static void _cull_shadow_pass(ShadowPass &p_pass, Scenario *p_scenario);
+    void _cull_shadow_passes(Scenario *p_scenario);
+    void _render_shadow_passes(RID p_shadow_atlas);
 
     void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal,
             RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas,
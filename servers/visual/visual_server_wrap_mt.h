@@ -479,6 +479,7 @@ public:
     FUNC2(scenario_set_debug, RID, VS::ScenarioDebugMode)
     FUNC2(scenario_set_environment, RID, RID)
     FUNC3(scenario_set_reflection_atlas_size, RID, int, int)
+    FUNC2(scenario_set_use_bvh, RID, bool)
     FUNC2(scenario_set_fallback_environment, RID, RID)
 
     /* INSTANCING API */
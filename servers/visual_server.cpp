@@ -1827,6 +1827,7 @@ void VisualServer::_bind_methods() {
     MethodBinder::bind_method(D_METHOD("scenario_set_debug", {"scenario", "debug_mode"}), &VisualServer::scenario_set_debug);
     MethodBinder::bind_method(D_METHOD("scenario_set_environment", {"scenario", "environment"}), &VisualServer::scenario_set_environment);
     MethodBinder::bind_method(D_METHOD("scenario_set_reflection_atlas_size", {"scenario", "size", "subdiv"}), &VisualServer::scenario_set_reflection_atlas_size);
+    MethodBinder::bind_method(D_METHOD("scenario_set_use_bvh", {"scenario", "enable"}), &VisualServer::scenario_set_use_bvh);
     MethodBinder::bind_method(D_METHOD("scenario_set_fallback_environment", {"scenario", "environment"}), &VisualServer::scenario_set_fallback_environment);
 
 #ifndef _3D_DISABLED
@@ -2303,6 +2304,8 @@ VisualServer::VisualServer() {
     ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadow_atlas/quadrant_2_subdiv", PropertyInfo(VariantType::INT, "rendering/quality/shadow_atlas/quadrant_2_subdiv", PropertyHint::Enum, "Disabled,1 Shadow,4 Shadows,16 Shadows,64 Shadows,256 Shadows,1024 Shadows"));
     ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadow_atlas/quadrant_3_subdiv", PropertyInfo(VariantType::INT, "rendering/quality/shadow_atlas/quadrant_3_subdiv", PropertyHint::Enum, "Disabled,1 Shadow,4 Shadows,16 Shadows,64 Shadows,256 Shadows,1024 Shadows"));
 
+    GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", true);
+
     GLOBAL_DEF("rendering/quality/shadows/filter_mode", 1);
     GLOBAL_DEF("rendering/quality/shadows/filter_mode.mobile", 0);
     ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadows/filter_mode", PropertyInfo(VariantType::INT, "rendering/quality/shadows/filter_mode", PropertyHint::Enum, "Disabled,PCF5,PCF13"));
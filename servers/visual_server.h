@@ -651,6 +651,7 @@ public:
     virtual void scenario_set_debug(RID p_scenario, VS::ScenarioDebugMode p_debug_mode) = 0;
     virtual void scenario_set_environment(RID p_scenario, RID p_environment) = 0;
     virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv) = 0;
+    virtual void scenario_set_use_bvh(RID p_scenario, bool p_enable) = 0;
     virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment) = 0;
 
     /* INSTANCING API */